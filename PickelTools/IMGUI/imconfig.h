@@ -42,6 +42,23 @@
 //#define IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS              // Don't implement ImFileOpen/ImFileClose/ImFileRead/ImFileWrite so you can implement them yourself if you don't want to link with fopen/fclose/fread/fwrite. This will also disable the LogToTTY() function.
 //#define IMGUI_DISABLE_DEFAULT_ALLOCATORS                  // Don't implement default allocators calling malloc()/free() to avoid linking with them. You will need to call ImGui::SetAllocatorFunctions().
 
+//---- Don't use std::thread in ImParallelFor() (used by font atlas building when ImFontAtlasBuildOptions::ThreadsCount > 1). Work runs on the calling thread instead.
+//#define IMGUI_DISABLE_THREADS
+
+//---- Don't use SSE2/AVX2 intrinsics in hot paths such as ImDrawList::AddPolyline() (scalar code is used instead, output is identical).
+//#define IMGUI_DISABLE_SSE
+//#define IMGUI_DISABLE_AVX2
+
+//---- Use the counting allocator from imgui_allocator.cpp: NewFrame() rolls its per-frame counters and the Metrics window displays them.
+//     The allocator still needs to be installed with ImGui::InstallFrameAllocator(). Every allocation and free then takes a lock,
+//     which costs about 30 ns per pair over malloc()/free(): only enable it to investigate allocations.
+//#define IMGUI_ENABLE_FRAME_ALLOCATOR
+
+//---- Compile the IMGUI_PROFILE_ZONE() instrumentation zones of imgui_profiler.h (NewFrame(), Render() and the plugin callbacks), mark profiler frames
+//     in NewFrame() and show the profiler in the plugin settings. Zones only read the clock while a capture is running (see ImGui::ShowProfiler()),
+//     but still cost an atomic load each: only enable it to investigate frame times.
+//#define IMGUI_ENABLE_PROFILER
+
 //---- Include imgui_user.h at the end of imgui.h as a convenience
 //#define IMGUI_INCLUDE_IMGUI_USER_H
 
@@ -56,12 +56,14 @@ CODE
 // [SECTION] MISC HELPERS/UTILITIES (Geometry functions)
 // [SECTION] MISC HELPERS/UTILITIES (String, Format, Hash functions)
 // [SECTION] MISC HELPERS/UTILITIES (File functions)
+// [SECTION] MISC HELPERS/UTILITIES (Threading functions)
 // [SECTION] MISC HELPERS/UTILITIES (ImText* functions)
 // [SECTION] MISC HELPERS/UTILITIES (Color functions)
 // [SECTION] ImGuiStorage
 // [SECTION] ImGuiTextFilter
 // [SECTION] ImGuiTextBuffer
 // [SECTION] ImGuiListClipper
+// [SECTION] ImGuiVariableListClipper
 // [SECTION] RENDER HELPERS
 // [SECTION] MAIN CODE (most of the code! lots of stuff, needs tidying up!)
 // [SECTION] ERROR CHECKING
@@ -798,6 +800,10 @@ CODE
 #define IMGUI_DEFINE_MATH_OPERATORS
 #endif
 #include "imgui_internal.h"
+#ifdef IMGUI_ENABLE_FRAME_ALLOCATOR
+#include "imgui_allocator.h"
+#endif
+#include "imgui_profiler.h"     // IMGUI_PROFILE_ZONE() (empty unless IMGUI_ENABLE_PROFILER is defined)
 
 #include <ctype.h>      // toupper
 #include <stdio.h>      // vsnprintf, sscanf, printf
@@ -806,6 +812,11 @@ CODE
 #else
 #include <stdint.h>     // intptr_t
 #endif
+#ifndef IMGUI_DISABLE_THREADS
+#include <atomic>       // atomic<>
+#include <thread>       // thread, hardware_concurrency
+#include <vector>       // vector<>
+#endif
 
 // Debug options
 #define IMGUI_DEBUG_NAV_SCORING     0   // Display navigation scoring preview when hovering items. Display last moving direction matches when holding CTRL
@@ -874,10 +885,17 @@ static void             AddWindowToSortBuffer(ImVector<ImGuiWindow*>* out_sorted
 
 static ImRect           GetViewportRect();
 
+// Retained content
+static void             DestroyRetainedContentStorage(ImGuiContext* ctx);
+
 // Settings
 static void*            WindowSettingsHandler_ReadOpen(ImGuiContext*, ImGuiSettingsHandler*, const char* name);
 static void             WindowSettingsHandler_ReadLine(ImGuiContext*, ImGuiSettingsHandler*, void* entry, const char* line);
 static void             WindowSettingsHandler_WriteAll(ImGuiContext*, ImGuiSettingsHandler*, ImGuiTextBuffer* buf);
+static void             WindowSettingsHandler_ReadBinary(ImGuiContext*, ImGuiSettingsHandler*, const char* data, int data_size);
+static void             WindowSettingsHandler_WriteBinary(ImGuiContext*, ImGuiSettingsHandler*, ImVector<char>* buf);
+static void             SaveIniSettingsToDiskEx(const char* ini_filename, bool async);
+static void             DestroySettingsStorage(ImGuiContext* ctx);
 
 // Platform Dependents default implementation for IO functions
 static const char*      GetClipboardTextFn_DefaultImpl(void* user_data);
@@ -1545,6 +1563,61 @@ void*   ImFileLoadToMemory(const char* filename, const char* mode, size_t* out_f
     return file_data;
 }
 
+//-----------------------------------------------------------------------------
+// [SECTION] MISC HELPERS/UTILITIES (Threading functions)
+//-----------------------------------------------------------------------------
+
+#ifndef IMGUI_DISABLE_THREADS
+struct ImParallelForData
+{
+    void                (*Func)(int index, void* user_data);
+    void*               UserData;
+    int                 Count;
+    std::atomic<int>    NextIndex;
+};
+
+static void ImParallelForWorker(ImParallelForData* data)
+{
+    for (int index = data->NextIndex++; index < data->Count; index = data->NextIndex++)
+        data->Func(index, data->UserData);
+}
+#endif
+
+int ImGetHardwareThreadsCount()
+{
+#ifndef IMGUI_DISABLE_THREADS
+    const unsigned int count = std::thread::hardware_concurrency();
+    return count > 0 ? (int)count : 1;
+#else
+    return 1;
+#endif
+}
+
+void ImParallelFor(int count, void (*func)(int index, void* user_data), void* user_data, int threads_count)
+{
+#ifndef IMGUI_DISABLE_THREADS
+    threads_count = ImMin(threads_count, count);
+    if (threads_count > 1)
+    {
+        ImParallelForData data;
+        data.Func = func;
+        data.UserData = user_data;
+        data.Count = count;
+        data.NextIndex = 0;
+        std::vector<std::thread> workers;
+        workers.reserve((size_t)threads_count - 1);
+        for (int n = 1; n < threads_count; n++)
+            workers.push_back(std::thread(ImParallelForWorker, &data));
+        ImParallelForWorker(&data);
+        for (size_t n = 0; n < workers.size(); n++)
+            workers[n].join();
+        return;
+    }
+#endif
+    for (int index = 0; index < count; index++)
+        func(index, user_data);
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] MISC HELPERS/UTILITIES (ImText* functions)
 //-----------------------------------------------------------------------------
@@ -2259,6 +2332,236 @@ bool ImGuiListClipper::Step()
     return false;
 }
 
+//-----------------------------------------------------------------------------
+// [SECTION] ImGuiVariableListClipper
+// HeightsTree[n] holds the sum of the heights of items [n - lowbit(n), n), so prefix sums and updates touch O(log N) nodes.
+//-----------------------------------------------------------------------------
+
+static double VariableListClipper_GetPrefixSum(const ImVector<double>& tree, int count)
+{
+    double sum = 0.0;
+    for (int n = count; n > 0; n -= n & -n)
+        sum += tree[n];
+    return sum;
+}
+
+float ImGuiVariableListClipper::GetItemOffsetY(int item_index) const
+{
+    IM_ASSERT(item_index >= 0 && item_index <= ItemsHeight.Size);
+    return (float)VariableListClipper_GetPrefixSum(HeightsTree, item_index);
+}
+
+int ImGuiVariableListClipper::FindItemAtOffsetY(float offset_y) const
+{
+    const int count = ItemsHeight.Size;
+    if (count == 0 || offset_y <= 0.0f)
+        return 0;
+
+    // Find the number of items fitting entirely before 'offset_y' by walking down the tree
+    int step = 1;
+    while (step * 2 <= count)
+        step *= 2;
+    int n = 0;
+    double remaining = offset_y;
+    for (; step > 0; step >>= 1)
+        if (n + step <= count && HeightsTree[n + step] <= remaining)
+        {
+            n += step;
+            remaining -= HeightsTree[n];
+        }
+    return ImMin(n, count - 1);
+}
+
+void ImGuiVariableListClipper::SetItemHeight(int item_index, float height)
+{
+    IM_ASSERT(item_index >= 0 && item_index < ItemsHeight.Size);
+    const double delta = (double)height - ItemsHeight[item_index];
+    if (delta == 0.0)
+        return;
+    ItemsHeight[item_index] = height;
+    for (int n = item_index + 1; n < HeightsTree.Size; n += n & -n)
+        HeightsTree[n] += delta;
+}
+
+// Build the whole tree in O(N): each node adds its sum to the first node covering it
+static void VariableListClipper_BuildTree(const ImVector<float>& heights, ImVector<double>& tree)
+{
+    const int count = heights.Size;
+    tree.resize(count + 1);
+    tree[0] = 0.0;
+    for (int n = 1; n <= count; n++)
+        tree[n] = heights[n - 1];
+    for (int n = 1; n <= count; n++)
+    {
+        const int parent = n + (n & -n);
+        if (parent <= count)
+            tree[parent] += tree[n];
+    }
+}
+
+void ImGuiVariableListClipper::InsertItems(int item_index, int count)
+{
+    IM_ASSERT(ItemsCount == -1 && "Can't call InsertItems() between Begin() and End()");
+    IM_ASSERT(item_index >= 0 && item_index <= ItemsHeight.Size && count >= 0);
+    if (count == 0)
+        return;
+    if (DefaultItemHeight <= 0.0f)
+        DefaultItemHeight = GImGui->FontSize + GImGui->Style.ItemSpacing.y;
+    const int prev_count = ItemsHeight.Size;
+    ItemsHeight.resize(prev_count + count);
+    memmove(ItemsHeight.Data + item_index + count, ItemsHeight.Data + item_index, (size_t)(prev_count - item_index) * sizeof(float));
+    for (int n = item_index; n < item_index + count; n++)
+        ItemsHeight[n] = DefaultItemHeight;
+    VariableListClipper_BuildTree(ItemsHeight, HeightsTree);
+    if (AnchorItem >= item_index)
+        AnchorItem += count;
+}
+
+void ImGuiVariableListClipper::EraseItems(int item_index, int count)
+{
+    IM_ASSERT(ItemsCount == -1 && "Can't call EraseItems() between Begin() and End()");
+    IM_ASSERT(item_index >= 0 && count >= 0 && item_index + count <= ItemsHeight.Size);
+    if (count == 0)
+        return;
+    ItemsHeight.erase(ItemsHeight.Data + item_index, ItemsHeight.Data + item_index + count);
+    VariableListClipper_BuildTree(ItemsHeight, HeightsTree);
+    if (AnchorItem >= item_index + count)
+        AnchorItem -= count;
+    else if (AnchorItem >= item_index)
+        AnchorItem = -1;
+}
+
+void ImGuiVariableListClipper::Clear()
+{
+    IM_ASSERT(ItemsCount == -1 && "Can't call Clear() between Begin() and End()");
+    ItemsHeight.clear();
+    HeightsTree.clear();
+    AnchorItem = -1;
+}
+
+void ImGuiVariableListClipper::Begin(int items_count)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    IM_ASSERT(items_count >= 0);
+    IM_ASSERT(ItemsCount == -1 && "Forgot to call End()?");
+    if (DefaultItemHeight <= 0.0f)
+        DefaultItemHeight = g.FontSize + g.Style.ItemSpacing.y;
+
+    // Resize. Removing items leaves the remaining nodes valid, added nodes are built from the nodes before them.
+    const int prev_count = ItemsHeight.Size;
+    ItemsHeight.resize(items_count, DefaultItemHeight);
+    HeightsTree.resize(items_count + 1, 0.0);
+    for (int n = prev_count + 1; n <= items_count; n++)
+        HeightsTree[n] = ItemsHeight[n - 1] + VariableListClipper_GetPrefixSum(HeightsTree, n - 1) - VariableListClipper_GetPrefixSum(HeightsTree, n - (n & -n));
+
+    ItemsCount = items_count;
+    StartPosY = window->DC.CursorPos.y;
+    StepNo = 0;
+    ItemCurrent = -1;
+
+    // Items above the anchor of the last frame changed height since (e.g. SetItemHeight() between frames): view the list as if the scrolling
+    // already followed the anchor, and request that scrolling for the next frame. Skipped when the scrolling changed or is about to change.
+    float anchor_delta = 0.0f;
+    if (AnchorItem >= 0 && AnchorItem < items_count && window->Scroll.y == AnchorScrollY && window->ScrollTarget.y == FLT_MAX)
+        anchor_delta = (float)(VariableListClipper_GetPrefixSum(HeightsTree, AnchorItem) - AnchorOffsetY);
+    AnchorItem = -1;
+    if (g.LogEnabled)
+    {
+        // If logging is active, do not perform any clipping
+        DisplayStart = 0;
+        DisplayEnd = items_count;
+    }
+    else if (window->SkipItems || items_count == 0)
+    {
+        DisplayStart = DisplayEnd = 0;
+    }
+    else
+    {
+        // We create the union of the ClipRect and the NavScoringRect which at worst should be 1 page away from ClipRect
+        ImRect unclipped_rect = window->ClipRect;
+        if (g.NavMoveRequest)
+            unclipped_rect.Add(g.NavScoringRectScreen);
+        int start = FindItemAtOffsetY(unclipped_rect.Min.y - StartPosY + anchor_delta);
+        int end = FindItemAtOffsetY(unclipped_rect.Max.y - StartPosY + anchor_delta) + 1;
+
+        // When performing a navigation request, ensure we have one item extra in the direction we are moving to
+        if (g.NavMoveRequest && g.NavMoveClipDir == ImGuiDir_Up)
+            start--;
+        if (g.NavMoveRequest && g.NavMoveClipDir == ImGuiDir_Down)
+            end++;
+        DisplayStart = ImClamp(start, 0, items_count);
+        DisplayEnd = ImClamp(end, DisplayStart, items_count);
+
+        // Anchor the first item whose top is visible (or the one covering the whole view), items revealed at the top while scrolling up
+        // then grow above it. Only items before the anchor can move it, which happens when SetItemHeight() is called or with navigation.
+        const float clip_min_y = window->ClipRect.Min.y - StartPosY + anchor_delta;
+        AnchorItem = FindItemAtOffsetY(clip_min_y);
+        if (AnchorItem + 1 < items_count && GetItemOffsetY(AnchorItem) < clip_min_y && GetItemOffsetY(AnchorItem + 1) < window->ClipRect.Max.y - StartPosY + anchor_delta)
+            AnchorItem++;
+        AnchorOffsetY = VariableListClipper_GetPrefixSum(HeightsTree, AnchorItem);
+        AnchorScrollY = window->Scroll.y;
+        if (ImFabs(anchor_delta) > 0.001f)
+        {
+            AnchorScrollY = ImMax(window->Scroll.y + anchor_delta, 0.0f);
+            ImGui::SetScrollY(window, AnchorScrollY);
+        }
+    }
+
+    if (DisplayStart > 0)
+        SetCursorPosYAndSetupDummyPrevLine(StartPosY + GetItemOffsetY(DisplayStart), ItemsHeight[DisplayStart - 1]); // advance cursor
+}
+
+bool ImGuiVariableListClipper::Step()
+{
+    if (ItemsCount < 0)
+        return false;
+    if (StepNo == 0 && DisplayStart < DisplayEnd)
+    {
+        StepNo = 1;
+        return true;
+    }
+    End();
+    return false;
+}
+
+void ImGuiVariableListClipper::BeginItem(int item_index)
+{
+    ImGuiWindow* window = GImGui->CurrentWindow;
+    IM_ASSERT(item_index >= 0 && item_index < ItemsCount);
+    if (ItemCurrent >= 0 && window->DC.CursorPos.y > ItemCurrentPosY)
+        SetItemHeight(ItemCurrent, window->DC.CursorPos.y - ItemCurrentPosY);
+    ItemCurrent = item_index;
+    ItemCurrentPosY = window->DC.CursorPos.y;
+}
+
+void ImGuiVariableListClipper::End()
+{
+    if (ItemsCount < 0)
+        return;
+    ImGuiWindow* window = GImGui->CurrentWindow;
+    if (ItemCurrent >= 0 && window->DC.CursorPos.y > ItemCurrentPosY)
+        SetItemHeight(ItemCurrent, window->DC.CursorPos.y - ItemCurrentPosY);
+    ItemCurrent = -1;
+
+    // Scroll by the amount the anchor moved, unless a scroll position was already requested. The anchor is kept for the next Begin(),
+    // which follows the changes made in between.
+    if (AnchorItem >= 0 && window->ScrollTarget.y == FLT_MAX)
+    {
+        const double delta = VariableListClipper_GetPrefixSum(HeightsTree, AnchorItem) - AnchorOffsetY;
+        if (ImFabs((float)delta) > 0.001f)
+        {
+            AnchorOffsetY += delta;
+            AnchorScrollY = ImMax(window->Scroll.y + (float)delta, 0.0f);
+            ImGui::SetScrollY(window, AnchorScrollY);
+        }
+    }
+
+    SetCursorPosYAndSetupDummyPrevLine(StartPosY + GetTotalHeight(), ItemsCount > 0 ? ItemsHeight[ItemsCount - 1] : DefaultItemHeight); // advance cursor
+    ItemsCount = -1;
+    StepNo = 2;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] RENDER HELPERS
 // Some of those (internal) functions are currently quite a legacy mess - their signature and behavior will change.
@@ -3585,6 +3888,7 @@ void ImGui::NewFrame()
 {
     IM_ASSERT(GImGui != NULL && "No current context. Did you call ImGui::CreateContext() and ImGui::SetCurrentContext() ?");
     ImGuiContext& g = *GImGui;
+    IMGUI_PROFILE_ZONE("ImGui::NewFrame");
 
 #ifdef IMGUI_ENABLE_TEST_ENGINE
     ImGuiTestEngineHook_PreNewFrame(&g);
@@ -3609,7 +3913,7 @@ void ImGui::NewFrame()
         if (g.SettingsDirtyTimer <= 0.0f)
         {
             if (g.IO.IniFilename != NULL)
-                SaveIniSettingsToDisk(g.IO.IniFilename);
+                SaveIniSettingsToDiskEx(g.IO.IniFilename, GetIniSavingOptions().Async);
             else
                 g.IO.WantSaveIniSettings = true;  // Let user know they can call SaveIniSettingsToMemory(). user will need to clear io.WantSaveIniSettings themselves.
             g.SettingsDirtyTimer = 0.0f;
@@ -3621,8 +3925,16 @@ void ImGui::NewFrame()
     g.FrameCount += 1;
     g.TooltipOverrideCount = 0;
     g.WindowsActiveCount = 0;
+#ifdef IMGUI_ENABLE_FRAME_ALLOCATOR
+    FrameAllocatorNewFrame();
+#endif
+#ifdef IMGUI_ENABLE_PROFILER
+    ProfilerNewFrame();
+#endif
 
     // Setup current font and draw list shared data
+    // With ImFontAtlasFlags_DynamicGlyphs, rasterize the glyphs requested during the previous frame. The renderer uploads GetTexDirtyRects().
+    g.IO.Fonts->BuildPendingGlyphs();
     g.IO.Fonts->Locked = true;
     SetCurrentFont(GetDefaultFont());
     IM_ASSERT(g.Font->IsLoaded());
@@ -3884,6 +4196,7 @@ void ImGui::Shutdown(ImGuiContext* context)
         SaveIniSettingsToDisk(g.IO.IniFilename);
         SetCurrentContext(backup_context);
     }
+    DestroySettingsStorage(context);
 
     // Clear everything else
     for (int i = 0; i < g.Windows.Size; i++)
@@ -3909,6 +4222,7 @@ void ImGui::Shutdown(ImGuiContext* context)
 
     g.TabBars.Clear();
     g.CurrentTabBarStack.clear();
+    DestroyRetainedContentStorage(context);
     g.ShrinkWidthBuffer.clear();
 
     g.PrivateClipboard.clear();
@@ -4072,6 +4386,226 @@ void ImGui::PopClipRect()
     window->ClipRect = window->DrawList->_ClipRectStack.back();
 }
 
+// Side table of the retained content of each context (see ImGuiRetainedContentStorage). Like GImGui, it isn't protected against concurrent accesses.
+static ImVector<ImGuiRetainedContentStorage*> GRetainedContentStorages;
+
+ImGuiRetainedContentStorage* ImGui::FindRetainedContentStorage(ImGuiContext* ctx)
+{
+    for (int n = 0; n < GRetainedContentStorages.Size; n++)
+        if (GRetainedContentStorages[n]->Context == ctx)
+            return GRetainedContentStorages[n];
+    return NULL;
+}
+
+static void DestroyRetainedContentStorage(ImGuiContext* ctx)
+{
+    for (int n = 0; n < GRetainedContentStorages.Size; n++)
+        if (GRetainedContentStorages[n]->Context == ctx)
+        {
+            IM_DELETE(GRetainedContentStorages[n]);
+            GRetainedContentStorages.erase(GRetainedContentStorages.Data + n);
+            break;
+        }
+    if (GRetainedContentStorages.Size == 0)
+        GRetainedContentStorages.clear();
+}
+
+void ImGui::ClearRetainedContents()
+{
+    DestroyRetainedContentStorage(GImGui);
+}
+
+// Recordings are only reused on the frame following their last use, so older ones only hold memory. Keep them for a while anyway:
+// windows appearing and disappearing would otherwise reallocate them every time. A frame count going backward means the address
+// of a destroyed context was reused for a new one.
+void ImGui::GcRetainedContents(ImGuiRetainedContentStorage* storage)
+{
+    ImGuiContext& g = *storage->Context;
+    storage->LastGcFrame = g.FrameCount;
+    ImGuiStorage& map = storage->Contents.Map;
+    for (int n = 0; n < map.Data.Size; n++)
+    {
+        const int idx = map.Data[n].val_i;
+        if (idx == -1)
+            continue;
+        ImGuiRetainedContent* rc = storage->Contents.GetByIndex(idx);
+        if (rc == storage->Current)
+            continue;
+        if (rc->LastFrameActive < g.FrameCount - IMGUI_RETAINED_CONTENT_GC_FRAMES || rc->LastFrameActive > g.FrameCount)
+        {
+            storage->Contents.Remove(map.Data[n].key, idx);
+            storage->ContentsCount--;
+        }
+    }
+    if (storage->ContentsCount == 0)
+        storage->Contents.Clear();
+}
+
+// Reuse the draw list output of a region of the current window when nothing it depends on changed since the previous frame.
+// We never reuse while the window is hovered, active or navigated, so skipping the widgets submission cannot lose any interaction.
+bool ImGui::BeginRetainedContent(const char* str_id, ImGuiID content_key)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = GetCurrentWindow();
+    ImGuiRetainedContentStorage* storage = FindRetainedContentStorage(&g);
+    if (storage == NULL)
+    {
+        storage = IM_NEW(ImGuiRetainedContentStorage)();
+        storage->Context = &g;
+        GRetainedContentStorages.push_back(storage);
+    }
+    IM_ASSERT(storage->Current == NULL && "Nested BeginRetainedContent() calls are not supported");
+    IM_ASSERT(window->DC.CurrentColumns == NULL && "Retained content cannot be recorded while columns are active");
+    if (storage->LastGcFrame != g.FrameCount)
+        GcRetainedContents(storage);
+
+    const ImGuiID id = window->GetID(str_id);
+    ImGuiRetainedContent* rc = storage->Contents.GetByKey(id);
+    if (rc == NULL)
+    {
+        rc = storage->Contents.GetOrAddByKey(id);
+        storage->ContentsCount++;
+    }
+    rc->ID = id;
+    storage->Current = rc;
+    if (window->SkipItems)
+        return false;
+
+    ImDrawList* draw_list = window->DrawList;
+    const ImVec4 clip_rect = draw_list->_ClipRectStack.back();
+    const ImTextureID texture_id = draw_list->_TextureIdStack.Size ? draw_list->_TextureIdStack.back() : NULL;
+    const bool interacting = (g.HoveredWindow == window) || (g.ActiveIdWindow == window) || (g.NavWindow == window && !g.NavDisableHighlight);
+    const bool reuse = content_key != 0 && rc->ContentKey == content_key && rc->Window == window && rc->LastFrameActive == g.FrameCount - 1 && !interacting
+        && rc->StartCursorPos.x == window->DC.CursorPos.x && rc->StartCursorPos.y == window->DC.CursorPos.y && memcmp(&rc->StartClipRect, &clip_rect, sizeof(ImVec4)) == 0
+        && rc->StartTextureId == texture_id && rc->StartFont == g.Font && rc->StartFontSize == g.FontSize && rc->StartAlpha == g.Style.Alpha;
+
+    rc->ContentKey = content_key;
+    rc->Window = window;
+    rc->LastFrameActive = g.FrameCount;
+    rc->Replaying = reuse;
+    rc->Recording = !reuse && content_key != 0;
+    if (reuse)
+        return false;
+
+    rc->StartCursorPos = window->DC.CursorPos;
+    rc->StartClipRect = clip_rect;
+    rc->StartTextureId = texture_id;
+    rc->StartFont = g.Font;
+    rc->StartFontSize = g.FontSize;
+    rc->StartAlpha = g.Style.Alpha;
+    if (rc->Recording)
+    {
+        // Measure the extent of the region alone, so replaying doesn't depend on what was submitted before it
+        rc->RecordCmdStart = draw_list->CmdBuffer.Size - 1;
+        rc->RecordIdxStart = draw_list->IdxBuffer.Size;
+        rc->BackupCursorMaxPos = window->DC.CursorMaxPos;
+        window->DC.CursorMaxPos = window->DC.CursorPos;
+    }
+    return true;
+}
+
+void ImGui::EndRetainedContent()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = GetCurrentWindow();
+    ImGuiRetainedContentStorage* storage = FindRetainedContentStorage(&g);
+    ImGuiRetainedContent* rc = storage ? storage->Current : NULL;
+    IM_ASSERT(rc != NULL && "Mismatched BeginRetainedContent()/EndRetainedContent() calls");
+    storage->Current = NULL;
+    if (!rc->Recording && !rc->Replaying)
+        return;
+    IM_ASSERT(rc->Window == window && window->DC.CurrentColumns == NULL);
+
+    ImDrawList* draw_list = window->DrawList;
+    if (rc->Recording)
+    {
+        rc->Recording = false;
+        rc->EndCursorPos = window->DC.CursorPos;
+        rc->EndCursorPosPrevLine = window->DC.CursorPosPrevLine;
+        rc->EndCursorMaxPos = window->DC.CursorMaxPos;
+        rc->EndCurrLineSize = window->DC.CurrLineSize;
+        rc->EndPrevLineSize = window->DC.PrevLineSize;
+        rc->EndCurrLineTextBaseOffset = window->DC.CurrLineTextBaseOffset;
+        rc->EndPrevLineTextBaseOffset = window->DC.PrevLineTextBaseOffset;
+        window->DC.CursorMaxPos = ImMax(rc->BackupCursorMaxPos, window->DC.CursorMaxPos);
+
+        // Copy the commands submitted since BeginRetainedContent(). The first one may have started earlier, or have been merged into its
+        // predecessor, and large meshes may have switched VtxOffset: store each command with its own vertex range.
+        rc->CmdBuffer.resize(0);
+        rc->IdxBuffer.resize(0);
+        rc->VtxBuffer.resize(0);
+        for (int cmd_n = ImMax(rc->RecordCmdStart - 1, 0); cmd_n < draw_list->CmdBuffer.Size; cmd_n++)
+        {
+            const ImDrawCmd& src_cmd = draw_list->CmdBuffer[cmd_n];
+            const int idx_start = ImMax((int)src_cmd.IdxOffset, rc->RecordIdxStart);
+            const int idx_count = (int)(src_cmd.IdxOffset + src_cmd.ElemCount) - idx_start;
+            const bool is_callback = (src_cmd.UserCallback != NULL && cmd_n >= rc->RecordCmdStart);
+            if (idx_count <= 0 && !is_callback)
+                continue;
+
+            ImGuiRetainedDrawCmd dst_cmd;
+            dst_cmd.ClipRect = src_cmd.ClipRect;
+            dst_cmd.TextureId = src_cmd.TextureId;
+            dst_cmd.UserCallback = is_callback ? src_cmd.UserCallback : NULL;
+            dst_cmd.UserCallbackData = is_callback ? src_cmd.UserCallbackData : NULL;
+            dst_cmd.IdxOffset = rc->IdxBuffer.Size;
+            dst_cmd.IdxCount = ImMax(idx_count, 0);
+            dst_cmd.VtxOffset = rc->VtxBuffer.Size;
+            dst_cmd.VtxCount = 0;
+            if (dst_cmd.IdxCount > 0)
+            {
+                const ImDrawIdx* src_idx = draw_list->IdxBuffer.Data + idx_start;
+                unsigned int vtx_min = (unsigned int)-1, vtx_max = 0;
+                for (int n = 0; n < idx_count; n++)
+                {
+                    vtx_min = ImMin(vtx_min, (unsigned int)src_idx[n]);
+                    vtx_max = ImMax(vtx_max, (unsigned int)src_idx[n]);
+                }
+                dst_cmd.VtxCount = (int)(vtx_max - vtx_min + 1);
+                rc->VtxBuffer.resize(dst_cmd.VtxOffset + dst_cmd.VtxCount);
+                memcpy(rc->VtxBuffer.Data + dst_cmd.VtxOffset, draw_list->VtxBuffer.Data + src_cmd.VtxOffset + vtx_min, (size_t)dst_cmd.VtxCount * sizeof(ImDrawVert));
+                rc->IdxBuffer.resize(dst_cmd.IdxOffset + idx_count);
+                ImDrawIdx* dst_idx = rc->IdxBuffer.Data + dst_cmd.IdxOffset;
+                for (int n = 0; n < idx_count; n++)
+                    dst_idx[n] = (ImDrawIdx)(src_idx[n] - vtx_min);
+            }
+            rc->CmdBuffer.push_back(dst_cmd);
+        }
+        return;
+    }
+
+    // Replay the recording, then restore the layout state as if the content had been submitted
+    rc->Replaying = false;
+    for (int cmd_n = 0; cmd_n < rc->CmdBuffer.Size; cmd_n++)
+    {
+        const ImGuiRetainedDrawCmd& cmd = rc->CmdBuffer[cmd_n];
+        if (cmd.UserCallback != NULL)
+            draw_list->AddCallback(cmd.UserCallback, cmd.UserCallbackData);
+        if (cmd.IdxCount == 0)
+            continue;
+        draw_list->PushClipRect(ImVec2(cmd.ClipRect.x, cmd.ClipRect.y), ImVec2(cmd.ClipRect.z, cmd.ClipRect.w));
+        draw_list->PushTextureID(cmd.TextureId);
+        draw_list->PrimReserve(cmd.IdxCount, cmd.VtxCount);
+        memcpy(draw_list->_VtxWritePtr, rc->VtxBuffer.Data + cmd.VtxOffset, (size_t)cmd.VtxCount * sizeof(ImDrawVert));
+        const ImDrawIdx* src_idx = rc->IdxBuffer.Data + cmd.IdxOffset;
+        const unsigned int idx_base = draw_list->_VtxCurrentIdx;
+        for (int n = 0; n < cmd.IdxCount; n++)
+            draw_list->_IdxWritePtr[n] = (ImDrawIdx)(src_idx[n] + idx_base);
+        draw_list->_VtxWritePtr += cmd.VtxCount;
+        draw_list->_IdxWritePtr += cmd.IdxCount;
+        draw_list->_VtxCurrentIdx += cmd.VtxCount;
+        draw_list->PopTextureID();
+        draw_list->PopClipRect();
+    }
+    window->DC.CursorPos = rc->EndCursorPos;
+    window->DC.CursorPosPrevLine = rc->EndCursorPosPrevLine;
+    window->DC.CursorMaxPos = ImMax(window->DC.CursorMaxPos, rc->EndCursorMaxPos);
+    window->DC.CurrLineSize = rc->EndCurrLineSize;
+    window->DC.PrevLineSize = rc->EndPrevLineSize;
+    window->DC.CurrLineTextBaseOffset = rc->EndCurrLineTextBaseOffset;
+    window->DC.PrevLineTextBaseOffset = rc->EndPrevLineTextBaseOffset;
+}
+
 // This is normally called by Render(). You may want to call it directly if you want to avoid calling Render() but the gain will be very minimal.
 void ImGui::EndFrame()
 {
@@ -4153,6 +4687,7 @@ void ImGui::EndFrame()
 void ImGui::Render()
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_PROFILE_ZONE("ImGui::Render");
     IM_ASSERT(g.Initialized);
 
     if (g.FrameCountEnded != g.FrameCount)
@@ -9453,6 +9988,141 @@ void ImGui::MarkIniSettingsDirty(ImGuiWindow* window)
             g.SettingsDirtyTimer = g.IO.IniSavingRate;
 }
 
+#ifndef IMGUI_DISABLE_THREADS
+// Writes the .ini file from a background thread. The thread only does file I/O: the buffers are filled and freed by the main thread, after joining it.
+struct ImGuiSettingsWriter
+{
+    std::thread         Thread;
+    ImVector<char>      Filename;       // Zero-terminated
+    ImVector<char>      TempFilename;   // Zero-terminated
+    ImVector<char>      Data;
+    bool                Result;
+
+    ImGuiSettingsWriter() { Result = true; }
+};
+
+static void SettingsWriter_Run(ImGuiSettingsWriter* writer)
+{
+    writer->Result = ImFileWriteAtomic(writer->Filename.Data, writer->TempFilename.Data, writer->Data.Data, (size_t)writer->Data.Size);
+}
+#else
+struct ImGuiSettingsWriter
+{
+};
+#endif
+
+// Wait for the background write started by the previous save, if any
+static void SettingsWriter_Wait(ImGuiSettingsStorage* storage)
+{
+#ifndef IMGUI_DISABLE_THREADS
+    ImGuiSettingsWriter* writer = storage->Writer;
+    if (writer && writer->Thread.joinable())
+    {
+        writer->Thread.join();
+        if (!writer->Result)
+            storage->LastSavedHash = 0; // Write again on the next save
+    }
+#else
+    IM_UNUSED(storage);
+#endif
+}
+
+// Side table of the settings state of each context (see ImGuiSettingsStorage). Like GImGui, it isn't protected against concurrent accesses.
+static ImVector<ImGuiSettingsStorage*> GSettingsStorages;
+
+ImGuiSettingsStorage* ImGui::FindSettingsStorage(ImGuiContext* ctx)
+{
+    for (int n = 0; n < GSettingsStorages.Size; n++)
+        if (GSettingsStorages[n]->Context == ctx)
+            return GSettingsStorages[n];
+    return NULL;
+}
+
+static ImGuiSettingsStorage* GetSettingsStorage(ImGuiContext* ctx)
+{
+    if (ImGuiSettingsStorage* storage = ImGui::FindSettingsStorage(ctx))
+        return storage;
+    ImGuiSettingsStorage* storage = IM_NEW(ImGuiSettingsStorage)();
+    storage->Context = ctx;
+    ImGuiSettingsBinaryHandler binary_handler;
+    binary_handler.TypeHash = ImHashStr("Window");
+    binary_handler.ReadBinaryFn = WindowSettingsHandler_ReadBinary;
+    binary_handler.WriteBinaryFn = WindowSettingsHandler_WriteBinary;
+    storage->BinaryHandlers.push_back(binary_handler);
+    GSettingsStorages.push_back(storage);
+    return storage;
+}
+
+static void DestroySettingsStorage(ImGuiContext* ctx)
+{
+    for (int n = 0; n < GSettingsStorages.Size; n++)
+        if (GSettingsStorages[n]->Context == ctx)
+        {
+            ImGuiSettingsStorage* storage = GSettingsStorages[n];
+            if (storage->Writer)
+            {
+                SettingsWriter_Wait(storage);
+                IM_DELETE(storage->Writer);
+            }
+            IM_DELETE(storage);
+            GSettingsStorages.erase(GSettingsStorages.Data + n);
+            break;
+        }
+    if (GSettingsStorages.Size == 0)
+        GSettingsStorages.clear();
+}
+
+void ImGui::SetIniSavingOptions(const ImGuiIniSavingOptions& options)
+{
+    GetSettingsStorage(GImGui)->Options = options;
+}
+
+const ImGuiIniSavingOptions& ImGui::GetIniSavingOptions()
+{
+    return GetSettingsStorage(GImGui)->Options;
+}
+
+// Replaces the binary support of the settings handler of the same TypeHash, if any
+void ImGui::AddSettingsBinaryHandler(const ImGuiSettingsBinaryHandler& handler)
+{
+    ImGuiSettingsStorage* storage = GetSettingsStorage(GImGui);
+    for (int n = 0; n < storage->BinaryHandlers.Size; n++)
+        if (storage->BinaryHandlers[n].TypeHash == handler.TypeHash)
+        {
+            storage->BinaryHandlers[n] = handler;
+            return;
+        }
+    storage->BinaryHandlers.push_back(handler);
+}
+
+static const ImGuiSettingsBinaryHandler* FindSettingsBinaryHandler(ImGuiSettingsStorage* storage, ImGuiID type_hash)
+{
+    for (int n = 0; n < storage->BinaryHandlers.Size; n++)
+        if (storage->BinaryHandlers[n].TypeHash == type_hash)
+            return &storage->BinaryHandlers[n];
+    return NULL;
+}
+
+// Index the chunks appended to g.SettingsWindows since the last call. Settings are only ever appended, or all cleared on shutdown,
+// but the context may be shared with another copy of Dear ImGui which doesn't maintain the map: a shrunk buffer means it was cleared.
+// Offsets are always > 0 (chunks start with their size), the first entry wins on duplicate IDs.
+static void UpdateWindowSettingsMap(ImGuiContext& g, ImGuiSettingsStorage* storage)
+{
+    if (g.SettingsWindows.size() < storage->WindowsMapBufSize)
+    {
+        storage->WindowsMap.Clear();
+        storage->WindowsMapBufSize = 0;
+    }
+    for (int offset = storage->WindowsMapBufSize + (int)sizeof(int); offset < g.SettingsWindows.size(); )
+    {
+        ImGuiWindowSettings* settings = g.SettingsWindows.ptr_from_offset(offset);
+        if (storage->WindowsMap.GetInt(settings->ID) == 0)
+            storage->WindowsMap.SetInt(settings->ID, offset);
+        offset += g.SettingsWindows.chunk_size(settings);
+    }
+    storage->WindowsMapBufSize = g.SettingsWindows.size();
+}
+
 ImGuiWindowSettings* ImGui::CreateNewWindowSettings(const char* name)
 {
     ImGuiContext& g = *GImGui;
@@ -9471,17 +10141,25 @@ ImGuiWindowSettings* ImGui::CreateNewWindowSettings(const char* name)
     IM_PLACEMENT_NEW(settings) ImGuiWindowSettings();
     settings->ID = ImHashStr(name, name_len);
     memcpy(settings->GetName(), name, name_len + 1);   // Store with zero terminator
-
+    UpdateWindowSettingsMap(g, GetSettingsStorage(&g));
     return settings;
 }
 
 ImGuiWindowSettings* ImGui::FindWindowSettings(ImGuiID id)
 {
     ImGuiContext& g = *GImGui;
-    for (ImGuiWindowSettings* settings = g.SettingsWindows.begin(); settings != NULL; settings = g.SettingsWindows.next_chunk(settings))
-        if (settings->ID == id)
-            return settings;
-    return NULL;
+    ImGuiSettingsStorage* storage = GetSettingsStorage(&g);
+    UpdateWindowSettingsMap(g, storage);
+    int offset = storage->WindowsMap.GetInt(id);
+    if (offset != 0 && (offset + (int)sizeof(ImGuiWindowSettings) > g.SettingsWindows.size() || g.SettingsWindows.ptr_from_offset(offset)->ID != id))
+    {
+        // Stale map: the buffer was cleared and refilled past its previous size by another copy of Dear ImGui
+        storage->WindowsMap.Clear();
+        storage->WindowsMapBufSize = 0;
+        UpdateWindowSettingsMap(g, storage);
+        offset = storage->WindowsMap.GetInt(id);
+    }
+    return offset ? g.SettingsWindows.ptr_from_offset(offset) : NULL;
 }
 
 ImGuiWindowSettings* ImGui::FindOrCreateWindowSettings(const char* name)
@@ -9511,17 +10189,25 @@ ImGuiSettingsHandler* ImGui::FindSettingsHandler(const char* type_name)
     return NULL;
 }
 
-// Zero-tolerance, no error reporting, cheap .ini parsing
-void ImGui::LoadIniSettingsFromMemory(const char* ini_data, size_t ini_size)
+// Binary .ini format (ImGuiIniSavingOptions::Binary), in native byte order:
+// - "ImGuiIni" then a ImU32 version.
+// - Sections made of a ImU32 type hash, a ImU32 size and the data. Handlers with a ImGuiSettingsBinaryHandler get their own section,
+//   the other ones are written as .ini text in a section with a type hash of 0.
+static const char   IMGUI_INI_BINARY_MAGIC[8] = { 'I', 'm', 'G', 'u', 'i', 'I', 'n', 'i' };
+static const ImU32  IMGUI_INI_BINARY_VERSION = 1;
+
+static void SettingsBinary_Append(ImVector<char>* buf, const void* data, size_t data_size)
 {
-    ImGuiContext& g = *GImGui;
-    IM_ASSERT(g.Initialized);
-    IM_ASSERT(g.SettingsLoaded == false && g.FrameCount == 0);
+    const int offset = buf->Size;
+    buf->resize(offset + (int)data_size);
+    if (data_size > 0)
+        memcpy(buf->Data + offset, data, data_size);
+}
 
-    // For user convenience, we allow passing a non zero-terminated string (hence the ini_size parameter).
-    // For our convenience and to make the code simpler, we'll also write zero-terminators within the buffer. So let's create a writable copy..
-    if (ini_size == 0)
-        ini_size = strlen(ini_data);
+// Zero-tolerance, no error reporting, cheap .ini parsing
+static void LoadIniSettingsFromText(ImGuiContext& g, const char* ini_data, size_t ini_size)
+{
+    // For our convenience and to make the code simpler, we'll write zero-terminators within the buffer. So let's create a writable copy..
     char* buf = (char*)IM_ALLOC(ini_size + 1);
     char* buf_end = buf + ini_size;
     memcpy(buf, ini_data, ini_size);
@@ -9554,7 +10240,7 @@ void ImGui::LoadIniSettingsFromMemory(const char* ini_data, size_t ini_size)
                 continue;
             *type_end = 0; // Overwrite first ']'
             name_start++;  // Skip second '['
-            entry_handler = FindSettingsHandler(type_start);
+            entry_handler = ImGui::FindSettingsHandler(type_start);
             entry_data = entry_handler ? entry_handler->ReadOpenFn(&g, entry_handler, name_start) : NULL;
         }
         else if (entry_handler != NULL && entry_data != NULL)
@@ -9564,23 +10250,105 @@ void ImGui::LoadIniSettingsFromMemory(const char* ini_data, size_t ini_size)
         }
     }
     IM_FREE(buf);
+}
+
+static void LoadIniSettingsFromBinary(ImGuiContext& g, const char* ini_data, size_t ini_size)
+{
+    const char* p = ini_data + sizeof(IMGUI_INI_BINARY_MAGIC);
+    const char* p_end = ini_data + ini_size;
+    ImU32 version;
+    memcpy(&version, p, sizeof(version));
+    if (version != IMGUI_INI_BINARY_VERSION)
+        return;
+    p += sizeof(version);
+
+    while (p_end - p >= (ptrdiff_t)(sizeof(ImU32) * 2))
+    {
+        ImU32 section[2]; // Type hash, size
+        memcpy(section, p, sizeof(section));
+        p += sizeof(section);
+        if (section[1] > (size_t)(p_end - p))
+            break;
+        if (section[0] == 0)
+            LoadIniSettingsFromText(g, p, section[1]);
+        else if (const ImGuiSettingsBinaryHandler* binary_handler = FindSettingsBinaryHandler(GetSettingsStorage(&g), section[0]))
+            for (int handler_n = 0; handler_n < g.SettingsHandlers.Size; handler_n++)
+            {
+                ImGuiSettingsHandler* handler = &g.SettingsHandlers[handler_n];
+                if (handler->TypeHash == section[0] && binary_handler->ReadBinaryFn != NULL)
+                    binary_handler->ReadBinaryFn(&g, handler, p, (int)section[1]);
+            }
+        p += section[1];
+    }
+}
+
+// Accepts .ini text and the binary format written with ImGuiIniSavingOptions::Binary (pass 'ini_size' for binary data)
+void ImGui::LoadIniSettingsFromMemory(const char* ini_data, size_t ini_size)
+{
+    ImGuiContext& g = *GImGui;
+    IM_ASSERT(g.Initialized);
+    IM_ASSERT(g.SettingsLoaded == false && g.FrameCount == 0);
+
+    // For user convenience, we allow passing a non zero-terminated string (hence the ini_size parameter).
+    if (ini_size == 0)
+        ini_size = strlen(ini_data);
+    if (ini_size >= sizeof(IMGUI_INI_BINARY_MAGIC) + sizeof(ImU32) && memcmp(ini_data, IMGUI_INI_BINARY_MAGIC, sizeof(IMGUI_INI_BINARY_MAGIC)) == 0)
+        LoadIniSettingsFromBinary(g, ini_data, ini_size);
+    else
+        LoadIniSettingsFromText(g, ini_data, ini_size);
     g.SettingsLoaded = true;
 }
 
 void ImGui::SaveIniSettingsToDisk(const char* ini_filename)
+{
+    SaveIniSettingsToDiskEx(ini_filename, false);
+}
+
+// The file is written to "<ini_filename>.tmp" then renamed, so it is never left partially written.
+// With 'async' the data is handed to a background thread, so the caller only pays for serializing the settings.
+static void SaveIniSettingsToDiskEx(const char* ini_filename, bool async)
 {
     ImGuiContext& g = *GImGui;
     g.SettingsDirtyTimer = 0.0f;
     if (!ini_filename)
         return;
 
+    ImGuiSettingsStorage* storage = GetSettingsStorage(&g);
     size_t ini_data_size = 0;
-    const char* ini_data = SaveIniSettingsToMemory(&ini_data_size);
-    ImFileHandle f = ImFileOpen(ini_filename, "wt");
-    if (!f)
+    const char* ini_data = storage->Options.Binary ? (const char*)ImGui::SaveIniSettingsToMemoryBinary(&ini_data_size) : ImGui::SaveIniSettingsToMemory(&ini_data_size);
+
+    // Skip writes which wouldn't change the file (e.g. a window moved then moved back)
+    SettingsWriter_Wait(storage);
+    const ImGuiID hash = ImHashStr(ini_filename, 0, ImHashData(ini_data, ini_data_size));
+    if (hash == storage->LastSavedHash)
         return;
-    ImFileWrite(ini_data, sizeof(char), ini_data_size, f);
-    ImFileClose(f);
+    storage->LastSavedHash = hash;
+
+    const size_t filename_len = strlen(ini_filename);
+#ifndef IMGUI_DISABLE_THREADS
+    if (async)
+    {
+        if (storage->Writer == NULL)
+            storage->Writer = IM_NEW(ImGuiSettingsWriter)();
+        ImGuiSettingsWriter* writer = storage->Writer;
+        writer->Filename.resize(0);
+        SettingsBinary_Append(&writer->Filename, ini_filename, filename_len + 1);
+        writer->TempFilename.resize(0);
+        SettingsBinary_Append(&writer->TempFilename, ini_filename, filename_len);
+        SettingsBinary_Append(&writer->TempFilename, ".tmp", 5);
+        writer->Data.resize(0);
+        SettingsBinary_Append(&writer->Data, ini_data, ini_data_size);
+        writer->Thread = std::thread(SettingsWriter_Run, writer);
+        return;
+    }
+#else
+    IM_UNUSED(async);
+#endif
+    ImVector<char> temp_filename;
+    SettingsBinary_Append(&temp_filename, ini_filename, filename_len);
+    SettingsBinary_Append(&temp_filename, ".tmp", 5);
+    if (!ImFileWriteAtomic(ini_filename, temp_filename.Data, ini_data, ini_data_size))
+        storage->LastSavedHash = 0;
 }
 
 // Call registered handlers (e.g. SettingsHandlerWindow_WriteAll() + custom handlers) to write their stuff into a text buffer
@@ -9600,6 +10368,48 @@ const char* ImGui::SaveIniSettingsToMemory(size_t* out_size)
     return g.SettingsIniData.c_str();
 }
 
+const void* ImGui::SaveIniSettingsToMemoryBinary(size_t* out_size)
+{
+    ImGuiContext& g = *GImGui;
+    g.SettingsDirtyTimer = 0.0f;
+    ImGuiSettingsStorage* storage = GetSettingsStorage(&g);
+    ImVector<char>& buf = storage->IniBinaryData;
+    buf.resize(0);
+    SettingsBinary_Append(&buf, IMGUI_INI_BINARY_MAGIC, sizeof(IMGUI_INI_BINARY_MAGIC));
+    SettingsBinary_Append(&buf, &IMGUI_INI_BINARY_VERSION, sizeof(IMGUI_INI_BINARY_VERSION));
+
+    // Handlers without binary support
+    g.SettingsIniData.Buf.resize(0);
+    g.SettingsIniData.Buf.push_back(0);
+    for (int handler_n = 0; handler_n < g.SettingsHandlers.Size; handler_n++)
+    {
+        ImGuiSettingsHandler* handler = &g.SettingsHandlers[handler_n];
+        const ImGuiSettingsBinaryHandler* binary_handler = FindSettingsBinaryHandler(storage, handler->TypeHash);
+        if (binary_handler == NULL || binary_handler->WriteBinaryFn == NULL)
+            handler->WriteAllFn(&g, handler, &g.SettingsIniData);
+    }
+    const ImU32 text_section[2] = { 0, (ImU32)g.SettingsIniData.size() };
+    SettingsBinary_Append(&buf, text_section, sizeof(text_section));
+    SettingsBinary_Append(&buf, g.SettingsIniData.begin(), (size_t)g.SettingsIniData.size());
+
+    for (int handler_n = 0; handler_n < g.SettingsHandlers.Size; handler_n++)
+    {
+        ImGuiSettingsHandler* handler = &g.SettingsHandlers[handler_n];
+        const ImGuiSettingsBinaryHandler* binary_handler = FindSettingsBinaryHandler(storage, handler->TypeHash);
+        if (binary_handler == NULL || binary_handler->WriteBinaryFn == NULL)
+            continue;
+        const int section_offset = buf.Size;
+        const ImU32 section[2] = { handler->TypeHash, 0 };
+        SettingsBinary_Append(&buf, section, sizeof(section));
+        binary_handler->WriteBinaryFn(&g, handler, &buf);
+        const ImU32 section_size = (ImU32)(buf.Size - section_offset - (int)sizeof(section));
+        memcpy(buf.Data + section_offset + sizeof(ImU32), &section_size, sizeof(section_size));
+    }
+    if (out_size)
+        *out_size = (size_t)buf.Size;
+    return buf.Data;
+}
+
 static void* WindowSettingsHandler_ReadOpen(ImGuiContext*, ImGuiSettingsHandler*, const char* name)
 {
     ImGuiWindowSettings* settings = ImGui::FindWindowSettings(ImHashStr(name));
@@ -9618,11 +10428,10 @@ static void WindowSettingsHandler_ReadLine(ImGuiContext*, ImGuiSettingsHandler*,
     else if (sscanf(line, "Collapsed=%d", &i) == 1)     settings->Collapsed = (i != 0);
 }
 
-static void WindowSettingsHandler_WriteAll(ImGuiContext* ctx, ImGuiSettingsHandler* handler, ImGuiTextBuffer* buf)
+// Gather data from windows that were active during this session
+// (if a window wasn't opened in this session we preserve its settings)
+static void WindowSettingsHandler_UpdateAll(ImGuiContext& g)
 {
-    // Gather data from windows that were active during this session
-    // (if a window wasn't opened in this session we preserve its settings)
-    ImGuiContext& g = *ctx;
     for (int i = 0; i != g.Windows.Size; i++)
     {
         ImGuiWindow* window = g.Windows[i];
@@ -9636,21 +10445,112 @@ static void WindowSettingsHandler_WriteAll(ImGuiContext* ctx, ImGuiSettingsHandl
             window->SettingsOffset = g.SettingsWindows.offset_from_ptr(settings);
         }
         IM_ASSERT(settings->ID == window->ID);
-        settings->Pos = ImVec2ih((short)window->Pos.x, (short)window->Pos.y);
-        settings->Size = ImVec2ih((short)window->SizeFull.x, (short)window->SizeFull.y);
+        const ImVec2ih pos((short)window->Pos.x, (short)window->Pos.y);
+        const ImVec2ih size((short)window->SizeFull.x, (short)window->SizeFull.y);
+        settings->Pos = pos;
+        settings->Size = size;
         settings->Collapsed = window->Collapsed;
     }
+}
 
-    // Write to text buffer
+static void WindowSettingsHandler_WriteAll(ImGuiContext* ctx, ImGuiSettingsHandler* handler, ImGuiTextBuffer* buf)
+{
+    ImGuiContext& g = *ctx;
+    WindowSettingsHandler_UpdateAll(g);
+
+    // Write to text buffer. Records which didn't change since the last save are copied instead of being formatted again.
+    ImGuiSettingsStorage* storage = GetSettingsStorage(&g);
+    ImGuiTextBuffer& cache = storage->WindowsIniCache;
+    ImVector<ImGuiWindowSettingsIniRecord>& records = storage->WindowsIniRecords;
+    ImVector<ImGuiWindowSettingsIniRecord> new_records;
+    const int buf_start = buf->size();
     buf->reserve(buf->size() + g.SettingsWindows.size() * 6); // ballpark reserve
     for (ImGuiWindowSettings* settings = g.SettingsWindows.begin(); settings != NULL; settings = g.SettingsWindows.next_chunk(settings))
+    {
+        const int record_start = buf->size();
+        const ImGuiWindowSettingsIniRecord* old_record = (new_records.Size < records.Size) ? &records[new_records.Size] : NULL;
+        if (old_record && old_record->ID == settings->ID && old_record->Collapsed == settings->Collapsed &&
+            old_record->Pos.x == settings->Pos.x && old_record->Pos.y == settings->Pos.y && old_record->Size.x == settings->Size.x && old_record->Size.y == settings->Size.y &&
+            old_record->IniOffset + old_record->IniSize <= cache.size())
+        {
+            buf->append(cache.begin() + old_record->IniOffset, cache.begin() + old_record->IniOffset + old_record->IniSize);
+        }
+        else
+        {
+            const char* settings_name = settings->GetName();
+            buf->appendf("[%s][%s]\n", handler->TypeName, settings_name);
+            buf->appendf("Pos=%d,%d\n", settings->Pos.x, settings->Pos.y);
+            buf->appendf("Size=%d,%d\n", settings->Size.x, settings->Size.y);
+            buf->appendf("Collapsed=%d\n", settings->Collapsed);
+            buf->append("\n");
+        }
+        ImGuiWindowSettingsIniRecord record;
+        record.ID = settings->ID;
+        record.Pos = settings->Pos;
+        record.Size = settings->Size;
+        record.Collapsed = settings->Collapsed;
+        record.IniOffset = record_start - buf_start;
+        record.IniSize = buf->size() - record_start;
+        new_records.push_back(record);
+    }
+    records.swap(new_records);
+    cache.Buf.resize(0);
+    cache.append(buf->begin() + buf_start, buf->end());
+}
+
+// Binary record, followed by the name (without zero-terminator)
+struct ImGuiWindowSettingsBinaryRecord
+{
+    ImGuiID     ID;
+    ImVec2ih    Pos;
+    ImVec2ih    Size;
+    ImU16       NameLen;
+    ImU8        Collapsed;
+    ImU8        Padding;
+};
+
+static void WindowSettingsHandler_ReadBinary(ImGuiContext*, ImGuiSettingsHandler*, const char* data, int data_size)
+{
+    ImVector<char> name;
+    const char* data_end = data + data_size;
+    ImGuiWindowSettingsBinaryRecord record;
+    while (data_end - data >= (ptrdiff_t)sizeof(record))
+    {
+        memcpy(&record, data, sizeof(record));
+        data += sizeof(record);
+        if (record.NameLen > data_end - data)
+            break;
+        ImGuiWindowSettings* settings = ImGui::FindWindowSettings(record.ID);
+        if (!settings)
+        {
+            name.resize(record.NameLen + 1);
+            memcpy(name.Data, data, record.NameLen);
+            name[record.NameLen] = 0;
+            settings = ImGui::CreateNewWindowSettings(name.Data);
+        }
+        settings->Pos = record.Pos;
+        settings->Size = record.Size;
+        settings->Collapsed = (record.Collapsed != 0);
+        data += record.NameLen;
+    }
+}
+
+static void WindowSettingsHandler_WriteBinary(ImGuiContext* ctx, ImGuiSettingsHandler*, ImVector<char>* buf)
+{
+    ImGuiContext& g = *ctx;
+    WindowSettingsHandler_UpdateAll(g);
+    for (ImGuiWindowSettings* settings = g.SettingsWindows.begin(); settings != NULL; settings = g.SettingsWindows.next_chunk(settings))
     {
         const char* settings_name = settings->GetName();
-        buf->appendf("[%s][%s]\n", handler->TypeName, settings_name);
-        buf->appendf("Pos=%d,%d\n", settings->Pos.x, settings->Pos.y);
-        buf->appendf("Size=%d,%d\n", settings->Size.x, settings->Size.y);
-        buf->appendf("Collapsed=%d\n", settings->Collapsed);
-        buf->append("\n");
+        ImGuiWindowSettingsBinaryRecord record;
+        record.ID = settings->ID;
+        record.Pos = settings->Pos;
+        record.Size = settings->Size;
+        record.NameLen = (ImU16)ImMin(strlen(settings_name), (size_t)0xFFFF);
+        record.Collapsed = settings->Collapsed ? 1 : 0;
+        record.Padding = 0;
+        SettingsBinary_Append(buf, &record, sizeof(record));
+        SettingsBinary_Append(buf, settings_name, record.NameLen);
     }
 }
 
@@ -9673,7 +10573,7 @@ static void WindowSettingsHandler_WriteAll(ImGuiContext* ctx, ImGuiSettingsHandl
 // [SECTION] PLATFORM DEPENDENT HELPERS
 //-----------------------------------------------------------------------------
 
-#if defined(_WIN32) && !defined(_WINDOWS_) && !defined(IMGUI_DISABLE_WIN32_FUNCTIONS) && (!defined(IMGUI_DISABLE_WIN32_DEFAULT_CLIPBOARD_FUNCTIONS) || !defined(IMGUI_DISABLE_WIN32_DEFAULT_IME_FUNCTIONS))
+#if defined(_WIN32) && !defined(_WINDOWS_) && !defined(IMGUI_DISABLE_WIN32_FUNCTIONS) && (!defined(IMGUI_DISABLE_WIN32_DEFAULT_CLIPBOARD_FUNCTIONS) || !defined(IMGUI_DISABLE_WIN32_DEFAULT_IME_FUNCTIONS) || !defined(IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS))
 #ifndef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN
 #endif
@@ -9843,6 +10743,154 @@ static void ImeSetInputScreenPosFn_DefaultImpl(int, int) {}
 
 #endif
 
+// Write a file through a temporary file renamed over it, so readers never see a partially written file.
+// Paths are converted on the stack: this may run outside of the main thread and must not use the context.
+#if defined(_WIN32) && !defined(IMGUI_DISABLE_WIN32_FUNCTIONS) && !defined(IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS)
+
+bool ImFileWriteAtomic(const char* filename, const char* temp_filename, const void* data, size_t data_size)
+{
+    wchar_t wfilename[1024], wtemp_filename[1024];
+    if (::MultiByteToWideChar(CP_UTF8, 0, filename, -1, wfilename, IM_ARRAYSIZE(wfilename)) == 0 || ::MultiByteToWideChar(CP_UTF8, 0, temp_filename, -1, wtemp_filename, IM_ARRAYSIZE(wtemp_filename)) == 0)
+        return false;
+    FILE* f = _wfopen(wtemp_filename, L"wb");
+    if (!f)
+        return false;
+    const bool written = (fwrite(data, 1, data_size, f) == data_size);
+    if (fclose(f) != 0 || !written)
+    {
+        ::DeleteFileW(wtemp_filename);
+        return false;
+    }
+    return ::MoveFileExW(wtemp_filename, wfilename, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+}
+
+#elif !defined(IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS)
+
+bool ImFileWriteAtomic(const char* filename, const char* temp_filename, const void* data, size_t data_size)
+{
+    FILE* f = fopen(temp_filename, "wb");
+    if (!f)
+        return false;
+    const bool written = (fwrite(data, 1, data_size, f) == data_size);
+    if (fclose(f) != 0 || !written)
+    {
+        remove(temp_filename);
+        return false;
+    }
+    return rename(temp_filename, filename) == 0;
+}
+
+#else
+
+// Custom file functions can't rename: write in place
+bool ImFileWriteAtomic(const char* filename, const char*, const void* data, size_t data_size)
+{
+    ImFileHandle f = ImFileOpen(filename, "wb");
+    if (!f)
+        return false;
+    const bool written = (ImFileWrite(data, 1, data_size, f) == data_size);
+    return ImFileClose(f) && written;
+}
+
+#endif
+
+// Map a file read-only: the OS pages it in on demand instead of copying it to the heap.
+#if defined(_WIN32) && !defined(IMGUI_DISABLE_WIN32_FUNCTIONS) && !defined(IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS)
+
+bool ImFileMap(const char* filename, ImFileMapping* out_mapping)
+{
+    *out_mapping = ImFileMapping();
+    wchar_t wfilename[1024];
+    if (::MultiByteToWideChar(CP_UTF8, 0, filename, -1, wfilename, IM_ARRAYSIZE(wfilename)) == 0)
+        return false;
+    HANDLE file = ::CreateFileW(wfilename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER size;
+    HANDLE mapping = NULL;
+    if (::GetFileSizeEx(file, &size) && size.QuadPart > 0 && (ImU64)size.QuadPart <= (ImU64)(size_t)-1)
+        mapping = ::CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    ::CloseHandle(file);
+    if (mapping == NULL)
+        return false;
+    const void* data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    ::CloseHandle(mapping);     // The view keeps the mapping alive
+    if (data == NULL)
+        return false;
+    out_mapping->Data = data;
+    out_mapping->Size = (size_t)size.QuadPart;
+    out_mapping->Mapped = true;
+    return true;
+}
+
+void ImFileUnmap(ImFileMapping* mapping)
+{
+    if (mapping->Data)
+        ::UnmapViewOfFile(mapping->Data);
+    *mapping = ImFileMapping();
+}
+
+#elif (defined(__unix__) || defined(__APPLE__)) && !defined(IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS)
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+bool ImFileMap(const char* filename, ImFileMapping* out_mapping)
+{
+    *out_mapping = ImFileMapping();
+    const int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    void* data = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+        data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);                  // The mapping keeps the file alive
+    if (data == MAP_FAILED)
+        return false;
+    out_mapping->Data = data;
+    out_mapping->Size = (size_t)st.st_size;
+    out_mapping->Mapped = true;
+    return true;
+}
+
+void ImFileUnmap(ImFileMapping* mapping)
+{
+    if (mapping->Data)
+        munmap((void*)mapping->Data, mapping->Size);
+    *mapping = ImFileMapping();
+}
+
+#else
+
+bool ImFileMap(const char* filename, ImFileMapping* out_mapping)
+{
+    *out_mapping = ImFileMapping();
+    size_t size = 0;
+    void* data = ImFileLoadToMemory(filename, "rb", &size);
+    if (data != NULL && size == 0)
+    {
+        IM_FREE(data);
+        data = NULL;
+    }
+    if (data == NULL)
+        return false;
+    out_mapping->Data = data;
+    out_mapping->Size = size;
+    return true;
+}
+
+void ImFileUnmap(ImFileMapping* mapping)
+{
+    if (mapping->Data)
+        IM_FREE((void*)mapping->Data);
+    *mapping = ImFileMapping();
+}
+
+#endif
+
 //-----------------------------------------------------------------------------
 // [SECTION] METRICS/DEBUG WINDOW
 //-----------------------------------------------------------------------------
@@ -9892,6 +10940,9 @@ void ImGui::ShowMetricsWindow(bool* p_open)
     ImGui::Text("%d vertices, %d indices (%d triangles)", io.MetricsRenderVertices, io.MetricsRenderIndices, io.MetricsRenderIndices / 3);
     ImGui::Text("%d active windows (%d visible)", io.MetricsActiveWindows, io.MetricsRenderWindows);
     ImGui::Text("%d active allocations", io.MetricsActiveAllocations);
+#ifdef IMGUI_ENABLE_FRAME_ALLOCATOR
+    ImGui::ShowFrameAllocatorStats();
+#endif
     ImGui::Separator();
 
     // Helper functions to display common structures:
@@ -121,12 +121,14 @@ struct ImDrawListSplitter;          // Helper to split a draw list into differen
 struct ImDrawVert;                  // A single vertex (pos + uv + col = 20 bytes by default. Override layout with IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
 struct ImFont;                      // Runtime data for a single font within a parent ImFontAtlas
 struct ImFontAtlas;                 // Runtime data for multiple fonts, bake multiple fonts into a single texture, TTF/OTF font loader
+struct ImFontAtlasBuildOptions;     // Options of ImFontAtlas::Build()
 struct ImFontConfig;                // Configuration data when adding a font or merging fonts
 struct ImFontGlyph;                 // A single font glyph (code point + coordinates within in ImFontAtlas + offset)
 struct ImFontGlyphRangesBuilder;    // Helper to build glyph ranges from text/string data
 struct ImColor;                     // Helper functions to create a color that can be converted to either u32 or float4 (*OBSOLETE* please avoid using)
 struct ImGuiContext;                // Dear ImGui context (opaque structure, unless including imgui_internal.h)
 struct ImGuiIO;                     // Main configuration and I/O between your application and ImGui
+struct ImGuiIniSavingOptions;       // Options of the .ini file saving (SetIniSavingOptions())
 struct ImGuiInputTextCallbackData;  // Shared state of InputText() when using custom ImGuiInputTextCallback (rare/advanced use)
 struct ImGuiListClipper;            // Helper to manually clip large list of items
 struct ImGuiOnceUponAFrame;         // Helper for running a block of code not more than once a frame, used by IMGUI_ONCE_UPON_A_FRAME macro
@@ -637,6 +639,16 @@ namespace ImGui
     IMGUI_API void          PushClipRect(const ImVec2& clip_rect_min, const ImVec2& clip_rect_max, bool intersect_with_current_clip_rect);
     IMGUI_API void          PopClipRect();
 
+    // Retained Content
+    // - Wrap static content in BeginRetainedContent()/EndRetainedContent() to reuse its vertices from one frame to the next.
+    // - 'content_key' is a hash of everything the content depends on (displayed values, style, etc.). Pass 0 to always submit the content.
+    // - When the key, cursor position, clipping, font and alpha match the previous frame, and the window is not hovered, active or
+    //   navigated, BeginRetainedContent() returns false: don't submit the content, EndRetainedContent() re-emits last frame output.
+    // - The content may not use columns, begin child windows or open popups. Always call EndRetainedContent(), whatever the return value.
+    IMGUI_API bool          BeginRetainedContent(const char* str_id, ImGuiID content_key);
+    IMGUI_API void          EndRetainedContent();
+    IMGUI_API void          ClearRetainedContents();                                            // Release the regions of the current context. Done by DestroyContext(): only call it from a module unloading while the context lives on.
+
     // Focus, Activation
     // - Prefer using "SetItemDefaultFocus()" over "if (IsWindowAppearing()) SetScrollHereY()" when applicable to signify "this is the default item"
     IMGUI_API void          SetItemDefaultFocus();                                              // make last item the default focused item of a window.
@@ -726,6 +738,9 @@ namespace ImGui
     IMGUI_API void          LoadIniSettingsFromMemory(const char* ini_data, size_t ini_size=0); // call after CreateContext() and before the first call to NewFrame() to provide .ini data from your own data source.
     IMGUI_API void          SaveIniSettingsToDisk(const char* ini_filename);                    // this is automatically called (if io.IniFilename is not empty) a few seconds after any modification that should be reflected in the .ini file (and also by DestroyContext).
     IMGUI_API const char*   SaveIniSettingsToMemory(size_t* out_ini_size = NULL);               // return a zero-terminated string with the .ini data which you can save by your own mean. call when io.WantSaveIniSettings is set, then save data by your own mean and clear io.WantSaveIniSettings.
+    IMGUI_API const void*   SaveIniSettingsToMemoryBinary(size_t* out_ini_size);                // return the .ini data in the binary format used with ImGuiIniSavingOptions::Binary. LoadIniSettingsFromMemory() accepts it.
+    IMGUI_API void          SetIniSavingOptions(const ImGuiIniSavingOptions& options);          // set how the current context writes its .ini file (background thread, binary format).
+    IMGUI_API const ImGuiIniSavingOptions& GetIniSavingOptions();
 
     // Memory Allocators
     // - All those functions are not reliant on the current context.
@@ -1506,6 +1521,15 @@ struct ImGuiIO
     IMGUI_API   ImGuiIO();
 };
 
+// Options of the .ini file saving, see ImGui::SetIniSavingOptions(). Kept out of ImGuiIO, whose layout is shared with the host application.
+struct ImGuiIniSavingOptions
+{
+    bool        Async;                          // = true           // Write the .ini file from a background thread when saving after a modification. Ignored with IMGUI_DISABLE_THREADS.
+    bool        Binary;                         // = false          // Save the .ini file in a compact binary format instead of text. Loading accepts both formats.
+
+    ImGuiIniSavingOptions()                     { Async = true; Binary = false; }
+};
+
 //-----------------------------------------------------------------------------
 // Misc data structures
 //-----------------------------------------------------------------------------
@@ -1756,6 +1780,56 @@ struct ImGuiListClipper
     IMGUI_API void End();                                               // Automatically called on the last call of Step() that returns false.
 };
 
+// Helper: Manually clip large list of items of variable height.
+// Unlike ImGuiListClipper, this one needs to persist across frames (e.g. static or member of your widget): it keeps the height of every item as measured
+// the last time it was displayed, items never displayed being estimated with DefaultItemHeight. Heights are stored in a Fenwick tree, so finding the first
+// visible item and updating a height are O(log N), whatever the number of items.
+// Usage:
+//     static ImGuiVariableListClipper clipper;
+//     clipper.Begin(items.Size);
+//     while (clipper.Step())
+//         for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+//         {
+//             clipper.BeginItem(i);        // measure the height of the previous item
+//             ImGui::TextWrapped("%s", items[i]);
+//         }
+// - When items above the first visible item change height, during a frame or between two frames, the scrolling is adjusted (from the next frame)
+//   so the visible items don't move.
+// - Call SetItemHeight() if you know the height of an item which is not displayed changed (e.g. a tree node collapsed from code).
+// - Call InsertItems()/EraseItems() when items are added or removed in the middle of the list, so the other items keep their heights.
+struct ImGuiVariableListClipper
+{
+    int     DisplayStart, DisplayEnd;
+    int     ItemsCount;
+    float   DefaultItemHeight;      // Height of items never displayed. <= 0.0f: use GetTextLineHeightWithSpacing() on Begin().
+
+    // [Internal]
+    ImVector<float>     ItemsHeight;    // Height of each item, including spacing
+    ImVector<double>    HeightsTree;    // Fenwick tree over ItemsHeight (1-based). double so that repeated updates don't drift.
+    int     StepNo;
+    int     ItemCurrent;            // Item started by the last BeginItem(), or -1
+    float   ItemCurrentPosY;
+    float   StartPosY;
+    int     AnchorItem;             // First item fully visible on the last Begin(), kept in place, or -1
+    double  AnchorOffsetY;          // GetItemOffsetY(AnchorItem) when the scrolling was last adjusted to it
+    float   AnchorScrollY;          // Scrolling expected on the next Begin() if nobody else scrolled the window
+
+    ImGuiVariableListClipper()                                          { ItemsCount = -1; DefaultItemHeight = 0.0f; DisplayStart = DisplayEnd = StepNo = 0; ItemCurrent = AnchorItem = -1; ItemCurrentPosY = StartPosY = AnchorScrollY = 0.0f; AnchorOffsetY = 0.0; }
+    ~ImGuiVariableListClipper()                                         { IM_ASSERT(ItemsCount == -1); }      // Assert if user forgot to call End() or Step() until false.
+
+    IMGUI_API void  Begin(int items_count);                             // Resize the list (new items use DefaultItemHeight), calculate the range of visible items and position the cursor before the first one.
+    IMGUI_API bool  Step();                                             // Call until it returns false. The DisplayStart/DisplayEnd fields will be set and you can process/draw those items.
+    IMGUI_API void  BeginItem(int item_index);                          // Call before submitting each item between DisplayStart and DisplayEnd.
+    IMGUI_API void  End();                                              // Automatically called on the last call of Step() that returns false.
+    IMGUI_API void  Clear();                                            // Forget all measured heights.
+    IMGUI_API void  SetItemHeight(int item_index, float height);
+    IMGUI_API void  InsertItems(int item_index, int count);              // Insert items of DefaultItemHeight, keeping the heights measured for the others. O(N), call outside of Begin()/End().
+    IMGUI_API void  EraseItems(int item_index, int count);               // O(N), call outside of Begin()/End().
+    IMGUI_API float GetItemOffsetY(int item_index) const;              // Sum of the heights of the items before 'item_index', relative to the start of the list.
+    IMGUI_API int   FindItemAtOffsetY(float offset_y) const;            // Item containing 'offset_y', clamped to the list.
+    float           GetTotalHeight() const                              { return GetItemOffsetY(ItemsHeight.Size); }
+};
+
 // Helpers macros to generate 32-bit encoded colors
 #ifdef IMGUI_USE_BGRA_PACKED_COLOR
 #define IM_COL32_R_SHIFT    16
@@ -1979,7 +2053,7 @@ struct ImDrawList
     inline    void  PathLineToMergeDuplicate(const ImVec2& pos)                 { if (_Path.Size == 0 || memcmp(&_Path.Data[_Path.Size-1], &pos, 8) != 0) _Path.push_back(pos); }
     inline    void  PathFillConvex(ImU32 col)                                   { AddConvexPolyFilled(_Path.Data, _Path.Size, col); _Path.Size = 0; }  // Note: Anti-aliased filling requires points to be in clockwise order.
     inline    void  PathStroke(ImU32 col, bool closed, float thickness = 1.0f)  { AddPolyline(_Path.Data, _Path.Size, col, closed, thickness); _Path.Size = 0; }
-    IMGUI_API void  PathArcTo(const ImVec2& center, float radius, float a_min, float a_max, int num_segments = 10);
+    IMGUI_API void  PathArcTo(const ImVec2& center, float radius, float a_min, float a_max, int num_segments = 0);                                  // Use num_segments == 0 for automatic tessellation from CircleSegmentMaxError (preferred)
     IMGUI_API void  PathArcToFast(const ImVec2& center, float radius, int a_min_of_12, int a_max_of_12);                                            // Use precomputed angles for a 12 steps circle
     IMGUI_API void  PathBezierCurveTo(const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, int num_segments = 0);
     IMGUI_API void  PathRect(const ImVec2& rect_min, const ImVec2& rect_max, float rounding = 0.0f, ImDrawCornerFlags rounding_corners = ImDrawCornerFlags_All);
@@ -2013,6 +2087,9 @@ struct ImDrawList
     inline    void  PrimVtx(const ImVec2& pos, const ImVec2& uv, ImU32 col)     { PrimWriteIdx((ImDrawIdx)_VtxCurrentIdx); PrimWriteVtx(pos, uv, col); }
     IMGUI_API void  UpdateClipRect();
     IMGUI_API void  UpdateTextureID();
+    IMGUI_API int   _CalcCircleAutoSegmentCount(float radius) const;
+    IMGUI_API void  _PathArcToFastEx(const ImVec2& center, float radius, int a_min_sample, int a_max_sample, int a_step);  // Samples from the unit circle table of imgui_draw.cpp. a_step == 0: derive step from radius
+    IMGUI_API void  _PathArcToN(const ImVec2& center, float radius, float a_min, float a_max, int num_segments);
 };
 
 // All draw data to render a Dear ImGui frame
@@ -2092,6 +2169,21 @@ struct ImFontGlyphRangesBuilder
     IMGUI_API void  BuildRanges(ImVector<ImWchar>* out_ranges);                 // Output new ranges
 };
 
+// Area of the texture modified after Build(), see ImFontAtlas::GetTexDirtyRects().
+struct ImFontAtlasDirtyRect
+{
+    unsigned short  X, Y;
+    unsigned short  Width, Height;
+};
+
+// Options of ImFontAtlas::Build(options). Kept out of ImFontAtlas, whose layout is shared with the host application.
+struct ImFontAtlasBuildOptions
+{
+    int             ThreadsCount;   // = 1      // Number of threads rasterizing glyphs, the calling thread included. Packing is unaffected so the texture is identical for any value.
+    const char*     CacheFilename;  // = NULL   // When set, restore the atlas from this file with LoadBuildCache() when it matches the fonts configuration, else build and write it with SaveBuildCache(). Ignored with ImFontAtlasFlags_DynamicGlyphs.
+    ImFontAtlasBuildOptions()       { ThreadsCount = 1; CacheFilename = NULL; }
+};
+
 // See ImFontAtlas::AddCustomRectXXX functions.
 struct ImFontAtlasCustomRect
 {
@@ -2109,7 +2201,8 @@ enum ImFontAtlasFlags_
 {
     ImFontAtlasFlags_None               = 0,
     ImFontAtlasFlags_NoPowerOfTwoHeight = 1 << 0,   // Don't round the height to next power of two
-    ImFontAtlasFlags_NoMouseCursors     = 1 << 1    // Don't build software mouse cursors into the atlas
+    ImFontAtlasFlags_NoMouseCursors     = 1 << 1,   // Don't build software mouse cursors into the atlas
+    ImFontAtlasFlags_DynamicGlyphs      = 1 << 2    // [BETA] Reserve free space in the texture and keep the packing state after Build(): code points missing from the glyph ranges are rasterized on demand by BuildPendingGlyphs(). Disables ImFontAtlasBuildOptions::CacheFilename.
 };
 
 // Load and rasterize multiple TTF/OTF fonts into a same texture. The font atlas will build a single texture holding:
@@ -2150,10 +2243,15 @@ struct ImFontAtlas
     // Building in RGBA32 format is provided for convenience and compatibility, but note that unless you manually manipulate or copy color data into
     // the texture (e.g. when using the AddCustomRect*** api), then the RGB pixels emitted will always be white (~75% of memory/bandwidth waste.
     IMGUI_API bool              Build();                    // Build pixels data. This is called automatically for you by the GetTexData*** functions.
+    IMGUI_API bool              Build(const ImFontAtlasBuildOptions& options);  // Build pixels data with non-default options (e.g. rasterizing glyphs on multiple threads, or a cache file).
+    IMGUI_API bool              SaveBuildCache(const char* filename);   // Write the baked texture, glyphs and custom rectangles of a built atlas to a file.
+    IMGUI_API bool              LoadBuildCache(const char* filename);   // Restore a file written by SaveBuildCache(), skipping rasterization. Returns false if the file doesn't match the current fonts configuration.
+    IMGUI_API bool              BuildPendingGlyphs();       // [BETA] With ImFontAtlasFlags_DynamicGlyphs: rasterize and pack the code points ImFont::FindGlyph() couldn't find since the last call. Called by ImGui::NewFrame(). Returns true if pixels were added to GetTexDirtyRects().
     IMGUI_API void              GetTexDataAsAlpha8(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel = NULL);  // 1 byte per-pixel
     IMGUI_API void              GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel = NULL);  // 4 bytes-per-pixel
     bool                        IsBuilt() const             { return Fonts.Size > 0 && (TexPixelsAlpha8 != NULL || TexPixelsRGBA32 != NULL); }
     void                        SetTexID(ImTextureID id)    { TexID = id; }
+    IMGUI_API ImVector<ImFontAtlasDirtyRect>* GetTexDirtyRects();   // [BETA] With ImFontAtlasFlags_DynamicGlyphs: rectangles of the texture modified by BuildPendingGlyphs(). The renderer back-end should upload them (or the whole texture) and clear the list. NULL for atlases not built with the flag by this code.
 
     //-------------------------------------------
     // Glyph Ranges
@@ -0,0 +1,87 @@
+#include "pch.h"
+#include "imgui_allocator.h"
+#include "imgui_internal.h"
+
+#include <stdlib.h>         // malloc, free
+#include <mutex>            // mutex, lock_guard
+
+struct ImFrameAllocatorState
+{
+    std::mutex                          Mutex;
+    bool                                Installed;
+    int                                 LastFrameCount;     // ImGui frame for which counters were last rolled
+    ImFrameAllocatorStats               Current;
+    ImFrameAllocatorStats               Last;
+
+    ImFrameAllocatorState() { Installed = false; LastFrameCount = -1; }
+};
+
+static ImFrameAllocatorState& GetFrameAllocatorState()
+{
+    static ImFrameAllocatorState state;
+    return state;
+}
+
+static void* FrameAllocatorAlloc(size_t size, void* user_data)
+{
+    ImFrameAllocatorState& s = *(ImFrameAllocatorState*)user_data;
+    {
+        std::lock_guard<std::mutex> lock(s.Mutex);
+        s.Current.AllocCount++;
+        s.Current.AllocBytes += size;
+    }
+    return malloc(size);
+}
+
+static void FrameAllocatorFree(void* ptr, void* user_data)
+{
+    if (ptr == NULL)
+        return;
+    ImFrameAllocatorState& s = *(ImFrameAllocatorState*)user_data;
+    {
+        std::lock_guard<std::mutex> lock(s.Mutex);
+        s.Current.FreeCount++;
+    }
+    free(ptr);
+}
+
+void ImGui::InstallFrameAllocator()
+{
+    ImFrameAllocatorState& s = GetFrameAllocatorState();
+    {
+        std::lock_guard<std::mutex> lock(s.Mutex);
+        s.Installed = true;
+    }
+    SetAllocatorFunctions(FrameAllocatorAlloc, FrameAllocatorFree, &s);
+}
+
+void ImGui::FrameAllocatorNewFrame()
+{
+    ImGuiContext* ctx = GImGui;
+    if (ctx == NULL)
+        return;
+    ImFrameAllocatorState& s = GetFrameAllocatorState();
+    std::lock_guard<std::mutex> lock(s.Mutex);
+    if (s.LastFrameCount == ctx->FrameCount)
+        return;
+    s.LastFrameCount = ctx->FrameCount;
+    s.Last = s.Current;
+    s.Current = ImFrameAllocatorStats();
+}
+
+bool ImGui::IsFrameAllocatorInstalled()
+{
+    return GetFrameAllocatorState().Installed;
+}
+
+const ImFrameAllocatorStats& ImGui::GetFrameAllocatorStats(bool current_frame)
+{
+    ImFrameAllocatorState& s = GetFrameAllocatorState();
+    return current_frame ? s.Current : s.Last;
+}
+
+void ImGui::ShowFrameAllocatorStats()
+{
+    const ImFrameAllocatorStats& stats = GetFrameAllocatorStats();
+    Text("Frame allocator: %d allocs, %d frees, %d bytes requested last frame", stats.AllocCount, stats.FreeCount, (int)stats.AllocBytes);
+}
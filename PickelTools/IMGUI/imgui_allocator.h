@@ -0,0 +1,28 @@
+#pragma once
+#include "imgui.h"
+
+#include <stddef.h>     // size_t
+#include <string.h>     // memset
+
+// Counting allocator for Dear ImGui, installed with ImGui::SetAllocatorFunctions().
+// - Every allocation goes to malloc() and every free to free(), so blocks can be released by another module sharing the context (e.g. the host
+//   of a plugin), and pointers allocated before installation are released normally.
+// - Allocations, frees and bytes requested are counted per frame, and displayed by the Metrics window.
+// - Thread-safe (a single lock), so fonts may be built from worker threads.
+struct ImFrameAllocatorStats
+{
+    int         AllocCount;         // Number of allocations during the frame
+    int         FreeCount;          // Number of frees during the frame
+    size_t      AllocBytes;         // Bytes requested during the frame
+
+    ImFrameAllocatorStats() { memset(this, 0, sizeof(*this)); }
+};
+
+namespace ImGui
+{
+    IMGUI_API void          InstallFrameAllocator();                // Call SetAllocatorFunctions() with the counting allocator
+    IMGUI_API void          FrameAllocatorNewFrame();               // Roll per-frame counters. Called by NewFrame(), may also be called by code running inside another module's frame. Only the first call of a frame has an effect.
+    IMGUI_API bool          IsFrameAllocatorInstalled();
+    IMGUI_API const ImFrameAllocatorStats& GetFrameAllocatorStats(bool current_frame = false); // Counters of the last completed frame, or of the frame in progress
+    IMGUI_API void          ShowFrameAllocatorStats();              // Display counters (used by the Metrics window)
+} // namespace ImGui
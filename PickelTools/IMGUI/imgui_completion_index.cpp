@@ -0,0 +1,205 @@
+#include "pch.h"
+#include "imgui_completion_index.h"
+#include "imgui_internal.h"
+
+static int CommonPrefixLength(const char* a, const char* b)
+{
+    int n = 0;
+    while (a[n] != 0 && a[n] == b[n])
+        n++;
+    return n;
+}
+
+static int IMGUI_CDECL StringPtrComparer(const void* lhs, const void* rhs)
+{
+    return strcmp(*(const char* const*)lhs, *(const char* const*)rhs);
+}
+
+void ImGuiCompletionIndex::Build(const char* const items[], int items_count)
+{
+    ImVector<const char*> sorted;
+    sorted.resize(items_count);
+    if (items_count > 0)
+        memcpy(sorted.Data, items, (size_t)items_count * sizeof(const char*));
+    ImQsort(sorted.Data, (size_t)sorted.Size, sizeof(const char*), StringPtrComparer);
+
+    // Copy the strings in sorted order, so that searches walk the arena forward
+    int strings_size = 0;
+    for (int n = 0; n < sorted.Size; n++)
+        strings_size += (int)strlen(sorted[n]) + 1;
+    Strings.resize(0);
+    Strings.reserve(strings_size);
+    Entries.resize(0);
+    Entries.reserve(sorted.Size);
+    GarbageSize = 0;
+    for (int n = 0; n < sorted.Size; n++)
+    {
+        if (n > 0 && strcmp(sorted[n], sorted[n - 1]) == 0)
+            continue;
+        const int len = (int)strlen(sorted[n]);
+        ImGuiCompletionEntry entry;
+        entry.Offset = Strings.Size;
+        entry.Lcp = Entries.Size > 0 ? CommonPrefixLength(GetItem(Entries.Size - 1), sorted[n]) : 0;
+        Strings.resize(Strings.Size + len + 1);
+        memcpy(Strings.Data + entry.Offset, sorted[n], (size_t)len + 1);
+        Entries.push_back(entry);
+    }
+}
+
+int ImGuiCompletionIndex::LowerBound(const char* txt, bool* out_found) const
+{
+    // Invariant: item[lo - 1] < txt <= item[hi]. All the items in between share the prefix of length min(lcp_lo, lcp_hi) with 'txt'.
+    int lo = 0, hi = Entries.Size;
+    int lcp_lo = 0, lcp_hi = 0;
+    while (lo < hi)
+    {
+        const int mid = (lo + hi) >> 1;
+        const char* item = GetItem(mid);
+        int k = ImMin(lcp_lo, lcp_hi);
+        while (txt[k] != 0 && txt[k] == item[k])
+            k++;
+        if ((unsigned char)txt[k] <= (unsigned char)item[k])
+        {
+            hi = mid;
+            lcp_hi = k;
+        }
+        else
+        {
+            lo = mid + 1;
+            lcp_lo = k;
+        }
+    }
+    if (out_found)
+        *out_found = (lo < Entries.Size && strcmp(GetItem(lo), txt) == 0);
+    return lo;
+}
+
+int ImGuiCompletionIndex::FindPrefixRange(const char* prefix, int* out_end) const
+{
+    const int begin = LowerBound(prefix);
+    const size_t prefix_len = strlen(prefix);
+    int lo = begin, hi = Entries.Size;
+    while (lo < hi)
+    {
+        const int mid = (lo + hi) >> 1;
+        if (strncmp(GetItem(mid), prefix, prefix_len) == 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    *out_end = lo;
+    return begin;
+}
+
+int ImGuiCompletionIndex::GetCommonPrefixLength(int begin, int end) const
+{
+    if (begin >= end)
+        return 0;
+    int len = (int)strlen(GetItem(begin));
+    for (int n = begin + 1; n < end; n++)
+        len = ImMin(len, Entries[n].Lcp);
+    return len;
+}
+
+int ImGuiCompletionIndex::Insert(const char* txt, bool* out_already_present)
+{
+    bool found;
+    const int pos = LowerBound(txt, &found);
+    if (out_already_present)
+        *out_already_present = found;
+    if (found)
+        return pos;
+
+    // 'txt' may point into the arena, which we are about to grow
+    const int len = (int)strlen(txt);
+    const int txt_offset = (txt >= Strings.Data && txt < Strings.Data + Strings.Size) ? (int)(txt - Strings.Data) : -1;
+    ImGuiCompletionEntry entry;
+    entry.Offset = Strings.Size;
+    Strings.resize(Strings.Size + len + 1);
+    memcpy(Strings.Data + entry.Offset, txt_offset >= 0 ? Strings.Data + txt_offset : txt, (size_t)len + 1);
+    const char* item = Strings.Data + entry.Offset;
+    entry.Lcp = pos > 0 ? CommonPrefixLength(GetItem(pos - 1), item) : 0;
+    Entries.insert(Entries.Data + pos, entry);
+    if (pos + 1 < Entries.Size)
+        Entries[pos + 1].Lcp = CommonPrefixLength(item, GetItem(pos + 1));
+    return pos;
+}
+
+void ImGuiCompletionIndex::Erase(int n)
+{
+    IM_ASSERT(n >= 0 && n < Entries.Size);
+    GarbageSize += (int)strlen(GetItem(n)) + 1;
+    const int erased_lcp = Entries[n].Lcp;
+    Entries.erase(Entries.Data + n);
+
+    // The prefix shared by the new neighbors is the shortest of the two prefixes they shared with the erased item
+    if (n < Entries.Size)
+        Entries[n].Lcp = (n > 0) ? ImMin(erased_lcp, Entries[n].Lcp) : 0;
+    if (GarbageSize > Strings.Size / 2)
+        Compact();
+}
+
+int ImGuiCompletionIndex::Rename(int n, const char* txt)
+{
+    IM_ASSERT(n >= 0 && n < Entries.Size);
+    bool found;
+    const int pos = LowerBound(txt, &found);
+    if (found)
+        return (pos == n) ? n : -1;
+    Insert(txt);
+    Erase(pos <= n ? n + 1 : n);
+    return (pos > n) ? pos - 1 : pos;
+}
+
+void ImGuiCompletionIndex::Compact()
+{
+    ImVector<char> strings;
+    strings.reserve(Strings.Size - GarbageSize);
+    for (int n = 0; n < Entries.Size; n++)
+    {
+        const char* item = GetItem(n);
+        const int len = (int)strlen(item);
+        const int offset = strings.Size;
+        strings.resize(offset + len + 1);
+        memcpy(strings.Data + offset, item, (size_t)len + 1);
+        Entries[n].Offset = offset;
+    }
+    Strings.swap(strings);
+    GarbageSize = 0;
+}
+
+bool ImGuiCompletionIndex::ItemGetter(void* data, int idx, const char** out_text)
+{
+    const ImGuiCompletionIndex* index = (const ImGuiCompletionIndex*)data;
+    if (idx < 0 || idx >= index->Entries.Size)
+        return false;
+    if (out_text)
+        *out_text = index->GetItem(idx);
+    return true;
+}
+
+bool ImGuiCompletionIndex::ItemInserter(void* data, int idx, const char* txt)
+{
+    IM_UNUSED(idx);
+    bool already_present;
+    ((ImGuiCompletionIndex*)data)->Insert(txt, &already_present);
+    return !already_present;
+}
+
+bool ImGuiCompletionIndex::ItemDeleter(void* data, int idx)
+{
+    ImGuiCompletionIndex* index = (ImGuiCompletionIndex*)data;
+    if (idx < 0 || idx >= index->Entries.Size)
+        return false;
+    index->Erase(idx);
+    return true;
+}
+
+bool ImGuiCompletionIndex::ItemRenamer(void* data, int idx, int new_idx, const char* txt)
+{
+    IM_UNUSED(new_idx);
+    ImGuiCompletionIndex* index = (ImGuiCompletionIndex*)data;
+    if (idx < 0 || idx >= index->Entries.Size)
+        return false;
+    return index->Rename(idx, txt) >= 0;
+}
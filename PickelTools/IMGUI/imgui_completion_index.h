@@ -0,0 +1,48 @@
+#pragma once
+#include "imgui.h"
+
+// Sorted string set, meant as the items source of InputTextWithAutoCompletion() and InputComboWithAutoCompletion().
+// - Strings are stored back to back in a single arena, and referenced from a single sorted array of entries, which also
+//   stores the length of the prefix shared with the previous entry (LCP).
+// - LowerBound() is a binary search which skips the prefix already known to match on both sides of the range, so it compares
+//   O(length + log N) characters. Insert(), Erase() and Rename() add a memmove of the entries array.
+// - Erased strings leave a hole in the arena, which is compacted when holes exceed half of it.
+// - Strings are unique and sorted with strcmp(), like the widgets expect.
+// Usage:
+//     ImGuiCompletionIndex index;
+//     index.Build(names, names_count);
+//     InputComboWithAutoCompletion("Name", &current, 64, &data, ImGuiCompletionIndex::ItemGetter, ImGuiCompletionIndex::ItemInserter,
+//                                  ImGuiCompletionIndex::ItemDeleter, ImGuiCompletionIndex::ItemRenamer, index.Size(), &index);
+// The widgets recognize ImGuiCompletionIndex::ItemGetter and then search the index directly instead of calling the getter on every item.
+struct ImGuiCompletionEntry
+{
+    int             Offset;         // Offset of the string in the arena
+    int             Lcp;            // Length of the prefix shared with the previous entry (0 for the first one)
+};
+
+struct IMGUI_API ImGuiCompletionIndex
+{
+    ImVector<char>                  Strings;        // Zero-terminated strings
+    ImVector<ImGuiCompletionEntry>  Entries;        // Sorted
+    int                             GarbageSize;    // Bytes of erased strings in the arena
+
+    ImGuiCompletionIndex()          { GarbageSize = 0; }
+    void            Clear()         { Strings.clear(); Entries.clear(); GarbageSize = 0; }
+    int             Size() const    { return Entries.Size; }
+    const char*     GetItem(int n) const { return Strings.Data + Entries[n].Offset; }
+
+    void            Build(const char* const items[], int items_count);                  // Duplicates are dropped
+    int             LowerBound(const char* txt, bool* out_found = NULL) const;          // Position of the first item >= 'txt' (insertion position)
+    int             FindPrefixRange(const char* prefix, int* out_end) const;            // Range of the items starting with 'prefix': returns the first one, '*out_end' is the end
+    int             GetCommonPrefixLength(int begin, int end) const;                    // Length of the prefix shared by the items of the range
+    int             Insert(const char* txt, bool* out_already_present = NULL);          // Returns the position of the item
+    void            Erase(int n);
+    int             Rename(int n, const char* txt);                                     // Returns the new position, or -1 if 'txt' is already another item
+    void            Compact();
+
+    // Callbacks for InputTextWithAutoCompletion() / InputComboWithAutoCompletion(), with 'user_data' pointing to the index
+    static bool     ItemGetter(void* data, int idx, const char** out_text);
+    static bool     ItemInserter(void* data, int idx, const char* txt);                 // 'idx' is ignored, the item is inserted at its sorted position
+    static bool     ItemDeleter(void* data, int idx);
+    static bool     ItemRenamer(void* data, int idx, int new_idx, const char* txt);     // 'new_idx' is ignored, same as ItemInserter()
+};
@@ -49,6 +49,11 @@ Index of this file:
 #endif
 #endif
 
+// Scratch buffers of the anti-aliased tessellation (normals and extruded points) larger than this are allocated on the heap instead of the stack
+#ifndef IM_DRAWLIST_TESSELLATION_ALLOCA_MAX
+#define IM_DRAWLIST_TESSELLATION_ALLOCA_MAX     (32 * 1024)
+#endif
+
 // Visual Studio warnings
 #ifdef _MSC_VER
 #pragma warning (disable: 4127) // condition expression is constant
@@ -134,8 +139,10 @@ namespace IMGUI_STB_NAMESPACE
 
 #ifndef STB_TRUETYPE_IMPLEMENTATION                         // in case the user already have an implementation in the _same_ compilation unit (e.g. unity builds)
 #ifndef IMGUI_DISABLE_STB_TRUETYPE_IMPLEMENTATION
-#define STBTT_malloc(x,u)   ((void)(u), IM_ALLOC(x))
-#define STBTT_free(x,u)     ((void)(u), IM_FREE(x))
+// Glyphs rendered from worker threads pass a non-NULL allocator context (stbtt_fontinfo::userdata, stbtt_pack_context::user_allocator_context):
+// their temporary allocations bypass ImGui::MemAlloc(), which updates the context metrics non-atomically.
+#define STBTT_malloc(x,u)   ((u) ? malloc(x) : IM_ALLOC(x))
+#define STBTT_free(x,u)     ((u) ? free(x) : IM_FREE(x))
 #define STBTT_assert(x)     IM_ASSERT(x)
 #define STBTT_fmod(x,y)     ImFmod(x,y)
 #define STBTT_sqrt(x)       ImSqrt(x)
@@ -621,6 +628,146 @@ void ImDrawList::PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, c
 #define IM_NORMALIZE2F_OVER_ZERO(VX,VY)     { float d2 = VX*VX + VY*VY; if (d2 > 0.0f) { float inv_len = 1.0f / ImSqrt(d2); VX *= inv_len; VY *= inv_len; } }
 #define IM_FIXNORMAL2F(VX,VY)               { float d2 = VX*VX + VY*VY; if (d2 < 0.5f) d2 = 0.5f; float inv_lensq = 1.0f / d2; VX *= inv_lensq; VY *= inv_lensq; }
 
+// Anti-aliased tessellation passes shared by AddPolyline() and AddConvexPolyFilled().
+// The SSE2/AVX2 paths perform the same float operations in the same order as the scalar code (no reciprocal approximations,
+// no fused multiply-add), so their output is bit-identical to the scalar fallback used for the remaining points.
+#ifdef IMGUI_ENABLE_SSE
+// Two (x,y) vectors per register. Horizontal sum of each pair is x*x+y*y in both lanes.
+static inline __m128 ImLengthSqr2x2(__m128 v)                   { const __m128 sq = _mm_mul_ps(v, v); return _mm_add_ps(sq, _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(2, 3, 0, 1))); }
+static inline __m128 ImNormalizeOverZero2x2(__m128 v)           { const __m128 d2 = ImLengthSqr2x2(v); const __m128 mask = _mm_cmpgt_ps(d2, _mm_setzero_ps()); const __m128 n = _mm_mul_ps(v, _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(d2))); return _mm_or_ps(_mm_and_ps(mask, n), _mm_andnot_ps(mask, v)); }
+static inline __m128 ImFixNormal2x2(__m128 v)                   { const __m128 d2 = _mm_max_ps(_mm_set1_ps(0.5f), ImLengthSqr2x2(v)); return _mm_mul_ps(v, _mm_div_ps(_mm_set1_ps(1.0f), d2)); } // max(0.5,NaN) is NaN, same as the scalar test
+static inline __m128 ImPerp2x2(__m128 v)                        { return _mm_xor_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)), _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f)); } // (x,y) -> (y,-x)
+#endif
+#ifdef IMGUI_ENABLE_AVX2
+static inline __m256 ImLengthSqr2x4(__m256 v)                   { const __m256 sq = _mm256_mul_ps(v, v); return _mm256_add_ps(sq, _mm256_permute_ps(sq, _MM_SHUFFLE(2, 3, 0, 1))); }
+static inline __m256 ImNormalizeOverZero2x4(__m256 v)           { const __m256 d2 = ImLengthSqr2x4(v); const __m256 mask = _mm256_cmp_ps(d2, _mm256_setzero_ps(), _CMP_GT_OQ); const __m256 n = _mm256_mul_ps(v, _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(d2))); return _mm256_blendv_ps(v, n, mask); }
+static inline __m256 ImFixNormal2x4(__m256 v)                   { const __m256 d2 = _mm256_max_ps(_mm256_set1_ps(0.5f), ImLengthSqr2x4(v)); return _mm256_mul_ps(v, _mm256_div_ps(_mm256_set1_ps(1.0f), d2)); }
+static inline __m256 ImPerp2x4(__m256 v)                        { return _mm256_xor_ps(_mm256_permute_ps(v, _MM_SHUFFLE(2, 3, 0, 1)), _mm256_setr_ps(0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f)); }
+#endif
+
+// out_normals[i] = normalized perpendicular of segment points[i] -> points[i+1] (-> points[0] for the last segment of a closed shape)
+static void PolylineComputeSegmentNormals(const ImVec2* points, const int points_count, bool closed, ImVec2* out_normals)
+{
+    const int count = closed ? points_count : points_count-1;
+    int i1 = 0;
+#ifdef IMGUI_ENABLE_AVX2
+    for (; i1 + 4 < points_count; i1 += 4)
+        _mm256_storeu_ps(&out_normals[i1].x, ImPerp2x4(ImNormalizeOverZero2x4(_mm256_sub_ps(_mm256_loadu_ps(&points[i1+1].x), _mm256_loadu_ps(&points[i1].x)))));
+#endif
+#ifdef IMGUI_ENABLE_SSE
+    for (; i1 + 2 < points_count; i1 += 2)
+        _mm_storeu_ps(&out_normals[i1].x, ImPerp2x2(ImNormalizeOverZero2x2(_mm_sub_ps(_mm_loadu_ps(&points[i1+1].x), _mm_loadu_ps(&points[i1].x)))));
+#endif
+    for (; i1 < count; i1++)
+    {
+        const int i2 = (i1+1) == points_count ? 0 : i1+1;
+        float dx = points[i2].x - points[i1].x;
+        float dy = points[i2].y - points[i1].y;
+        IM_NORMALIZE2F_OVER_ZERO(dx, dy);
+        out_normals[i1].x = dy;
+        out_normals[i1].y = -dx;
+    }
+}
+
+// out_normals[i] = average of the normals of the two segments joining at points[i], scaled so the offset stays at unit distance from both
+// segments (for i in [first, points_count), segment -1 being the last segment)
+static void PolylineComputeJointNormals(const ImVec2* seg_normals, const int points_count, int first, ImVec2* out_normals)
+{
+    int i = first;
+    if (i == 0)
+    {
+        float dm_x = (seg_normals[points_count-1].x + seg_normals[0].x) * 0.5f;
+        float dm_y = (seg_normals[points_count-1].y + seg_normals[0].y) * 0.5f;
+        IM_FIXNORMAL2F(dm_x, dm_y);
+        out_normals[0].x = dm_x;
+        out_normals[0].y = dm_y;
+        i = 1;
+    }
+#ifdef IMGUI_ENABLE_AVX2
+    for (; i + 4 <= points_count; i += 4)
+    {
+        const __m256 dm = _mm256_mul_ps(_mm256_add_ps(_mm256_loadu_ps(&seg_normals[i-1].x), _mm256_loadu_ps(&seg_normals[i].x)), _mm256_set1_ps(0.5f));
+        _mm256_storeu_ps(&out_normals[i].x, ImFixNormal2x4(dm));
+    }
+#endif
+#ifdef IMGUI_ENABLE_SSE
+    for (; i + 2 <= points_count; i += 2)
+    {
+        const __m128 dm = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(&seg_normals[i-1].x), _mm_loadu_ps(&seg_normals[i].x)), _mm_set1_ps(0.5f));
+        _mm_storeu_ps(&out_normals[i].x, ImFixNormal2x2(dm));
+    }
+#endif
+    for (; i < points_count; i++)
+    {
+        float dm_x = (seg_normals[i-1].x + seg_normals[i].x) * 0.5f;
+        float dm_y = (seg_normals[i-1].y + seg_normals[i].y) * 0.5f;
+        IM_FIXNORMAL2F(dm_x, dm_y);
+        out_normals[i].x = dm_x;
+        out_normals[i].y = dm_y;
+    }
+}
+
+// out[i*2+0] = points[i] + normals[i] * scale, out[i*2+1] = points[i] - normals[i] * scale
+static void PolylineExtrude2(const ImVec2* points, const ImVec2* normals, const int count, float scale, ImVec2* out)
+{
+    int i = 0;
+#ifdef IMGUI_ENABLE_SSE
+    const __m128 scale4 = _mm_set1_ps(scale);
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m128 p = _mm_loadu_ps(&points[i].x);
+        const __m128 dm = _mm_mul_ps(_mm_loadu_ps(&normals[i].x), scale4);
+        const __m128 a = _mm_add_ps(p, dm);
+        const __m128 b = _mm_sub_ps(p, dm);
+        _mm_storeu_ps(&out[i*2+0].x, _mm_movelh_ps(a, b));
+        _mm_storeu_ps(&out[i*2+2].x, _mm_movehl_ps(b, a));
+    }
+#endif
+    for (; i < count; i++)
+    {
+        const float dm_x = normals[i].x * scale;
+        const float dm_y = normals[i].y * scale;
+        out[i*2+0].x = points[i].x + dm_x; out[i*2+0].y = points[i].y + dm_y;
+        out[i*2+1].x = points[i].x - dm_x; out[i*2+1].y = points[i].y - dm_y;
+    }
+}
+
+// out[i*4+0..3] = points[i] + normals[i] * scale_out, + normals[i] * scale_in, - normals[i] * scale_in, - normals[i] * scale_out
+static void PolylineExtrude4(const ImVec2* points, const ImVec2* normals, const int count, float scale_in, float scale_out, ImVec2* out)
+{
+    int i = 0;
+#ifdef IMGUI_ENABLE_SSE
+    const __m128 scale_in4 = _mm_set1_ps(scale_in);
+    const __m128 scale_out4 = _mm_set1_ps(scale_out);
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m128 p = _mm_loadu_ps(&points[i].x);
+        const __m128 n = _mm_loadu_ps(&normals[i].x);
+        const __m128 dm_out = _mm_mul_ps(n, scale_out4);
+        const __m128 dm_in = _mm_mul_ps(n, scale_in4);
+        const __m128 a = _mm_add_ps(p, dm_out);
+        const __m128 b = _mm_add_ps(p, dm_in);
+        const __m128 c = _mm_sub_ps(p, dm_in);
+        const __m128 d = _mm_sub_ps(p, dm_out);
+        _mm_storeu_ps(&out[i*4+0].x, _mm_movelh_ps(a, b));
+        _mm_storeu_ps(&out[i*4+2].x, _mm_movelh_ps(c, d));
+        _mm_storeu_ps(&out[i*4+4].x, _mm_movehl_ps(b, a));
+        _mm_storeu_ps(&out[i*4+6].x, _mm_movehl_ps(d, c));
+    }
+#endif
+    for (; i < count; i++)
+    {
+        const float dm_out_x = normals[i].x * scale_out;
+        const float dm_out_y = normals[i].y * scale_out;
+        const float dm_in_x = normals[i].x * scale_in;
+        const float dm_in_y = normals[i].y * scale_in;
+        out[i*4+0].x = points[i].x + dm_out_x; out[i*4+0].y = points[i].y + dm_out_y;
+        out[i*4+1].x = points[i].x + dm_in_x;  out[i*4+1].y = points[i].y + dm_in_y;
+        out[i*4+2].x = points[i].x - dm_in_x;  out[i*4+2].y = points[i].y - dm_in_y;
+        out[i*4+3].x = points[i].x - dm_out_x; out[i*4+3].y = points[i].y - dm_out_y;
+    }
+}
+
 // TODO: Thickness anti-aliased lines cap are missing their AA fringe.
 // We avoid using the ImVec2 math operators here to reduce cost to a minimum for debug/non-inlined builds.
 void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32 col, bool closed, float thickness)
@@ -646,20 +793,18 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
         PrimReserve(idx_count, vtx_count);
 
         // Temporary buffer
-        ImVec2* temp_normals = (ImVec2*)alloca(points_count * (thick_line ? 5 : 3) * sizeof(ImVec2)); //-V630
-        ImVec2* temp_points = temp_normals + points_count;
-
-        for (int i1 = 0; i1 < count; i1++)
-        {
-            const int i2 = (i1+1) == points_count ? 0 : i1+1;
-            float dx = points[i2].x - points[i1].x;
-            float dy = points[i2].y - points[i1].y;
-            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i1].x = dy;
-            temp_normals[i1].y = -dx;
-        }
+        const size_t temp_size = (size_t)points_count * (thick_line ? 6 : 4) * sizeof(ImVec2);
+        const bool temp_on_heap = temp_size > IM_DRAWLIST_TESSELLATION_ALLOCA_MAX;
+        ImVec2* temp_normals = (ImVec2*)(temp_on_heap ? IM_ALLOC(temp_size) : alloca(temp_size)); //-V630
+        ImVec2* temp_joint_normals = temp_normals + points_count;
+        ImVec2* temp_points = temp_joint_normals + points_count;
+
+        // The first point of an open line is extruded along its segment normal, every other point along its joint normal
+        PolylineComputeSegmentNormals(points, points_count, closed, temp_normals);
         if (!closed)
             temp_normals[points_count-1] = temp_normals[points_count-2];
+        const int first_joint = closed ? 0 : 1;
+        PolylineComputeJointNormals(temp_normals, points_count, first_joint, temp_joint_normals);
 
         if (!thick_line)
         {
@@ -667,38 +812,19 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
             {
                 temp_points[0] = points[0] + temp_normals[0] * AA_SIZE;
                 temp_points[1] = points[0] - temp_normals[0] * AA_SIZE;
-                temp_points[(points_count-1)*2+0] = points[points_count-1] + temp_normals[points_count-1] * AA_SIZE;
-                temp_points[(points_count-1)*2+1] = points[points_count-1] - temp_normals[points_count-1] * AA_SIZE;
             }
+            PolylineExtrude2(points + first_joint, temp_joint_normals + first_joint, points_count - first_joint, AA_SIZE, temp_points + first_joint * 2);
 
-            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
+            // Add indexes
             unsigned int idx1 = _VtxCurrentIdx;
             for (int i1 = 0; i1 < count; i1++)
             {
-                const int i2 = (i1+1) == points_count ? 0 : i1+1;
                 unsigned int idx2 = (i1+1) == points_count ? _VtxCurrentIdx : idx1+3;
-
-                // Average normals
-                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
-                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
-                IM_FIXNORMAL2F(dm_x, dm_y)
-                dm_x *= AA_SIZE;
-                dm_y *= AA_SIZE;
-
-                // Add temporary vertexes
-                ImVec2* out_vtx = &temp_points[i2*2];
-                out_vtx[0].x = points[i2].x + dm_x;
-                out_vtx[0].y = points[i2].y + dm_y;
-                out_vtx[1].x = points[i2].x - dm_x;
-                out_vtx[1].y = points[i2].y - dm_y;
-
-                // Add indexes
                 _IdxWritePtr[0] = (ImDrawIdx)(idx2+0); _IdxWritePtr[1] = (ImDrawIdx)(idx1+0); _IdxWritePtr[2] = (ImDrawIdx)(idx1+2);
                 _IdxWritePtr[3] = (ImDrawIdx)(idx1+2); _IdxWritePtr[4] = (ImDrawIdx)(idx2+2); _IdxWritePtr[5] = (ImDrawIdx)(idx2+0);
                 _IdxWritePtr[6] = (ImDrawIdx)(idx2+1); _IdxWritePtr[7] = (ImDrawIdx)(idx1+1); _IdxWritePtr[8] = (ImDrawIdx)(idx1+0);
                 _IdxWritePtr[9] = (ImDrawIdx)(idx1+0); _IdxWritePtr[10]= (ImDrawIdx)(idx2+0); _IdxWritePtr[11]= (ImDrawIdx)(idx2+1);
                 _IdxWritePtr += 12;
-
                 idx1 = idx2;
             }
 
@@ -720,40 +846,14 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 temp_points[1] = points[0] + temp_normals[0] * (half_inner_thickness);
                 temp_points[2] = points[0] - temp_normals[0] * (half_inner_thickness);
                 temp_points[3] = points[0] - temp_normals[0] * (half_inner_thickness + AA_SIZE);
-                temp_points[(points_count-1)*4+0] = points[points_count-1] + temp_normals[points_count-1] * (half_inner_thickness + AA_SIZE);
-                temp_points[(points_count-1)*4+1] = points[points_count-1] + temp_normals[points_count-1] * (half_inner_thickness);
-                temp_points[(points_count-1)*4+2] = points[points_count-1] - temp_normals[points_count-1] * (half_inner_thickness);
-                temp_points[(points_count-1)*4+3] = points[points_count-1] - temp_normals[points_count-1] * (half_inner_thickness + AA_SIZE);
             }
+            PolylineExtrude4(points + first_joint, temp_joint_normals + first_joint, points_count - first_joint, half_inner_thickness, half_inner_thickness + AA_SIZE, temp_points + first_joint * 4);
 
-            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
+            // Add indexes
             unsigned int idx1 = _VtxCurrentIdx;
             for (int i1 = 0; i1 < count; i1++)
             {
-                const int i2 = (i1+1) == points_count ? 0 : i1+1;
                 unsigned int idx2 = (i1+1) == points_count ? _VtxCurrentIdx : idx1+4;
-
-                // Average normals
-                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
-                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
-                IM_FIXNORMAL2F(dm_x, dm_y);
-                float dm_out_x = dm_x * (half_inner_thickness + AA_SIZE);
-                float dm_out_y = dm_y * (half_inner_thickness + AA_SIZE);
-                float dm_in_x = dm_x * half_inner_thickness;
-                float dm_in_y = dm_y * half_inner_thickness;
-
-                // Add temporary vertexes
-                ImVec2* out_vtx = &temp_points[i2*4];
-                out_vtx[0].x = points[i2].x + dm_out_x;
-                out_vtx[0].y = points[i2].y + dm_out_y;
-                out_vtx[1].x = points[i2].x + dm_in_x;
-                out_vtx[1].y = points[i2].y + dm_in_y;
-                out_vtx[2].x = points[i2].x - dm_in_x;
-                out_vtx[2].y = points[i2].y - dm_in_y;
-                out_vtx[3].x = points[i2].x - dm_out_x;
-                out_vtx[3].y = points[i2].y - dm_out_y;
-
-                // Add indexes
                 _IdxWritePtr[0]  = (ImDrawIdx)(idx2+1); _IdxWritePtr[1]  = (ImDrawIdx)(idx1+1); _IdxWritePtr[2]  = (ImDrawIdx)(idx1+2);
                 _IdxWritePtr[3]  = (ImDrawIdx)(idx1+2); _IdxWritePtr[4]  = (ImDrawIdx)(idx2+2); _IdxWritePtr[5]  = (ImDrawIdx)(idx2+1);
                 _IdxWritePtr[6]  = (ImDrawIdx)(idx2+1); _IdxWritePtr[7]  = (ImDrawIdx)(idx1+1); _IdxWritePtr[8]  = (ImDrawIdx)(idx1+0);
@@ -761,7 +861,6 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 _IdxWritePtr[12] = (ImDrawIdx)(idx2+2); _IdxWritePtr[13] = (ImDrawIdx)(idx1+2); _IdxWritePtr[14] = (ImDrawIdx)(idx1+3);
                 _IdxWritePtr[15] = (ImDrawIdx)(idx1+3); _IdxWritePtr[16] = (ImDrawIdx)(idx2+3); _IdxWritePtr[17] = (ImDrawIdx)(idx2+2);
                 _IdxWritePtr += 18;
-
                 idx1 = idx2;
             }
 
@@ -776,6 +875,8 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
             }
         }
         _VtxCurrentIdx += (ImDrawIdx)vtx_count;
+        if (temp_on_heap)
+            IM_FREE(temp_normals);
     }
     else
     {
@@ -836,33 +937,21 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
             _IdxWritePtr += 3;
         }
 
-        // Compute normals
-        ImVec2* temp_normals = (ImVec2*)alloca(points_count * sizeof(ImVec2)); //-V630
-        for (int i0 = points_count-1, i1 = 0; i1 < points_count; i0 = i1++)
-        {
-            const ImVec2& p0 = points[i0];
-            const ImVec2& p1 = points[i1];
-            float dx = p1.x - p0.x;
-            float dy = p1.y - p0.y;
-            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i0].x = dy;
-            temp_normals[i0].y = -dx;
-        }
+        // Compute normals, then extrude every point by half the fringe inward and outward along its joint normal
+        const size_t temp_size = (size_t)points_count * 4 * sizeof(ImVec2);
+        const bool temp_on_heap = temp_size > IM_DRAWLIST_TESSELLATION_ALLOCA_MAX;
+        ImVec2* temp_normals = (ImVec2*)(temp_on_heap ? IM_ALLOC(temp_size) : alloca(temp_size)); //-V630
+        ImVec2* temp_joint_normals = temp_normals + points_count;
+        ImVec2* temp_points = temp_joint_normals + points_count;
+        PolylineComputeSegmentNormals(points, points_count, true, temp_normals);
+        PolylineComputeJointNormals(temp_normals, points_count, 0, temp_joint_normals);
+        PolylineExtrude2(points, temp_joint_normals, points_count, AA_SIZE * 0.5f, temp_points);
 
         for (int i0 = points_count-1, i1 = 0; i1 < points_count; i0 = i1++)
         {
-            // Average normals
-            const ImVec2& n0 = temp_normals[i0];
-            const ImVec2& n1 = temp_normals[i1];
-            float dm_x = (n0.x + n1.x) * 0.5f;
-            float dm_y = (n0.y + n1.y) * 0.5f;
-            IM_FIXNORMAL2F(dm_x, dm_y);
-            dm_x *= AA_SIZE * 0.5f;
-            dm_y *= AA_SIZE * 0.5f;
-
             // Add vertices
-            _VtxWritePtr[0].pos.x = (points[i1].x - dm_x); _VtxWritePtr[0].pos.y = (points[i1].y - dm_y); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
-            _VtxWritePtr[1].pos.x = (points[i1].x + dm_x); _VtxWritePtr[1].pos.y = (points[i1].y + dm_y); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
+            _VtxWritePtr[0].pos = temp_points[i1*2+1]; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
+            _VtxWritePtr[1].pos = temp_points[i1*2+0]; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
             _VtxWritePtr += 2;
 
             // Add indexes for fringes
@@ -871,6 +960,8 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
             _IdxWritePtr += 6;
         }
         _VtxCurrentIdx += (ImDrawIdx)vtx_count;
+        if (temp_on_heap)
+            IM_FREE(temp_normals);
     }
     else
     {
@@ -892,29 +983,105 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
     }
 }
 
-void ImDrawList::PathArcToFast(const ImVec2& center, float radius, int a_min_of_12, int a_max_of_12)
+// Unit circle sampled at IM_DRAWLIST_ARCFAST_TABLE_SIZE evenly spaced angles, starting at angle 0
+struct ImDrawListArcFastTable
 {
-    if (radius == 0.0f || a_min_of_12 > a_max_of_12)
+    ImVec2  Vtx[IM_DRAWLIST_ARCFAST_TABLE_SIZE];
+    float   RadiusCutoffScale;  // Radius above which Vtx[] is too coarse for a maximum error of 1 pixel. Scales linearly with CircleSegmentMaxError.
+
+    ImDrawListArcFastTable()
+    {
+        for (int i = 0; i < IM_ARRAYSIZE(Vtx); i++)
+        {
+            const float a = ((float)i * 2 * IM_PI) / (float)IM_ARRAYSIZE(Vtx);
+            Vtx[i] = ImVec2(ImCos(a), ImSin(a));
+        }
+        // Inverse of IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_CALC() for IM_DRAWLIST_ARCFAST_SAMPLE_MAX segments
+        RadiusCutoffScale = 1.0f / (1.0f - ImCos((IM_PI * 2.0f) / (float)IM_DRAWLIST_ARCFAST_SAMPLE_MAX));
+    }
+};
+static const ImDrawListArcFastTable GArcFastTable;
+
+static inline bool ImDrawListArcFastFits(const ImDrawListSharedData* data, float radius)
+{
+    return radius <= data->CircleSegmentMaxError * GArcFastTable.RadiusCutoffScale;
+}
+
+int ImDrawList::_CalcCircleAutoSegmentCount(float radius) const
+{
+    const int radius_idx = (int)radius - 1;
+    if (radius_idx >= 0 && radius_idx < IM_ARRAYSIZE(_Data->CircleSegmentCounts))
+        return _Data->CircleSegmentCounts[radius_idx]; // Use cached value
+    return IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_CALC(radius, _Data->CircleSegmentMaxError);
+}
+
+// Emit points from the unit circle table, going from sample 'a_min_sample' to sample 'a_max_sample' (both included, either direction,
+// values outside [0,IM_DRAWLIST_ARCFAST_SAMPLE_MAX] wrap around). When the range is not a multiple of 'a_step' the points are spread
+// evenly over the range instead of leaving one short segment at the end.
+void ImDrawList::_PathArcToFastEx(const ImVec2& center, float radius, int a_min_sample, int a_max_sample, int a_step)
+{
+    if (radius <= 0.0f)
     {
         _Path.push_back(center);
         return;
     }
-    _Path.reserve(_Path.Size + (a_max_of_12 - a_min_of_12 + 1));
-    for (int a = a_min_of_12; a <= a_max_of_12; a++)
+
+    if (a_step <= 0)
+        a_step = IM_DRAWLIST_ARCFAST_SAMPLE_MAX / _CalcCircleAutoSegmentCount(radius);
+    a_step = ImClamp(a_step, 1, IM_DRAWLIST_ARCFAST_SAMPLE_MAX / 4); // Never step more than a quarter turn
+
+    const int a_dir = (a_max_sample >= a_min_sample) ? +1 : -1;
+    const int a_range = (a_max_sample - a_min_sample) * a_dir;
+    const int segments = ImMax((a_range + a_step - 1) / a_step, 1);
+    int a_base = a_min_sample % IM_DRAWLIST_ARCFAST_SAMPLE_MAX;
+    if (a_base < 0)
+        a_base += IM_DRAWLIST_ARCFAST_SAMPLE_MAX;
+
+    const int points_count = (a_range > 0) ? segments + 1 : 1;
+    _Path.resize(_Path.Size + points_count);
+    ImVec2* out_ptr = _Path.Data + _Path.Size - points_count;
+    const ImVec2* table = GArcFastTable.Vtx;
+    for (int i = 0; i < points_count; i++)
     {
-        const ImVec2& c = _Data->CircleVtx12[a % IM_ARRAYSIZE(_Data->CircleVtx12)];
-        _Path.push_back(ImVec2(center.x + c.x * radius, center.y + c.y * radius));
+        int sample = (a_base + a_dir * (i * a_range / segments)) % IM_DRAWLIST_ARCFAST_SAMPLE_MAX;
+        if (sample < 0)
+            sample += IM_DRAWLIST_ARCFAST_SAMPLE_MAX;
+        const ImVec2& c = table[sample];
+        out_ptr->x = center.x + c.x * radius;
+        out_ptr->y = center.y + c.y * radius;
+        out_ptr++;
     }
 }
 
-void ImDrawList::PathArcTo(const ImVec2& center, float radius, float a_min, float a_max, int num_segments)
+// Explicit segment count. Arcs starting on a table sample and whose segments are a whole number of samples are read from the table too.
+void ImDrawList::_PathArcToN(const ImVec2& center, float radius, float a_min, float a_max, int num_segments)
 {
-    if (radius == 0.0f)
+    if (radius <= 0.0f)
     {
         _Path.push_back(center);
         return;
     }
 
+    const float a_min_sample_f = a_min * (IM_DRAWLIST_ARCFAST_SAMPLE_MAX / (IM_PI * 2.0f));
+    const float a_step_f = (a_max - a_min) * (IM_DRAWLIST_ARCFAST_SAMPLE_MAX / (IM_PI * 2.0f)) / (float)num_segments;
+    const float a_min_sample_r = ImFloorStd(a_min_sample_f + 0.5f);
+    const float a_step_r = ImFloorStd(ImFabs(a_step_f) + 0.5f);
+    if (a_step_r >= 1.0f && ImFabs(a_min_sample_f - a_min_sample_r) < 1e-3f && ImFabs(ImFabs(a_step_f) - a_step_r) < 1e-3f)
+    {
+        const int a_min_sample = (int)a_min_sample_r;
+        const int a_step = (a_step_f < 0.0f) ? -(int)a_step_r : (int)a_step_r;
+        _Path.reserve(_Path.Size + (num_segments + 1));
+        for (int i = 0; i <= num_segments; i++)
+        {
+            int sample = (a_min_sample + a_step * i) % IM_DRAWLIST_ARCFAST_SAMPLE_MAX;
+            if (sample < 0)
+                sample += IM_DRAWLIST_ARCFAST_SAMPLE_MAX;
+            const ImVec2& c = GArcFastTable.Vtx[sample];
+            _Path.push_back(ImVec2(center.x + c.x * radius, center.y + c.y * radius));
+        }
+        return;
+    }
+
     // Note that we are adding a point at both a_min and a_max.
     // If you are trying to draw a full closed circle you don't want the overlapping points!
     _Path.reserve(_Path.Size + (num_segments + 1));
@@ -925,6 +1092,59 @@ void ImDrawList::PathArcTo(const ImVec2& center, float radius, float a_min, floa
     }
 }
 
+void ImDrawList::PathArcToFast(const ImVec2& center, float radius, int a_min_of_12, int a_max_of_12)
+{
+    if (radius <= 0.0f || a_min_of_12 > a_max_of_12)
+    {
+        _Path.push_back(center);
+        return;
+    }
+    _PathArcToFastEx(center, radius, a_min_of_12 * IM_DRAWLIST_ARCFAST_SAMPLE_MAX / 12, a_max_of_12 * IM_DRAWLIST_ARCFAST_SAMPLE_MAX / 12, 0);
+}
+
+void ImDrawList::PathArcTo(const ImVec2& center, float radius, float a_min, float a_max, int num_segments)
+{
+    if (radius <= 0.0f)
+    {
+        _Path.push_back(center);
+        return;
+    }
+
+    if (num_segments > 0)
+    {
+        _PathArcToN(center, radius, a_min, a_max, num_segments);
+        return;
+    }
+
+    // Automatic segment count
+    if (ImDrawListArcFastFits(_Data, radius))
+    {
+        // Walk the table samples strictly inside [a_min,a_max] and only compute the two end points exactly (when they don't already fall on a sample)
+        const bool a_is_reverse = a_max < a_min;
+        const float a_min_sample_f = a_min * (IM_DRAWLIST_ARCFAST_SAMPLE_MAX / (IM_PI * 2.0f));
+        const float a_max_sample_f = a_max * (IM_DRAWLIST_ARCFAST_SAMPLE_MAX / (IM_PI * 2.0f));
+        const int a_min_sample = a_is_reverse ? (int)ImFloorStd(a_min_sample_f) : (int)ImCeil(a_min_sample_f);
+        const int a_max_sample = a_is_reverse ? (int)ImCeil(a_max_sample_f) : (int)ImFloorStd(a_max_sample_f);
+        const bool a_has_mid_samples = a_is_reverse ? (a_min_sample >= a_max_sample) : (a_max_sample >= a_min_sample);
+        const bool a_emit_start = !a_has_mid_samples || ImFabs(a_min_sample_f - (float)a_min_sample) >= 1e-4f;
+        const bool a_emit_end = !a_has_mid_samples || ImFabs(a_max_sample_f - (float)a_max_sample) >= 1e-4f;
+
+        if (a_emit_start)
+            _Path.push_back(ImVec2(center.x + ImCos(a_min) * radius, center.y + ImSin(a_min) * radius));
+        if (a_has_mid_samples)
+            _PathArcToFastEx(center, radius, a_min_sample, a_max_sample, 0);
+        if (a_emit_end)
+            _Path.push_back(ImVec2(center.x + ImCos(a_max) * radius, center.y + ImSin(a_max) * radius));
+    }
+    else
+    {
+        const float arc_length = ImFabs(a_max - a_min);
+        const int circle_segment_count = _CalcCircleAutoSegmentCount(radius);
+        const int arc_segment_count = ImMax((int)ImCeil(circle_segment_count * arc_length / (IM_PI * 2.0f)), 1);
+        _PathArcToN(center, radius, a_min, a_max, arc_segment_count);
+    }
+}
+
 ImVec2 ImBezierCalc(const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, float t)
 {
     float u = 1.0f - t;
@@ -1106,28 +1326,23 @@ void ImDrawList::AddCircle(const ImVec2& center, float radius, ImU32 col, int nu
     if ((col & IM_COL32_A_MASK) == 0 || radius <= 0.0f)
         return;
 
-    // Obtain segment count
-    if (num_segments <= 0)
+    if (num_segments <= 0 && ImDrawListArcFastFits(_Data, radius))
     {
-        // Automatic segment count
-        const int radius_idx = (int)radius - 1;
-        if (radius_idx < IM_ARRAYSIZE(_Data->CircleSegmentCounts))
-            num_segments = _Data->CircleSegmentCounts[radius_idx]; // Use cached value
-        else
-            num_segments = IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_CALC(radius, _Data->CircleSegmentMaxError);
+        // Automatic segment count: scale and translate the cached unit circle, dropping the closing point (a full turn repeats sample 0)
+        _PathArcToFastEx(center, radius - 0.5f, 0, IM_DRAWLIST_ARCFAST_SAMPLE_MAX, 0);
+        _Path.Size--;
     }
     else
     {
-        // Explicit segment count (still clamp to avoid drawing insanely tessellated shapes)
-        num_segments = ImClamp(num_segments, 3, IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX);
-    }
+        if (num_segments <= 0)
+            num_segments = _CalcCircleAutoSegmentCount(radius);                                 // Automatic segment count
+        else
+            num_segments = ImClamp(num_segments, 3, IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX);        // Explicit segment count (still clamp to avoid drawing insanely tessellated shapes)
 
-    // Because we are filling a closed shape we remove 1 from the count of segments/points
-    const float a_max = (IM_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
-    if (num_segments == 12)
-        PathArcToFast(center, radius - 0.5f, 0, 12);
-    else
+        // Because we are filling a closed shape we remove 1 from the count of segments/points
+        const float a_max = (IM_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
         PathArcTo(center, radius - 0.5f, 0.0f, a_max, num_segments - 1);
+    }
     PathStroke(col, true, thickness);
 }
 
@@ -1136,28 +1351,23 @@ void ImDrawList::AddCircleFilled(const ImVec2& center, float radius, ImU32 col,
     if ((col & IM_COL32_A_MASK) == 0 || radius <= 0.0f)
         return;
 
-    // Obtain segment count
-    if (num_segments <= 0)
+    if (num_segments <= 0 && ImDrawListArcFastFits(_Data, radius))
     {
-        // Automatic segment count
-        const int radius_idx = (int)radius - 1;
-        if (radius_idx < IM_ARRAYSIZE(_Data->CircleSegmentCounts))
-            num_segments = _Data->CircleSegmentCounts[radius_idx]; // Use cached value
-        else
-            num_segments = IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_CALC(radius, _Data->CircleSegmentMaxError);
+        // Automatic segment count: scale and translate the cached unit circle, dropping the closing point (a full turn repeats sample 0)
+        _PathArcToFastEx(center, radius, 0, IM_DRAWLIST_ARCFAST_SAMPLE_MAX, 0);
+        _Path.Size--;
     }
     else
     {
-        // Explicit segment count (still clamp to avoid drawing insanely tessellated shapes)
-        num_segments = ImClamp(num_segments, 3, IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX);
-    }
+        if (num_segments <= 0)
+            num_segments = _CalcCircleAutoSegmentCount(radius);                                 // Automatic segment count
+        else
+            num_segments = ImClamp(num_segments, 3, IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX);        // Explicit segment count (still clamp to avoid drawing insanely tessellated shapes)
 
-    // Because we are filling a closed shape we remove 1 from the count of segments/points
-    const float a_max = (IM_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
-    if (num_segments == 12)
-        PathArcToFast(center, radius, 0, 12);
-    else
+        // Because we are filling a closed shape we remove 1 from the count of segments/points
+        const float a_max = (IM_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
         PathArcTo(center, radius, 0.0f, a_max, num_segments - 1);
+    }
     PathFillConvex(col);
 }
 
@@ -1625,6 +1835,7 @@ void    ImFontAtlas::ClearInputData()
     CustomRects.clear();
     for (int n = 0; n < IM_ARRAYSIZE(CustomRectIds); n++)
         CustomRectIds[n] = -1;
+    ImFontAtlasBuildDestroyDynamicData(this);
 }
 
 void    ImFontAtlas::ClearTexData()
@@ -1636,6 +1847,7 @@ void    ImFontAtlas::ClearTexData()
         IM_FREE(TexPixelsRGBA32);
     TexPixelsAlpha8 = NULL;
     TexPixelsRGBA32 = NULL;
+    ImFontAtlasBuildDestroyDynamicData(this);
 }
 
 void    ImFontAtlas::ClearFonts()
@@ -1644,6 +1856,7 @@ void    ImFontAtlas::ClearFonts()
     for (int i = 0; i < Fonts.Size; i++)
         IM_DELETE(Fonts[i]);
     Fonts.clear();
+    ImFontAtlasBuildDestroyDynamicData(this);
 }
 
 void    ImFontAtlas::Clear()
@@ -1880,9 +2093,265 @@ bool ImFontAtlas::GetMouseCursorTexData(ImGuiMouseCursor cursor_type, ImVec2* ou
 }
 
 bool    ImFontAtlas::Build()
+{
+    return Build(ImFontAtlasBuildOptions());
+}
+
+bool    ImFontAtlas::Build(const ImFontAtlasBuildOptions& options)
+{
+    IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    const bool use_cache = (options.CacheFilename != NULL) && !(Flags & ImFontAtlasFlags_DynamicGlyphs); // The packing state can't be restored from the cache
+    if (use_cache && LoadBuildCache(options.CacheFilename))
+        return true;
+    if (!ImFontAtlasBuildWithStbTruetype(this, options.ThreadsCount))
+        return false;
+    if (use_cache)
+        SaveBuildCache(options.CacheFilename);
+    return true;
+}
+
+// Baked atlas cache file: a header, one record per font, then flat arrays stored at 8-bytes aligned offsets from the start of the file.
+// Everything is stored in native layout so the file can be used in place (e.g. memory-mapped) by code sharing this build of Dear ImGui.
+static const char   FONT_ATLAS_CACHE_MAGIC[8] = { 'I', 'm', 'F', 'n', 't', 'A', 't', 'l' };
+static const ImU32  FONT_ATLAS_CACHE_VERSION = 1;
+
+struct ImFontAtlasCacheHeader
+{
+    char                Magic[8];
+    ImU32               Version;
+    ImU32               BuildHash;          // = ImFontAtlasCalcBuildHash()
+    ImU32               FileSize;
+    int                 TexWidth, TexHeight;
+    ImVec2              TexUvWhitePixel;
+    int                 FontsCount;         // Followed by FontsCount x ImFontAtlasCacheFont
+    int                 CustomRectsCount;
+    ImU32               CustomRectsOffset;  // CustomRectsCount x (unsigned short X, Y)
+    ImU32               TexPixelsOffset;    // TexWidth x TexHeight alpha8 pixels
+};
+
+struct ImFontAtlasCacheFont
+{
+    float               FontSize;
+    float               Ascent, Descent;
+    float               FallbackAdvanceX;
+    int                 MetricsTotalSurface;
+    short               ConfigDataCount;
+    ImWchar             EllipsisChar;
+    int                 GlyphsCount;
+    int                 IndexCount;
+    ImU32               GlyphsOffset;       // GlyphsCount x ImFontGlyph
+    ImU32               IndexAdvanceXOffset;// IndexCount x float
+    ImU32               IndexLookupOffset;  // IndexCount x ImWchar
+};
+
+// Hash every input of the build: if it matches, the baked output is the same.
+static ImU32 ImFontAtlasCalcBuildHash(ImFontAtlas* atlas)
+{
+    const int header[] = { IMGUI_VERSION_NUM, (int)sizeof(ImWchar), (int)sizeof(ImFontGlyph), atlas->Flags, atlas->TexDesiredWidth, atlas->TexGlyphPadding, atlas->ConfigData.Size, atlas->Fonts.Size, atlas->CustomRects.Size };
+    ImU32 hash = ImHashData(header, sizeof(header));
+    for (int src_i = 0; src_i < atlas->ConfigData.Size; src_i++)
+    {
+        const ImFontConfig& cfg = atlas->ConfigData[src_i];
+        const int dst_index = (int)(atlas->Fonts.find(cfg.DstFont) - atlas->Fonts.Data);
+        const ImWchar* ranges = cfg.GlyphRanges ? cfg.GlyphRanges : atlas->GetGlyphRangesDefault();
+        int ranges_count = 0;
+        while (ranges[ranges_count])
+            ranges_count++;
+        const int ints[] = { dst_index, cfg.FontDataSize, cfg.FontNo, cfg.OversampleH, cfg.OversampleV, cfg.PixelSnapH, cfg.MergeMode, (int)cfg.RasterizerFlags, (int)cfg.EllipsisChar };
+        const float floats[] = { cfg.SizePixels, cfg.GlyphExtraSpacing.x, cfg.GlyphExtraSpacing.y, cfg.GlyphOffset.x, cfg.GlyphOffset.y, cfg.GlyphMinAdvanceX, cfg.GlyphMaxAdvanceX, cfg.RasterizerMultiply };
+        hash = ImHashData(ints, sizeof(ints), hash);
+        hash = ImHashData(floats, sizeof(floats), hash);
+        hash = ImHashData(ranges, ranges_count * sizeof(ImWchar), hash);
+        hash = ImHashData(cfg.FontData, (size_t)cfg.FontDataSize, hash);
+    }
+    for (int i = 0; i < atlas->CustomRects.Size; i++)
+    {
+        const ImFontAtlasCustomRect& r = atlas->CustomRects[i];
+        const int ints[] = { (int)r.ID, r.Width, r.Height, (int)(atlas->Fonts.find(r.Font) - atlas->Fonts.Data) };
+        const float floats[] = { r.GlyphAdvanceX, r.GlyphOffset.x, r.GlyphOffset.y };
+        hash = ImHashData(ints, sizeof(ints), hash);
+        hash = ImHashData(floats, sizeof(floats), hash);
+    }
+    return hash;
+}
+
+bool    ImFontAtlas::SaveBuildCache(const char* filename)
+{
+    IM_ASSERT(filename != NULL);
+    if (TexPixelsAlpha8 == NULL)
+        return false;
+
+    // Layout the file
+    ImU32 offset = (ImU32)(sizeof(ImFontAtlasCacheHeader) + sizeof(ImFontAtlasCacheFont) * Fonts.Size);
+    ImVector<ImFontAtlasCacheFont> font_records;
+    font_records.resize(Fonts.Size);
+    if (font_records.Size > 0)
+        memset(font_records.Data, 0, (size_t)font_records.size_in_bytes());
+    for (int i = 0; i < Fonts.Size; i++)
+    {
+        const ImFont* font = Fonts[i];
+        ImFontAtlasCacheFont& rec = font_records[i];
+        rec.FontSize = font->FontSize;
+        rec.Ascent = font->Ascent;
+        rec.Descent = font->Descent;
+        rec.FallbackAdvanceX = font->FallbackAdvanceX;
+        rec.MetricsTotalSurface = font->MetricsTotalSurface;
+        rec.ConfigDataCount = font->ConfigDataCount;
+        rec.EllipsisChar = font->EllipsisChar;
+        rec.GlyphsCount = font->Glyphs.Size;
+        rec.IndexCount = font->IndexLookup.Size;
+        rec.GlyphsOffset = offset = (offset + 7) & ~7;
+        offset += rec.GlyphsCount * sizeof(ImFontGlyph);
+        rec.IndexAdvanceXOffset = offset = (offset + 7) & ~7;
+        offset += rec.IndexCount * sizeof(float);
+        rec.IndexLookupOffset = offset = (offset + 7) & ~7;
+        offset += rec.IndexCount * sizeof(ImWchar);
+    }
+    ImFontAtlasCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.Magic, FONT_ATLAS_CACHE_MAGIC, sizeof(header.Magic));
+    header.Version = FONT_ATLAS_CACHE_VERSION;
+    header.BuildHash = ImFontAtlasCalcBuildHash(this);
+    header.TexWidth = TexWidth;
+    header.TexHeight = TexHeight;
+    header.TexUvWhitePixel = TexUvWhitePixel;
+    header.FontsCount = Fonts.Size;
+    header.CustomRectsCount = CustomRects.Size;
+    header.CustomRectsOffset = offset = (offset + 7) & ~7;
+    offset += CustomRects.Size * sizeof(unsigned short) * 2;
+    header.TexPixelsOffset = offset = (offset + 7) & ~7;
+    offset += TexWidth * TexHeight;
+    header.FileSize = offset;
+
+    // Fill and write it in one go (zero-filled so padding bytes are deterministic)
+    ImVector<char> buf;
+    buf.resize((int)header.FileSize);
+    memset(buf.Data, 0, (size_t)buf.Size);
+    memcpy(buf.Data, &header, sizeof(header));
+    if (font_records.Size > 0)
+        memcpy(buf.Data + sizeof(header), font_records.Data, (size_t)font_records.size_in_bytes());
+    for (int i = 0; i < Fonts.Size; i++)
+    {
+        const ImFont* font = Fonts[i];
+        const ImFontAtlasCacheFont& rec = font_records[i];
+        ImFontGlyph* dst_glyphs = (ImFontGlyph*)(buf.Data + rec.GlyphsOffset);
+        for (int glyph_i = 0; glyph_i < rec.GlyphsCount; glyph_i++)
+        {
+            const ImFontGlyph& src = font->Glyphs[glyph_i];
+            ImFontGlyph& dst = dst_glyphs[glyph_i];
+            dst.Codepoint = src.Codepoint;
+            dst.AdvanceX = src.AdvanceX;
+            dst.X0 = src.X0; dst.Y0 = src.Y0; dst.X1 = src.X1; dst.Y1 = src.Y1;
+            dst.U0 = src.U0; dst.V0 = src.V0; dst.U1 = src.U1; dst.V1 = src.V1;
+        }
+        if (rec.IndexCount > 0)
+        {
+            memcpy(buf.Data + rec.IndexAdvanceXOffset, font->IndexAdvanceX.Data, (size_t)font->IndexAdvanceX.size_in_bytes());
+            memcpy(buf.Data + rec.IndexLookupOffset, font->IndexLookup.Data, (size_t)font->IndexLookup.size_in_bytes());
+        }
+    }
+    unsigned short* dst_rects = (unsigned short*)(buf.Data + header.CustomRectsOffset);
+    for (int i = 0; i < CustomRects.Size; i++)
+    {
+        dst_rects[i * 2 + 0] = CustomRects[i].X;
+        dst_rects[i * 2 + 1] = CustomRects[i].Y;
+    }
+    memcpy(buf.Data + header.TexPixelsOffset, TexPixelsAlpha8, (size_t)(TexWidth * TexHeight));
+
+    ImFileHandle f = ImFileOpen(filename, "wb");
+    if (f == NULL)
+        return false;
+    const bool ret = (ImFileWrite(buf.Data, 1, (ImU64)buf.Size, f) == (ImU64)buf.Size);
+    ImFileClose(f);
+    return ret;
+}
+
+bool    ImFontAtlas::LoadBuildCache(const char* filename)
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
-    return ImFontAtlasBuildWithStbTruetype(this);
+    IM_ASSERT(filename != NULL);
+    if (ConfigData.Size == 0)
+        return false;
+    ImFontAtlasBuildRegisterDefaultCustomRects(this);
+
+    size_t file_size = 0;
+    char* file_data = (char*)ImFileLoadToMemory(filename, "rb", &file_size);
+    if (file_data == NULL)
+        return false;
+
+    // Validate everything before touching the atlas, so a stale or truncated file leaves it untouched
+    const ImFontAtlasCacheHeader* header = (const ImFontAtlasCacheHeader*)file_data;
+    const ImFontAtlasCacheFont* font_records = (const ImFontAtlasCacheFont*)(file_data + sizeof(ImFontAtlasCacheHeader));
+    bool valid = file_size >= sizeof(ImFontAtlasCacheHeader);
+    valid = valid && memcmp(header->Magic, FONT_ATLAS_CACHE_MAGIC, sizeof(header->Magic)) == 0 && header->Version == FONT_ATLAS_CACHE_VERSION && header->FileSize == file_size;
+    valid = valid && header->FontsCount == Fonts.Size && header->CustomRectsCount == CustomRects.Size && header->TexWidth > 0 && header->TexHeight > 0;
+    valid = valid && sizeof(ImFontAtlasCacheHeader) + sizeof(ImFontAtlasCacheFont) * header->FontsCount <= file_size;
+    valid = valid && header->CustomRectsOffset + header->CustomRectsCount * sizeof(unsigned short) * 2 <= file_size;
+    valid = valid && header->TexPixelsOffset + (size_t)header->TexWidth * header->TexHeight <= file_size;
+    for (int i = 0; valid && i < header->FontsCount; i++)
+    {
+        const ImFontAtlasCacheFont& rec = font_records[i];
+        valid = rec.GlyphsCount >= 0 && rec.IndexCount >= 0 && rec.GlyphsOffset + rec.GlyphsCount * sizeof(ImFontGlyph) <= file_size;
+        valid = valid && rec.IndexAdvanceXOffset + rec.IndexCount * sizeof(float) <= file_size && rec.IndexLookupOffset + rec.IndexCount * sizeof(ImWchar) <= file_size;
+    }
+    valid = valid && header->BuildHash == ImFontAtlasCalcBuildHash(this);
+    if (!valid)
+    {
+        IM_FREE(file_data);
+        return false;
+    }
+
+    // Restore atlas
+    TexID = (ImTextureID)NULL;
+    ClearTexData();
+    TexWidth = header->TexWidth;
+    TexHeight = header->TexHeight;
+    TexUvScale = ImVec2(1.0f / TexWidth, 1.0f / TexHeight);
+    TexUvWhitePixel = header->TexUvWhitePixel;
+    TexPixelsAlpha8 = (unsigned char*)IM_ALLOC((size_t)(TexWidth * TexHeight));
+    memcpy(TexPixelsAlpha8, file_data + header->TexPixelsOffset, (size_t)(TexWidth * TexHeight));
+    const unsigned short* src_rects = (const unsigned short*)(file_data + header->CustomRectsOffset);
+    for (int i = 0; i < CustomRects.Size; i++)
+    {
+        CustomRects[i].X = src_rects[i * 2 + 0];
+        CustomRects[i].Y = src_rects[i * 2 + 1];
+    }
+
+    // Restore fonts, as ImFontAtlasBuildSetupFont() + ImFontAtlasBuildFinish() would have left them
+    for (int i = 0; i < Fonts.Size; i++)
+    {
+        ImFont* font = Fonts[i];
+        const ImFontAtlasCacheFont& rec = font_records[i];
+        font->ClearOutputData();
+        for (int src_i = 0; src_i < ConfigData.Size; src_i++)
+            if (ConfigData[src_i].DstFont == font && !ConfigData[src_i].MergeMode)
+            {
+                font->ConfigData = &ConfigData[src_i];
+                break;
+            }
+        font->ContainerAtlas = this;
+        font->FontSize = rec.FontSize;
+        font->Ascent = rec.Ascent;
+        font->Descent = rec.Descent;
+        font->MetricsTotalSurface = rec.MetricsTotalSurface;
+        font->ConfigDataCount = rec.ConfigDataCount;
+        font->EllipsisChar = rec.EllipsisChar;
+        font->Glyphs.resize(rec.GlyphsCount);
+        font->IndexAdvanceX.resize(rec.IndexCount);
+        font->IndexLookup.resize(rec.IndexCount);
+        if (rec.GlyphsCount > 0)
+            memcpy(font->Glyphs.Data, file_data + rec.GlyphsOffset, (size_t)font->Glyphs.size_in_bytes());
+        if (rec.IndexCount > 0)
+        {
+            memcpy(font->IndexAdvanceX.Data, file_data + rec.IndexAdvanceXOffset, (size_t)font->IndexAdvanceX.size_in_bytes());
+            memcpy(font->IndexLookup.Data, file_data + rec.IndexLookupOffset, (size_t)font->IndexLookup.size_in_bytes());
+        }
+        font->FallbackGlyph = font->FindGlyphNoFallback(font->FallbackChar);
+        font->FallbackAdvanceX = rec.FallbackAdvanceX;
+        font->DirtyLookupTables = false;
+    }
+    IM_FREE(file_data);
+    return true;
 }
 
 void    ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_brighten_factor)
@@ -1927,6 +2396,108 @@ struct ImFontBuildDstData
     ImBoolVector        GlyphsSet;          // This is used to resolve collision when multiple sources are merged into a same destination font.
 };
 
+// Rasterization work item: a slice of the glyphs of one source font. Slices land in disjoint rectangles of the texture so they can be rendered in any order.
+struct ImFontBuildRenderTask
+{
+    int                 SrcIndex;
+    int                 GlyphStart;
+    int                 GlyphCount;
+};
+
+struct ImFontBuildRenderJob
+{
+    ImFontAtlas*                    Atlas;
+    ImFontBuildSrcData*             SrcTmp;
+    const stbtt_pack_context*       PackContext;
+    bool                            Threaded;
+    ImVector<ImFontBuildRenderTask> Tasks;
+};
+
+// State kept after Build() by ImFontAtlasFlags_DynamicGlyphs.
+// Stored in GFontAtlasDynamicData rather than in ImFontAtlas, whose layout is shared with the host application: atlases built by the host
+// don't have an entry, so their texture is never modified.
+struct ImFontAtlasDynamicGlyph
+{
+    ImFont*             Font;
+    ImWchar             Codepoint;
+};
+
+struct ImFontAtlasDynamicData
+{
+    ImFontAtlas*                        Atlas;
+    stbtt_pack_context                  PackContext;        // Owns the skyline of the whole texture
+    ImVector<stbtt_fontinfo>            FontInfos;          // Per ConfigData[] entry. Point into ImFontConfig::FontData.
+    ImBoolVector                        RequestedGlyphs;    // 1-bit per (font index, code point), so each code point is only requested once, even if no source font has it
+    ImVector<ImFontAtlasDynamicGlyph>   PendingGlyphs;
+    ImVector<ImFontAtlasDirtyRect>      TexDirtyRects;      // See ImFontAtlas::GetTexDirtyRects()
+};
+
+static ImVector<ImFontAtlasDynamicData*> GFontAtlasDynamicData;
+
+static void ImFontAtlasBuildRenderGlyphs(int task_i, void* user_data)
+{
+    ImFontBuildRenderJob* job = (ImFontBuildRenderJob*)user_data;
+    const ImFontBuildRenderTask& task = job->Tasks[task_i];
+    ImFontBuildSrcData& src_tmp = job->SrcTmp[task.SrcIndex];
+    const ImFontConfig& cfg = job->Atlas->ConfigData[task.SrcIndex];
+
+    // stb_truetype temporarily modifies the pack context, so each task works on its own copy
+    stbtt_pack_context spc = *job->PackContext;
+    stbtt_fontinfo font_info = src_tmp.FontInfo;
+    if (job->Threaded)
+        spc.user_allocator_context = font_info.userdata = job;
+    stbtt_pack_range pack_range = src_tmp.PackRange;
+    pack_range.array_of_unicode_codepoints += task.GlyphStart;
+    pack_range.chardata_for_range += task.GlyphStart;
+    pack_range.num_chars = task.GlyphCount;
+    stbrp_rect* rects = src_tmp.Rects + task.GlyphStart;
+    stbtt_PackFontRangesRenderIntoRects(&spc, &font_info, &pack_range, 1, rects);
+
+    // Apply multiply operator
+    if (cfg.RasterizerMultiply != 1.0f)
+    {
+        unsigned char multiply_table[256];
+        ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+        stbrp_rect* r = rects;
+        for (int glyph_i = 0; glyph_i < task.GlyphCount; glyph_i++, r++)
+            if (r->was_packed)
+                ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, job->Atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, job->Atlas->TexWidth * 1);
+    }
+}
+
+// Size of the texture rectangle needed by a glyph, padding and oversampling included (this is based on stbtt_PackFontRangesGatherRects)
+static void ImFontAtlasBuildCalcGlyphRectSize(ImFontAtlas* atlas, const stbtt_fontinfo* font_info, const ImFontConfig& cfg, int codepoint, stbrp_rect* out_rect)
+{
+    const float scale = (cfg.SizePixels > 0) ? stbtt_ScaleForPixelHeight(font_info, cfg.SizePixels) : stbtt_ScaleForMappingEmToPixels(font_info, -cfg.SizePixels);
+    const int padding = atlas->TexGlyphPadding;
+    int x0, y0, x1, y1;
+    const int glyph_index_in_font = stbtt_FindGlyphIndex(font_info, codepoint);
+    IM_ASSERT(glyph_index_in_font != 0);
+    stbtt_GetGlyphBitmapBoxSubpixel(font_info, glyph_index_in_font, scale * cfg.OversampleH, scale * cfg.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
+    out_rect->w = (stbrp_coord)(x1 - x0 + padding + cfg.OversampleH - 1);
+    out_rect->h = (stbrp_coord)(y1 - y0 + padding + cfg.OversampleV - 1);
+}
+
+// Register a rendered glyph into its destination font
+static void ImFontAtlasBuildAddPackedGlyph(ImFontAtlas* atlas, ImFont* dst_font, const ImFontConfig& cfg, int codepoint, const stbtt_packedchar* packed_chars, int glyph_i)
+{
+    const float font_off_x = cfg.GlyphOffset.x;
+    const float font_off_y = cfg.GlyphOffset.y + IM_ROUND(dst_font->Ascent);
+    const stbtt_packedchar& pc = packed_chars[glyph_i];
+
+    const float char_advance_x_org = pc.xadvance;
+    const float char_advance_x_mod = ImClamp(char_advance_x_org, cfg.GlyphMinAdvanceX, cfg.GlyphMaxAdvanceX);
+    float char_off_x = font_off_x;
+    if (char_advance_x_org != char_advance_x_mod)
+        char_off_x += cfg.PixelSnapH ? ImFloor((char_advance_x_mod - char_advance_x_org) * 0.5f) : (char_advance_x_mod - char_advance_x_org) * 0.5f;
+
+    // Register glyph
+    stbtt_aligned_quad q;
+    float dummy_x = 0.0f, dummy_y = 0.0f;
+    stbtt_GetPackedQuad(packed_chars, atlas->TexWidth, atlas->TexHeight, glyph_i, &dummy_x, &dummy_y, &q, 0);
+    dst_font->AddGlyph((ImWchar)codepoint, q.x0 + char_off_x, q.y0 + font_off_y, q.x1 + char_off_x, q.y1 + font_off_y, q.s0, q.t0, q.s1, q.t1, char_advance_x_mod);
+}
+
 static void UnpackBoolVectorToFlatIndexList(const ImBoolVector* in, ImVector<int>* out)
 {
     IM_ASSERT(sizeof(in->Storage.Data[0]) == sizeof(int));
@@ -1939,7 +2510,7 @@ static void UnpackBoolVectorToFlatIndexList(const ImBoolVector* in, ImVector<int
                     out->push_back((int)((it - it_begin) << 5) + bit_n);
 }
 
-bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
+bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas, int threads_count)
 {
     IM_ASSERT(atlas->ConfigData.Size > 0);
 
@@ -2065,17 +2636,10 @@ bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         src_tmp.PackRange.h_oversample = (unsigned char)cfg.OversampleH;
         src_tmp.PackRange.v_oversample = (unsigned char)cfg.OversampleV;
 
-        // Gather the sizes of all rectangles we will need to pack (this loop is based on stbtt_PackFontRangesGatherRects)
-        const float scale = (cfg.SizePixels > 0) ? stbtt_ScaleForPixelHeight(&src_tmp.FontInfo, cfg.SizePixels) : stbtt_ScaleForMappingEmToPixels(&src_tmp.FontInfo, -cfg.SizePixels);
-        const int padding = atlas->TexGlyphPadding;
+        // Gather the sizes of all rectangles we will need to pack
         for (int glyph_i = 0; glyph_i < src_tmp.GlyphsList.Size; glyph_i++)
         {
-            int x0, y0, x1, y1;
-            const int glyph_index_in_font = stbtt_FindGlyphIndex(&src_tmp.FontInfo, src_tmp.GlyphsList[glyph_i]);
-            IM_ASSERT(glyph_index_in_font != 0);
-            stbtt_GetGlyphBitmapBoxSubpixel(&src_tmp.FontInfo, glyph_index_in_font, scale * cfg.OversampleH, scale * cfg.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
-            src_tmp.Rects[glyph_i].w = (stbrp_coord)(x1 - x0 + padding + cfg.OversampleH - 1);
-            src_tmp.Rects[glyph_i].h = (stbrp_coord)(y1 - y0 + padding + cfg.OversampleV - 1);
+            ImFontAtlasBuildCalcGlyphRectSize(atlas, &src_tmp.FontInfo, cfg, src_tmp.GlyphsList[glyph_i], &src_tmp.Rects[glyph_i]);
             total_surface += src_tmp.Rects[glyph_i].w * src_tmp.Rects[glyph_i].h;
         }
     }
@@ -2114,6 +2678,9 @@ bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     }
 
     // 7. Allocate texture
+    // With dynamic glyphs, reserve as much free space as the packed glyphs use: glyphs rasterized on demand are packed into it.
+    if (atlas->Flags & ImFontAtlasFlags_DynamicGlyphs)
+        atlas->TexHeight *= 2;
     atlas->TexHeight = (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? (atlas->TexHeight + 1) : ImUpperPowerOfTwo(atlas->TexHeight);
     atlas->TexUvScale = ImVec2(1.0f / atlas->TexWidth, 1.0f / atlas->TexHeight);
     atlas->TexPixelsAlpha8 = (unsigned char*)IM_ALLOC(atlas->TexWidth * atlas->TexHeight);
@@ -2122,30 +2689,45 @@ bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     spc.height = atlas->TexHeight;
 
     // 8. Render/rasterize font characters into the texture
+    // Every source is split in slices of glyphs so large ranges (e.g. CJK) spread over all threads. Packing is already done, so the output doesn't depend on the threads count.
+    const int RENDER_GLYPHS_PER_TASK = 128;
+    ImFontBuildRenderJob render_job;
+    render_job.Atlas = atlas;
+    render_job.SrcTmp = src_tmp_array.Data;
+    render_job.PackContext = &spc;
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
-    {
-        ImFontConfig& cfg = atlas->ConfigData[src_i];
-        ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
-        if (src_tmp.GlyphsCount == 0)
-            continue;
-
-        stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &src_tmp.PackRange, 1, src_tmp.Rects);
-
-        // Apply multiply operator
-        if (cfg.RasterizerMultiply != 1.0f)
+        for (int glyph_start = 0; glyph_start < src_tmp_array[src_i].GlyphsCount; glyph_start += RENDER_GLYPHS_PER_TASK)
         {
-            unsigned char multiply_table[256];
-            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
-            stbrp_rect* r = &src_tmp.Rects[0];
-            for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++, r++)
-                if (r->was_packed)
-                    ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, atlas->TexWidth * 1);
+            ImFontBuildRenderTask task;
+            task.SrcIndex = src_i;
+            task.GlyphStart = glyph_start;
+            task.GlyphCount = ImMin(RENDER_GLYPHS_PER_TASK, src_tmp_array[src_i].GlyphsCount - glyph_start);
+            render_job.Tasks.push_back(task);
         }
-        src_tmp.Rects = NULL;
-    }
+    threads_count = ImMin(threads_count, render_job.Tasks.Size);
+    render_job.Threaded = (threads_count > 1);
+    ImParallelFor(render_job.Tasks.Size, ImFontAtlasBuildRenderGlyphs, &render_job, threads_count);
+    for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+        src_tmp_array[src_i].Rects = NULL;
 
-    // End packing
-    stbtt_PackEnd(&spc);
+    // End packing, or keep the skyline for glyphs rasterized on demand
+    if (atlas->Flags & ImFontAtlasFlags_DynamicGlyphs)
+    {
+        ImFontAtlasBuildDestroyDynamicData(atlas);
+        ImFontAtlasDynamicData* dynamic_data = IM_NEW(ImFontAtlasDynamicData)();
+        dynamic_data->Atlas = atlas;
+        ((stbrp_context*)spc.pack_info)->height = atlas->TexHeight;
+        dynamic_data->PackContext = spc;
+        dynamic_data->FontInfos.resize(src_tmp_array.Size);
+        for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+            dynamic_data->FontInfos[src_i] = src_tmp_array[src_i].FontInfo;
+        dynamic_data->RequestedGlyphs.Resize(atlas->Fonts.Size * (IM_UNICODE_CODEPOINT_MAX + 1));
+        GFontAtlasDynamicData.push_back(dynamic_data);
+    }
+    else
+    {
+        stbtt_PackEnd(&spc);
+    }
     buf_rects.clear();
 
     // 9. Setup ImFont and glyphs for runtime
@@ -2165,26 +2747,8 @@ bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         const float ascent = ImFloor(unscaled_ascent * font_scale + ((unscaled_ascent > 0.0f) ? +1 : -1));
         const float descent = ImFloor(unscaled_descent * font_scale + ((unscaled_descent > 0.0f) ? +1 : -1));
         ImFontAtlasBuildSetupFont(atlas, dst_font, &cfg, ascent, descent);
-        const float font_off_x = cfg.GlyphOffset.x;
-        const float font_off_y = cfg.GlyphOffset.y + IM_ROUND(dst_font->Ascent);
-
         for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++)
-        {
-            const int codepoint = src_tmp.GlyphsList[glyph_i];
-            const stbtt_packedchar& pc = src_tmp.PackedChars[glyph_i];
-
-            const float char_advance_x_org = pc.xadvance;
-            const float char_advance_x_mod = ImClamp(char_advance_x_org, cfg.GlyphMinAdvanceX, cfg.GlyphMaxAdvanceX);
-            float char_off_x = font_off_x;
-            if (char_advance_x_org != char_advance_x_mod)
-                char_off_x += cfg.PixelSnapH ? ImFloor((char_advance_x_mod - char_advance_x_org) * 0.5f) : (char_advance_x_mod - char_advance_x_org) * 0.5f;
-
-            // Register glyph
-            stbtt_aligned_quad q;
-            float dummy_x = 0.0f, dummy_y = 0.0f;
-            stbtt_GetPackedQuad(src_tmp.PackedChars, atlas->TexWidth, atlas->TexHeight, glyph_i, &dummy_x, &dummy_y, &q, 0);
-            dst_font->AddGlyph((ImWchar)codepoint, q.x0 + char_off_x, q.y0 + font_off_y, q.x1 + char_off_x, q.y1 + font_off_y, q.s0, q.t0, q.s1, q.t1, char_advance_x_mod);
-        }
+            ImFontAtlasBuildAddPackedGlyph(atlas, dst_font, cfg, src_tmp.GlyphsList[glyph_i], src_tmp.PackedChars, glyph_i);
     }
 
     // Cleanup temporary (ImVector doesn't honor destructor)
@@ -2318,6 +2882,145 @@ void ImFontAtlasBuildFinish(ImFontAtlas* atlas)
     }
 }
 
+void ImFontAtlasBuildRequestGlyph(ImFontAtlas* atlas, const ImFont* font, ImWchar codepoint)
+{
+    ImFontAtlasDynamicData* dynamic_data = ImFontAtlasBuildFindDynamicData(atlas);
+    if (dynamic_data == NULL)
+        return;
+    ImFont** font_it = atlas->Fonts.find((ImFont*)font);
+    if (font_it == atlas->Fonts.end())
+        return;
+    const int bit_n = atlas->Fonts.index_from_ptr(font_it) * (IM_UNICODE_CODEPOINT_MAX + 1) + (int)codepoint;
+    if (dynamic_data->RequestedGlyphs.GetBit(bit_n))
+        return;
+    dynamic_data->RequestedGlyphs.SetBit(bit_n, true);
+    ImFontAtlasDynamicGlyph glyph;
+    glyph.Font = (ImFont*)font;
+    glyph.Codepoint = codepoint;
+    dynamic_data->PendingGlyphs.push_back(glyph);
+}
+
+ImFontAtlasDynamicData* ImFontAtlasBuildFindDynamicData(const ImFontAtlas* atlas)
+{
+    for (int n = 0; n < GFontAtlasDynamicData.Size; n++)
+        if (GFontAtlasDynamicData[n]->Atlas == atlas)
+            return GFontAtlasDynamicData[n];
+    return NULL;
+}
+
+void ImFontAtlasBuildDestroyDynamicData(ImFontAtlas* atlas)
+{
+    ImFontAtlasDynamicData* dynamic_data = ImFontAtlasBuildFindDynamicData(atlas);
+    if (dynamic_data == NULL)
+        return;
+    GFontAtlasDynamicData.find_erase_unsorted(dynamic_data);
+    stbtt_PackEnd(&dynamic_data->PackContext);
+    IM_DELETE(dynamic_data);
+}
+
+ImVector<ImFontAtlasDirtyRect>* ImFontAtlas::GetTexDirtyRects()
+{
+    ImFontAtlasDynamicData* dynamic_data = ImFontAtlasBuildFindDynamicData(this);
+    return dynamic_data ? &dynamic_data->TexDirtyRects : NULL;
+}
+
+bool    ImFontAtlas::BuildPendingGlyphs()
+{
+    ImFontAtlasDynamicData* dynamic_data = ImFontAtlasBuildFindDynamicData(this);
+    if (dynamic_data == NULL || dynamic_data->PendingGlyphs.empty())
+        return false;
+    IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    IM_ASSERT(TexPixelsAlpha8 != NULL);
+
+    // 1. Find the first source font of each requested glyph which has it (regardless of its glyph ranges), and measure it
+    ImVector<int> glyphs_src;
+    ImVector<stbrp_rect> rects;
+    glyphs_src.resize(dynamic_data->PendingGlyphs.Size);
+    rects.resize(dynamic_data->PendingGlyphs.Size);
+    for (int glyph_i = 0; glyph_i < dynamic_data->PendingGlyphs.Size; glyph_i++)
+    {
+        const ImFontAtlasDynamicGlyph& glyph = dynamic_data->PendingGlyphs[glyph_i];
+        glyphs_src[glyph_i] = -1;
+        memset(&rects[glyph_i], 0, sizeof(stbrp_rect));
+        for (int src_i = 0; src_i < ConfigData.Size && glyphs_src[glyph_i] == -1; src_i++)
+            if (ConfigData[src_i].DstFont == glyph.Font && stbtt_FindGlyphIndex(&dynamic_data->FontInfos[src_i], glyph.Codepoint) != 0)
+                glyphs_src[glyph_i] = src_i;
+        if (glyphs_src[glyph_i] != -1)
+            ImFontAtlasBuildCalcGlyphRectSize(this, &dynamic_data->FontInfos[glyphs_src[glyph_i]], ConfigData[glyphs_src[glyph_i]], glyph.Codepoint, &rects[glyph_i]);
+    }
+
+    // 2. Pack them into the free space left by the skyline. Glyphs which don't fit keep using the fallback glyph.
+    stbrp_pack_rects((stbrp_context*)dynamic_data->PackContext.pack_info, rects.Data, rects.Size);
+
+    // 3. Render and register, one source font at a time
+    bool pixels_added = false;
+    ImVector<int> codepoints;
+    ImVector<stbrp_rect> src_rects;
+    ImVector<stbtt_packedchar> packed_chars;
+    for (int src_i = 0; src_i < ConfigData.Size; src_i++)
+    {
+        codepoints.resize(0);
+        src_rects.resize(0);
+        for (int glyph_i = 0; glyph_i < dynamic_data->PendingGlyphs.Size; glyph_i++)
+            if (glyphs_src[glyph_i] == src_i && rects[glyph_i].was_packed)
+            {
+                codepoints.push_back(dynamic_data->PendingGlyphs[glyph_i].Codepoint);
+                src_rects.push_back(rects[glyph_i]);
+            }
+        if (codepoints.empty())
+            continue;
+
+        const ImFontConfig& cfg = ConfigData[src_i];
+        packed_chars.resize(codepoints.Size);
+        memset(packed_chars.Data, 0, (size_t)packed_chars.size_in_bytes());
+        stbtt_pack_range pack_range = {};
+        pack_range.font_size = cfg.SizePixels;
+        pack_range.array_of_unicode_codepoints = codepoints.Data;
+        pack_range.num_chars = codepoints.Size;
+        pack_range.chardata_for_range = packed_chars.Data;
+        pack_range.h_oversample = (unsigned char)cfg.OversampleH;
+        pack_range.v_oversample = (unsigned char)cfg.OversampleV;
+        dynamic_data->PackContext.pixels = TexPixelsAlpha8;
+        stbtt_PackFontRangesRenderIntoRects(&dynamic_data->PackContext, &dynamic_data->FontInfos[src_i], &pack_range, 1, src_rects.Data);
+
+        unsigned char multiply_table[256];
+        if (cfg.RasterizerMultiply != 1.0f)
+            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+        for (int glyph_i = 0; glyph_i < codepoints.Size; glyph_i++)
+        {
+            const stbrp_rect& r = src_rects[glyph_i];
+            if (cfg.RasterizerMultiply != 1.0f)
+                ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, TexPixelsAlpha8, r.x, r.y, r.w, r.h, TexWidth * 1);
+            ImFontAtlasBuildAddPackedGlyph(this, cfg.DstFont, cfg, codepoints[glyph_i], packed_chars.Data, glyph_i);
+
+            ImFontAtlasDirtyRect dirty_rect;
+            dirty_rect.X = (unsigned short)r.x;
+            dirty_rect.Y = (unsigned short)r.y;
+            dirty_rect.Width = (unsigned short)r.w;
+            dirty_rect.Height = (unsigned short)r.h;
+            dynamic_data->TexDirtyRects.push_back(dirty_rect);
+            pixels_added = true;
+
+            // Keep the RGBA32 copy in sync if it has been requested
+            if (TexPixelsRGBA32 != NULL)
+                for (int y = r.y; y < r.y + r.h; y++)
+                {
+                    const unsigned char* src = TexPixelsAlpha8 + y * TexWidth + r.x;
+                    unsigned int* dst = TexPixelsRGBA32 + y * TexWidth + r.x;
+                    for (int n = r.w; n > 0; n--)
+                        *dst++ = IM_COL32(255, 255, 255, (unsigned int)(*src++));
+                }
+        }
+    }
+    dynamic_data->PendingGlyphs.resize(0);
+
+    // 4. Update lookup tables of the fonts which received glyphs
+    for (int i = 0; i < Fonts.Size; i++)
+        if (Fonts[i]->DirtyLookupTables)
+            Fonts[i]->BuildLookupTable();
+    return pixels_added;
+}
+
 // Retrieve list of range (2 int per range, values are inclusive)
 const ImWchar*   ImFontAtlas::GetGlyphRangesDefault()
 {
@@ -2638,14 +3341,16 @@ void ImFont::BuildLookupTable()
     // FIXME: Needs proper TAB handling but it needs to be contextualized (or we could arbitrary say that each string starts at "column 0" ?)
     if (FindGlyph((ImWchar)' '))
     {
-        if (Glyphs.back().Codepoint != '\t')   // So we can call this function multiple times
+        if (IndexLookup[(int)'\t'] == (ImWchar)-1)   // So we can call this function multiple times, even after glyphs have been added
+        {
             Glyphs.resize(Glyphs.Size + 1);
-        ImFontGlyph& tab_glyph = Glyphs.back();
+            IndexLookup[(int)'\t'] = (ImWchar)(Glyphs.Size-1);
+        }
+        ImFontGlyph& tab_glyph = Glyphs[IndexLookup[(int)'\t']];
         tab_glyph = *FindGlyph((ImWchar)' ');
         tab_glyph.Codepoint = '\t';
         tab_glyph.AdvanceX *= IM_TABSIZE;
         IndexAdvanceX[(int)tab_glyph.Codepoint] = (float)tab_glyph.AdvanceX;
-        IndexLookup[(int)tab_glyph.Codepoint] = (ImWchar)(Glyphs.Size-1);
     }
 
     FallbackGlyph = FindGlyphNoFallback(FallbackChar);
@@ -2712,11 +3417,14 @@ void ImFont::AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst)
 
 const ImFontGlyph* ImFont::FindGlyph(ImWchar c) const
 {
-    if (c >= IndexLookup.Size)
-        return FallbackGlyph;
-    const ImWchar i = IndexLookup.Data[c];
+    const ImWchar i = (c < IndexLookup.Size) ? IndexLookup.Data[c] : (ImWchar)-1;
     if (i == (ImWchar)-1)
+    {
+        // Missing code points are rasterized before the next frame with ImFontAtlasFlags_DynamicGlyphs
+        if (ContainerAtlas != NULL && (ContainerAtlas->Flags & ImFontAtlasFlags_DynamicGlyphs))
+            ImFontAtlasBuildRequestGlyph(ContainerAtlas, this, c);
         return FallbackGlyph;
+    }
     return &Glyphs.Data[i];
 }
 
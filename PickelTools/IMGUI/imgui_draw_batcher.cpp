@@ -0,0 +1,210 @@
+#include "pch.h"
+#include "imgui_draw_batcher.h"
+#include "imgui_internal.h"
+
+// Highest number of vertices a list can hold while being addressed by ImDrawIdx without ImDrawCmd::VtxOffset
+static const int BATCHER_MAX_VERTICES = (sizeof(ImDrawIdx) == 2) ? 0x10000 : 0x7FFFFFFF;
+
+// Back-ends convert clipping rectangles to integer scissor rectangles by truncation, relative to DisplayPos.
+static ImRect GetScissorRect(const ImVec4& clip_rect, const ImVec2& display_pos)
+{
+    return ImRect(ImFloor(clip_rect.x - display_pos.x) + display_pos.x, ImFloor(clip_rect.y - display_pos.y) + display_pos.y,
+                  ImFloor(clip_rect.z - display_pos.x) + display_pos.x, ImFloor(clip_rect.w - display_pos.y) + display_pos.y);
+}
+
+// Match the quads emitted by ImDrawList::PrimRect()/PrimRectUV(): indices (a, a+1, a+2, a, a+2, a+3), corners clockwise from top-left,
+// UV varying along the axes and a single color. Clipping those on the CPU gives the same pixels as the scissor.
+static bool IsAxisAlignedQuad(const ImDrawVert* vtx, const ImDrawIdx* idx)
+{
+    const unsigned int a = idx[0];
+    if (idx[1] != a + 1 || idx[2] != a + 2 || idx[3] != a || idx[4] != a + 2 || idx[5] != a + 3)
+        return false;
+    const ImDrawVert& v0 = vtx[a];
+    const ImDrawVert& v1 = vtx[a + 1];
+    const ImDrawVert& v2 = vtx[a + 2];
+    const ImDrawVert& v3 = vtx[a + 3];
+    return v0.pos.y == v1.pos.y && v1.pos.x == v2.pos.x && v2.pos.y == v3.pos.y && v3.pos.x == v0.pos.x && v0.pos.x < v1.pos.x && v0.pos.y < v3.pos.y
+        && v0.uv.y == v1.uv.y && v1.uv.x == v2.uv.x && v2.uv.y == v3.uv.y && v3.uv.x == v0.uv.x
+        && v0.col == v1.col && v0.col == v2.col && v0.col == v3.col;
+}
+
+// Append the indices of a command to 'out', rebased on the vertices of its source list copied at 'vtx_base'.
+// Returns true if none of the appended triangles is affected by the scissor rectangle.
+static bool AppendCommandIndices(ImDrawList* out, int vtx_base, const ImDrawList* src, const ImDrawCmd* cmd, const ImRect& scissor, bool cpu_clip, ImDrawBatcherStats* stats)
+{
+    const ImDrawIdx* idx = src->IdxBuffer.Data + cmd->IdxOffset;
+    const ImDrawIdx* idx_end = idx + cmd->ElemCount;
+    const ImDrawVert* src_vtx = src->VtxBuffer.Data;
+    bool unclipped = true;
+    while (idx < idx_end)
+    {
+        // Quads
+        if (cpu_clip && idx + 6 <= idx_end && IsAxisAlignedQuad(src_vtx, idx))
+        {
+            const ImDrawVert& v0 = src_vtx[idx[0]];
+            const ImDrawVert& v2 = src_vtx[idx[2]];
+            const ImRect quad(v0.pos, v2.pos);
+            if (scissor.Contains(quad))
+            {
+                for (int n = 0; n < 6; n++)
+                    out->IdxBuffer.push_back((ImDrawIdx)(vtx_base + idx[n]));
+            }
+            else if (!scissor.Overlaps(quad))
+            {
+                stats->PrimitivesCulled++;
+            }
+            else if (out->VtxBuffer.Size + 4 <= BATCHER_MAX_VERTICES)
+            {
+                // Clip position, interpolate UV
+                ImRect clipped = quad;
+                clipped.ClipWithFull(scissor);
+                const ImVec2 uv_scale((v2.uv.x - v0.uv.x) / (quad.Max.x - quad.Min.x), (v2.uv.y - v0.uv.y) / (quad.Max.y - quad.Min.y));
+                const ImVec2 uv_a(v0.uv.x + (clipped.Min.x - quad.Min.x) * uv_scale.x, v0.uv.y + (clipped.Min.y - quad.Min.y) * uv_scale.y);
+                const ImVec2 uv_c(v0.uv.x + (clipped.Max.x - quad.Min.x) * uv_scale.x, v0.uv.y + (clipped.Max.y - quad.Min.y) * uv_scale.y);
+                const ImDrawIdx new_idx = (ImDrawIdx)out->VtxBuffer.Size;
+                ImDrawVert v;
+                v.col = v0.col;
+                v.pos = clipped.Min;                                v.uv = uv_a;                        out->VtxBuffer.push_back(v);
+                v.pos = ImVec2(clipped.Max.x, clipped.Min.y);       v.uv = ImVec2(uv_c.x, uv_a.y);      out->VtxBuffer.push_back(v);
+                v.pos = clipped.Max;                                v.uv = uv_c;                        out->VtxBuffer.push_back(v);
+                v.pos = ImVec2(clipped.Min.x, clipped.Max.y);       v.uv = ImVec2(uv_a.x, uv_c.y);      out->VtxBuffer.push_back(v);
+                const ImDrawIdx quad_idx[6] = { new_idx, (ImDrawIdx)(new_idx + 1), (ImDrawIdx)(new_idx + 2), new_idx, (ImDrawIdx)(new_idx + 2), (ImDrawIdx)(new_idx + 3) };
+                for (int n = 0; n < 6; n++)
+                    out->IdxBuffer.push_back(quad_idx[n]);
+                stats->QuadsClipped++;
+            }
+            else
+            {
+                for (int n = 0; n < 6; n++)
+                    out->IdxBuffer.push_back((ImDrawIdx)(vtx_base + idx[n]));
+                unclipped = false;
+            }
+            idx += 6;
+            continue;
+        }
+
+        // Triangles
+        const ImVec2& p0 = src_vtx[idx[0]].pos;
+        const ImVec2& p1 = src_vtx[idx[1]].pos;
+        const ImVec2& p2 = src_vtx[idx[2]].pos;
+        const ImRect bb(ImMin(p0, ImMin(p1, p2)), ImMax(p0, ImMax(p1, p2)));
+        if (cpu_clip && !scissor.Overlaps(bb))
+        {
+            stats->PrimitivesCulled++;
+        }
+        else
+        {
+            if (!scissor.Contains(bb))
+                unclipped = false;
+            for (int n = 0; n < 3; n++)
+                out->IdxBuffer.push_back((ImDrawIdx)(vtx_base + idx[n]));
+        }
+        idx += 3;
+    }
+    return unclipped;
+}
+
+ImDrawBatcher::~ImDrawBatcher()
+{
+    for (int n = 0; n < DrawLists.Size; n++)
+        IM_DELETE(DrawLists[n]);
+}
+
+void ImDrawBatcher::Optimize(ImDrawData* draw_data, ImDrawBatcherFlags flags)
+{
+    Stats = ImDrawBatcherStats();
+    if (!draw_data->Valid)
+        return;
+
+    // Merging commands with different clipping rectangles relies on scissor rectangles mapping 1:1 to pixels
+    const bool can_merge_clip_rects = draw_data->FramebufferScale.x == 1.0f && draw_data->FramebufferScale.y == 1.0f && ImFloor(draw_data->DisplayPos.x) == draw_data->DisplayPos.x && ImFloor(draw_data->DisplayPos.y) == draw_data->DisplayPos.y;
+    const bool cpu_clip = (flags & ImDrawBatcherFlags_CpuClipQuads) && can_merge_clip_rects;
+
+    Stats.DrawListsBefore = draw_data->CmdListsCount;
+    CmdLists.resize(0);
+    int draw_lists_used = 0;
+    ImDrawList* out = NULL;
+    bool out_last_cmd_unclipped = false;
+    for (int list_n = 0; list_n < draw_data->CmdListsCount; list_n++)
+    {
+        ImDrawList* src = draw_data->CmdLists[list_n];
+        bool pass_through = (src->VtxBuffer.Size > BATCHER_MAX_VERTICES);
+        for (int cmd_n = 0; cmd_n < src->CmdBuffer.Size; cmd_n++)
+        {
+            const ImDrawCmd& cmd = src->CmdBuffer[cmd_n];
+            if (cmd.UserCallback != NULL || cmd.VtxOffset != 0)
+                pass_through = true;
+            if (cmd.UserCallback == NULL)
+                Stats.DrawCmdsBefore++;
+        }
+        if (pass_through)
+        {
+            CmdLists.push_back(src);
+            out = NULL;
+            continue;
+        }
+
+        // Start a new output list when this one can't address more vertices
+        if (out == NULL || out->VtxBuffer.Size + src->VtxBuffer.Size > BATCHER_MAX_VERTICES)
+        {
+            if (draw_lists_used == DrawLists.Size)
+                DrawLists.push_back(IM_NEW(ImDrawList)(NULL));
+            out = DrawLists[draw_lists_used++];
+            out->Clear();
+            out->_OwnerName = "##Batched";
+            out_last_cmd_unclipped = false;
+            CmdLists.push_back(out);
+        }
+
+        const int vtx_base = out->VtxBuffer.Size;
+        out->VtxBuffer.resize(vtx_base + src->VtxBuffer.Size);
+        memcpy(out->VtxBuffer.Data + vtx_base, src->VtxBuffer.Data, (size_t)src->VtxBuffer.size_in_bytes());
+        for (int cmd_n = 0; cmd_n < src->CmdBuffer.Size; cmd_n++)
+        {
+            const ImDrawCmd& cmd = src->CmdBuffer[cmd_n];
+            if (cmd.ElemCount == 0 || cmd.ClipRect.x >= cmd.ClipRect.z || cmd.ClipRect.y >= cmd.ClipRect.w)
+                continue;
+            const ImRect scissor = GetScissorRect(cmd.ClipRect, draw_data->DisplayPos);
+            const int idx_start = out->IdxBuffer.Size;
+            const bool unclipped = AppendCommandIndices(out, vtx_base, src, &cmd, scissor, cpu_clip, &Stats);
+            const unsigned int elem_count = (unsigned int)(out->IdxBuffer.Size - idx_start);
+            if (elem_count == 0)
+                continue;
+
+            ImDrawCmd* last = out->CmdBuffer.Size > 0 ? &out->CmdBuffer.back() : NULL;
+            const bool same_clip_rect = last && memcmp(&last->ClipRect, &cmd.ClipRect, sizeof(ImVec4)) == 0;
+            if (last && last->TextureId == cmd.TextureId && (same_clip_rect || (can_merge_clip_rects && out_last_cmd_unclipped && unclipped)))
+            {
+                if (!same_clip_rect)
+                    last->ClipRect = ImVec4(ImMin(last->ClipRect.x, cmd.ClipRect.x), ImMin(last->ClipRect.y, cmd.ClipRect.y), ImMax(last->ClipRect.z, cmd.ClipRect.z), ImMax(last->ClipRect.w, cmd.ClipRect.w));
+                last->ElemCount += elem_count;
+                out_last_cmd_unclipped = out_last_cmd_unclipped && unclipped;
+            }
+            else
+            {
+                ImDrawCmd new_cmd;
+                new_cmd.ClipRect = cmd.ClipRect;
+                new_cmd.TextureId = cmd.TextureId;
+                new_cmd.IdxOffset = (unsigned int)idx_start;
+                new_cmd.ElemCount = elem_count;
+                out->CmdBuffer.push_back(new_cmd);
+                out_last_cmd_unclipped = unclipped;
+            }
+        }
+    }
+
+    // Point the draw data to the output lists
+    draw_data->CmdLists = CmdLists.Data;
+    draw_data->CmdListsCount = CmdLists.Size;
+    draw_data->TotalVtxCount = draw_data->TotalIdxCount = 0;
+    for (int list_n = 0; list_n < CmdLists.Size; list_n++)
+    {
+        const ImDrawList* list = CmdLists[list_n];
+        draw_data->TotalVtxCount += list->VtxBuffer.Size;
+        draw_data->TotalIdxCount += list->IdxBuffer.Size;
+        for (int cmd_n = 0; cmd_n < list->CmdBuffer.Size; cmd_n++)
+            if (list->CmdBuffer[cmd_n].UserCallback == NULL)
+                Stats.DrawCmdsAfter++;
+    }
+    Stats.DrawListsAfter = CmdLists.Size;
+}
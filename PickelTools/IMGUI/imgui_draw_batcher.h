@@ -0,0 +1,44 @@
+#pragma once
+#include "imgui.h"
+
+#include <string.h>     // memset
+
+// Backend-agnostic draw call batcher, run over ImDrawData after ImGui::Render() and before the renderer back-end.
+// - Consecutive draw lists are concatenated into lists owned by the batcher (as long as 16-bit indices can address them),
+//   so the last command of a window can merge with the first command of the next one.
+// - Two consecutive commands merge when they use the same texture and either share their clipping rectangle, or neither of
+//   them is affected by its clipping rectangle (all its triangles lie inside). The merged command uses the union of both rectangles.
+// - Commands are never reordered, so the result is correct whatever the windows overlap.
+// - Lists with user callbacks or more than 64K vertices (ImDrawCmd::VtxOffset) are passed through untouched.
+// - With ImDrawBatcherFlags_CpuClipQuads, axis-aligned quads (text glyphs, rectangles, images) crossing their clipping rectangle are
+//   clipped on the CPU, which makes most commands independent of their clipping rectangle and lets whole windows merge.
+// The batcher keeps its draw lists between frames to reuse their memory. ImDrawData then points to them until the next Optimize().
+enum ImDrawBatcherFlags_
+{
+    ImDrawBatcherFlags_None             = 0,
+    ImDrawBatcherFlags_CpuClipQuads     = 1 << 0    // Clip axis-aligned quads to their clipping rectangle on the CPU, and cull primitives outside of it
+};
+typedef int ImDrawBatcherFlags;
+
+struct ImDrawBatcherStats
+{
+    int         DrawListsBefore;
+    int         DrawListsAfter;
+    int         DrawCmdsBefore;     // Draw calls, not counting user callbacks
+    int         DrawCmdsAfter;
+    int         QuadsClipped;       // Quads clipped on the CPU
+    int         PrimitivesCulled;   // Triangles or quads dropped because they were entirely outside of their clipping rectangle
+
+    ImDrawBatcherStats() { memset(this, 0, sizeof(*this)); }
+};
+
+struct IMGUI_API ImDrawBatcher
+{
+    ImVector<ImDrawList*>   DrawLists;      // Owned draw lists, reused every frame
+    ImVector<ImDrawList*>   CmdLists;       // Output, pointed to by ImDrawData::CmdLists
+    ImDrawBatcherStats      Stats;          // Stats of the last Optimize()
+
+    ImDrawBatcher()         { }
+    ~ImDrawBatcher();
+    void                    Optimize(ImDrawData* draw_data, ImDrawBatcherFlags flags = ImDrawBatcherFlags_None);
+};
@@ -0,0 +1,315 @@
+#include "pch.h"
+#include "imgui_fuzzy_matcher.h"
+#include "imgui_internal.h"
+
+#include <chrono>       // steady_clock
+#if defined(IMGUI_ENABLE_SSE) && defined(_MSC_VER)
+#include <intrin.h>     // _BitScanForward
+#endif
+
+// Scoring, roughly following fzf
+static const int FUZZY_SCORE_MATCH = 16;
+static const int FUZZY_SCORE_GAP_START = -3;
+static const int FUZZY_SCORE_GAP_EXTENSION = -1;
+static const int FUZZY_BONUS_BOUNDARY = 8;              // Character after a separator, or first character of the item
+static const int FUZZY_BONUS_CAMEL = 7;                 // Lowercase to uppercase or letter to digit transition
+static const int FUZZY_BONUS_CONSECUTIVE = 4;
+static const int FUZZY_BONUS_FIRST_CHAR_MULTIPLIER = 2; // The bonus of the first character of the query counts twice
+static const int FUZZY_TEXT_PADDING = 16;               // Allows 16-byte loads at the end of any item
+static const int FUZZY_ITEMS_PER_TIME_CHECK = 256;
+
+static inline char ToLowerAscii(char c)         { return (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c; }
+static inline bool IsLowerAscii(char c)         { return c >= 'a' && c <= 'z'; }
+static inline bool IsUpperAscii(char c)         { return c >= 'A' && c <= 'Z'; }
+static inline bool IsDigitAscii(char c)         { return c >= '0' && c <= '9'; }
+static inline bool IsSeparator(char c)          { return c == ' ' || c == '\t' || c == '_' || c == '-' || c == '/' || c == '\\' || c == '.' || c == ',' || c == ':' || c == '(' || c == '['; }
+
+// One bit per letter and digit, other characters share the remaining bits
+static inline ImU64 GetCharMaskBit(char c)
+{
+    c = ToLowerAscii(c);
+    if (IsLowerAscii(c))
+        return (ImU64)1 << (c - 'a');
+    if (IsDigitAscii(c))
+        return (ImU64)1 << (26 + c - '0');
+    if ((unsigned char)c >= 0x80)
+        return (ImU64)1 << 63;
+    return (ImU64)1 << (36 + (unsigned char)c % 27);
+}
+
+#ifdef IMGUI_ENABLE_SSE
+static inline int CountTrailingZeros(unsigned int v)
+{
+#ifdef _MSC_VER
+    unsigned long n;
+    _BitScanForward(&n, v);
+    return (int)n;
+#else
+    return __builtin_ctz(v);
+#endif
+}
+#endif
+
+// Find the first occurrence of lowercase 'c' in [p, end), in both cases. Reads up to 15 bytes past 'end' (see FUZZY_TEXT_PADDING).
+static const char* FindCharPadded(const char* p, const char* end, char c)
+{
+    const char c_upper = IsLowerAscii(c) ? (char)(c - 'a' + 'A') : c;
+#ifdef IMGUI_ENABLE_SSE
+    const __m128i v_lower = _mm_set1_epi8(c);
+    const __m128i v_upper = _mm_set1_epi8(c_upper);
+    for (; p < end; p += 16)
+    {
+        const __m128i chunk = _mm_loadu_si128((const __m128i*)(const void*)p);
+        const unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, v_lower), _mm_cmpeq_epi8(chunk, v_upper)));
+        if (mask != 0)
+        {
+            const char* found = p + CountTrailingZeros(mask);
+            return found < end ? found : NULL;
+        }
+    }
+#else
+    for (; p < end; p++)
+        if (*p == c || *p == c_upper)
+            return p;
+#endif
+    return NULL;
+}
+
+static int GetCharBonus(const char* text, const char* c)
+{
+    if (c == text)
+        return FUZZY_BONUS_BOUNDARY;
+    const char prev = c[-1];
+    if (IsSeparator(prev))
+        return FUZZY_BONUS_BOUNDARY;
+    if ((IsLowerAscii(prev) && IsUpperAscii(*c)) || (!IsDigitAscii(prev) && IsDigitAscii(*c)))
+        return FUZZY_BONUS_CAMEL;
+    return 0;
+}
+
+// Match a lowercase query as a subsequence of [text, text_end)
+static bool MatchText(const char* query, int query_len, const char* text, const char* text_end, int* out_score)
+{
+    // End of the first occurrence
+    const char* p = FindCharPadded(text, text_end, query[0]);
+    if (p == NULL)
+        return false;
+    int query_n = 1;
+    for (p++; query_n < query_len && p < text_end; p++)
+        if (ToLowerAscii(*p) == query[query_n])
+            query_n++;
+    if (query_n < query_len)
+        return false;
+    const char* match_end = p;
+
+    // Walk back from the end for the latest start, which gives the shortest window
+    const char* match_start = match_end - 1;
+    for (query_n = query_len - 1; ; match_start--)
+        if (ToLowerAscii(*match_start) == query[query_n] && query_n-- == 0)
+            break;
+
+    // Score the window
+    int score = 0;
+    bool prev_matched = false;
+    bool in_gap = false;
+    query_n = 0;
+    for (const char* c = match_start; c < match_end; c++)
+    {
+        if (query_n < query_len && ToLowerAscii(*c) == query[query_n])
+        {
+            int bonus = GetCharBonus(text, c);
+            if (prev_matched)
+                bonus = ImMax(bonus, FUZZY_BONUS_CONSECUTIVE);
+            if (query_n == 0)
+                bonus *= FUZZY_BONUS_FIRST_CHAR_MULTIPLIER;
+            score += FUZZY_SCORE_MATCH + bonus;
+            prev_matched = true;
+            in_gap = false;
+            query_n++;
+        }
+        else
+        {
+            score += in_gap ? FUZZY_SCORE_GAP_EXTENSION : FUZZY_SCORE_GAP_START;
+            prev_matched = false;
+            in_gap = true;
+        }
+    }
+    *out_score = score;
+    return true;
+}
+
+static inline bool IsWorseMatch(const ImGuiFuzzyMatch& a, const ImGuiFuzzyMatch& b)
+{
+    if (a.Score != b.Score)
+        return a.Score < b.Score;
+    if (a.Length != b.Length)
+        return a.Length > b.Length;
+    return a.Index > b.Index;
+}
+
+static int IMGUI_CDECL FuzzyMatchComparer(const void* lhs, const void* rhs)
+{
+    const ImGuiFuzzyMatch& a = *(const ImGuiFuzzyMatch*)lhs;
+    const ImGuiFuzzyMatch& b = *(const ImGuiFuzzyMatch*)rhs;
+    return IsWorseMatch(b, a) ? -1 : IsWorseMatch(a, b) ? +1 : 0;
+}
+
+// Keep the best 'max_count' matches, the worst one being at the root
+static bool PushMatch(ImVector<ImGuiFuzzyMatch>& heap, int max_count, const ImGuiFuzzyMatch& match)
+{
+    int n;
+    if (heap.Size < max_count)
+    {
+        heap.push_back(match);
+        for (n = heap.Size - 1; n > 0 && IsWorseMatch(match, heap[(n - 1) / 2]); n = (n - 1) / 2)
+            heap[n] = heap[(n - 1) / 2];
+        heap[n] = match;
+        return true;
+    }
+    if (max_count <= 0 || !IsWorseMatch(heap[0], match))
+        return false;
+    for (n = 0; ; )
+    {
+        int child = n * 2 + 1;
+        if (child >= heap.Size)
+            break;
+        if (child + 1 < heap.Size && IsWorseMatch(heap[child + 1], heap[child]))
+            child++;
+        if (!IsWorseMatch(heap[child], match))
+            break;
+        heap[n] = heap[child];
+        n = child;
+    }
+    heap[n] = match;
+    return true;
+}
+
+ImGuiFuzzyMatcher::ImGuiFuzzyMatcher()
+{
+    MaxResults = 100;
+    ItemsData = NULL;
+    ItemsCount = -1;
+    Query[0] = 0;
+    QueryLen = 0;
+    QueryMask = 0;
+    QueryDone = true;
+    UseCandidates = false;
+    CandidatesNext = 0;
+}
+
+void ImGuiFuzzyMatcher::SetItems(bool (*items_getter)(void* data, int idx, const char** out_text), void* data, int items_count)
+{
+    if (ItemsData == data && ItemsCount == items_count)
+        return;
+    ItemsData = data;
+    ItemsCount = items_count;
+    Text.resize(0);
+    TextOffsets.resize(items_count + 1);
+    CharMasks.resize(items_count);
+    for (int i = 0; i < items_count; i++)
+    {
+        const char* item_text;
+        if (!items_getter(data, i, &item_text))
+            item_text = "";
+        const int offset = Text.Size;
+        const int len = (int)strlen(item_text);
+        Text.resize(offset + len + 1);
+        memcpy(Text.Data + offset, item_text, (size_t)len + 1);
+        ImU64 mask = 0;
+        for (int n = 0; n < len; n++)
+            mask |= GetCharMaskBit(item_text[n]);
+        TextOffsets[i] = offset;
+        CharMasks[i] = mask;
+    }
+    TextOffsets[items_count] = Text.Size;
+    Text.resize(Text.Size + FUZZY_TEXT_PADDING, 0);
+
+    // Evaluate the current query again
+    UseCandidates = false;
+    CandidatesNext = 0;
+    QueryDone = (QueryLen == 0);
+    Matched.resize(0);
+    Heap.resize(0);
+    Results.resize(0);
+}
+
+void ImGuiFuzzyMatcher::SetQuery(const char* query)
+{
+    char query_lower[IM_ARRAYSIZE(Query)];
+    int query_len = 0;
+    for (; query[query_len] != 0 && query_len < IM_ARRAYSIZE(query_lower) - 1; query_len++)
+        query_lower[query_len] = ToLowerAscii(query[query_len]);
+    query_lower[query_len] = 0;
+    if (query_len == QueryLen && memcmp(query_lower, Query, (size_t)query_len) == 0)
+        return;
+
+    // A match for the new query also matches the previous one when it is a prefix of it: only evaluate again the previous matches,
+    // plus the items that weren't evaluated yet.
+    if (QueryLen > 0 && query_len > QueryLen && memcmp(query_lower, Query, (size_t)QueryLen) == 0)
+    {
+        ImVector<int> candidates;
+        const int total = UseCandidates ? Candidates.Size : ItemsCount;
+        candidates.swap(Matched);
+        candidates.reserve(candidates.Size + ImMax(total - CandidatesNext, 0));
+        for (int n = CandidatesNext; n < total; n++)
+            candidates.push_back(UseCandidates ? Candidates.Data[n] : n);
+        Candidates.swap(candidates);
+        UseCandidates = true;
+    }
+    else
+    {
+        Candidates.resize(0);
+        UseCandidates = false;
+    }
+
+    memcpy(Query, query_lower, (size_t)query_len + 1);
+    QueryLen = query_len;
+    QueryMask = 0;
+    for (int n = 0; n < query_len; n++)
+        QueryMask |= GetCharMaskBit(query_lower[n]);
+    QueryDone = (query_len == 0);
+    CandidatesNext = 0;
+    Matched.resize(0);
+    Heap.resize(0);
+    Results.resize(0);
+}
+
+bool ImGuiFuzzyMatcher::Update(float time_budget_ms)
+{
+    if (QueryDone)
+        return true;
+    IM_ASSERT(ItemsCount >= 0 && "Call SetItems() first!");
+
+    const std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+    const int total = UseCandidates ? Candidates.Size : ItemsCount;
+    bool results_changed = false;
+    while (CandidatesNext < total)
+    {
+        const int chunk_end = ImMin(CandidatesNext + FUZZY_ITEMS_PER_TIME_CHECK, total);
+        for (; CandidatesNext < chunk_end; CandidatesNext++)
+        {
+            const int item_idx = UseCandidates ? Candidates.Data[CandidatesNext] : CandidatesNext;
+            if ((QueryMask & ~CharMasks.Data[item_idx]) != 0)
+                continue;
+            const char* text = Text.Data + TextOffsets.Data[item_idx];
+            const char* text_end = Text.Data + TextOffsets.Data[item_idx + 1] - 1;
+            ImGuiFuzzyMatch match;
+            if (!MatchText(Query, QueryLen, text, text_end, &match.Score))
+                continue;
+            match.Index = item_idx;
+            match.Length = (int)(text_end - text);
+            Matched.push_back(item_idx);
+            results_changed |= PushMatch(Heap, MaxResults, match);
+        }
+        if (std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start_time).count() >= time_budget_ms)
+            break;
+    }
+    QueryDone = (CandidatesNext >= total);
+
+    if (results_changed)
+    {
+        Results = Heap;
+        ImQsort(Results.Data, (size_t)Results.Size, sizeof(ImGuiFuzzyMatch), FuzzyMatchComparer);
+    }
+    return QueryDone;
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include "imgui.h"
+
+// Fuzzy matching engine, used by SearchableCombo() and InputTextWithAutoCompletion().
+// - A query matches an item when its characters appear in the item in the same order, ignoring case (e.g. "dfhs" matches "DFH Stadium").
+// - Matches are scored: characters starting a word (start of the item, after a separator or on a lowercase to uppercase transition) and
+//   consecutive characters get a bonus, gaps get a penalty. Ties go to the shortest item, then to the lowest index.
+// - Items which can't match are rejected from a mask of the characters they contain, then the first character of the query
+//   is searched 16 bytes at a time (SSE2, when available).
+// - Only the best MaxResults matches are kept, in a bounded min-heap.
+// - Update() evaluates items until its time budget runs out and resumes on the next call, so large item sets never stall a frame.
+//   When the new query extends the previous one, only the items matching the previous query are evaluated again.
+struct ImGuiFuzzyMatch
+{
+    int             Index;          // Item index
+    int             Score;
+    int             Length;         // Item length, to break ties
+};
+
+struct IMGUI_API ImGuiFuzzyMatcher
+{
+    int                         MaxResults;         // Number of best matches kept (default: 100)
+
+    // [Internal]
+    const void*                 ItemsData;          // Identity of the item set (data pointer and count)
+    int                         ItemsCount;
+    ImVector<char>              Text;               // Items, zero-terminated, back to back, padded for 16-byte loads
+    ImVector<int>               TextOffsets;        // Offset of each item in Text, plus the end
+    ImVector<ImU64>             CharMasks;          // Characters contained by each item
+    char                        Query[64];          // Lowercase query
+    int                         QueryLen;
+    ImU64                       QueryMask;
+    bool                        QueryDone;          // All candidates of the current query were evaluated
+    bool                        UseCandidates;      // Evaluate Candidates[] instead of all items
+    int                         CandidatesNext;     // Next item (or index in Candidates[]) to evaluate
+    ImVector<int>               Candidates;         // Items matching the previous query, when the current one extends it
+    ImVector<int>               Matched;            // Items matching the current query so far
+    ImVector<ImGuiFuzzyMatch>   Heap;               // Best matches so far, min-heap
+    ImVector<ImGuiFuzzyMatch>   Results;            // Heap sorted from the best match, refreshed by Update()
+
+    ImGuiFuzzyMatcher();
+    void            Invalidate()            { ItemsData = NULL; ItemsCount = -1; }      // Call if you modify the items in place
+    void            SetItems(bool (*items_getter)(void* data, int idx, const char** out_text), void* data, int items_count);  // Copy the items when the data pointer or count changed
+    void            SetQuery(const char* query);                                        // Restart the evaluation if the query changed
+    bool            Update(float time_budget_ms = 1.0f);                                // Evaluate items for up to 'time_budget_ms'. Returns true when all items were evaluated.
+    bool            IsDone() const          { return QueryDone; }
+    int             GetResultsCount() const { return Results.Size; }
+    const ImGuiFuzzyMatch& GetResult(int n) const { return Results[n]; }
+};
@@ -5,6 +5,8 @@
 // Implemented features:
 //  [X] Renderer: User texture binding. Use 'ID3D11ShaderResourceView*' as ImTextureID. Read the FAQ about ImTextureID!
 //  [X] Renderer: Support for large meshes (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Uploads ImFontAtlas::GetTexDirtyRects() (ImFontAtlasFlags_DynamicGlyphs).
+//  [X] Renderer: Optional draw call batching across draw lists (ImGui_ImplDX11_EnableDrawBatcher()).
 
 // You can copy and use unmodified imgui_impl_* files in your project. See main.cpp for an example of using this.
 // If you are new to dear imgui, read examples/README.txt and read the documentation at the top of imgui.cpp
@@ -28,6 +30,7 @@
 
 #include "imgui.h"
 #include "imgui_impl_dx11.h"
+#include "imgui_draw_batcher.h"
 
 // DirectX
 #include <stdio.h>
@@ -55,6 +58,8 @@ static ID3D11RasterizerState* g_pRasterizerState = NULL;
 static ID3D11BlendState* g_pBlendState = NULL;
 static ID3D11DepthStencilState* g_pDepthStencilState = NULL;
 static int                      g_VertexBufferSize = 5000, g_IndexBufferSize = 10000;
+static ImDrawBatcher*           g_pDrawBatcher = NULL;
+static ImDrawBatcherFlags       g_DrawBatcherFlags = ImDrawBatcherFlags_None;
 
 struct VERTEX_CONSTANT_BUFFER
 {
@@ -98,13 +103,41 @@ static void ImGui_ImplDX11_SetupRenderState(ImDrawData* draw_data, ID3D11DeviceC
 
 // Render function
 // (this used to be set in io.RenderDrawListsFn and called by ImGui::Render(), but you can now call this directly from your main loop)
+// Upload the parts of the font atlas modified after it was built (glyphs rasterized on demand with ImFontAtlasFlags_DynamicGlyphs)
+static void ImGui_ImplDX11_UpdateFontsTexture(ID3D11DeviceContext* ctx)
+{
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    ImVector<ImFontAtlasDirtyRect>* dirty_rects = atlas->GetTexDirtyRects();
+    if (dirty_rects == NULL || dirty_rects->empty() || !g_pFontTextureView)
+        return;
+
+    unsigned char* pixels;
+    int width, height;
+    atlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+    ID3D11Resource* pTexture = NULL;
+    g_pFontTextureView->GetResource(&pTexture);
+    for (int n = 0; n < dirty_rects->Size; n++)
+    {
+        const ImFontAtlasDirtyRect& r = (*dirty_rects)[n];
+        D3D11_BOX box = { r.X, r.Y, 0, (UINT)(r.X + r.Width), (UINT)(r.Y + r.Height), 1 };
+        ctx->UpdateSubresource(pTexture, 0, &box, pixels + ((size_t)r.Y * width + r.X) * 4, width * 4, 0);
+    }
+    pTexture->Release();
+    dirty_rects->clear();
+}
+
 void ImGui_ImplDX11_RenderDrawData(ImDrawData* draw_data)
 {
     // Avoid rendering when minimized
     if (draw_data->DisplaySize.x <= 0.0f || draw_data->DisplaySize.y <= 0.0f)
         return;
 
+    // Merge draw calls across draw lists, see ImGui_ImplDX11_EnableDrawBatcher()
+    if (g_pDrawBatcher)
+        g_pDrawBatcher->Optimize(draw_data, g_DrawBatcherFlags);
+
     ID3D11DeviceContext* ctx = g_pd3dDeviceContext;
+    ImGui_ImplDX11_UpdateFontsTexture(ctx);
 
     // Create and grow vertex/index buffers if needed
     if (!g_pVB || g_VertexBufferSize < draw_data->TotalVtxCount)
@@ -533,11 +566,24 @@ bool    ImGui_ImplDX11_Init(ID3D11Device* device, ID3D11DeviceContext* device_co
 void ImGui_ImplDX11_Shutdown()
 {
     ImGui_ImplDX11_InvalidateDeviceObjects();
+    ImGui_ImplDX11_EnableDrawBatcher(false);
     if (g_pFactory) { g_pFactory->Release(); g_pFactory = NULL; }
     if (g_pd3dDevice) { g_pd3dDevice->Release(); g_pd3dDevice = NULL; }
     if (g_pd3dDeviceContext) { g_pd3dDeviceContext->Release(); g_pd3dDeviceContext = NULL; }
 }
 
+void ImGui_ImplDX11_EnableDrawBatcher(bool enabled, int batcher_flags)
+{
+    if (enabled && !g_pDrawBatcher)
+        g_pDrawBatcher = IM_NEW(ImDrawBatcher)();
+    else if (!enabled && g_pDrawBatcher)
+    {
+        IM_DELETE(g_pDrawBatcher);
+        g_pDrawBatcher = NULL;
+    }
+    g_DrawBatcherFlags = batcher_flags;
+}
+
 void ImGui_ImplDX11_NewFrame()
 {
     if (!g_pFontSampler)
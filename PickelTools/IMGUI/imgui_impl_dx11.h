@@ -4,6 +4,7 @@
 // Implemented features:
 //  [X] Renderer: User texture binding. Use 'ID3D11ShaderResourceView*' as ImTextureID. Read the FAQ about ImTextureID!
 //  [X] Renderer: Support for large meshes (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Optional draw call batching across draw lists (ImGui_ImplDX11_EnableDrawBatcher()).
 
 // You can copy and use unmodified imgui_impl_* files in your project. See main.cpp for an example of using this.
 // If you are new to dear imgui, read examples/README.txt and read the documentation at the top of imgui.cpp.
@@ -19,6 +20,10 @@ IMGUI_IMPL_API void     ImGui_ImplDX11_Shutdown();
 IMGUI_IMPL_API void     ImGui_ImplDX11_NewFrame();
 IMGUI_IMPL_API void     ImGui_ImplDX11_RenderDrawData(ImDrawData* draw_data);
 
+// Merge draw calls across draw lists with ImDrawBatcher before rendering (disabled by default). 'batcher_flags' are ImDrawBatcherFlags_ values.
+// ImDrawData then points to draw lists owned by the back-end until the next frame. See imgui_draw_batcher.h.
+IMGUI_IMPL_API void     ImGui_ImplDX11_EnableDrawBatcher(bool enabled, int batcher_flags = 0);
+
 // Use if you want to reset your rendering device without losing ImGui state.
 IMGUI_IMPL_API void     ImGui_ImplDX11_InvalidateDeviceObjects();
 IMGUI_IMPL_API bool     ImGui_ImplDX11_CreateDeviceObjects();
\ No newline at end of file
@@ -0,0 +1,201 @@
+// dear imgui: Null Platform + Renderer Binding (headless: no window, no GPU)
+// Drives NewFrame()/Render() with synthetic input and consumes ImDrawData on the CPU, so UI code can be run and profiled on any platform.
+
+// Implemented features:
+//  [X] Platform: Synthetic mouse, keyboard and text input. Keyboard arrays are indexed using ImGuiKey_* values, e.g. ImGui_ImplNull_SetKey(ImGuiKey_Enter, true).
+//  [X] Platform: Fixed time step, or real elapsed time.
+//  [X] Renderer: Walks ImDrawData, runs ImDrawCmd user callbacks and counts draw lists, draw calls, vertices and indices.
+//  [X] Renderer: Support for large meshes (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Consumes ImFontAtlas::GetTexDirtyRects() (ImFontAtlasFlags_DynamicGlyphs).
+//  [X] Harness: ImGui_ImplNull_RunFrames() measures per-frame CPU time, geometry and allocation counts of a scene.
+
+#include "imgui.h"
+#include "imgui_impl_null.h"
+#ifdef IMGUI_ENABLE_FRAME_ALLOCATOR
+#include "imgui_allocator.h"
+#endif
+#include <stdlib.h>     // qsort
+#include <string.h>     // memset
+#include <chrono>       // steady_clock
+
+// Null Data
+typedef std::chrono::steady_clock ImplNullClock;
+static ImplNullClock::time_point    g_Time;
+static ImplNullClock::time_point    g_FrameStartTime;
+static ImGui_ImplNull_FrameStats    g_FrameStats;
+static ImVector<char>               g_InputCharacters;  // UTF-8, queued until the next NewFrame(): EndFrame() drops the characters of the current frame
+
+bool    ImGui_ImplNull_Init(float display_width, float display_height)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    io.BackendPlatformName = "imgui_impl_null";
+    io.BackendRendererName = "imgui_impl_null";
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
+    io.DisplaySize = ImVec2(display_width, display_height);
+    io.DisplayFramebufferScale = ImVec2(1.0f, 1.0f);
+    io.IniFilename = NULL;
+
+    // Keyboard mapping. ImGui will use those indices to peek into the io.KeysDown[] array.
+    for (int key = 0; key < ImGuiKey_COUNT; key++)
+        io.KeyMap[key] = key;
+
+    // Build the font atlas, there is no texture to upload it to
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height);
+    io.Fonts->TexID = (ImTextureID)(intptr_t)1;
+
+    g_Time = ImplNullClock::now();
+    memset(&g_FrameStats, 0, sizeof(g_FrameStats));
+    return true;
+}
+
+void    ImGui_ImplNull_Shutdown()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    io.Fonts->TexID = NULL;
+    io.BackendPlatformName = io.BackendRendererName = NULL;
+    g_InputCharacters.clear();
+}
+
+void    ImGui_ImplNull_NewFrame(float delta_time)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    IM_ASSERT(io.Fonts->IsBuilt() && "Font atlas not built! It is generally built by the renderer back-end. Missing call to renderer _NewFrame() function? e.g. ImGui_ImplNull_Init().");
+
+    // Setup time step
+    const ImplNullClock::time_point current_time = ImplNullClock::now();
+    const float elapsed = std::chrono::duration<float>(current_time - g_Time).count();
+    io.DeltaTime = (delta_time > 0.0f) ? delta_time : (elapsed > 0.0f ? elapsed : 1e-6f);
+    g_Time = current_time;
+    g_FrameStartTime = current_time;
+
+    if (g_InputCharacters.Size > 0)
+    {
+        g_InputCharacters.push_back(0);
+        io.AddInputCharactersUTF8(g_InputCharacters.Data);
+        g_InputCharacters.resize(0);
+    }
+}
+
+void    ImGui_ImplNull_RenderDrawData(ImDrawData* draw_data)
+{
+    ImGui_ImplNull_FrameStats& stats = g_FrameStats;
+    stats.DrawLists = draw_data->CmdListsCount;
+    stats.DrawCmds = stats.Callbacks = 0;
+    stats.VtxCount = draw_data->TotalVtxCount;
+    stats.IdxCount = draw_data->TotalIdxCount;
+
+    // A GPU renderer would copy these rectangles of the alpha8/RGBA32 pixels into its texture
+    ImVector<ImFontAtlasDirtyRect>* dirty_rects = ImGui::GetIO().Fonts->GetTexDirtyRects();
+    stats.TexUploads = dirty_rects ? dirty_rects->Size : 0;
+    if (dirty_rects)
+        dirty_rects->clear();
+
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+        {
+            const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+            if (pcmd->UserCallback != NULL)
+            {
+                // User callback, registered via ImDrawList::AddCallback()
+                // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
+                if (pcmd->UserCallback != ImDrawCallback_ResetRenderState)
+                    pcmd->UserCallback(cmd_list, pcmd);
+                stats.Callbacks++;
+            }
+            else
+            {
+                // Validate the command the same way a GPU renderer would read it
+                IM_ASSERT(pcmd->IdxOffset + pcmd->ElemCount <= (unsigned int)cmd_list->IdxBuffer.Size);
+                IM_ASSERT(pcmd->ElemCount == 0 || pcmd->VtxOffset < (unsigned int)cmd_list->VtxBuffer.Size);
+                stats.DrawCmds++;
+            }
+        }
+    }
+
+#ifdef IMGUI_ENABLE_FRAME_ALLOCATOR
+    stats.AllocCount = ImGui::IsFrameAllocatorInstalled() ? ImGui::GetFrameAllocatorStats(true).AllocCount : -1;
+#else
+    stats.AllocCount = -1;
+#endif
+    stats.CpuTimeMs = std::chrono::duration<double, std::milli>(ImplNullClock::now() - g_FrameStartTime).count();
+}
+
+const ImGui_ImplNull_FrameStats& ImGui_ImplNull_GetFrameStats()
+{
+    return g_FrameStats;
+}
+
+void    ImGui_ImplNull_SetMousePos(float x, float y)
+{
+    ImGui::GetIO().MousePos = ImVec2(x, y);
+}
+
+void    ImGui_ImplNull_SetMouseButton(int button, bool down)
+{
+    IM_ASSERT(button >= 0 && button < IM_ARRAYSIZE(ImGui::GetIO().MouseDown));
+    ImGui::GetIO().MouseDown[button] = down;
+}
+
+void    ImGui_ImplNull_AddMouseWheel(float wheel_y)
+{
+    ImGui::GetIO().MouseWheel += wheel_y;
+}
+
+void    ImGui_ImplNull_SetKey(int imgui_key, bool down)
+{
+    IM_ASSERT(imgui_key >= 0 && imgui_key < ImGuiKey_COUNT);
+    ImGui::GetIO().KeysDown[imgui_key] = down;
+}
+
+void    ImGui_ImplNull_AddInputCharacters(const char* utf8_chars)
+{
+    const int len = (int)strlen(utf8_chars);
+    g_InputCharacters.resize(g_InputCharacters.Size + len);
+    memcpy(g_InputCharacters.Data + g_InputCharacters.Size - len, utf8_chars, (size_t)len);
+}
+
+static int CompareDoubles(const void* lhs, const void* rhs)
+{
+    const double a = *(const double*)lhs;
+    const double b = *(const double*)rhs;
+    return (a < b) ? -1 : (a > b) ? 1 : 0;
+}
+
+void    ImGui_ImplNull_RunFrames(void (*scene)(int frame, void* user_data), void* user_data, int warmup_frames, int frames, ImGui_ImplNull_RunStats* out_stats)
+{
+    IM_ASSERT(scene != NULL && frames > 0 && out_stats != NULL);
+    ImVector<double> times;
+    times.reserve(frames);
+    out_stats->AllocCountMax = 0;
+    for (int frame = 0; frame < warmup_frames + frames; frame++)
+    {
+        ImGui_ImplNull_NewFrame();
+        ImGui::NewFrame();
+        scene(frame, user_data);
+        ImGui::Render();
+        ImGui_ImplNull_RenderDrawData(ImGui::GetDrawData());
+        if (frame < warmup_frames)
+            continue;
+
+        times.push_back(g_FrameStats.CpuTimeMs);
+        if (g_FrameStats.AllocCount < 0 || out_stats->AllocCountMax < 0)
+            out_stats->AllocCountMax = -1;
+        else
+            out_stats->AllocCountMax = (g_FrameStats.AllocCount > out_stats->AllocCountMax) ? g_FrameStats.AllocCount : out_stats->AllocCountMax;
+    }
+
+    double total = 0.0;
+    for (int n = 0; n < times.Size; n++)
+        total += times[n];
+    qsort(times.Data, (size_t)times.Size, sizeof(double), CompareDoubles);
+    out_stats->Frames = frames;
+    out_stats->CpuTimeMsMin = times[0];
+    out_stats->CpuTimeMsMedian = times[times.Size / 2];
+    out_stats->CpuTimeMsAvg = total / times.Size;
+    out_stats->CpuTimeMsMax = times.back();
+    out_stats->LastFrame = g_FrameStats;
+}
@@ -0,0 +1,54 @@
+// dear imgui: Null Platform + Renderer Binding (headless: no window, no GPU)
+// Drives NewFrame()/Render() with synthetic input and consumes ImDrawData on the CPU, so UI code can be run and profiled on any platform.
+
+// Implemented features:
+//  [X] Platform: Synthetic mouse, keyboard and text input. Keyboard arrays are indexed using ImGuiKey_* values, e.g. ImGui_ImplNull_SetKey(ImGuiKey_Enter, true).
+//  [X] Platform: Fixed time step, or real elapsed time.
+//  [X] Renderer: Walks ImDrawData, runs ImDrawCmd user callbacks and counts draw lists, draw calls, vertices and indices.
+//  [X] Renderer: Support for large meshes (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Consumes ImFontAtlas::GetTexDirtyRects() (ImFontAtlasFlags_DynamicGlyphs).
+//  [X] Harness: ImGui_ImplNull_RunFrames() measures per-frame CPU time, geometry and allocation counts of a scene.
+
+#pragma once
+
+struct ImDrawData;
+
+struct ImGui_ImplNull_FrameStats
+{
+    double      CpuTimeMs;          // Time from ImGui_ImplNull_NewFrame() to the end of ImGui_ImplNull_RenderDrawData()
+    int         DrawLists;
+    int         DrawCmds;           // Draw calls, not counting user callbacks
+    int         Callbacks;
+    int         VtxCount;
+    int         IdxCount;
+    int         TexUploads;         // Font atlas rectangles uploaded (ImFontAtlas::GetTexDirtyRects(), e.g. glyphs rasterized on demand)
+    int         AllocCount;         // ImGui allocations from NewFrame() to the end of RenderDrawData(). Requires IMGUI_ENABLE_FRAME_ALLOCATOR and an installed frame allocator, -1 otherwise.
+};
+
+struct ImGui_ImplNull_RunStats
+{
+    int         Frames;
+    double      CpuTimeMsMin;
+    double      CpuTimeMsMedian;
+    double      CpuTimeMsAvg;
+    double      CpuTimeMsMax;
+    int         AllocCountMax;      // Highest AllocCount of the measured frames (0 means steady state frames don't allocate), -1 if unknown
+    ImGui_ImplNull_FrameStats LastFrame;
+};
+
+IMGUI_IMPL_API bool     ImGui_ImplNull_Init(float display_width = 1280.0f, float display_height = 720.0f);
+IMGUI_IMPL_API void     ImGui_ImplNull_Shutdown();
+IMGUI_IMPL_API void     ImGui_ImplNull_NewFrame(float delta_time = 1.0f / 60.0f);  // Call before ImGui::NewFrame(). Pass delta_time <= 0.0f to use real elapsed time.
+IMGUI_IMPL_API void     ImGui_ImplNull_RenderDrawData(ImDrawData* draw_data);
+IMGUI_IMPL_API const ImGui_ImplNull_FrameStats& ImGui_ImplNull_GetFrameStats();     // Stats of the last rendered frame
+
+// Synthetic input, read by the next ImGui::NewFrame()
+IMGUI_IMPL_API void     ImGui_ImplNull_SetMousePos(float x, float y);
+IMGUI_IMPL_API void     ImGui_ImplNull_SetMouseButton(int button, bool down);
+IMGUI_IMPL_API void     ImGui_ImplNull_AddMouseWheel(float wheel_y);
+IMGUI_IMPL_API void     ImGui_ImplNull_SetKey(int imgui_key, bool down);
+IMGUI_IMPL_API void     ImGui_ImplNull_AddInputCharacters(const char* utf8_chars);
+
+// Harness: run 'warmup_frames' untimed frames then 'frames' measured frames of 'scene', which is called between ImGui::NewFrame() and ImGui::Render().
+// The scene may feed synthetic input for the next frame. Call after ImGui_ImplNull_Init().
+IMGUI_IMPL_API void     ImGui_ImplNull_RunFrames(void (*scene)(int frame, void* user_data), void* user_data, int warmup_frames, int frames, ImGui_ImplNull_RunStats* out_stats);
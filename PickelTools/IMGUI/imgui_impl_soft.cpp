@@ -0,0 +1,465 @@
+// dear imgui: Software Renderer Binding (CPU rasterizer, no GPU)
+// Rasterizes ImDrawData into a 32-bit framebuffer, e.g. for golden image tests or to benchmark draw list changes without a GPU.
+// Use together with a platform binding, or with imgui_impl_null for headless runs.
+
+// Implemented features:
+//  [X] Renderer: User texture binding. Use 'ImGui_ImplSoft_Texture*' as ImTextureID. Read the FAQ about ImTextureID!
+//  [X] Renderer: Support for large meshes (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Triangles are binned into 64x64 tiles, which are rasterized in parallel (ImParallelFor()), with SSE2 edge functions when available.
+//  [X] Renderer: Consumes ImFontAtlas::GetTexDirtyRects() (ImFontAtlasFlags_DynamicGlyphs).
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "imgui_impl_soft.h"
+#include <math.h>       // floor, ceil
+
+static const int SOFT_TILE_SHIFT = 6;
+static const int SOFT_TILE_SIZE = 1 << SOFT_TILE_SHIFT;
+
+// Triangle set up for rasterization
+struct ImplSoftTriangle
+{
+    int         MinX, MinY, MaxX, MaxY;         // Pixel bounds, clipped by the scissor rectangle and the framebuffer (max exclusive)
+    double      EdgeA[3], EdgeB[3], EdgeC[3];   // Edge functions E(x, y) = A*x + B*y + C, positive inside
+    bool        EdgeTopLeft[3];                 // Pixel centers exactly on a top or left edge are inside
+    ImVec2      Origin;                         // Position of the first vertex, which the attribute planes are relative to
+    float       Attr[6], AttrDx[6], AttrDy[6];  // U, V, R, G, B, A (0..255) planes
+    bool        FlatColor;                      // All vertices have the same color
+    bool        FlatTexel;                      // All vertices have the same UV (e.g. ImFontAtlas::TexUvWhitePixel): sampled once in Texel
+    ImU32       Color;
+    ImU32       Texel;
+    ImU32       FlatSource;                     // Color modulated by Texel, when both FlatColor and FlatTexel
+    const ImGui_ImplSoft_Texture* Texture;
+};
+
+struct ImplSoftBinRef
+{
+    int         Tile;
+    int         Triangle;
+};
+
+struct ImplSoftRenderJob
+{
+    ImU32*      Pixels;
+    int         Width;
+    int         Height;
+    int         TilesX;
+};
+
+// Software Renderer Data
+static int                              g_ThreadsCount = 1;
+static ImGui_ImplSoft_Texture           g_FontTexture;
+static ImVector<ImplSoftTriangle>       g_Triangles;
+static ImVector<ImplSoftBinRef>         g_BinRefs;          // (tile, triangle) pairs in submission order
+static ImVector<int>                    g_BinOffsets;       // Offset of the first triangle of each tile in g_BinTriangles, followed by the total count
+static ImVector<int>                    g_BinTriangles;     // Triangles of each tile, in submission order
+
+static inline int   Div255(int x)              { x += 128; return (x + (x >> 8)) >> 8; }  // x / 255 rounded to nearest, for x in [0, 65025]
+static inline int   ClampUnorm8(float v)        { return (v <= 0.0f) ? 0 : (v >= 255.0f) ? 255 : (int)(v + 0.5f); }
+
+static ImU32 ImGui_ImplSoft_SampleTexture(const ImGui_ImplSoft_Texture* tex, float u, float v)
+{
+    if (tex == NULL || tex->Pixels == NULL)
+        return IM_COL32_WHITE;
+    const int x = ImClamp((int)(u * tex->Width), 0, tex->Width - 1);
+    const int y = ImClamp((int)(v * tex->Height), 0, tex->Height - 1);
+    if (tex->BytesPerPixel == 1)
+        return IM_COL32(255, 255, 255, ((const unsigned char*)tex->Pixels)[y * tex->Width + x]);
+    return ((const ImU32*)tex->Pixels)[y * tex->Width + x];
+}
+
+// Modulate the texel by the vertex color
+static inline ImU32 ImGui_ImplSoft_Modulate(int r, int g, int b, int a, ImU32 texel)
+{
+    return IM_COL32(Div255(r * (int)((texel >> IM_COL32_R_SHIFT) & 0xFF)), Div255(g * (int)((texel >> IM_COL32_G_SHIFT) & 0xFF)),
+                    Div255(b * (int)((texel >> IM_COL32_B_SHIFT) & 0xFF)), Div255(a * (int)((texel >> IM_COL32_A_SHIFT) & 0xFF)));
+}
+
+// Blend over the destination: color with SRC_ALPHA/ONE_MINUS_SRC_ALPHA, alpha with ONE/ONE_MINUS_SRC_ALPHA
+static inline void ImGui_ImplSoft_BlendPixel(ImU32* dst, ImU32 src)
+{
+    const int a = (int)((src >> IM_COL32_A_SHIFT) & 0xFF);
+    if (a == 0)
+        return;
+    if (a == 255)
+    {
+        *dst = src;
+        return;
+    }
+    const ImU32 d = *dst;
+    const int inv_a = 255 - a;
+    *dst = IM_COL32(Div255((int)((src >> IM_COL32_R_SHIFT) & 0xFF) * a + (int)((d >> IM_COL32_R_SHIFT) & 0xFF) * inv_a),
+                    Div255((int)((src >> IM_COL32_G_SHIFT) & 0xFF) * a + (int)((d >> IM_COL32_G_SHIFT) & 0xFF) * inv_a),
+                    Div255((int)((src >> IM_COL32_B_SHIFT) & 0xFF) * a + (int)((d >> IM_COL32_B_SHIFT) & 0xFF) * inv_a),
+                    Div255(255 * a + (int)((d >> IM_COL32_A_SHIFT) & 0xFF) * inv_a));
+}
+
+#ifdef IMGUI_ENABLE_SSE
+// Same as ImGui_ImplSoft_BlendPixel() for 4 pixels and a single source color. 'src_mul' holds the source channels multiplied by their
+// blend factor (r*a, g*a, b*a, 255*a) for 2 pixels, 'inv_a' holds 255-a. Pixels outside of 'mask' are written back unchanged.
+static inline void ImGui_ImplSoft_BlendFlat4(ImU32* dst, __m128i src_mul, __m128i inv_a, __m128i mask)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bias = _mm_set1_epi16(128);
+    const __m128i d = _mm_loadu_si128((const __m128i*)dst);
+    __m128i lo = _mm_add_epi16(_mm_add_epi16(src_mul, _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), inv_a)), bias);
+    __m128i hi = _mm_add_epi16(_mm_add_epi16(src_mul, _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), inv_a)), bias);
+    lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+    hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+    const __m128i blended = _mm_packus_epi16(lo, hi);
+    _mm_storeu_si128((__m128i*)dst, _mm_or_si128(_mm_and_si128(mask, blended), _mm_andnot_si128(mask, d)));
+}
+#endif
+
+static bool ImGui_ImplSoft_SetupTriangle(ImplSoftTriangle* tri, const ImVec2 pos[3], const ImDrawVert* vtx[3], const ImGui_ImplSoft_Texture* tex, const int clip[4])
+{
+    const double area = (double)(pos[1].x - pos[0].x) * (pos[2].y - pos[0].y) - (double)(pos[2].x - pos[0].x) * (pos[1].y - pos[0].y);
+    if (area == 0.0 || area != area)
+        return false;
+
+    tri->MinX = ImMax(clip[0], (int)floor(ImMin(pos[0].x, ImMin(pos[1].x, pos[2].x))));
+    tri->MinY = ImMax(clip[1], (int)floor(ImMin(pos[0].y, ImMin(pos[1].y, pos[2].y))));
+    tri->MaxX = ImMin(clip[2], (int)ceil(ImMax(pos[0].x, ImMax(pos[1].x, pos[2].x))));
+    tri->MaxY = ImMin(clip[3], (int)ceil(ImMax(pos[0].y, ImMax(pos[1].y, pos[2].y))));
+    if (tri->MinX >= tri->MaxX || tri->MinY >= tri->MaxY)
+        return false;
+
+    // Edge i is opposite to vertex i. A shared edge gets exactly opposite coefficients in both triangles, so the top-left rule is watertight.
+    const double sign = (area > 0.0) ? 1.0 : -1.0;
+    for (int i = 0; i < 3; i++)
+    {
+        const ImVec2& a = pos[(i + 1) % 3];
+        const ImVec2& b = pos[(i + 2) % 3];
+        tri->EdgeA[i] = sign * ((double)a.y - b.y);
+        tri->EdgeB[i] = sign * ((double)b.x - a.x);
+        tri->EdgeC[i] = sign * ((double)a.x * b.y - (double)a.y * b.x);
+        tri->EdgeTopLeft[i] = tri->EdgeA[i] > 0.0 || (tri->EdgeA[i] == 0.0 && tri->EdgeB[i] > 0.0);
+    }
+
+    // Attribute planes, relative to the first vertex
+    float attr[3][6];
+    for (int n = 0; n < 3; n++)
+    {
+        const ImU32 col = vtx[n]->col;
+        attr[n][0] = vtx[n]->uv.x;
+        attr[n][1] = vtx[n]->uv.y;
+        attr[n][2] = (float)((col >> IM_COL32_R_SHIFT) & 0xFF);
+        attr[n][3] = (float)((col >> IM_COL32_G_SHIFT) & 0xFF);
+        attr[n][4] = (float)((col >> IM_COL32_B_SHIFT) & 0xFF);
+        attr[n][5] = (float)((col >> IM_COL32_A_SHIFT) & 0xFF);
+    }
+    const float dx1 = pos[1].x - pos[0].x, dy1 = pos[1].y - pos[0].y;
+    const float dx2 = pos[2].x - pos[0].x, dy2 = pos[2].y - pos[0].y;
+    const float inv_area = (float)(1.0 / area);
+    for (int k = 0; k < 6; k++)
+    {
+        const float da1 = attr[1][k] - attr[0][k];
+        const float da2 = attr[2][k] - attr[0][k];
+        tri->Attr[k] = attr[0][k];
+        tri->AttrDx[k] = (da1 * dy2 - da2 * dy1) * inv_area;
+        tri->AttrDy[k] = (da2 * dx1 - da1 * dx2) * inv_area;
+    }
+    tri->Origin = pos[0];
+    tri->FlatColor = (vtx[0]->col == vtx[1]->col && vtx[0]->col == vtx[2]->col);
+    tri->FlatTexel = (vtx[0]->uv.x == vtx[1]->uv.x && vtx[0]->uv.x == vtx[2]->uv.x && vtx[0]->uv.y == vtx[1]->uv.y && vtx[0]->uv.y == vtx[2]->uv.y);
+    tri->Color = vtx[0]->col;
+    tri->Texel = tri->FlatTexel ? ImGui_ImplSoft_SampleTexture(tex, vtx[0]->uv.x, vtx[0]->uv.y) : 0;
+    tri->FlatSource = ImGui_ImplSoft_Modulate((tri->Color >> IM_COL32_R_SHIFT) & 0xFF, (tri->Color >> IM_COL32_G_SHIFT) & 0xFF, (tri->Color >> IM_COL32_B_SHIFT) & 0xFF, (tri->Color >> IM_COL32_A_SHIFT) & 0xFF, tri->Texel);
+    tri->Texture = tex;
+    return true;
+}
+
+// Conservative test: false if all the pixel centers of the tile are outside of one edge
+static bool ImGui_ImplSoft_TriangleOverlapsTile(const ImplSoftTriangle& tri, int tile_x, int tile_y)
+{
+    const double x0 = tile_x * SOFT_TILE_SIZE + 0.5, x1 = x0 + SOFT_TILE_SIZE - 1;
+    const double y0 = tile_y * SOFT_TILE_SIZE + 0.5, y1 = y0 + SOFT_TILE_SIZE - 1;
+    for (int i = 0; i < 3; i++)
+        if (tri.EdgeA[i] * (tri.EdgeA[i] > 0.0 ? x1 : x0) + tri.EdgeB[i] * (tri.EdgeB[i] > 0.0 ? y1 : y0) + tri.EdgeC[i] < 0.0)
+            return false;
+    return true;
+}
+
+static void ImGui_ImplSoft_ShadeSpan(const ImplSoftTriangle& tri, ImU32* dst, int x, unsigned int mask, const float row_attr[6])
+{
+    for (int k = 0; k < 4; k++)
+    {
+        if (!(mask & (1 << k)))
+            continue;
+        if (tri.FlatColor && tri.FlatTexel)
+        {
+            ImGui_ImplSoft_BlendPixel(dst + k, tri.FlatSource);
+            continue;
+        }
+        const float dx = (float)(x + k);
+        ImU32 texel = tri.Texel;
+        if (!tri.FlatTexel)
+            texel = ImGui_ImplSoft_SampleTexture(tri.Texture, row_attr[0] + tri.AttrDx[0] * dx, row_attr[1] + tri.AttrDx[1] * dx);
+        if (tri.FlatColor)
+            ImGui_ImplSoft_BlendPixel(dst + k, ImGui_ImplSoft_Modulate((tri.Color >> IM_COL32_R_SHIFT) & 0xFF, (tri.Color >> IM_COL32_G_SHIFT) & 0xFF, (tri.Color >> IM_COL32_B_SHIFT) & 0xFF, (tri.Color >> IM_COL32_A_SHIFT) & 0xFF, texel));
+        else
+            ImGui_ImplSoft_BlendPixel(dst + k, ImGui_ImplSoft_Modulate(ClampUnorm8(row_attr[2] + tri.AttrDx[2] * dx), ClampUnorm8(row_attr[3] + tri.AttrDx[3] * dx), ClampUnorm8(row_attr[4] + tri.AttrDx[4] * dx), ClampUnorm8(row_attr[5] + tri.AttrDx[5] * dx), texel));
+    }
+}
+
+// Coverage of the 4 pixels of a row starting at x, where edge i is A*(x+0.5) + row_c[i].
+// Edge values are computed in double at the first pixel, then stepped in float the same way with or without SSE.
+static inline unsigned int ImGui_ImplSoft_CoverageMask(const ImplSoftTriangle& tri, int x, const double row_c[3])
+{
+#ifdef IMGUI_ENABLE_SSE
+    const __m128 lane_offsets = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+    const __m128 zero = _mm_setzero_ps();
+    __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    for (int i = 0; i < 3; i++)
+    {
+        const __m128 edge = _mm_add_ps(_mm_set1_ps((float)(tri.EdgeA[i] * (x + 0.5) + row_c[i])), _mm_mul_ps(_mm_set1_ps((float)tri.EdgeA[i]), lane_offsets));
+        const __m128 top_left = _mm_castsi128_ps(_mm_set1_epi32(tri.EdgeTopLeft[i] ? -1 : 0));
+        inside = _mm_and_ps(inside, _mm_or_ps(_mm_cmpgt_ps(edge, zero), _mm_and_ps(_mm_cmpeq_ps(edge, zero), top_left)));
+    }
+    return (unsigned int)_mm_movemask_ps(inside);
+#else
+    float group_edge[3], step[3];
+    for (int i = 0; i < 3; i++)
+    {
+        group_edge[i] = (float)(tri.EdgeA[i] * (x + 0.5) + row_c[i]);
+        step[i] = (float)tri.EdgeA[i];
+    }
+    unsigned int mask = 0;
+    for (int k = 0; k < 4; k++)
+    {
+        bool inside = true;
+        for (int i = 0; i < 3; i++)
+        {
+            const float edge = group_edge[i] + step[i] * (float)k;
+            inside &= edge > 0.0f || (edge == 0.0f && tri.EdgeTopLeft[i]);
+        }
+        mask |= inside ? (1u << k) : 0u;
+    }
+    return mask;
+#endif
+}
+
+// Rasterize the part of a triangle inside [x0,x1)*[y0,y1), 4 pixels at a time. Each row is first narrowed to a conservative span.
+static void ImGui_ImplSoft_RasterizeTriangle(const ImplSoftTriangle& tri, ImU32* pixels, int width, int x0, int y0, int x1, int y1)
+{
+#ifdef IMGUI_ENABLE_SSE
+    const bool flat = tri.FlatColor && tri.FlatTexel;
+    const int flat_a = (int)((tri.FlatSource >> IM_COL32_A_SHIFT) & 0xFF);
+    const __m128i lane_bits = _mm_setr_epi32(1, 2, 4, 8);
+    const __m128i flat_src = _mm_unpacklo_epi8(_mm_set1_epi32((int)(tri.FlatSource | (0xFFu << IM_COL32_A_SHIFT))), _mm_setzero_si128());
+    const __m128i flat_src_mul = _mm_mullo_epi16(flat_src, _mm_set1_epi16((short)flat_a));
+    const __m128i flat_inv_a = _mm_set1_epi16((short)(255 - flat_a));
+#endif
+
+    for (int y = y0; y < y1; y++)
+    {
+        // Narrow the row to the pixels whose center may be inside. Pixel x is on the edge when A*(x+0.5) + B*(y+0.5) + C == 0.
+        // Pixels in [inner_x0, inner_x1) are at least 2 pixels away from every edge, so they pass the tests below whatever the rounding.
+        const double py = y + 0.5;
+        double row_c[3];
+        int span_x0 = x0, span_x1 = x1;
+        int inner_x0 = x0, inner_x1 = x1;
+        for (int i = 0; i < 3 && span_x0 < span_x1; i++)
+        {
+            row_c[i] = tri.EdgeB[i] * py + tri.EdgeC[i];
+            if (tri.EdgeA[i] == 0.0)
+            {
+                if (row_c[i] < 0.0 || (row_c[i] == 0.0 && !tri.EdgeTopLeft[i]))
+                    span_x0 = span_x1;
+                continue;
+            }
+            const double cross_x = -row_c[i] / tri.EdgeA[i] - 0.5;
+            if (cross_x < x0 - 1 || cross_x > x1 + 1)
+            {
+                if ((tri.EdgeA[i] > 0.0) == (cross_x > x1 + 1))
+                    span_x0 = span_x1;
+                continue;
+            }
+            if (tri.EdgeA[i] > 0.0)
+            {
+                span_x0 = ImMax(span_x0, (int)floor(cross_x));
+                inner_x0 = ImMax(inner_x0, (int)floor(cross_x) + 3);
+            }
+            else
+            {
+                span_x1 = ImMin(span_x1, (int)floor(cross_x) + 2);
+                inner_x1 = ImMin(inner_x1, (int)floor(cross_x) - 1);
+            }
+        }
+        if (span_x0 >= span_x1)
+            continue;
+
+        // Attributes at pixel x0 + dx are row_attr + AttrDx * dx
+        const float px = x0 + 0.5f;
+        float row_attr[6];
+        for (int k = 0; k < 6; k++)
+            row_attr[k] = tri.Attr[k] + tri.AttrDx[k] * (px - tri.Origin.x) + tri.AttrDy[k] * ((float)py - tri.Origin.y);
+
+        ImU32* dst = pixels + y * width + x0;
+        for (int x = span_x0; x < span_x1; x += 4)
+        {
+            unsigned int mask = (x >= inner_x0 && x + 4 <= inner_x1) ? 0x0F : ImGui_ImplSoft_CoverageMask(tri, x, row_c);
+            if (x + 4 > span_x1)
+                mask &= (1u << (span_x1 - x)) - 1;
+#ifdef IMGUI_ENABLE_SSE
+            // Single color: blend 4 pixels at once, unless the group crosses the tile (another thread owns those pixels)
+            if (flat && mask != 0 && flat_a != 0 && x + 4 <= x1)
+            {
+                ImU32* group_dst = dst + (x - x0);
+                if (mask == 0x0F && flat_a == 255)
+                    _mm_storeu_si128((__m128i*)group_dst, _mm_set1_epi32((int)tri.FlatSource));
+                else
+                    ImGui_ImplSoft_BlendFlat4(group_dst, flat_src_mul, flat_inv_a, _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32((int)mask), lane_bits), lane_bits));
+                continue;
+            }
+#endif
+            if (mask != 0)
+                ImGui_ImplSoft_ShadeSpan(tri, dst + (x - x0), x - x0, mask, row_attr);
+        }
+    }
+}
+
+static void ImGui_ImplSoft_RenderTile(int tile, void* user_data)
+{
+    const ImplSoftRenderJob* job = (const ImplSoftRenderJob*)user_data;
+    const int tile_x0 = (tile % job->TilesX) * SOFT_TILE_SIZE;
+    const int tile_y0 = (tile / job->TilesX) * SOFT_TILE_SIZE;
+    const int tile_x1 = ImMin(tile_x0 + SOFT_TILE_SIZE, job->Width);
+    const int tile_y1 = ImMin(tile_y0 + SOFT_TILE_SIZE, job->Height);
+    for (int n = g_BinOffsets[tile]; n < g_BinOffsets[tile + 1]; n++)
+    {
+        const ImplSoftTriangle& tri = g_Triangles[g_BinTriangles[n]];
+        const int x0 = ImMax(tri.MinX, tile_x0), y0 = ImMax(tri.MinY, tile_y0);
+        const int x1 = ImMin(tri.MaxX, tile_x1), y1 = ImMin(tri.MaxY, tile_y1);
+        ImGui_ImplSoft_RasterizeTriangle(tri, job->Pixels, job->Width, x0, y0, x1, y1);
+    }
+}
+
+bool    ImGui_ImplSoft_Init(int threads_count)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    io.BackendRendererName = "imgui_impl_soft";
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
+
+    g_ThreadsCount = (threads_count > 0) ? threads_count : ImGetHardwareThreadsCount();
+    ImGui_ImplSoft_NewFrame();
+    return true;
+}
+
+void    ImGui_ImplSoft_Shutdown()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    io.Fonts->TexID = NULL;
+    io.BackendRendererName = NULL;
+    g_Triangles.clear();
+    g_BinRefs.clear();
+    g_BinOffsets.clear();
+    g_BinTriangles.clear();
+}
+
+void    ImGui_ImplSoft_NewFrame()
+{
+    // The atlas is sampled in place: (re)build it if needed and point the font texture to its current pixels
+    ImGuiIO& io = ImGui::GetIO();
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height);
+    g_FontTexture.Pixels = pixels;
+    g_FontTexture.Width = width;
+    g_FontTexture.Height = height;
+    g_FontTexture.BytesPerPixel = 1;
+    io.Fonts->TexID = (ImTextureID)&g_FontTexture;
+}
+
+void    ImGui_ImplSoft_RenderDrawData(ImDrawData* draw_data, unsigned int* pixels, int width, int height)
+{
+    // Glyphs rasterized on demand are already in the pixels we sample
+    if (ImVector<ImFontAtlasDirtyRect>* dirty_rects = ImGui::GetIO().Fonts->GetTexDirtyRects())
+        dirty_rects->clear();
+    if (width <= 0 || height <= 0)
+        return;
+
+    // Set up and bin the triangles of all commands, in submission order
+    const int tiles_x = (width + SOFT_TILE_SIZE - 1) >> SOFT_TILE_SHIFT;
+    const int tiles_y = (height + SOFT_TILE_SIZE - 1) >> SOFT_TILE_SHIFT;
+    const ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
+    const ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
+    g_Triangles.resize(0);
+    g_BinRefs.resize(0);
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+        {
+            const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+            if (pcmd->UserCallback != NULL)
+            {
+                // User callback, registered via ImDrawList::AddCallback()
+                // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
+                if (pcmd->UserCallback != ImDrawCallback_ResetRenderState)
+                    pcmd->UserCallback(cmd_list, pcmd);
+                continue;
+            }
+
+            // Same integer scissor rectangle as the GPU back-ends
+            const int clip[4] =
+            {
+                ImMax(0, (int)((pcmd->ClipRect.x - clip_off.x) * clip_scale.x)),
+                ImMax(0, (int)((pcmd->ClipRect.y - clip_off.y) * clip_scale.y)),
+                ImMin(width, (int)((pcmd->ClipRect.z - clip_off.x) * clip_scale.x)),
+                ImMin(height, (int)((pcmd->ClipRect.w - clip_off.y) * clip_scale.y))
+            };
+            if (clip[0] >= clip[2] || clip[1] >= clip[3])
+                continue;
+
+            const ImGui_ImplSoft_Texture* tex = (const ImGui_ImplSoft_Texture*)pcmd->TextureId;
+            const ImDrawIdx* idx = cmd_list->IdxBuffer.Data + pcmd->IdxOffset;
+            const ImDrawVert* vtx_base = cmd_list->VtxBuffer.Data + pcmd->VtxOffset;
+            for (unsigned int elem = 0; elem + 3 <= pcmd->ElemCount; elem += 3)
+            {
+                const ImDrawVert* vtx[3] = { vtx_base + idx[elem], vtx_base + idx[elem + 1], vtx_base + idx[elem + 2] };
+                ImVec2 pos[3];
+                for (int k = 0; k < 3; k++)
+                    pos[k] = ImVec2((vtx[k]->pos.x - clip_off.x) * clip_scale.x, (vtx[k]->pos.y - clip_off.y) * clip_scale.y);
+
+                g_Triangles.resize(g_Triangles.Size + 1);
+                ImplSoftTriangle& tri = g_Triangles.back();
+                if (!ImGui_ImplSoft_SetupTriangle(&tri, pos, vtx, tex, clip))
+                {
+                    g_Triangles.pop_back();
+                    continue;
+                }
+                for (int tile_y = tri.MinY >> SOFT_TILE_SHIFT; tile_y <= (tri.MaxY - 1) >> SOFT_TILE_SHIFT; tile_y++)
+                    for (int tile_x = tri.MinX >> SOFT_TILE_SHIFT; tile_x <= (tri.MaxX - 1) >> SOFT_TILE_SHIFT; tile_x++)
+                        if (ImGui_ImplSoft_TriangleOverlapsTile(tri, tile_x, tile_y))
+                        {
+                            ImplSoftBinRef ref = { tile_y * tiles_x + tile_x, g_Triangles.Size - 1 };
+                            g_BinRefs.push_back(ref);
+                        }
+            }
+        }
+    }
+
+    // Counting sort of the references by tile, keeping the submission order within each tile
+    const int tiles_count = tiles_x * tiles_y;
+    g_BinOffsets.resize(tiles_count + 1);
+    memset(g_BinOffsets.Data, 0, (size_t)g_BinOffsets.size_in_bytes());
+    for (int n = 0; n < g_BinRefs.Size; n++)
+        g_BinOffsets[g_BinRefs[n].Tile + 1]++;
+    for (int tile = 0; tile < tiles_count; tile++)
+        g_BinOffsets[tile + 1] += g_BinOffsets[tile];
+    g_BinTriangles.resize(g_BinRefs.Size);
+    for (int n = 0; n < g_BinRefs.Size; n++)
+        g_BinTriangles[g_BinOffsets[g_BinRefs[n].Tile]++] = g_BinRefs[n].Triangle;
+    for (int tile = tiles_count; tile > 0; tile--)
+        g_BinOffsets[tile] = g_BinOffsets[tile - 1];
+    g_BinOffsets[0] = 0;
+
+    // Tiles don't overlap, so they can be rasterized in any order and from any thread
+    ImplSoftRenderJob job;
+    job.Pixels = pixels;
+    job.Width = width;
+    job.Height = height;
+    job.TilesX = tiles_x;
+    ImParallelFor(tiles_count, ImGui_ImplSoft_RenderTile, &job, g_ThreadsCount);
+}
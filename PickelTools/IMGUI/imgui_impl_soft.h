@@ -0,0 +1,33 @@
+// dear imgui: Software Renderer Binding (CPU rasterizer, no GPU)
+// Rasterizes ImDrawData into a 32-bit framebuffer, e.g. for golden image tests or to benchmark draw list changes without a GPU.
+// Use together with a platform binding, or with imgui_impl_null for headless runs.
+
+// Implemented features:
+//  [X] Renderer: User texture binding. Use 'ImGui_ImplSoft_Texture*' as ImTextureID. Read the FAQ about ImTextureID!
+//  [X] Renderer: Support for large meshes (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Triangles are binned into 64x64 tiles, which are rasterized in parallel (ImParallelFor()), with SSE2 edge functions when available.
+//  [X] Renderer: Consumes ImFontAtlas::GetTexDirtyRects() (ImFontAtlasFlags_DynamicGlyphs).
+// Notes:
+//  - Output pixels use the IM_COL32() layout (R in the low byte), which is RGBA in memory on little-endian targets.
+//  - Color is blended with SRC_ALPHA/ONE_MINUS_SRC_ALPHA, alpha with ONE/ONE_MINUS_SRC_ALPHA. Textures are point sampled.
+//  - Pixel centers are at +0.5 and triangle edges follow the top-left rule, so shared edges are never drawn twice.
+//    The output is deterministic: it doesn't depend on the number of threads or on SSE being enabled.
+//  - ImDrawCmd user callbacks are called from ImGui_ImplSoft_RenderDrawData() in order, but before any pixel is drawn.
+
+#pragma once
+
+struct ImDrawData;
+
+// Texture sampled by the rasterizer. Pixels are read in place and must stay valid until ImGui_ImplSoft_RenderDrawData() returns.
+struct ImGui_ImplSoft_Texture
+{
+    const void*     Pixels;
+    int             Width;
+    int             Height;
+    int             BytesPerPixel;  // 1: alpha8, sampled as white with alpha. 4: IM_COL32() layout.
+};
+
+IMGUI_IMPL_API bool     ImGui_ImplSoft_Init(int threads_count = 0);     // 0: use all hardware threads
+IMGUI_IMPL_API void     ImGui_ImplSoft_Shutdown();
+IMGUI_IMPL_API void     ImGui_ImplSoft_NewFrame();
+IMGUI_IMPL_API void     ImGui_ImplSoft_RenderDrawData(ImDrawData* draw_data, unsigned int* pixels, int width, int height); // Blends over the existing content of 'pixels' (width * height, no padding)
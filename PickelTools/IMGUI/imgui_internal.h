@@ -37,6 +37,15 @@ Index of this file:
 #include <math.h>       // sqrtf, fabsf, fmodf, powf, floorf, ceilf, cosf, sinf
 #include <limits.h>     // INT_MIN, INT_MAX
 
+// Enable SSE2 intrinsics if available (always the case on x64). AVX2 is only used when the compiler targets it (e.g. /arch:AVX2 or -mavx2).
+#if (defined __SSE2__ || defined __x86_64__ || defined _M_X64 || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))) && !defined(IMGUI_DISABLE_SSE)
+#define IMGUI_ENABLE_SSE
+#include <immintrin.h>
+#if defined(__AVX2__) && !defined(IMGUI_DISABLE_AVX2)
+#define IMGUI_ENABLE_AVX2
+#endif
+#endif
+
 // Visual Studio warnings
 #ifdef _MSC_VER
 #pragma warning (push)
@@ -77,6 +86,7 @@ struct ImBoolVector;                // Store 1-bit per value
 struct ImRect;                      // An axis-aligned rectangle (2 points)
 struct ImDrawDataBuilder;           // Helper to build a ImDrawData instance
 struct ImDrawListSharedData;        // Data shared between all ImDrawList instances
+struct ImFontAtlasDynamicData;      // State kept after Build() by ImFontAtlasFlags_DynamicGlyphs
 struct ImGuiColorMod;               // Stacked color modifier, backup of modified data so we can restore it
 struct ImGuiColumnData;             // Storage data for a single column
 struct ImGuiColumns;                // Storage data for a columns set
@@ -91,7 +101,11 @@ struct ImGuiNextWindowData;         // Storage for SetNextWindow** functions
 struct ImGuiNextItemData;           // Storage for SetNextItem** functions
 struct ImGuiPopupData;              // Storage for current popup stack
 struct ImGuiSettingsHandler;        // Storage for one type registered in the .ini file
+struct ImGuiSettingsBinaryHandler;  // Binary .ini support of a settings handler (ImGuiIniSavingOptions::Binary)
+struct ImGuiSettingsStorage;        // .ini settings state of a context, kept out of ImGuiContext
+struct ImGuiSettingsWriter;         // Background writer for the .ini file (ImGuiIniSavingOptions::Async)
 struct ImGuiStyleMod;               // Stacked style modifier, backup of modified data so we can restore it
+struct ImGuiRetainedContent;        // Storage for a retained content region (BeginRetainedContent()/EndRetainedContent())
 struct ImGuiTabBar;                 // Storage for a tab bar
 struct ImGuiTabItem;                // Storage for a tab item (within a tab bar)
 struct ImGuiWindow;                 // Storage for one window
@@ -204,6 +218,7 @@ extern IMGUI_API ImGuiContext* GImGui;  // Current implicit context pointer
 // - Helpers: ImVec2/ImVec4 operators
 // - Helpers: Maths
 // - Helpers: Geometry
+// - Helpers: Threading
 // - Helper: ImBoolVector
 // - Helper: ImPool<>
 // - Helper: ImChunkStream<>
@@ -292,6 +307,17 @@ IMGUI_API ImU64             ImFileWrite(const void* data, ImU64 size, ImU64 coun
 #define IMGUI_DISABLE_TTY_FUNCTIONS // Can't use stdout, fflush if we are not using default file functions
 #endif
 IMGUI_API void*             ImFileLoadToMemory(const char* filename, const char* mode, size_t* out_file_size = NULL, int padding_bytes = 0);
+IMGUI_API bool              ImFileWriteAtomic(const char* filename, const char* temp_filename, const void* data, size_t data_size);  // Write to 'temp_filename' then rename it over 'filename'. Doesn't use the context nor allocate: can be called from any thread.
+struct ImFileMapping { const void* Data; size_t Size; bool Mapped; ImFileMapping() { Data = NULL; Size = 0; Mapped = false; } };
+IMGUI_API bool              ImFileMap(const char* filename, ImFileMapping* out_mapping);    // Map a whole file read-only (or load it with ImFileLoadToMemory() when mapping isn't available). Fails on empty files.
+IMGUI_API void              ImFileUnmap(ImFileMapping* mapping);
+
+// Helpers: Threading
+// - ImParallelFor() calls func(index, user_data) for every index in [0, count) from up to 'threads_count' threads, the calling thread included, and returns when all calls are done.
+//   Indices are handed out dynamically. It runs a plain loop on the calling thread when threads_count <= 1 or IMGUI_DISABLE_THREADS is defined.
+// - func may not use the ImGui context nor call ImGui::MemAlloc(), which updates metrics non-atomically.
+IMGUI_API int               ImGetHardwareThreadsCount();
+IMGUI_API void              ImParallelFor(int count, void (*func)(int index, void* user_data), void* user_data, int threads_count);
 
 // Helpers: Maths
 // - Wrapper for standard libs functions. (Note that imgui_demo.cpp does _not_ use them to keep the code easy to copy)
@@ -805,6 +831,47 @@ struct ImGuiSettingsHandler
     ImGuiSettingsHandler() { memset(this, 0, sizeof(*this)); }
 };
 
+// Binary .ini support of the settings handler of the same TypeHash, see ImGui::AddSettingsBinaryHandler().
+// Not a member of ImGuiSettingsHandler, whose layout is shared with the host application. Handlers without it are saved as text.
+struct ImGuiSettingsBinaryHandler
+{
+    ImGuiID     TypeHash;       // == ImGuiSettingsHandler::TypeHash
+    void        (*ReadBinaryFn)(ImGuiContext* ctx, ImGuiSettingsHandler* handler, const char* data, int data_size); // Read: Called with the section written by WriteBinaryFn
+    void        (*WriteBinaryFn)(ImGuiContext* ctx, ImGuiSettingsHandler* handler, ImVector<char>* out_buf);    // Write: Output every entries into 'out_buf' with ImGuiIniSavingOptions::Binary
+
+    ImGuiSettingsBinaryHandler() { memset(this, 0, sizeof(*this)); }
+};
+
+// [Window] record written by the last save, with the values it was formatted from
+struct ImGuiWindowSettingsIniRecord
+{
+    ImGuiID     ID;
+    ImVec2ih    Pos;
+    ImVec2ih    Size;
+    bool        Collapsed;
+    int         IniOffset;      // In ImGuiSettingsStorage::WindowsIniCache
+    int         IniSize;
+};
+
+// .ini settings state of one context.
+// Not a member of ImGuiContext: the context may be owned by another copy of Dear ImGui (e.g. a plugin host), so its layout can't change.
+// imgui.cpp keeps one per context in a side table. The other copy may add or clear window settings too, so WindowsMap is validated on use.
+struct ImGuiSettingsStorage
+{
+    ImGuiContext*                           Context;
+    ImGuiIniSavingOptions                   Options;                // SetIniSavingOptions()
+    ImVector<ImGuiSettingsBinaryHandler>    BinaryHandlers;
+    ImVector<char>                          IniBinaryData;          // In memory .ini settings, binary format
+    ImGuiStorage                            WindowsMap;             // Map ImGuiWindowSettings::ID to their offset in ImGuiContext::SettingsWindows
+    int                                     WindowsMapBufSize;      // Size of ImGuiContext::SettingsWindows indexed by WindowsMap
+    ImVector<ImGuiWindowSettingsIniRecord>  WindowsIniRecords;      // One per ImGuiContext::SettingsWindows entry, in order, as of the last save
+    ImGuiTextBuffer                         WindowsIniCache;        // [Window] records of the last save, copied instead of formatted again when the window didn't change
+    ImGuiID                                 LastSavedHash;          // Hash of the last file written by SaveIniSettingsToDisk(), identical saves are skipped
+    ImGuiSettingsWriter*                    Writer;                 // Background .ini writer, created by the first asynchronous save
+
+    ImGuiSettingsStorage() { Context = NULL; WindowsMapBufSize = 0; LastSavedHash = 0; Writer = NULL; }
+};
+
 // Storage for current popup stack
 struct ImGuiPopupData
 {
@@ -868,6 +935,14 @@ struct ImGuiColumns
 #define IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX                     512
 #define IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_CALC(_RAD,_MAXERROR)    ImClamp((int)((IM_PI * 2.0f) / ImAcos((_RAD - _MAXERROR) / _RAD)), IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MIN, IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX)
 
+// Size of the unit circle lookup table used by PathArcTo()/AddCircle() etc. Arcs with a radius small enough to need no more
+// than this many segments per full turn are emitted by scaling and translating table entries instead of calling ImCos()/ImSin().
+// The table is a static of imgui_draw.cpp rather than a member of ImDrawListSharedData, which belongs to the context and keeps the stock layout.
+#ifndef IM_DRAWLIST_ARCFAST_TABLE_SIZE
+#define IM_DRAWLIST_ARCFAST_TABLE_SIZE                          48
+#endif
+#define IM_DRAWLIST_ARCFAST_SAMPLE_MAX                          IM_DRAWLIST_ARCFAST_TABLE_SIZE  // Sample index for a full turn (2*PI)
+
 // Data shared between all ImDrawList instances
 // You may want to create your own instance of this if you want to use ImDrawList completely without ImGui. In that case, watch out for future changes to this structure.
 struct IMGUI_API ImDrawListSharedData
@@ -1611,6 +1686,77 @@ struct ImGuiTabBar
     }
 };
 
+// One draw command recorded by a retained content region
+struct ImGuiRetainedDrawCmd
+{
+    ImVec4              ClipRect;
+    ImTextureID         TextureId;
+    ImDrawCallback      UserCallback;           // Callbacks are re-added as is when replaying
+    void*               UserCallbackData;
+    int                 IdxOffset;              // Start offset in ImGuiRetainedContent::IdxBuffer
+    int                 IdxCount;
+    int                 VtxOffset;              // Start offset in ImGuiRetainedContent::VtxBuffer, indices are relative to it
+    int                 VtxCount;
+};
+
+// Storage for a retained content region (see BeginRetainedContent())
+// Vertices are recorded in absolute coordinates: a recording is only reused while the region starts at the same position with the same clipping.
+struct ImGuiRetainedContent
+{
+    ImGuiID             ID;
+    ImGuiID             ContentKey;             // User provided hash of everything the content depends on. 0 = never reuse.
+    int                 LastFrameActive;        // Last frame the content was recorded or replayed
+    ImGuiWindow*        Window;
+    bool                Recording;              // Set between BeginRetainedContent() and EndRetainedContent() when the draw list output is being captured
+    bool                Replaying;              // Set between BeginRetainedContent() and EndRetainedContent() when the previous recording is reused
+
+    // State at BeginRetainedContent(), must be identical for the recording to be reused
+    ImVec2              StartCursorPos;
+    ImVec4              StartClipRect;
+    ImTextureID         StartTextureId;
+    ImFont*             StartFont;
+    float               StartFontSize;
+    float               StartAlpha;
+
+    // Layout state at EndRetainedContent(), restored when replaying
+    ImVec2              EndCursorPos;
+    ImVec2              EndCursorPosPrevLine;
+    ImVec2              EndCursorMaxPos;        // Extent of the region alone
+    ImVec2              EndCurrLineSize;
+    ImVec2              EndPrevLineSize;
+    float               EndCurrLineTextBaseOffset;
+    float               EndPrevLineTextBaseOffset;
+
+    // Recorded output
+    ImVector<ImGuiRetainedDrawCmd>  CmdBuffer;
+    ImVector<ImDrawIdx>             IdxBuffer;
+    ImVector<ImDrawVert>            VtxBuffer;
+
+    // Draw list and layout state while recording
+    int                 RecordCmdStart;
+    int                 RecordIdxStart;
+    ImVec2              BackupCursorMaxPos;
+
+    ImGuiRetainedContent() { ID = ContentKey = 0; LastFrameActive = -1; Window = NULL; Recording = Replaying = false; StartTextureId = NULL; StartFont = NULL; StartFontSize = StartAlpha = 0.0f; EndCurrLineTextBaseOffset = EndPrevLineTextBaseOffset = 0.0f; RecordCmdStart = RecordIdxStart = 0; }
+};
+
+// Retained content regions of one context.
+// Not a member of ImGuiContext: the context may be owned by another copy of Dear ImGui (e.g. a plugin host), so its layout can't change.
+// ImGui.cpp keeps one per context in a side table. Regions unused for IMGUI_RETAINED_CONTENT_GC_FRAMES frames are released.
+#ifndef IMGUI_RETAINED_CONTENT_GC_FRAMES
+#define IMGUI_RETAINED_CONTENT_GC_FRAMES    120
+#endif
+struct ImGuiRetainedContentStorage
+{
+    ImGuiContext*                   Context;
+    ImGuiRetainedContent*           Current;        // Set between BeginRetainedContent() and EndRetainedContent()
+    ImPool<ImGuiRetainedContent>    Contents;
+    int                             ContentsCount;  // Live entries of Contents
+    int                             LastGcFrame;
+
+    ImGuiRetainedContentStorage() { Context = NULL; Current = NULL; ContentsCount = 0; LastGcFrame = -1; }
+};
+
 //-----------------------------------------------------------------------------
 // Internal API
 // No guarantee of forward compatibility here.
@@ -1665,6 +1811,8 @@ namespace ImGui
     IMGUI_API ImGuiWindowSettings*  FindWindowSettings(ImGuiID id);
     IMGUI_API ImGuiWindowSettings*  FindOrCreateWindowSettings(const char* name);
     IMGUI_API ImGuiSettingsHandler* FindSettingsHandler(const char* type_name);
+    IMGUI_API ImGuiSettingsStorage* FindSettingsStorage(ImGuiContext* ctx);                     // NULL until a settings function created it
+    IMGUI_API void                  AddSettingsBinaryHandler(const ImGuiSettingsBinaryHandler& handler);
 
     // Scrolling
     IMGUI_API void          SetScrollX(ImGuiWindow* window, float new_scroll_x);
@@ -1764,6 +1912,10 @@ namespace ImGui
     IMGUI_API float         GetColumnOffsetFromNorm(const ImGuiColumns* columns, float offset_norm);
     IMGUI_API float         GetColumnNormFromOffset(const ImGuiColumns* columns, float offset);
 
+    // Retained Content
+    IMGUI_API ImGuiRetainedContentStorage* FindRetainedContentStorage(ImGuiContext* ctx);  // NULL if the context never used BeginRetainedContent()
+    IMGUI_API void          GcRetainedContents(ImGuiRetainedContentStorage* storage);     // Release the regions unused for IMGUI_RETAINED_CONTENT_GC_FRAMES frames. Called once per frame by BeginRetainedContent().
+
     // Tab Bars
     IMGUI_API bool          BeginTabBarEx(ImGuiTabBar* tab_bar, const ImRect& bb, ImGuiTabBarFlags flags);
     IMGUI_API ImGuiTabItem* TabBarFindTabByID(ImGuiTabBar* tab_bar, ImGuiID tab_id);
@@ -1867,13 +2019,16 @@ namespace ImGui
 } // namespace ImGui
 
 // ImFontAtlas internals
-IMGUI_API bool              ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas);
+IMGUI_API bool              ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas, int threads_count = 1);
 IMGUI_API void              ImFontAtlasBuildRegisterDefaultCustomRects(ImFontAtlas* atlas);
 IMGUI_API void              ImFontAtlasBuildSetupFont(ImFontAtlas* atlas, ImFont* font, ImFontConfig* font_config, float ascent, float descent);
 IMGUI_API void              ImFontAtlasBuildPackCustomRects(ImFontAtlas* atlas, void* stbrp_context_opaque);
 IMGUI_API void              ImFontAtlasBuildFinish(ImFontAtlas* atlas);
 IMGUI_API void              ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_multiply_factor);
 IMGUI_API void              ImFontAtlasBuildMultiplyRectAlpha8(const unsigned char table[256], unsigned char* pixels, int x, int y, int w, int h, int stride);
+IMGUI_API void              ImFontAtlasBuildRequestGlyph(ImFontAtlas* atlas, const ImFont* font, ImWchar codepoint);
+IMGUI_API ImFontAtlasDynamicData* ImFontAtlasBuildFindDynamicData(const ImFontAtlas* atlas);
+IMGUI_API void              ImFontAtlasBuildDestroyDynamicData(ImFontAtlas* atlas);
 
 // Debug Tools
 // Use 'Metrics->Tools->Item Picker' to break into the call-stack of a specific item.
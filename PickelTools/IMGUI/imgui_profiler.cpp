@@ -0,0 +1,540 @@
+#include "pch.h"
+#include "imgui_profiler.h"
+#include "imgui_internal.h"
+#include "imgui_timeline.h"
+
+#include <stdio.h>          // snprintf
+#include <algorithm>        // sort
+#include <atomic>           // atomic<>
+#include <chrono>           // steady_clock
+#include <mutex>            // mutex, lock_guard
+#include <vector>           // vector<>
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>         // __rdtsc
+#define IMGUI_PROFILER_RDTSC
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>      // __rdtsc
+#define IMGUI_PROFILER_RDTSC
+#endif
+
+// The capture uses the C++ heap, never ImGui::MemAlloc(): zones may be recorded by threads which don't have an ImGui context, and the
+// state outlives the contexts. Only the views (ImGuiTimeline) use ImGui allocations, they are released by ProfilerShutdown().
+static const unsigned int   PROFILER_RING_SIZE = 1 << 16;                   // Zones a thread can record between two ProfilerNewFrame()
+static const int            PROFILER_FRAME_TIMES_COUNT = 300;              // Frames in the frame times plot
+
+struct ImProfilerRecord
+{
+    ImU64                       Start;
+    ImU64                       End;
+    const char*                 Name;
+    int                         Depth;
+};
+
+// Written by its thread, read by the thread calling ProfilerNewFrame(). Created by the first zone the thread records during a capture:
+// threads which never record one don't pay for the ring.
+struct ImProfilerThreadBuffer
+{
+    std::atomic<unsigned int>   Write;              // Records [Read, Write) are ready, indices wrap around
+    std::atomic<unsigned int>   Read;
+    std::atomic<int>            Dropped;            // Records dropped because the ring was full
+    int                         Index;
+    int                         Depth;              // Only used by the owning thread
+    char                        Name[32];           // Protected by ImProfilerState::ThreadsMutex
+    bool                        Named;              // Set by ProfilerSetThreadName()
+    ImProfilerRecord            Records[PROFILER_RING_SIZE];
+
+    ImProfilerThreadBuffer(int index) : Write(0), Read(0), Dropped(0) { Index = index; Depth = 0; Named = false; snprintf(Name, sizeof(Name), "Thread %d", index); }
+};
+
+struct ImProfilerZoneTotal
+{
+    const char*                 Name;
+    int                         Count;
+    double                      TotalMs;
+};
+
+struct ImProfilerState
+{
+    std::mutex                              ThreadsMutex;       // Threads registration and names
+    std::vector<ImProfilerThreadBuffer*>    Threads;
+    std::atomic<bool>                       Capturing;
+    int                                     LastFrameCount;     // ImGui frame for which the last frame was marked
+    int                                     MaxZones;
+    int                                     DroppedZones;
+    ImU64                                   CaptureStartTicks;
+    std::chrono::steady_clock::time_point   CaptureStartTime;
+    double                                  TicksPerMs;
+    ImU64                                   FrameStart;         // Ticks of the frame in progress, 0 before the first frame of the capture
+    int                                     FrameZonesStart;
+    std::vector<ImProfilerZone>             Zones;
+    std::vector<ImProfilerFrame>            Frames;
+
+    // Views
+    ImGuiTimeline*                          Timeline;
+    bool                                    TimelineDirty;
+    int                                     SelectedFrame;
+    std::vector<ImProfilerZoneTotal>        SelectedFrameTotals;
+    char                                    ExportPath[256];
+    int                                     ExportResult;       // 0: none, 1: success, -1: failure
+
+    ImProfilerState() : Capturing(false)
+    {
+        LastFrameCount = -1; MaxZones = 0; DroppedZones = 0; CaptureStartTicks = 0; TicksPerMs = 0.0; FrameStart = 0; FrameZonesStart = 0;
+        Timeline = NULL; TimelineDirty = false; SelectedFrame = -1; ExportResult = 0;
+        ImStrncpy(ExportPath, "imgui_trace.json", IM_ARRAYSIZE(ExportPath));
+#ifndef IMGUI_PROFILER_RDTSC
+        TicksPerMs = 1000000.0;
+#endif
+    }
+    ~ImProfilerState()
+    {
+        for (size_t n = 0; n < Threads.size(); n++)
+            delete Threads[n];
+    }
+};
+
+static thread_local ImProfilerThreadBuffer* GProfilerThreadBuffer = NULL;
+static thread_local char                    GProfilerThreadName[32] = "";  // Set by ProfilerSetThreadName(), copied to the buffer when it's created
+
+static ImProfilerState& GetProfilerState()
+{
+    static ImProfilerState state;
+    return state;
+}
+
+static inline ImU64 ProfilerGetTicks()
+{
+#ifdef IMGUI_PROFILER_RDTSC
+    return (ImU64)__rdtsc();
+#else
+    return (ImU64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+static ImProfilerThreadBuffer* GetThreadBuffer(ImProfilerState& s)
+{
+    if (GProfilerThreadBuffer == NULL)
+    {
+        std::lock_guard<std::mutex> lock(s.ThreadsMutex);
+        GProfilerThreadBuffer = new ImProfilerThreadBuffer((int)s.Threads.size());
+        if (GProfilerThreadName[0] != 0)
+        {
+            ImStrncpy(GProfilerThreadBuffer->Name, GProfilerThreadName, IM_ARRAYSIZE(GProfilerThreadBuffer->Name));
+            GProfilerThreadBuffer->Named = true;
+        }
+        s.Threads.push_back(GProfilerThreadBuffer);
+    }
+    return GProfilerThreadBuffer;
+}
+
+// Ticks per millisecond, measured against steady_clock over the capture so far
+static void CalibrateTicks(ImProfilerState& s, ImU64 ticks)
+{
+#ifdef IMGUI_PROFILER_RDTSC
+    const double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - s.CaptureStartTime).count();
+    if (elapsed_ms >= 1.0 && ticks > s.CaptureStartTicks)
+        s.TicksPerMs = (double)(ticks - s.CaptureStartTicks) / elapsed_ms;
+#else
+    IM_UNUSED(s);
+    IM_UNUSED(ticks);
+#endif
+}
+
+// Move the records of all the threads to the capture
+static void CollectZones(ImProfilerState& s)
+{
+    std::lock_guard<std::mutex> lock(s.ThreadsMutex);
+    for (size_t thread_n = 0; thread_n < s.Threads.size(); thread_n++)
+    {
+        ImProfilerThreadBuffer* buf = s.Threads[thread_n];
+        const unsigned int write = buf->Write.load(std::memory_order_acquire);
+        unsigned int read = buf->Read.load(std::memory_order_relaxed);
+        s.DroppedZones += buf->Dropped.exchange(0, std::memory_order_relaxed);
+        for (; read != write && s.Capturing.load(std::memory_order_relaxed); read++)
+        {
+            if ((int)s.Zones.size() >= s.MaxZones)
+            {
+                s.Capturing.store(false, std::memory_order_relaxed);
+                break;
+            }
+            const ImProfilerRecord& rec = buf->Records[read & (PROFILER_RING_SIZE - 1)];
+            ImProfilerZone zone;
+            zone.Start = ImMax(rec.Start, s.CaptureStartTicks);
+            zone.End = ImMax(rec.End, zone.Start);
+            zone.Name = rec.Name;
+            zone.ThreadIndex = buf->Index;
+            zone.Depth = rec.Depth;
+            s.Zones.push_back(zone);
+        }
+        s.DroppedZones += (int)(write - read);
+        buf->Read.store(write, std::memory_order_release);
+    }
+}
+
+ImU64 ImGui::ProfilerZoneBegin()
+{
+    ImProfilerState& s = GetProfilerState();
+    if (!s.Capturing.load(std::memory_order_relaxed))
+        return 0;
+    GetThreadBuffer(s)->Depth++;
+    return ProfilerGetTicks();
+}
+
+void ImGui::ProfilerZoneEnd(const char* name, ImU64 start)
+{
+    const ImU64 end = ProfilerGetTicks();
+    ImProfilerThreadBuffer* buf = GProfilerThreadBuffer;
+    buf->Depth--;
+    const unsigned int write = buf->Write.load(std::memory_order_relaxed);
+    if (write - buf->Read.load(std::memory_order_acquire) >= PROFILER_RING_SIZE)
+    {
+        buf->Dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    ImProfilerRecord& rec = buf->Records[write & (PROFILER_RING_SIZE - 1)];
+    rec.Start = start;
+    rec.End = end;
+    rec.Name = name;
+    rec.Depth = buf->Depth;
+    buf->Write.store(write + 1, std::memory_order_release);
+}
+
+void ImGui::ProfilerNewFrame()
+{
+    ImGuiContext* ctx = GImGui;
+    if (ctx == NULL)
+        return;
+    ImProfilerState& s = GetProfilerState();
+    if (s.LastFrameCount == ctx->FrameCount)
+        return;
+    s.LastFrameCount = ctx->FrameCount;
+    if (!s.Capturing.load(std::memory_order_relaxed))
+        return;
+
+    const ImU64 now = ProfilerGetTicks();
+    CalibrateTicks(s, now);
+    if (GProfilerThreadName[0] == 0)
+        ProfilerSetThreadName("ImGui thread");
+    if (s.FrameStart != 0)
+    {
+        CollectZones(s);
+        ImProfilerFrame frame;
+        frame.Start = s.FrameStart;
+        frame.End = now;
+        frame.ZonesStart = s.FrameZonesStart;
+        frame.ZonesEnd = (int)s.Zones.size();
+        s.Frames.push_back(frame);
+        if (!s.Capturing.load(std::memory_order_relaxed))
+            s.TimelineDirty = true;     // The capture is full
+    }
+    s.FrameStart = now;
+    s.FrameZonesStart = (int)s.Zones.size();
+}
+
+void ImGui::ProfilerStartCapture(int max_zones)
+{
+    ImProfilerState& s = GetProfilerState();
+    s.Capturing.store(false, std::memory_order_relaxed);
+    {
+        // Discard the records of the previous capture
+        std::lock_guard<std::mutex> lock(s.ThreadsMutex);
+        for (size_t thread_n = 0; thread_n < s.Threads.size(); thread_n++)
+        {
+            ImProfilerThreadBuffer* buf = s.Threads[thread_n];
+            buf->Read.store(buf->Write.load(std::memory_order_acquire), std::memory_order_release);
+            buf->Dropped.store(0, std::memory_order_relaxed);
+        }
+    }
+    s.Zones.clear();
+    s.Frames.clear();
+    s.MaxZones = max_zones;
+    s.DroppedZones = 0;
+    s.FrameStart = 0;
+    s.FrameZonesStart = 0;
+    s.SelectedFrame = -1;
+    s.SelectedFrameTotals.clear();
+    if (s.Timeline)
+        s.Timeline->Clear();
+    s.TimelineDirty = false;
+    s.CaptureStartTime = std::chrono::steady_clock::now();
+    s.CaptureStartTicks = ProfilerGetTicks();
+    s.Capturing.store(true, std::memory_order_relaxed);
+}
+
+void ImGui::ProfilerStopCapture()
+{
+    ImProfilerState& s = GetProfilerState();
+    if (!s.Capturing.load(std::memory_order_relaxed))
+        return;
+    CalibrateTicks(s, ProfilerGetTicks());
+    CollectZones(s);
+    s.Capturing.store(false, std::memory_order_relaxed);
+    s.TimelineDirty = true;
+}
+
+bool ImGui::IsProfilerCapturing()
+{
+    return GetProfilerState().Capturing.load(std::memory_order_relaxed);
+}
+
+void ImGui::ProfilerSetThreadName(const char* name)
+{
+    ImStrncpy(GProfilerThreadName, name, IM_ARRAYSIZE(GProfilerThreadName));
+    if (ImProfilerThreadBuffer* buf = GProfilerThreadBuffer)
+    {
+        std::lock_guard<std::mutex> lock(GetProfilerState().ThreadsMutex);
+        ImStrncpy(buf->Name, name, IM_ARRAYSIZE(buf->Name));
+        buf->Named = true;
+    }
+}
+
+double ImGui::ProfilerTicksToMs(ImU64 ticks)
+{
+    const ImProfilerState& s = GetProfilerState();
+    return s.TicksPerMs > 0.0 ? (double)ticks / s.TicksPerMs : 0.0;
+}
+
+void ImGui::ProfilerGetCapture(const ImProfilerZone** out_zones, int* out_zones_count, const ImProfilerFrame** out_frames, int* out_frames_count, int* out_dropped_zones)
+{
+    const ImProfilerState& s = GetProfilerState();
+    if (out_zones)          *out_zones = s.Zones.empty() ? NULL : &s.Zones[0];
+    if (out_zones_count)    *out_zones_count = (int)s.Zones.size();
+    if (out_frames)         *out_frames = s.Frames.empty() ? NULL : &s.Frames[0];
+    if (out_frames_count)   *out_frames_count = (int)s.Frames.size();
+    if (out_dropped_zones)  *out_dropped_zones = s.DroppedZones;
+}
+
+void ImGui::ProfilerShutdown()
+{
+    ImProfilerState& s = GetProfilerState();
+    ProfilerStopCapture();
+    std::vector<ImProfilerZone>().swap(s.Zones);
+    std::vector<ImProfilerFrame>().swap(s.Frames);
+    std::vector<ImProfilerZoneTotal>().swap(s.SelectedFrameTotals);
+    s.SelectedFrame = -1;
+    if (s.Timeline)
+        IM_DELETE(s.Timeline);
+    s.Timeline = NULL;
+}
+
+//-----------------------------------------------------------------------------
+// Chrome trace export
+//-----------------------------------------------------------------------------
+
+static void AppendJsonString(ImGuiTextBuffer& buf, const char* str)
+{
+    buf.append("\"");
+    for (const char* p = str; *p; p++)
+    {
+        if (*p == '"' || *p == '\\')
+            buf.appendf("\\%c", *p);
+        else if ((unsigned char)*p < 0x20)
+            buf.appendf("\\u%04x", (unsigned char)*p);
+        else
+            buf.append(p, p + 1);
+    }
+    buf.append("\"");
+}
+
+bool ImGui::ProfilerExportChromeTrace(const char* filename)
+{
+    ImProfilerState& s = GetProfilerState();
+    ImFileHandle f = ImFileOpen(filename, "wb");
+    if (f == NULL)
+        return false;
+
+    // Timestamps and durations are in microseconds. Frames are exported as the zones of an extra "Frames" thread.
+    const int frames_tid = (int)s.Threads.size();
+    bool ok = true;
+    ImGuiTextBuffer buf;
+    buf.append("{\"traceEvents\":[\n");
+    {
+        std::lock_guard<std::mutex> lock(s.ThreadsMutex);
+        for (size_t thread_n = 0; thread_n < s.Threads.size(); thread_n++)
+        {
+            buf.appendf("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"args\":{\"name\":", (int)thread_n);
+            AppendJsonString(buf, s.Threads[thread_n]->Name);
+            buf.append("}},\n");
+        }
+    }
+    buf.appendf("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"args\":{\"name\":\"Frames\"}}", frames_tid);
+    for (size_t frame_n = 0; frame_n < s.Frames.size(); frame_n++)
+    {
+        const ImProfilerFrame& frame = s.Frames[frame_n];
+        buf.appendf(",\n{\"name\":\"Frame %d\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}", (int)frame_n, frames_tid,
+            ProfilerTicksToMs(frame.Start - s.CaptureStartTicks) * 1000.0, ProfilerTicksToMs(frame.End - frame.Start) * 1000.0);
+    }
+    for (size_t zone_n = 0; zone_n < s.Zones.size() && ok; zone_n++)
+    {
+        const ImProfilerZone& zone = s.Zones[zone_n];
+        buf.append(",\n{\"name\":");
+        AppendJsonString(buf, zone.Name);
+        buf.appendf(",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}", zone.ThreadIndex,
+            ProfilerTicksToMs(zone.Start - s.CaptureStartTicks) * 1000.0, ProfilerTicksToMs(zone.End - zone.Start) * 1000.0);
+        if (buf.size() > 1024 * 1024)
+        {
+            ok = ImFileWrite(buf.c_str(), 1, (ImU64)buf.size(), f) == (ImU64)buf.size();
+            buf.clear();
+        }
+    }
+    buf.append("\n]}\n");
+    ok = ok && ImFileWrite(buf.c_str(), 1, (ImU64)buf.size(), f) == (ImU64)buf.size();
+    return ImFileClose(f) && ok;
+}
+
+//-----------------------------------------------------------------------------
+// Views
+//-----------------------------------------------------------------------------
+
+static double ProfilerTimestampToMs(const ImProfilerState& s, ImU64 ticks)
+{
+    return ImGui::ProfilerTicksToMs(ticks - s.CaptureStartTicks);
+}
+
+// One track for the frames, then one per thread with a lane per zone depth
+static void BuildProfilerTimeline(ImProfilerState& s)
+{
+    if (s.Timeline == NULL)
+        s.Timeline = IM_NEW(ImGuiTimeline)();
+    ImGuiTimeline* tl = s.Timeline;
+    tl->Clear();
+    tl->AddTrack("Frames");
+    {
+        std::lock_guard<std::mutex> lock(s.ThreadsMutex);
+        for (size_t thread_n = 0; thread_n < s.Threads.size(); thread_n++)
+            tl->AddTrack(s.Threads[thread_n]->Name);
+    }
+    const ImU32 frame_color = ImGui::GetColorU32(ImGuiCol_PlotHistogram);
+    for (int frame_n = 0; frame_n < (int)s.Frames.size(); frame_n++)
+        tl->AddEvent(0, ProfilerTimestampToMs(s, s.Frames[frame_n].Start), ProfilerTimestampToMs(s, s.Frames[frame_n].End), "Frame", 0, frame_color, frame_n);
+    for (int zone_n = 0; zone_n < (int)s.Zones.size(); zone_n++)
+    {
+        const ImProfilerZone& zone = s.Zones[zone_n];
+        tl->AddEvent(1 + zone.ThreadIndex, ProfilerTimestampToMs(s, zone.Start), ProfilerTimestampToMs(s, zone.End), zone.Name, zone.Depth, 0, zone_n);
+    }
+    s.TimelineDirty = false;
+}
+
+static bool ProfilerZoneTotalGreater(const ImProfilerZoneTotal& a, const ImProfilerZoneTotal& b)
+{
+    return a.TotalMs > b.TotalMs;
+}
+
+// Time spent in each zone name during the frame, on all threads. Zones collected at the end of the neighbor frames may overlap it too.
+static void BuildFrameTotals(ImProfilerState& s, int frame_n)
+{
+    s.SelectedFrame = frame_n;
+    s.SelectedFrameTotals.clear();
+    if (frame_n < 0 || frame_n >= (int)s.Frames.size())
+        return;
+    const ImProfilerFrame& frame = s.Frames[frame_n];
+    const int zones_start = s.Frames[frame_n > 0 ? frame_n - 1 : 0].ZonesStart;
+    const int zones_end = frame_n + 1 < (int)s.Frames.size() ? s.Frames[frame_n + 1].ZonesEnd : (int)s.Zones.size();
+    for (int zone_n = zones_start; zone_n < zones_end; zone_n++)
+    {
+        const ImProfilerZone& zone = s.Zones[zone_n];
+        if (zone.End <= frame.Start || zone.Start >= frame.End)
+            continue;
+        const double ms = ImGui::ProfilerTicksToMs(ImMin(zone.End, frame.End) - ImMax(zone.Start, frame.Start));
+        size_t total_n = 0;
+        while (total_n < s.SelectedFrameTotals.size() && strcmp(s.SelectedFrameTotals[total_n].Name, zone.Name) != 0)
+            total_n++;
+        if (total_n == s.SelectedFrameTotals.size())
+        {
+            ImProfilerZoneTotal total = { zone.Name, 0, 0.0 };
+            s.SelectedFrameTotals.push_back(total);
+        }
+        s.SelectedFrameTotals[total_n].Count++;
+        s.SelectedFrameTotals[total_n].TotalMs += ms;
+    }
+    std::sort(s.SelectedFrameTotals.begin(), s.SelectedFrameTotals.end(), ProfilerZoneTotalGreater);
+}
+
+static float ProfilerFrameTimeGetter(void* data, int idx)
+{
+    const ImProfilerState& s = *(const ImProfilerState*)data;
+    const int first = ImMax((int)s.Frames.size() - PROFILER_FRAME_TIMES_COUNT, 0);
+    const ImProfilerFrame& frame = s.Frames[first + idx];
+    return (float)ImGui::ProfilerTicksToMs(frame.End - frame.Start);
+}
+
+void ImGui::ShowProfiler()
+{
+    ImProfilerState& s = GetProfilerState();
+    const bool capturing = s.Capturing.load(std::memory_order_relaxed);
+    if (Button(capturing ? "Stop capture" : "Start capture"))
+    {
+        if (capturing)
+            ProfilerStopCapture();
+        else
+            ProfilerStartCapture();
+    }
+    SameLine();
+    Text("%d frames, %d zones, %d dropped", (int)s.Frames.size(), (int)s.Zones.size(), s.DroppedZones);
+
+    const int frame_times_count = ImMin((int)s.Frames.size(), PROFILER_FRAME_TIMES_COUNT);
+    if (frame_times_count > 0)
+        PlotLines("Frame times (ms)", ProfilerFrameTimeGetter, &s, frame_times_count, 0, NULL, 0.0f, FLT_MAX, ImVec2(0, 60));
+    if (capturing || s.Frames.empty())
+        return;
+
+    PushItemWidth(-GetFontSize() * 12.0f);
+    InputText("##ExportPath", s.ExportPath, IM_ARRAYSIZE(s.ExportPath));
+    PopItemWidth();
+    SameLine();
+    if (Button("Export Chrome trace"))
+        s.ExportResult = ProfilerExportChromeTrace(s.ExportPath) ? 1 : -1;
+    if (s.ExportResult != 0)
+    {
+        SameLine();
+        TextUnformatted(s.ExportResult > 0 ? "Exported" : "Export failed");
+    }
+
+    if (s.TimelineDirty || s.Timeline == NULL)
+    {
+        BuildProfilerTimeline(s);
+
+        // Start with the slowest frame
+        int slowest = 0;
+        for (int frame_n = 1; frame_n < (int)s.Frames.size(); frame_n++)
+            if (s.Frames[frame_n].End - s.Frames[frame_n].Start > s.Frames[slowest].End - s.Frames[slowest].Start)
+                slowest = frame_n;
+        BuildFrameTotals(s, slowest);
+    }
+
+    // Clicking an event selects the frame it starts in
+    ImGuiTimeline* tl = s.Timeline;
+    if (Timeline("##ProfilerTimeline", tl, ImVec2(0, GetFrameHeight() * 12.0f)))
+    {
+        const double t = tl->Events[tl->ClickedEvent].Start;
+        int lo = 0, hi = (int)s.Frames.size();
+        while (lo < hi)
+        {
+            const int mid = (lo + hi) >> 1;
+            if (ProfilerTimestampToMs(s, s.Frames[mid].Start) <= t)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        BuildFrameTotals(s, ImMax(lo - 1, 0));
+    }
+
+    if (s.SelectedFrame >= 0)
+    {
+        const ImProfilerFrame& frame = s.Frames[s.SelectedFrame];
+        Text("Frame %d: %.3f ms", s.SelectedFrame, ProfilerTicksToMs(frame.End - frame.Start));
+        Columns(3, "##FrameTotals");
+        TextUnformatted("Zone"); NextColumn();
+        TextUnformatted("Calls"); NextColumn();
+        TextUnformatted("Total (ms)"); NextColumn();
+        Separator();
+        for (size_t total_n = 0; total_n < s.SelectedFrameTotals.size(); total_n++)
+        {
+            const ImProfilerZoneTotal& total = s.SelectedFrameTotals[total_n];
+            TextUnformatted(total.Name); NextColumn();
+            Text("%d", total.Count); NextColumn();
+            Text("%.3f", total.TotalMs); NextColumn();
+        }
+        Columns(1);
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include "imgui.h"
+
+// Instrumentation profiler: named scoped zones, collected per frame and browsed in a flame view (see ShowProfiler()).
+// - IMGUI_PROFILE_ZONE("name") records the scope it's declared in. It compiles to nothing unless IMGUI_ENABLE_PROFILER is defined in imconfig.h,
+//   and only reads the clock while a capture is running. Names must be string literals (only the pointer is kept).
+// - Timestamps come from rdtsc on x86/x64 (calibrated against std::chrono::steady_clock during the capture), steady_clock elsewhere.
+// - Every thread writes its zones to its own ring buffer (single producer, single consumer, no lock), created by the first zone it records
+//   during a capture. ProfilerNewFrame() marks a frame and moves the zones of all the threads to the capture. Zones are dropped (and counted) when a ring is full, or when the capture is full.
+// - The capture can be exported to a Chrome trace JSON file (chrome://tracing, https://ui.perfetto.dev).
+#ifdef IMGUI_ENABLE_PROFILER
+#define IMGUI_PROFILE_CONCAT_(A, B)     A##B
+#define IMGUI_PROFILE_CONCAT(A, B)      IMGUI_PROFILE_CONCAT_(A, B)
+#define IMGUI_PROFILE_ZONE(NAME)        ImProfilerScope IMGUI_PROFILE_CONCAT(im_profile_zone_, __LINE__)(NAME)
+#else
+#define IMGUI_PROFILE_ZONE(NAME)        ((void)0)
+#endif
+
+struct ImProfilerZone
+{
+    ImU64       Start;              // Ticks
+    ImU64       End;
+    const char* Name;
+    int         ThreadIndex;        // Index of the thread in the capture
+    int         Depth;              // Nesting level in the thread
+};
+
+struct ImProfilerFrame
+{
+    ImU64       Start;              // Ticks
+    ImU64       End;
+    int         ZonesStart;         // Zones collected at the end of the frame: [ZonesStart, ZonesEnd) in the capture
+    int         ZonesEnd;
+};
+
+namespace ImGui
+{
+    IMGUI_API void          ProfilerNewFrame();                     // Mark a frame and collect the zones of all threads. Called by NewFrame(), may also be called by code running inside another module's frame. Only the first call of a frame has an effect.
+    IMGUI_API void          ProfilerStartCapture(int max_zones = 1 << 20);  // Discard the previous capture. The capture stops by itself when 'max_zones' are recorded.
+    IMGUI_API void          ProfilerStopCapture();
+    IMGUI_API bool          IsProfilerCapturing();
+    IMGUI_API void          ProfilerSetThreadName(const char* name);        // Name of the calling thread in the views and exports (copied). Doesn't allocate: may be called by every thread on startup.
+    IMGUI_API double        ProfilerTicksToMs(ImU64 ticks);                 // Duration of 'ticks' in milliseconds (0.0 until the clock is calibrated)
+    IMGUI_API bool          ProfilerExportChromeTrace(const char* filename);
+    IMGUI_API void          ProfilerGetCapture(const ImProfilerZone** out_zones, int* out_zones_count, const ImProfilerFrame** out_frames, int* out_frames_count, int* out_dropped_zones);  // Valid until the next ProfilerNewFrame(), ProfilerStartCapture() or ProfilerShutdown(): call it from the same thread.
+    IMGUI_API void          ProfilerShutdown();                     // Stop the capture and release it, and the views. Call before destroying the ImGui context or unloading the module.
+    IMGUI_API void          ShowProfiler();                         // Capture controls, frame times, flame view of the capture and per-frame zone totals
+
+    // [Internal] Used by ImProfilerScope
+    IMGUI_API ImU64         ProfilerZoneBegin();                    // Returns 0 when not capturing
+    IMGUI_API void          ProfilerZoneEnd(const char* name, ImU64 start);
+} // namespace ImGui
+
+struct ImProfilerScope
+{
+    const char* Name;
+    ImU64       Start;
+
+    ImProfilerScope(const char* name)   { Name = name; Start = ImGui::ProfilerZoneBegin(); }
+    ~ImProfilerScope()                  { if (Start != 0) ImGui::ProfilerZoneEnd(Name, Start); }
+};
@@ -155,65 +155,210 @@ void ImGui::EndSearchableCombo()
 }
 
 
+static bool Items_ArrayGetter(void* data, int idx, const char** out_text)
+{
+    const char* const* items = (const char* const*)data;
+    if (out_text)
+        *out_text = items[idx];
+    return true;
+}
+
+static bool Items_StringVectorGetter(void* data, int idx, const char** out_text)
+{
+    const std::string* items = (const std::string*)data;
+    if (out_text)
+        *out_text = items[idx].c_str();
+    return true;
+}
+
+static inline char ToLowerAscii(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c;
+}
+
+void ImGuiSearchableComboIndex::Build(bool (*items_getter)(void* data, int idx, const char** out_text), void* data, int items_count)
+{
+    ItemsData = data;
+    ItemsCount = items_count;
+    LowerText.resize(0);
+    LowerOffsets.resize(items_count);
+    for (int i = 0; i < items_count; i++)
+    {
+        const char* item_text;
+        if (!items_getter(data, i, &item_text))
+            item_text = "";
+        const int offset = LowerText.Size;
+        const int len = (int)strlen(item_text);
+        LowerOffsets[i] = offset;
+        LowerText.resize(offset + len + 1);
+        for (int n = 0; n <= len; n++)
+            LowerText[offset + n] = ToLowerAscii(item_text[n]);
+    }
+
+    // Drop the cached results
+    Matches.resize(0);
+    Levels.resize(0);
+    FilteredQuery[0] = 0;
+}
+
+void ImGuiSearchableComboIndex::Filter(const char* query)
+{
+    char query_lower[IM_ARRAYSIZE(FilteredQuery)];
+    int query_len = 0;
+    for (; query[query_len] != 0 && query_len < IM_ARRAYSIZE(query_lower) - 1; query_len++)
+        query_lower[query_len] = ToLowerAscii(query[query_len]);
+    query_lower[query_len] = 0;
+
+    if (FuzzyMatching)
+    {
+        Matches.resize(0);
+        Levels.resize(0);
+        memcpy(FilteredQuery, query_lower, (size_t)query_len + 1);
+        Fuzzy.SetQuery(query_lower);
+        Fuzzy.Update(FuzzyTimeBudgetMs);
+        return;
+    }
+
+    // Keep the levels of the longest common prefix with the previous query
+    int common_len = 0;
+    while (common_len < query_len && FilteredQuery[common_len] == query_lower[common_len])
+        common_len++;
+    while (Levels.Size > 0 && Levels.back().QueryLen > common_len)
+    {
+        Matches.resize(Levels.back().MatchesStart);
+        Levels.pop_back();
+    }
+    memcpy(FilteredQuery, query_lower, (size_t)query_len + 1);
+    if (query_len == 0 || (Levels.Size > 0 && Levels.back().QueryLen == query_len))
+        return;
+
+    // A match for the new query also matches its prefixes: only filter the matches of the last level
+    const int parent_count = GetMatchesCount();
+    const int parent_start = Levels.Size > 0 ? Levels.back().MatchesStart : -1;
+    const int matches_start = Matches.Size;
+    Matches.reserve(matches_start + parent_count);
+    for (int n = 0; n < parent_count; n++)
+    {
+        const int item_idx = (parent_start >= 0) ? Matches.Data[parent_start + n] : n;
+        if (strstr(LowerText.Data + LowerOffsets.Data[item_idx], query_lower) != NULL)
+            Matches.push_back(item_idx);
+    }
+    ImGuiSearchableComboFilterLevel level;
+    level.QueryLen = query_len;
+    level.MatchesStart = matches_start;
+    Levels.push_back(level);
+}
+
 /* Modified version of Combo from imgui.cpp at line 9343,
- * to include a input field to be able to filter the combo values. */
-bool ImGui::SearchableCombo(const char* label, int* current_item, std::vector<std::string> items, const char* default_preview_text, const char* input_preview_value, int popup_max_height_in_items)
+ * to include a input field to be able to filter the combo values.
+ * Only the visible matches are submitted, through ImGuiListClipper. */
+bool ImGui::SearchableCombo(const char* label, int* current_item, ImGuiSearchableComboIndex* index, bool (*items_getter)(void* data, int idx, const char** out_text), void* data, int items_count, const char* default_preview_text, const char* input_preview_value, int popup_max_height_in_items)
 {
     ImGuiContext& g = *GImGui;
 
     const char* preview_text = NULL;
-    if (*current_item >= (int)items.size())
+    if (*current_item >= items_count)
         *current_item = 0;
-    if (*current_item >= 0 && *current_item < (int)items.size())
-        preview_text = items[*current_item].c_str();
-    else
+    if (*current_item >= 0 && *current_item < items_count)
+        items_getter(data, *current_item, &preview_text);
+    if (preview_text == NULL)
         preview_text = default_preview_text;
 
     // The old Combo() API exposed "popup_max_height_in_items". The new more general BeginCombo() API doesn't have/need it, but we emulate it here.
     if (popup_max_height_in_items != -1 && !(g.NextWindowData.Flags & ImGuiNextWindowDataFlags_HasSizeConstraint))
         SetNextWindowSizeConstraints(ImVec2(0, 0), ImVec2(FLT_MAX, CalcMaxPopupHeightFromItemCount(popup_max_height_in_items)));
 
-    const int input_size = 64;
-    char input_buffer[input_size] = "";
-    if (!BeginSearchableCombo(label, preview_text, input_buffer, input_size, input_preview_value, ImGuiComboFlags_None))
+    if (!BeginSearchableCombo(label, preview_text, index->Query, IM_ARRAYSIZE(index->Query), input_preview_value, ImGuiComboFlags_None))
         return false;
 
+    if (index->ItemsData != data || index->ItemsCount != items_count)
+        index->Build(items_getter, data, items_count);
+    if (index->FuzzyMatching)
+        index->Fuzzy.SetItems(items_getter, data, items_count);
+    index->Filter(index->Query);
+
     // Display items
-    // FIXME-OPT: Use clipper (but we need to disable it on the appearing frame to make sure our call to SetItemDefaultFocus() is processed)
-    int matched_items = 0;
+    const int matches_count = index->GetMatchesCount();
+    const float item_height = GetTextLineHeightWithSpacing();
+    const float start_pos_y = GetCursorPosY();
     bool value_changed = false;
-    for (int i = 0; i < (int)items.size(); i++)
+    bool selected_displayed = false;
+    ImGuiListClipper clipper(matches_count, item_height);
+    while (clipper.Step())
+        for (int n = clipper.DisplayStart; n < clipper.DisplayEnd; n++)
+        {
+            const int i = index->GetMatch(n);
+            const char* item_text;
+            if (!items_getter(data, i, &item_text))
+                item_text = "*Unknown item*";
+            PushID((void*)(intptr_t)i);
+            const bool item_selected = (i == *current_item);
+            if (Selectable(item_text, item_selected))
+            {
+                value_changed = true;
+                *current_item = i;
+            }
+            if (item_selected)
+            {
+                SetItemDefaultFocus();
+                selected_displayed = true;
+            }
+            PopID();
+        }
+
+    // When appearing, also submit the selected item so it gets the default focus and is scrolled to.
+    // Substring matches are sorted by item index, fuzzy matches are few.
+    if (IsWindowAppearing() && !selected_displayed && *current_item >= 0)
     {
-        char buffer[input_size] = "";
-        ImStrncpy(buffer, input_buffer, input_size);
-        std::string input(buffer);
-        std::string item = items[i];
-
-        std::transform(item.begin(), item.end(), item.begin(),
-            [](unsigned char c) { return (unsigned char)std::tolower(c); });
-        std::transform(input.begin(), input.end(), input.begin(),
-            [](unsigned char c) { return (unsigned char)std::tolower(c); });
-
-        if (item.find(input, 0) == std::string::npos)
-            continue;
-
-        matched_items++;
-        PushID((void*)(intptr_t)i);
-        const bool item_selected = (i == *current_item);
-        const char* item_text = items[i].c_str();
-        if (Selectable(item_text, item_selected))
+        int lo = 0, hi = matches_count;
+        if (index->IsFuzzyFiltering())
         {
-            value_changed = true;
-            *current_item = i;
+            while (lo < matches_count && index->GetMatch(lo) != *current_item)
+                lo++;
         }
-        if (item_selected)
+        else
+        {
+            while (lo < hi)
+            {
+                const int mid = (lo + hi) / 2;
+                if (index->GetMatch(mid) < *current_item)
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+        }
+        if (lo < matches_count && index->GetMatch(lo) == *current_item)
+        {
+            const float end_pos_y = GetCursorPosY();
+            const char* item_text;
+            if (!items_getter(data, *current_item, &item_text))
+                item_text = "*Unknown item*";
+            SetCursorPosY(start_pos_y + lo * item_height);
+            PushID((void*)(intptr_t)*current_item);
+            if (Selectable(item_text, true))
+                value_changed = true;
             SetItemDefaultFocus();
-        PopID();
+            SetScrollHereY();
+            PopID();
+            SetCursorPosY(end_pos_y);
+        }
     }
-    if (matched_items == 0)
+    if (index->IsFuzzyFiltering() && !index->Fuzzy.IsDone())
+        ImGui::Selectable("...", false, ImGuiSelectableFlags_Disabled);
+    else if (matches_count == 0)
         ImGui::Selectable("No maps found", false, ImGuiSelectableFlags_Disabled);
 
     EndSearchableCombo();
 
     return value_changed;
-}
\ No newline at end of file
+}
+
+bool ImGui::SearchableCombo(const char* label, int* current_item, ImGuiSearchableComboIndex* index, const char* const items[], int items_count, const char* default_preview_text, const char* input_preview_value, int popup_max_height_in_items)
+{
+    return SearchableCombo(label, current_item, index, &Items_ArrayGetter, (void*)items, items_count, default_preview_text, input_preview_value, popup_max_height_in_items);
+}
+
+bool ImGui::SearchableCombo(const char* label, int* current_item, ImGuiSearchableComboIndex* index, const std::vector<std::string>& items, const char* default_preview_text, const char* input_preview_value, int popup_max_height_in_items)
+{
+    return SearchableCombo(label, current_item, index, &Items_StringVectorGetter, (void*)items.data(), (int)items.size(), default_preview_text, input_preview_value, popup_max_height_in_items);
+}
@@ -1,14 +1,54 @@
 #pragma once
 #include "imgui.h"
+#include "imgui_fuzzy_matcher.h"
 
 #include <ctype.h>      // isprint
 #include <vector>       // vector<>
 #include <string>       // string
-#include <algorithm>    // transform
+
+struct ImGuiSearchableComboFilterLevel
+{
+    int             QueryLen;       // Length of the query prefix this level was filtered with
+    int             MatchesStart;   // Offset in ImGuiSearchableComboIndex::Matches
+};
+
+// State of a SearchableCombo(), to keep alive as long as the combo (e.g. next to the items).
+// - A lowercase copy of the items is built once per item set. The item set is identified by the items pointer and count:
+//   call Invalidate() if you modify the items in place.
+// - Filter results are cached per query prefix. Typing one more character only filters the previous matches,
+//   erasing characters goes back to the results cached for the shorter query.
+// - With FuzzyMatching, the best Fuzzy.MaxResults fuzzy matches are listed from the best one instead (see ImGuiFuzzyMatcher).
+struct ImGuiSearchableComboIndex
+{
+    char                Query[64];          // Input text
+    char                FilteredQuery[64];  // Lowercase query the cached levels belong to
+    bool                FuzzyMatching;      // Rank items by fuzzy matching score instead of listing the items containing the query
+    float               FuzzyTimeBudgetMs;  // Time spent matching items per frame, the list fills up over several frames for large item sets
+    ImGuiFuzzyMatcher   Fuzzy;
+
+    // [Internal]
+    const void*         ItemsData;
+    int                 ItemsCount;
+    ImVector<char>      LowerText;          // Lowercase items, zero-terminated, back to back
+    ImVector<int>       LowerOffsets;       // Offset of each item in LowerText
+    ImVector<int>       Matches;            // Indices of the matching items, for all levels back to back
+    ImVector<ImGuiSearchableComboFilterLevel> Levels;   // One level per query prefix. No level: the query is empty and all items match.
+
+    ImGuiSearchableComboIndex()     { Query[0] = FilteredQuery[0] = 0; FuzzyMatching = false; FuzzyTimeBudgetMs = 1.0f; ItemsData = NULL; ItemsCount = -1; }
+    void                Invalidate() { ItemsData = NULL; ItemsCount = -1; Fuzzy.Invalidate(); }
+
+    IMGUI_API void      Build(bool (*items_getter)(void* data, int idx, const char** out_text), void* data, int items_count);   // Called by SearchableCombo() when the item set changed
+    IMGUI_API void      Filter(const char* query);                                  // Update the matches for a new query
+    bool                IsFuzzyFiltering() const        { return FuzzyMatching && FilteredQuery[0] != 0; }
+    int                 GetMatchesCount() const         { return IsFuzzyFiltering() ? Fuzzy.GetResultsCount() : Levels.Size > 0 ? Matches.Size - Levels.back().MatchesStart : (ItemsCount > 0 ? ItemsCount : 0); }
+    int                 GetMatch(int n) const           { return IsFuzzyFiltering() ? Fuzzy.GetResult(n).Index : Levels.Size > 0 ? Matches[Levels.back().MatchesStart + n] : n; }
+};
 
 namespace ImGui
 {
     IMGUI_API bool          BeginSearchableCombo(const char* label, const char* preview_value, char* input, int input_size, const char* input_preview_value, ImGuiComboFlags flags = 0);
     IMGUI_API void          EndSearchableCombo();
-    IMGUI_API bool          SearchableCombo(const char* label, int* current_item, std::vector<std::string> items, const char* default_preview_text, const char* input_preview_value, int popup_max_height_in_items = -1);
+    IMGUI_API bool          SearchableCombo(const char* label, int* current_item, ImGuiSearchableComboIndex* index, const char* const items[], int items_count, const char* default_preview_text, const char* input_preview_value, int popup_max_height_in_items = -1);
+    IMGUI_API bool          SearchableCombo(const char* label, int* current_item, ImGuiSearchableComboIndex* index, const std::vector<std::string>& items, const char* default_preview_text, const char* input_preview_value, int popup_max_height_in_items = -1);
+    IMGUI_API bool          SearchableCombo(const char* label, int* current_item, ImGuiSearchableComboIndex* index, bool (*items_getter)(void* data, int idx, const char** out_text), void* data, int items_count, const char* default_preview_text, const char* input_preview_value, int popup_max_height_in_items = -1);
 } // namespace ImGui
\ No newline at end of file
@@ -100,7 +100,8 @@ namespace ImGui {
 
 		// @r-lyeh {
 		if (t >= 0) {
-			if (t > s_max_timeline_value) t = s_max_timeline_value; t /= s_max_timeline_value;
+			if (t > s_max_timeline_value) t = s_max_timeline_value;
+			t /= s_max_timeline_value;
 			const ImU32 line_color = ColorConvertFloat4ToU32(GImGui->Style.Colors[ImGuiCol_SeparatorActive]);
 			ImVec2 a(win->Pos.x + GetWindowContentRegionMin().x + t * GetWindowContentRegionWidth(), GetWindowContentRegionMin().y + win->Pos.y + win->Scroll.y);
 			ImVec2 b(win->Pos.x + GetWindowContentRegionMin().x + t * GetWindowContentRegionWidth(), GetWindowContentRegionMax().y + win->Pos.y + win->Scroll.y);
@@ -135,4 +136,470 @@ namespace ImGui {
 		EndChild();
 	}
 
-}
\ No newline at end of file
+}
+
+//-----------------------------------------------------------------------------
+// ImGuiTimeline
+//-----------------------------------------------------------------------------
+
+void ImGuiTimeline::Clear()
+{
+	Tracks.clear();
+	Events.clear();
+	MaxEndsTree.clear();
+	Lanes.clear();
+	Strings.clear();
+	StringOffsets.Clear();
+	MinTime = MaxTime = ViewMin = ViewMax = 0.0;
+	HoveredEvent = ClickedEvent = -1;
+	HoveredCount = 0;
+	Dirty = false;
+}
+
+int ImGuiTimeline::AddString(const char* str)
+{
+	const ImGuiID hash = ImHashStr(str);
+	const int offset = StringOffsets.GetInt(hash) - 1;
+	if (offset >= 0 && strcmp(Strings.Data + offset, str) == 0)
+		return offset;
+	const int len = (int)strlen(str);
+	const int new_offset = Strings.Size;
+	Strings.resize(Strings.Size + len + 1);
+	memcpy(Strings.Data + new_offset, str, (size_t)len + 1);
+	if (offset < 0)
+		StringOffsets.SetInt(hash, new_offset + 1);     // On collision the first string keeps the slot, others are stored again
+	return new_offset;
+}
+
+int ImGuiTimeline::AddTrack(const char* name)
+{
+	ImGuiTimelineTrack track;
+	track.NameOffset = AddString(name);
+	track.LanesStart = Lanes.Size;
+	track.LanesCount = 0;
+	track.Collapsed = false;
+	Tracks.push_back(track);
+	return Tracks.Size - 1;
+}
+
+void ImGuiTimeline::AddEvent(int track, double start, double end, const char* label, int depth, ImU32 color, int user_id)
+{
+	IM_ASSERT(track >= 0 && track < Tracks.Size && depth >= 0);
+	if (end < start)
+	{
+		const double tmp = start;
+		start = end;
+		end = tmp;
+	}
+	ImGuiTimelineEvent ev;
+	ev.Start = start;
+	ev.End = end;
+	ev.Track = track;
+	ev.Depth = depth;
+	ev.LabelOffset = label ? AddString(label) : -1;
+	ev.UserId = user_id;
+	if (color == 0)
+	{
+		// Same label, same color
+		float r = 0.5f, g = 0.5f, b = 0.5f;
+		if (label)
+			ImGui::ColorConvertHSVtoRGB((float)(ImHashStr(label) & 0xFFFF) / 65535.0f, 0.45f, 0.75f, r, g, b);
+		color = ImGui::ColorConvertFloat4ToU32(ImVec4(r, g, b, 1.0f));
+	}
+	ev.Color = color;
+	if (Events.Size == 0)
+	{
+		MinTime = start;
+		MaxTime = end;
+	}
+	else
+	{
+		MinTime = ImMin(MinTime, start);
+		MaxTime = ImMax(MaxTime, end);
+	}
+	Events.push_back(ev);
+	Dirty = true;
+}
+
+static int IMGUI_CDECL TimelineEventComparer(const void* lhs, const void* rhs)
+{
+	const ImGuiTimelineEvent* a = (const ImGuiTimelineEvent*)lhs;
+	const ImGuiTimelineEvent* b = (const ImGuiTimelineEvent*)rhs;
+	if (a->Track != b->Track)
+		return a->Track < b->Track ? -1 : 1;
+	if (a->Depth != b->Depth)
+		return a->Depth < b->Depth ? -1 : 1;
+	if (a->Start != b->Start)
+		return a->Start < b->Start ? -1 : 1;
+	return 0;
+}
+
+void ImGuiTimeline::Build()
+{
+	// Events are often added in order (e.g. appended while recording): skip the sort then
+	bool sorted = true;
+	for (int n = 1; n < Events.Size && sorted; n++)
+		sorted = TimelineEventComparer(&Events[n - 1], &Events[n]) <= 0;
+	if (!sorted)
+		ImQsort(Events.Data, (size_t)Events.Size, sizeof(ImGuiTimelineEvent), TimelineEventComparer);
+
+	// One lane per depth (empty ones included)
+	Lanes.resize(0);
+	int n = 0;
+	for (int track_n = 0; track_n < Tracks.Size; track_n++)
+	{
+		ImGuiTimelineTrack& track = Tracks[track_n];
+		track.LanesStart = Lanes.Size;
+		while (n < Events.Size && Events[n].Track == track_n)
+		{
+			const int depth = Events[n].Depth;
+			while (Lanes.Size - track.LanesStart <= depth)
+			{
+				ImGuiTimelineLane lane;
+				lane.EventsStart = n;
+				lane.EventsCount = 0;
+				Lanes.push_back(lane);
+			}
+			ImGuiTimelineLane& lane = Lanes.back();
+			for (; n < Events.Size && Events[n].Track == track_n && Events[n].Depth == depth; n++)
+				lane.EventsCount++;
+		}
+		track.LanesCount = Lanes.Size - track.LanesStart;
+	}
+
+	// Segment tree of the end times of each lane. Padding leaves hold -DBL_MAX so they never match.
+	MaxEndsTree.resize(0);
+	for (int lane_n = 0; lane_n < Lanes.Size; lane_n++)
+	{
+		ImGuiTimelineLane& lane = Lanes[lane_n];
+		lane.TreeLeaves = 1;
+		while (lane.TreeLeaves < lane.EventsCount)
+			lane.TreeLeaves <<= 1;
+		lane.TreeStart = MaxEndsTree.Size;
+		MaxEndsTree.resize(MaxEndsTree.Size + lane.TreeLeaves * 2, -DBL_MAX);
+		double* tree = MaxEndsTree.Data + lane.TreeStart;
+		for (int event_n = 0; event_n < lane.EventsCount; event_n++)
+			tree[lane.TreeLeaves + event_n] = Events[lane.EventsStart + event_n].End;
+		for (int node = lane.TreeLeaves - 1; node >= 1; node--)
+			tree[node] = ImMax(tree[node * 2], tree[node * 2 + 1]);
+	}
+	HoveredEvent = ClickedEvent = -1;
+	HoveredCount = 0;
+	Dirty = false;
+}
+
+void ImGuiTimeline::FitView()
+{
+	const double margin = (MaxTime > MinTime) ? (MaxTime - MinTime) * 0.02 : 1.0;
+	ViewMin = MinTime - margin;
+	ViewMax = MaxTime + margin;
+}
+
+int ImGuiTimeline::FindNextEvent(int lane, int first, double time) const
+{
+	const ImGuiTimelineLane& l = Lanes[lane];
+	const int events_end = l.EventsStart + l.EventsCount;
+	if (first >= events_end)
+		return events_end;
+	const double* tree = MaxEndsTree.Data + l.TreeStart;
+	int node = l.TreeLeaves + ImMax(first - l.EventsStart, 0);
+	if (tree[node] < time)
+	{
+		// Go up until a right sibling has a match, then down to its leftmost matching leaf
+		for (;;)
+		{
+			if (node <= 1)
+				return events_end;
+			if ((node & 1) == 0 && tree[node + 1] >= time)
+			{
+				node++;
+				break;
+			}
+			node >>= 1;
+		}
+		while (node < l.TreeLeaves)
+			node = (tree[node * 2] >= time) ? node * 2 : node * 2 + 1;
+	}
+	return ImMin(l.EventsStart + node - l.TreeLeaves, events_end);
+}
+
+double ImGuiTimeline::GetMaxEnd(int lane, int first, int last) const
+{
+	const ImGuiTimelineLane& l = Lanes[lane];
+	const double* tree = MaxEndsTree.Data + l.TreeStart;
+	double max_end = -DBL_MAX;
+	for (int lo = first - l.EventsStart + l.TreeLeaves, hi = last - l.EventsStart + l.TreeLeaves; lo < hi; lo >>= 1, hi >>= 1)
+	{
+		if (lo & 1)
+			max_end = ImMax(max_end, tree[lo++]);
+		if (hi & 1)
+			max_end = ImMax(max_end, tree[--hi]);
+	}
+	return max_end;
+}
+
+// First event in [first, last) starting after 'time'
+static int TimelineUpperBound(const ImGuiTimeline* timeline, int first, int last, double time)
+{
+	while (first < last)
+	{
+		const int mid = (first + last) >> 1;
+		if (timeline->Events[mid].Start <= time)
+			first = mid + 1;
+		else
+			last = mid;
+	}
+	return first;
+}
+
+// Tick spacing of at least 'min_step': 1, 2 or 5 times a power of 10
+static double TimelineTickStep(double min_step)
+{
+	const double p = pow(10.0, floor(log10(min_step)));
+	const double m = min_step / p;
+	return p * (m <= 1.0 ? 1.0 : m <= 2.0 ? 2.0 : m <= 5.0 ? 5.0 : 10.0);
+}
+
+namespace ImGui {
+
+	bool Timeline(const char* str_id, ImGuiTimeline* timeline, const ImVec2& size, double current_time)
+	{
+		ImGuiTimeline* tl = timeline;
+		if (tl->Dirty)
+			tl->Build();
+
+		PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(0, 0));
+		const bool visible = BeginChild(str_id, size, true, ImGuiWindowFlags_NoScrollWithMouse | ImGuiWindowFlags_NoMove);
+		PopStyleVar();
+		if (!visible)
+		{
+			EndChild();
+			return false;
+		}
+
+		ImGuiContext& g = *GImGui;
+		ImGuiIO& io = g.IO;
+		const ImGuiStyle& style = g.Style;
+		ImGuiWindow* window = GetCurrentWindow();
+		ImDrawList* draw_list = window->DrawList;
+		const float lane_h = tl->LaneHeight > 0.0f ? tl->LaneHeight : GetFrameHeight();
+		const float ruler_h = GetFrameHeight();
+		const ImRect inner = window->InnerRect;
+		const ImRect events_bb(ImVec2(ImMin(inner.Min.x + tl->TrackNameWidth, inner.Max.x), inner.Min.y + ruler_h), inner.Max);
+		const ImRect area_bb(ImVec2(events_bb.Min.x, inner.Min.y), inner.Max);     // Events and ruler
+		if (tl->ViewMax <= tl->ViewMin)
+			tl->FitView();
+
+		// Zoom and pan
+		const ImGuiID id = window->GetID("##area");
+		ItemAdd(area_bb, id);
+		bool hovered, held;
+		const bool pressed = ButtonBehavior(area_bb, id, &hovered, &held);
+		const float width = ImMax(events_bb.GetWidth(), 1.0f);
+		if (hovered && io.MouseWheel != 0.0f)
+		{
+			if (io.KeyShift)
+				SetScrollY(window, window->Scroll.y - io.MouseWheel * lane_h * 3.0f);
+			else
+			{
+				const double range = tl->ViewMax - tl->ViewMin;
+				const double full_range = ImMax(tl->MaxTime - tl->MinTime, 1e-9);
+				const double new_range = ImClamp(range * pow(1.25, -io.MouseWheel), full_range * 1e-9, full_range * 2.0);
+				const double mouse_t = tl->ViewMin + (io.MousePos.x - events_bb.Min.x) / width * range;
+				tl->ViewMin = mouse_t - (io.MousePos.x - events_bb.Min.x) / width * new_range;
+				tl->ViewMax = tl->ViewMin + new_range;
+			}
+		}
+		if (held && (io.MouseDelta.x != 0.0f || io.MouseDelta.y != 0.0f))
+		{
+			const double dt = io.MouseDelta.x / width * (tl->ViewMax - tl->ViewMin);
+			tl->ViewMin -= dt;
+			tl->ViewMax -= dt;
+			SetScrollY(window, window->Scroll.y - io.MouseDelta.y);
+		}
+		// Keep some events in view
+		const double range = tl->ViewMax - tl->ViewMin;
+		if (tl->ViewMin > tl->MaxTime)
+		{
+			tl->ViewMin = tl->MaxTime;
+			tl->ViewMax = tl->ViewMin + range;
+		}
+		if (tl->ViewMax < tl->MinTime)
+		{
+			tl->ViewMax = tl->MinTime;
+			tl->ViewMin = tl->ViewMax - range;
+		}
+		const double view_min = tl->ViewMin, view_max = tl->ViewMax;
+		const double scale = width / (view_max - view_min);    // Pixels per time unit
+		#define TIMELINE_X(T)   ((float)ImClamp(events_bb.Min.x + ((T) - view_min) * scale, (double)events_bb.Min.x - 2.0, (double)events_bb.Max.x + 2.0))
+
+		// Ruler and grid
+		const ImU32 text_color = GetColorU32(ImGuiCol_Text);
+		const ImU32 grid_color = GetColorU32(ImGuiCol_Border);
+		draw_list->AddRectFilled(inner.Min, ImVec2(inner.Max.x, events_bb.Min.y), GetColorU32(ImGuiCol_FrameBg));
+		const double step = TimelineTickStep(80.0 / scale);
+		const int decimals = step >= 1.0 ? 0 : (int)ImMin(-floor(log10(step)), 9.0);
+		const double first_tick = ceil(view_min / step);
+		for (int tick_n = 0; tick_n <= (int)(width / 80.0f) + 1; tick_n++)
+		{
+			const double t = (first_tick + tick_n) * step;
+			if (t > view_max)
+				break;
+			const float x = TIMELINE_X(t);
+			char tmp[64];
+			ImFormatString(tmp, IM_ARRAYSIZE(tmp), "%.*f", decimals, t);
+			draw_list->AddLine(ImVec2(x, inner.Min.y + ruler_h * 0.5f), ImVec2(x, inner.Max.y), grid_color);
+			draw_list->AddText(ImVec2(x + style.ItemInnerSpacing.x, inner.Min.y + style.FramePadding.y), text_color, tmp);
+		}
+
+		// Visible tracks and events
+		tl->HoveredEvent = -1;
+		tl->HoveredCount = 0;
+		double hovered_end = 0.0;
+		const bool mouse_in_events = hovered && events_bb.Contains(io.MousePos);
+		const ImU32 track_bg_color = GetColorU32(ImGuiCol_FrameBg, 0.5f);
+		float y = events_bb.Min.y - window->Scroll.y;
+		for (int track_n = 0; track_n < tl->Tracks.Size; track_n++)
+		{
+			ImGuiTimelineTrack& track = tl->Tracks[track_n];
+			const int lanes_count = track.Collapsed ? ImMin(track.LanesCount, 1) : track.LanesCount;
+			const float track_h = ImMax(lanes_count, 1) * lane_h + style.ItemSpacing.y;
+			const float track_y = y;
+			y += track_h;
+			if (track_y + track_h <= events_bb.Min.y || track_y >= events_bb.Max.y)
+				continue;
+
+			// Track name: click to collapse
+			const ImRect name_bb(ImVec2(inner.Min.x, ImMax(track_y, events_bb.Min.y)), ImVec2(events_bb.Min.x, ImMin(track_y + lane_h, events_bb.Max.y)));
+			const ImGuiID name_id = window->GetID(track_n);
+			if (name_bb.Min.y < name_bb.Max.y && ItemAdd(name_bb, name_id))
+			{
+				bool name_hovered, name_held;
+				if (ButtonBehavior(name_bb, name_id, &name_hovered, &name_held) && track.LanesCount > 1)
+					track.Collapsed = !track.Collapsed;
+				if (name_hovered)
+					draw_list->AddRectFilled(name_bb.Min, name_bb.Max, GetColorU32(ImGuiCol_HeaderHovered));
+			}
+			PushClipRect(ImVec2(inner.Min.x, events_bb.Min.y), events_bb.Max, true);
+			if (track_n & 1)
+				draw_list->AddRectFilled(ImVec2(inner.Min.x, track_y), ImVec2(inner.Max.x, track_y + track_h), track_bg_color);
+			float name_x = inner.Min.x + style.FramePadding.x;
+			if (track.LanesCount > 1)
+			{
+				RenderArrow(draw_list, ImVec2(name_x, track_y + style.FramePadding.y), text_color, track.Collapsed ? ImGuiDir_Right : ImGuiDir_Down, 0.7f);
+				name_x += g.FontSize;
+			}
+			const ImRect name_clip(inner.Min.x, events_bb.Min.y, events_bb.Min.x - style.ItemInnerSpacing.x, events_bb.Max.y);
+			RenderTextClipped(ImVec2(name_x, track_y), ImVec2(name_clip.Max.x, track_y + lane_h), tl->GetString(track.NameOffset), NULL, NULL, ImVec2(0.0f, 0.5f), &name_clip);
+			PopClipRect();
+
+			PushClipRect(events_bb.Min, events_bb.Max, true);
+			for (int lane_n = 0; lane_n < lanes_count; lane_n++)
+			{
+				const float y0 = track_y + lane_n * lane_h, y1 = y0 + lane_h - 1.0f;
+				if (y1 <= events_bb.Min.y || y0 >= events_bb.Max.y)
+					continue;
+				const int lane_idx = track.LanesStart + lane_n;
+				const int events_end = tl->Lanes[lane_idx].EventsStart + tl->Lanes[lane_idx].EventsCount;
+				int n = tl->FindNextEvent(lane_idx, tl->Lanes[lane_idx].EventsStart, view_min);
+				while (n < events_end && tl->Events[n].Start <= view_max)
+				{
+					const ImGuiTimelineEvent& ev = tl->Events[n];
+					const float x0 = TIMELINE_X(ev.Start);
+					float x1 = TIMELINE_X(ev.End);
+					int next = n + 1;
+					double box_end = ev.End;
+					if (x1 - x0 < tl->MergeWidth)
+					{
+						// Merge the following narrow events, starting at most one pixel after the box
+						x1 = ImMax(x1, x0 + 1.0f);
+						while (next < events_end && x1 <= events_bb.Max.x)
+						{
+							const float pixel_end = ImFloor(x1) + 1.0f;
+							const int last = TimelineUpperBound(tl, next, events_end, view_min + (pixel_end - events_bb.Min.x) / scale);
+							if (last == next)
+								break;
+							const double run_max_end = tl->GetMaxEnd(lane_idx, next, last);
+							const float max_end_x = TIMELINE_X(run_max_end);
+							if (max_end_x <= pixel_end + tl->MergeWidth)
+							{
+								// All of them are narrow: take them at once, the box grows by at least one pixel
+								box_end = ImMax(box_end, run_max_end);
+								x1 = ImMax(pixel_end, max_end_x);
+								next = last;
+								continue;
+							}
+							// One of them is wider: take the next one if it's narrow
+							const ImGuiTimelineEvent& next_ev = tl->Events[next];
+							const float next_x1 = TIMELINE_X(next_ev.End);
+							if (next_x1 - TIMELINE_X(next_ev.Start) >= tl->MergeWidth)
+								break;
+							box_end = ImMax(box_end, next_ev.End);
+							x1 = ImMax(x1, next_x1);
+							next++;
+						}
+					}
+					const int count = next - n;
+					const ImRect box_bb(x0, y0, ImMax(x1, x0 + 1.0f), y1);
+					draw_list->AddRectFilled(box_bb.Min, box_bb.Max, count > 1 ? (ev.Color & ~IM_COL32_A_MASK) | (0x99 << IM_COL32_A_SHIFT) : ev.Color);
+					if (count == 1 && ev.LabelOffset >= 0 && box_bb.GetWidth() > g.FontSize * 2.0f)
+					{
+						const ImRect label_clip(ImMax(box_bb.Min.x, events_bb.Min.x), y0, ImMin(box_bb.Max.x, events_bb.Max.x) - style.FramePadding.x, y1);
+						RenderTextClipped(ImVec2(label_clip.Min.x + style.FramePadding.x, y0), label_clip.Max, tl->GetString(ev.LabelOffset), NULL, NULL, ImVec2(0.0f, 0.5f), &label_clip);
+					}
+					if (mouse_in_events && box_bb.Contains(io.MousePos))
+					{
+						tl->HoveredEvent = n;
+						tl->HoveredCount = count;
+						hovered_end = box_end;
+					}
+					n = tl->FindNextEvent(lane_idx, next, view_min);
+				}
+			}
+			PopClipRect();
+		}
+		const float content_h = y + window->Scroll.y - events_bb.Min.y;
+
+		if (current_time != DBL_MAX && current_time >= view_min && current_time <= view_max)
+		{
+			const float x = TIMELINE_X(current_time);
+			draw_list->AddLine(ImVec2(x, inner.Min.y), ImVec2(x, inner.Max.y), GetColorU32(ImGuiCol_SeparatorActive));
+		}
+		#undef TIMELINE_X
+
+		// Hovered event: tooltip, click to select it, double-click to zoom on it
+		bool clicked = false;
+		if (tl->HoveredEvent >= 0)
+		{
+			const ImGuiTimelineEvent& ev = tl->Events[tl->HoveredEvent];
+			BeginTooltip();
+			if (tl->HoveredCount == 1)
+			{
+				if (ev.LabelOffset >= 0)
+					TextUnformatted(tl->GetString(ev.LabelOffset));
+				Text("%.6g - %.6g (%.6g)", ev.Start, ev.End, ev.End - ev.Start);
+			}
+			else
+				Text("%d events\n%.6g - %.6g (%.6g)", tl->HoveredCount, ev.Start, hovered_end, hovered_end - ev.Start);
+			EndTooltip();
+			if (pressed && io.MouseDragMaxDistanceSqr[0] < io.MouseDragThreshold * io.MouseDragThreshold)
+			{
+				tl->ClickedEvent = tl->HoveredEvent;
+				clicked = true;
+			}
+			if (hovered && io.MouseDoubleClicked[0])
+			{
+				const double margin = ImMax(hovered_end - ev.Start, 1e-9) * 0.05;
+				tl->ViewMin = ev.Start - margin;
+				tl->ViewMax = hovered_end + margin;
+			}
+		}
+
+		// Content size, for the vertical scrollbar
+		SetCursorPos(ImVec2(0.0f, 0.0f));
+		Dummy(ImVec2(1.0f, ruler_h + content_h));
+		EndChild();
+		return clicked;
+	}
+
+}
@@ -1,9 +1,91 @@
 #pragma once
+#include "imgui.h"
+
 namespace ImGui {
 
+	// Editable timeline: a draggable [start, end] range per TimelineEvent() row. Only one BeginTimeline()/EndTimeline() at a time.
 	bool BeginTimeline(const char* str_id, float max_time);
 	bool TimelineEvent(const char* str_id, float times[2]);
 	void EndTimeline(float current_time = -1);
 
 }
 
+// Read-only timeline of many tracks of events (e.g. every match and queue span of a session, or a profiler capture), drawn by ImGui::Timeline().
+// - Keep an ImGuiTimeline per timeline: it owns the events and the view (visible time range), so several timelines can be shown at once.
+// - The events of a track are stacked in lanes by depth (e.g. the nesting level of profiler zones). Build() sorts the events of every lane by
+//   start time and indexes them in a segment tree of their end times, so the next event overlapping the visible range is found in O(log N),
+//   whatever the lengths of the events before it (a long event doesn't make the following ones visible).
+// - Only the visible tracks and events are drawn. Consecutive events narrower than MergeWidth pixels are drawn as a single box, and runs of
+//   events fitting in the box are skipped by binary search, so the cost of a lane depends on its width in pixels rather than its number of events.
+// - Mouse wheel: zoom around the mouse cursor. Shift + mouse wheel: scroll the tracks. Drag: pan. Double-click an event: zoom on it.
+//   Click a track name: collapse the track to its first lane.
+// Usage:
+//     int track = timeline.AddTrack("Matches");
+//     timeline.AddEvent(track, match.start, match.end, match.name);
+//     if (ImGui::Timeline("##session", &timeline, ImVec2(0, 300)))
+//         OnEventClicked(timeline.Events[timeline.ClickedEvent].UserId);
+struct ImGuiTimelineEvent
+{
+	double          Start;
+	double          End;
+	ImU32           Color;
+	int             Track;
+	int             Depth;          // Lane in the track
+	int             LabelOffset;    // Offset in ImGuiTimeline::Strings, -1 if none
+	int             UserId;         // Any value identifying the event (indices in Events change when Build() sorts them)
+};
+
+struct ImGuiTimelineTrack
+{
+	int             NameOffset;     // Offset in ImGuiTimeline::Strings
+	int             LanesStart;     // Offset in ImGuiTimeline::Lanes (set by Build())
+	int             LanesCount;
+	bool            Collapsed;      // Only show the first lane
+};
+
+struct ImGuiTimelineLane
+{
+	int             EventsStart;    // Offset in ImGuiTimeline::Events, sorted by start time
+	int             EventsCount;
+	int             TreeStart;      // Offset in ImGuiTimeline::MaxEndsTree
+	int             TreeLeaves;     // Power of 2 >= EventsCount. Node 1 is the root, node n has children 2n and 2n+1, leaves start at TreeLeaves.
+};
+
+struct IMGUI_API ImGuiTimeline
+{
+	ImVector<ImGuiTimelineTrack>    Tracks;
+	ImVector<ImGuiTimelineEvent>    Events;         // Sorted by track, depth and start time by Build()
+	ImVector<double>                MaxEndsTree;    // Segment trees of the end times of each lane: every node holds the maximum end time of its leaves
+	ImVector<ImGuiTimelineLane>     Lanes;
+	ImVector<char>                  Strings;        // Track names and event labels, zero-terminated. Identical labels are stored once.
+	ImGuiStorage                    StringOffsets;  // Label hash -> offset + 1 in Strings
+	double          MinTime;        // Time range of the events
+	double          MaxTime;
+	double          ViewMin;        // Visible time range (ViewMin >= ViewMax: fit the events on the next frame)
+	double          ViewMax;
+	float           LaneHeight;     // 0.0f: GetFrameHeight()
+	float           TrackNameWidth;
+	float           MergeWidth;     // Events narrower than this (in pixels) are merged with the following ones
+	int             HoveredEvent;   // Index in Events of the hovered event (the first one of a merged box), -1 if none
+	int             HoveredCount;   // Number of events in the hovered box
+	int             ClickedEvent;   // Index in Events of the last clicked event, -1 if none
+	bool            Dirty;          // Events were added since the last Build()
+
+	ImGuiTimeline()                 { MinTime = MaxTime = ViewMin = ViewMax = 0.0; LaneHeight = 0.0f; TrackNameWidth = 120.0f; MergeWidth = 1.0f; HoveredEvent = ClickedEvent = -1; HoveredCount = 0; Dirty = false; }
+	void            Clear();        // Remove all the tracks and events
+	int             AddTrack(const char* name);
+	void            AddEvent(int track, double start, double end, const char* label = NULL, int depth = 0, ImU32 color = 0, int user_id = 0);  // color == 0: derived from the label
+	void            Build();        // Called by ImGui::Timeline() when Dirty
+	void            FitView();
+	int             FindNextEvent(int lane, int first, double time) const;  // First event of the lane from index 'first' ending at or after 'time', or the end of the lane. O(log N).
+	double          GetMaxEnd(int lane, int first, int last) const;         // Maximum end time of the events [first, last) of the lane. O(log N).
+	const char*     GetString(int offset) const                     { return offset >= 0 ? Strings.Data + offset : NULL; }
+	int             AddString(const char* str);
+};
+
+namespace ImGui {
+
+	// Returns true when an event is clicked (see ImGuiTimeline::ClickedEvent). 'current_time' draws a marker, unless it's DBL_MAX.
+	IMGUI_API bool Timeline(const char* str_id, ImGuiTimeline* timeline, const ImVec2& size = ImVec2(0, 0), double current_time = DBL_MAX);
+
+}
@@ -7,6 +7,8 @@
 //-----------------------------------------------------------------------------------------------------------------
 
 #include "imguivariouscontrols.h"
+#include "imgui_fuzzy_matcher.h"
+#include "imgui_completion_index.h"
 #define NO_IMGUIVARIOUSCONTROLS_ANIMATEDIMAGE
 #ifndef NO_IMGUIVARIOUSCONTROLS_ANIMATEDIMAGE
 #ifndef IMGUI_USE_AUTO_BINDING
@@ -25,6 +27,9 @@
 #endif //DEBUG_OUT_TEXTURE
 #endif //STBI_INCLUDE_STB_IMAGE_WRITE_H
 #endif //NO_IMGUIVARIOUSCONTROLS_ANIMATEDIMAGE
+#ifndef IMGUI_DISABLE_THREADS
+#include <mutex>                // mutex (PlotRingBuffer)
+#endif //IMGUI_DISABLE_THREADS
 
 
 namespace ImGui {
@@ -1526,6 +1531,227 @@ int AppendTreeNodeHeaderButtons(const void* ptr_id, float startWindowCursorXForC
     return rv;
 }
 
+// Start PlotMinMaxPyramid implementation ---------------------------------
+void PlotMinMaxPyramid::clear() {
+    for (int k=0;k<numLevels;k++) levels[k].clear();
+    size=numLevels=0;
+}
+void PlotMinMaxPyramid::build(const float* values,int values_count,int stride)  {
+    clear();
+    append(values,values_count,stride);
+}
+void PlotMinMaxPyramid::build(float (*getter)(const void* data,int idx),const void* data,int values_count)  {
+    clear();
+    if (values_count<=0) return;
+    ImVector<ImVec2>& l0 = levels[0];
+    l0.resize((values_count+BlockSize-1)/BlockSize);
+    for (int b=0;b<l0.size();b++)   {
+        const int end = ImMin((b+1)*BlockSize,values_count);
+        ImVec2 mm(FLT_MAX,-FLT_MAX);
+        for (int i=b*BlockSize;i<end;i++) {const float v = getter(data,i);mm.x = ImMin(mm.x,v);mm.y = ImMax(mm.y,v);}
+        l0[b] = mm;
+    }
+    size = values_count;
+    refreshLevels(0,l0.size()-1);
+}
+void PlotMinMaxPyramid::append(const float* values,int values_count,int stride)  {
+    if (values_count<=0) return;
+    ImVector<ImVec2>& l0 = levels[0];
+    const int firstBlock = size/BlockSize;
+    l0.resize((size+values_count+BlockSize-1)/BlockSize);
+    const unsigned char* p = (const unsigned char*) values;
+    for (int i=0;i<values_count;i++,p+=stride)  {
+        const float v = *(const float*)(const void*)p;
+        const int b = (size+i)/BlockSize;
+        if ((size+i)%BlockSize==0) l0[b] = ImVec2(v,v);
+        else {ImVec2& mm = l0[b];mm.x = ImMin(mm.x,v);mm.y = ImMax(mm.y,v);}
+    }
+    size+=values_count;
+    refreshLevels(firstBlock,l0.size()-1);
+}
+void PlotMinMaxPyramid::update(const float* values,int begin,int end,int stride)  {
+    if (begin<0) begin=0;
+    if (end>size) end=size;
+    if (begin>=end) return;
+    // A block can lose its min or max: it must be recomputed from all its values
+    const int firstBlock = begin/BlockSize, lastBlock = (end-1)/BlockSize;
+    for (int b=firstBlock;b<=lastBlock;b++) {
+        const int bEnd = ImMin((b+1)*BlockSize,size);
+        ImVec2 mm(FLT_MAX,-FLT_MAX);
+        for (int i=b*BlockSize;i<bEnd;i++) {const float v = *(const float*)(const void*)((const unsigned char*)values+(size_t)i*stride);mm.x = ImMin(mm.x,v);mm.y = ImMax(mm.y,v);}
+        levels[0][b] = mm;
+    }
+    refreshLevels(firstBlock,lastBlock);
+}
+void PlotMinMaxPyramid::refreshLevels(int firstBlock,int lastBlock) {
+    numLevels = 1;
+    for (int k=1;k<MaxLevels && levels[k-1].size()>1;k++)   {
+        const ImVector<ImVec2>& prev = levels[k-1];
+        ImVector<ImVec2>& cur = levels[k];
+        cur.resize((prev.size()+1)/2);
+        firstBlock/=2;lastBlock/=2;
+        for (int j=firstBlock;j<=lastBlock;j++) {
+            const ImVec2& a = prev[2*j];
+            cur[j] = (2*j+1<prev.size()) ? ImVec2(ImMin(a.x,prev[2*j+1].x),ImMax(a.y,prev[2*j+1].y)) : a;
+        }
+        numLevels = k+1;
+    }
+    for (int k=numLevels;k<MaxLevels && levels[k].size()>0;k++) levels[k].clear();
+}
+struct PlotMinMaxPyramidStridedValues {const float* values;int stride;};
+static float PlotMinMaxPyramidStridedGetter(const void* data,int idx) {
+    const PlotMinMaxPyramidStridedValues* sv = (const PlotMinMaxPyramidStridedValues*) data;
+    return *(const float*)(const void*)((const unsigned char*)sv->values+(size_t)idx*sv->stride);
+}
+bool PlotMinMaxPyramid::getMinMax(const float* values,int begin,int end,float* pMinOut,float* pMaxOut,int stride) const  {
+    PlotMinMaxPyramidStridedValues sv = {values,stride};
+    return getMinMax(&PlotMinMaxPyramidStridedGetter,&sv,begin,end,pMinOut,pMaxOut);
+}
+bool PlotMinMaxPyramid::getMinMax(float (*getter)(const void* data,int idx),const void* data,int begin,int end,float* pMinOut,float* pMaxOut) const  {
+    float mn = FLT_MAX, mx = -FLT_MAX;
+    if (begin<0) begin=0;
+    if (end>size) end=size;
+    // [b0,b1) are the whole blocks inside the range: the values before and after them are read one by one
+    int b0 = (begin+BlockSize-1)/BlockSize, b1 = end/BlockSize;
+    if (b0>=b1) {b0 = b1 = 0;for (int i=begin;i<end;i++) {const float v = getter(data,i);mn = ImMin(mn,v);mx = ImMax(mx,v);}}
+    else {
+        for (int i=begin;i<b0*BlockSize;i++) {const float v = getter(data,i);mn = ImMin(mn,v);mx = ImMax(mx,v);}
+        for (int i=b1*BlockSize;i<end;i++) {const float v = getter(data,i);mn = ImMin(mn,v);mx = ImMax(mx,v);}
+    }
+    // Bottom-up walk: at every level we take the unpaired entries at the ends, and we go up with the rest
+    for (int k=0;b0<b1;k++,b0/=2,b1/=2) {
+        const ImVector<ImVec2>& l = levels[k];
+        if (b0&1) {mn = ImMin(mn,l[b0].x);mx = ImMax(mx,l[b0].y);++b0;}
+        if (b1&1) {--b1;mn = ImMin(mn,l[b1].x);mx = ImMax(mx,l[b1].y);}
+    }
+    if (pMinOut) *pMinOut = mn;
+    if (pMaxOut) *pMaxOut = mx;
+    return mn<=mx;
+}
+struct PlotRangeValues {float (*values_getter)(void* data,int idx,int series);void* data;int series;};
+static float PlotRangeValuesGetter(const void* data,int idx) {
+    const PlotRangeValues* rv = (const PlotRangeValues*) data;
+    return rv->values_getter(rv->data,idx,rv->series);
+}
+// Min and max of the values in [begin,end) in plot order (the value index is (i+values_offset)%values_count).
+// Wide ranges are read from 'pyramid' (when not NULL), the others through 'values_getter'.
+static void PlotGetRangeMinMax(float (*values_getter)(void* data,int idx,int series),void* data,int series,const PlotMinMaxPyramid* pyramid,int values_count,int values_offset,int begin,int end,float& minOut,float& maxOut) {
+    minOut = FLT_MAX;maxOut = -FLT_MAX;
+    if (pyramid && end-begin>=PlotMinMaxPyramid::BlockSize) {
+        const PlotRangeValues rv = {values_getter,data,series};
+        const int first = (begin+values_offset)%values_count, last = first+end-begin;
+        pyramid->getMinMax(&PlotRangeValuesGetter,&rv,first,ImMin(last,values_count),&minOut,&maxOut);
+        if (last>values_count)  {
+            float mn,mx;pyramid->getMinMax(&PlotRangeValuesGetter,&rv,0,last-values_count,&mn,&mx);
+            minOut = ImMin(minOut,mn);maxOut = ImMax(maxOut,mx);
+        }
+        return;
+    }
+    for (int i=begin;i<end;i++) {
+        const float v = values_getter(data,(i+values_offset)%values_count,series);
+        minOut = ImMin(minOut,v);maxOut = ImMax(maxOut,v);
+    }
+}
+// End PlotMinMaxPyramid implementation -----------------------------------
+// Start PlotRingBuffer implementation ------------------------------------
+struct PlotRingBufferInternal {
+    float* data;                // 'numChannels' arrays of 'channelStride' floats
+    void* block;                // allocation of 'data' (which is 64-byte aligned inside it)
+    int capacity,numChannels,channelStride;
+    int start,size;             // the oldest value is at slot 'start'
+    ImVector<double> sums;      // of every channel
+    PlotMinMaxPyramid* pyramids;
+    ImVector<const float*> channels;
+    ImVector<const PlotMinMaxPyramid*> channelPyramids;
+#   ifndef IMGUI_DISABLE_THREADS
+    mutable std::mutex mutex;
+#   endif //IMGUI_DISABLE_THREADS
+
+    PlotRingBufferInternal(int _capacity,int _numChannels) : capacity(_capacity),numChannels(_numChannels),start(0),size(0) {
+        IM_ASSERT(capacity>0 && numChannels>0);
+        channelStride = (capacity+15)&~15;      // 64 bytes
+        block = ImGui::MemAlloc((size_t)numChannels*channelStride*sizeof(float)+64);
+        data = (float*)(((size_t)block+63)&~(size_t)63);
+        pyramids = (PlotMinMaxPyramid*) ImGui::MemAlloc(numChannels*sizeof(PlotMinMaxPyramid));
+        sums.resize(numChannels);channels.resize(numChannels);channelPyramids.resize(numChannels);
+        for (int c=0;c<numChannels;c++) {
+            IM_PLACEMENT_NEW(&pyramids[c]) PlotMinMaxPyramid();
+            sums[c] = 0.0;channels[c] = data+(size_t)c*channelStride;channelPyramids[c] = &pyramids[c];
+        }
+    }
+    ~PlotRingBufferInternal()   {
+        for (int c=0;c<numChannels;c++) pyramids[c].~PlotMinMaxPyramid();
+        ImGui::MemFree(pyramids);pyramids=NULL;
+        ImGui::MemFree(block);block=NULL;data=NULL;
+    }
+    void append(const float* values)    {
+        const int slot = start+size<capacity ? start+size : start+size-capacity;
+        const bool full = (size==capacity);
+        for (int c=0;c<numChannels;c++) {
+            float* d = data+(size_t)c*channelStride;
+            if (full) sums[c]-=d[slot];
+            d[slot] = values[c];sums[c]+=values[c];
+            if (full) pyramids[c].update(d,slot,slot+1);
+            else pyramids[c].append(values[c]);
+        }
+        if (!full) {++size;return;}
+        if (++start==capacity)  {
+            // Every 'capacity' values, we recompute the sums to drop the accumulated rounding errors
+            start = 0;
+            for (int c=0;c<numChannels;c++) {
+                const float* d = data+(size_t)c*channelStride;
+                double sum = 0.0;for (int i=0;i<size;i++) sum+=d[i];
+                sums[c] = sum;
+            }
+        }
+    }
+    void clear()    {
+        start = size = 0;
+        for (int c=0;c<numChannels;c++) {sums[c] = 0.0;pyramids[c].clear();}
+    }
+    inline void lock() const    {
+#       ifndef IMGUI_DISABLE_THREADS
+        mutex.lock();
+#       endif //IMGUI_DISABLE_THREADS
+    }
+    inline void unlock() const  {
+#       ifndef IMGUI_DISABLE_THREADS
+        mutex.unlock();
+#       endif //IMGUI_DISABLE_THREADS
+    }
+};
+PlotRingBuffer::PlotRingBuffer(int capacity,int numChannels)  {
+    ptr = (PlotRingBufferInternal*) ImGui::MemAlloc(sizeof(PlotRingBufferInternal));
+    IM_PLACEMENT_NEW(ptr) PlotRingBufferInternal(capacity,numChannels);
+}
+PlotRingBuffer::~PlotRingBuffer()   {
+    ptr->~PlotRingBufferInternal();
+    ImGui::MemFree(ptr);ptr=NULL;
+}
+void PlotRingBuffer::append(const float* values)    {ptr->lock();ptr->append(values);ptr->unlock();}
+void PlotRingBuffer::clear()    {ptr->lock();ptr->clear();ptr->unlock();}
+int PlotRingBuffer::getCapacity() const {return ptr->capacity;}
+int PlotRingBuffer::getNumChannels() const  {return ptr->numChannels;}
+int PlotRingBuffer::getSize() const {return ptr->size;}
+float PlotRingBuffer::getValue(int channel,int idx) const   {
+    IM_ASSERT(channel>=0 && channel<ptr->numChannels && idx>=0 && idx<ptr->size);
+    return ptr->channels[channel][(ptr->start+idx)%ptr->capacity];
+}
+void PlotRingBuffer::getView(int channel,const float** pValues0Out,int* pCount0Out,const float** pValues1Out,int* pCount1Out) const   {
+    IM_ASSERT(channel>=0 && channel<ptr->numChannels);
+    const float* d = ptr->channels[channel];
+    *pValues0Out = d+ptr->start;*pCount0Out = ImMin(ptr->size,ptr->capacity-ptr->start);
+    *pValues1Out = d;*pCount1Out = ptr->size-*pCount0Out;
+}
+float PlotRingBuffer::getMin(int channel) const {return ptr->pyramids[channel].getMin();}
+float PlotRingBuffer::getMax(int channel) const {return ptr->pyramids[channel].getMax();}
+float PlotRingBuffer::getMean(int channel) const    {return ptr->size>0 ? (float)(ptr->sums[channel]/(double)ptr->size) : 0.f;}
+const PlotMinMaxPyramid& PlotRingBuffer::getPyramid(int channel) const {return ptr->pyramids[channel];}
+int PlotRingBuffer::getStart() const    {return ptr->start;}
+void PlotRingBuffer::lock() const   {ptr->lock();}
+void PlotRingBuffer::unlock() const {ptr->unlock();}
+// End PlotRingBuffer implementation --------------------------------------
+
 // Start PlotHistogram(...) implementation -------------------------------
 struct ImGuiPlotMultiArrayGetterData    {
     const float** Values;int Stride;
@@ -1548,11 +1774,15 @@ struct ImGuiPlotMultiArrayGetterData    {
         const int A = (unsigned char) (c>>IM_COL32_A_SHIFT);
 
         int r = R+fcgi, g = G+fcgi, b = B+fcgi;
-        if (r>255) r=255;if (g>255) g=255;if (b>255) b=255;
+        if (r>255) r=255;
+        if (g>255) g=255;
+        if (b>255) b=255;
         if (negative) bc = IM_COL32(r,g,b,A); else tc = IM_COL32(r,g,b,A);
 
         r = R-fcgi; g = G-fcgi; b = B-fcgi;
-        if (r<0) r=0;if (g<0) g=0;if (b<0) b=0;
+        if (r<0) r=0;
+        if (g<0) g=0;
+        if (b<0) b=0;
         if (negative) tc = IM_COL32(r,g,b,A); else bc = IM_COL32(r,g,b,A);
 
         /* // Old legacy code (to remove)... [However here we lerp alpha too...]
@@ -1591,11 +1821,11 @@ static float Plot_MultiArrayGetter(void* data, int idx,int histogramIdx)    {
     const float v = *(float*)(void*)((unsigned char*)(&plot_data->Values[histogramIdx][0]) + (size_t)idx * plot_data->Stride);
     return v;
 }
-int PlotHistogram(const char* label, const float** values,int num_histograms,int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size, int stride,float histogramGroupSpacingInPixels,int* pOptionalHoveredHistogramIndexOut,float fillColorGradientDeltaIn0_05,const ImU32* pColorsOverride,int numColorsOverride)   {
+int PlotHistogram(const char* label, const float** values,int num_histograms,int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size, int stride,float histogramGroupSpacingInPixels,int* pOptionalHoveredHistogramIndexOut,float fillColorGradientDeltaIn0_05,const ImU32* pColorsOverride,int numColorsOverride,const PlotMinMaxPyramid* const* pyramids)   {
     ImGuiPlotMultiArrayGetterData data(values, stride);
-    return PlotHistogram(label, &Plot_MultiArrayGetter, (void*)&data, num_histograms, values_count, values_offset, overlay_text, scale_min, scale_max, graph_size,histogramGroupSpacingInPixels,pOptionalHoveredHistogramIndexOut,fillColorGradientDeltaIn0_05,pColorsOverride,numColorsOverride);
+    return PlotHistogram(label, &Plot_MultiArrayGetter, (void*)&data, num_histograms, values_count, values_offset, overlay_text, scale_min, scale_max, graph_size,histogramGroupSpacingInPixels,pOptionalHoveredHistogramIndexOut,fillColorGradientDeltaIn0_05,pColorsOverride,numColorsOverride,pyramids);
 }
-int PlotHistogram(const char* label, float (*values_getter)(void* data, int idx,int histogramIdx), void* data,int num_histograms, int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size,float histogramGroupSpacingInPixels,int* pOptionalHoveredHistogramIndexOut,float fillColorGradientDeltaIn0_05,const ImU32* pColorsOverride,int numColorsOverride)  {
+int PlotHistogram(const char* label, float (*values_getter)(void* data, int idx,int histogramIdx), void* data,int num_histograms, int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size,float histogramGroupSpacingInPixels,int* pOptionalHoveredHistogramIndexOut,float fillColorGradientDeltaIn0_05,const ImU32* pColorsOverride,int numColorsOverride,const PlotMinMaxPyramid* const* pyramids)  {
     ImGuiWindow* window = GetCurrentWindow();
     if (pOptionalHoveredHistogramIndexOut) *pOptionalHoveredHistogramIndexOut=-1;
     if (window->SkipItems) return -1;
@@ -1620,7 +1850,13 @@ int PlotHistogram(const char* label, float (*values_getter)(void* data, int idx,
     if (scale_min == FLT_MAX || scale_max == FLT_MAX || scale_min==scale_max)   {
         float v_min = FLT_MAX;
         float v_max = -FLT_MAX;
-        for (int i = 0; i < values_count; i++)  {
+        if (pyramids)   {
+            for (int h=0;h<num_histograms;h++)  {
+                v_min = ImMin(v_min, pyramids[h]->getMin());
+                v_max = ImMax(v_max, pyramids[h]->getMax());
+            }
+        }
+        else for (int i = 0; i < values_count; i++)  {
             for (int h=0;h<num_histograms;h++)  {
                 const float v = values_getter(data, (i + values_offset) % values_count, h);
                 v_min = ImMin(v_min, v);
@@ -1645,7 +1881,14 @@ int PlotHistogram(const char* label, float (*values_getter)(void* data, int idx,
         const ImU32* col_base = mustOverrideColors ? pColorsOverride : col_base_embedded;
         const int num_colors = mustOverrideColors ? numColorsOverride : num_colors_embedded;
 
-        const int total_histograms = values_count * num_histograms;
+        // With 'pyramids', values that don't fit the plot width are grouped into 'num_groups' bars per histogram
+        int num_groups = values_count;
+        const float groupWidth = num_histograms*minSingleHistogramWidth+histogramGroupSpacingInPixels;
+        if (pyramids)   {
+            for (int h=0;h<num_histograms;h++) IM_ASSERT(pyramids[h]->getSize()==values_count);
+            if ((float)values_count*groupWidth-histogramGroupSpacingInPixels > inner_bb.Max.x-inner_bb.Min.x) num_groups = ImMax((int)((inner_bb.Max.x-inner_bb.Min.x+histogramGroupSpacingInPixels)/groupWidth),1);
+        }
+        const int total_histograms = num_groups * num_histograms;
 
         const bool isItemHovered = ItemHoverable(inner_bb, 0);
 
@@ -1662,7 +1905,7 @@ int PlotHistogram(const char* label, float (*values_getter)(void* data, int idx,
         const float posXAxis = inner_bb.Max.y-inner_bb_extension.y*xAxisSat-0.5f;
         const bool isAlwaysNegative = scale_max<0 && scale_min<0;
 
-        float t_step = (inner_bb.Max.x-inner_bb.Min.x-(float)(values_count-1)*histogramGroupSpacingInPixels)/(float)total_histograms;
+        float t_step = (inner_bb.Max.x-inner_bb.Min.x-(float)(num_groups-1)*histogramGroupSpacingInPixels)/(float)total_histograms;
         if (t_step<minSingleHistogramWidth) t_step = minSingleHistogramWidth;
         else if (t_step>maxSingleHistogramWidth) t_step = maxSingleHistogramWidth;
 
@@ -1670,12 +1913,18 @@ int PlotHistogram(const char* label, float (*values_getter)(void* data, int idx,
         float posY=0.f;ImVec2 pos0(0.f,0.f),pos1(0.f,0.f);
         ImU32 rectCol=0,topRectCol=0,bottomRectCol=0;float gradient = 0.f;
         short overflow = 0;bool mustSkipBorder = false;int iWithOffset=0;
-        for (int i = 0; i < values_count; i++)  {
+        for (int i = 0; i < num_groups; i++)  {
             if (i!=0) t1+=histogramGroupSpacingInPixels;
             if (t1>inner_bb.Max.x) break;
-            iWithOffset = (i + values_offset) % values_count;
+            const int i0 = (int)((ImS64)i*values_count/num_groups), i1 = (int)((ImS64)(i+1)*values_count/num_groups);
+            iWithOffset = (i0 + values_offset) % values_count;
             for (int h=0;h<num_histograms;h++)  {
-                const float v1 = values_getter(data, iWithOffset, h);
+                float v1 = 0.f, vMin = 0.f, vMax = 0.f;
+                if (i1-i0==1) v1 = values_getter(data, iWithOffset, h);
+                else {
+                    PlotGetRangeMinMax(values_getter, data, h, pyramids[h], values_count, values_offset, i0, i1, vMin, vMax);
+                    v1 = hasXAxis ? (vMax>=-vMin ? vMax : vMin) : (isAlwaysNegative ? vMin : vMax);
+                }
 
                 pos0.x = inner_bb.Min.x+t1;
                 pos1.x = pos0.x+t_step;
@@ -1689,7 +1938,8 @@ int PlotHistogram(const char* label, float (*values_getter)(void* data, int idx,
                     h_hovered = h;
                     v_hovered = iWithOffset; // iWithOffset or just i ?
                     if (pOptionalHoveredHistogramIndexOut) *pOptionalHoveredHistogramIndexOut=h_hovered;
-                    SetTooltip("%d: %8.4g", i, v1); // Tooltip on hover
+                    if (i1-i0==1) SetTooltip("%d: %8.4g", i, v1); // Tooltip on hover
+                    else SetTooltip("%d-%d: %8.4g %8.4g", i0, i1-1, vMin, vMax);
 
                     if (h==0 && !mustOverrideColors) rectCol = GetColorU32(ImGuiCol_PlotHistogramHovered); // because: col_base[0] = GetColorU32(ImGuiCol_PlotHistogram);
                     else {
@@ -1777,9 +2027,9 @@ int PlotHistogram(const char* label, float (*values_getter)(void* data, int idx,
 
     return v_hovered;
 }
-int PlotHistogram2(const char* label, const float* values,int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size, int stride,float fillColorGradientDeltaIn0_05,const ImU32* pColorsOverride,int numColorsOverride) {
+int PlotHistogram2(const char* label, const float* values,int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size, int stride,float fillColorGradientDeltaIn0_05,const ImU32* pColorsOverride,int numColorsOverride,const PlotMinMaxPyramid* pyramid) {
     const float* pValues[1] = {values};
-    return PlotHistogram(label,pValues,1,values_count,values_offset,overlay_text,scale_min,scale_max,graph_size,stride,0.f,NULL,fillColorGradientDeltaIn0_05,pColorsOverride,numColorsOverride);
+    return PlotHistogram(label,pValues,1,values_count,values_offset,overlay_text,scale_min,scale_max,graph_size,stride,0.f,NULL,fillColorGradientDeltaIn0_05,pColorsOverride,numColorsOverride,pyramid ? &pyramid : NULL);
 }
 // End PlotHistogram(...) implementation ----------------------------------
 // Start PlotCurve(...) implementation ------------------------------------
@@ -1900,9 +2150,11 @@ int PlotCurve(const char* label, float (*values_getter)(void* data, float x,int
 
                 if (pos0.y>=inner_bb.Min.y && pos0.y<=inner_bb.Max.y && pos1.y>=inner_bb.Min.y && pos1.y<=inner_bb.Max.y)
                 {
-                    // Draw this curve segment
-                    window->DrawList->AddLine(pos0, pos1,curveCol,curveThick);
+                    // Add this curve segment to the current polyline (a single stroke for all the consecutive visible segments)
+                    if (window->DrawList->_Path.Size==0) window->DrawList->PathLineTo(pos0);
+                    window->DrawList->PathLineTo(pos1);
                 }
+                else window->DrawList->PathStroke(curveCol,false,curveThick);
 
                 if (isItemHovered && h==0 && v_hovered==-1 && ImGuiPlotMultiArrayGetterData::IsMouseBetweenXValues(pos0.x,pos1.x,&mouseHoverDeltaX)) {
                     v_hovered = v_idx;
@@ -1928,6 +2180,7 @@ int PlotCurve(const char* label, float (*values_getter)(void* data, float x,int
                 pos0 = pos1;
                 ++v_idx;
             }
+            window->DrawList->PathStroke(curveCol,false,curveThick);
         }
 
 
@@ -1977,6 +2230,18 @@ static inline ImU32 InvertColorU32(ImU32 in)
     return GetColorU32(in4);
 }
 
+struct PlotMultiExGetterData
+{
+    float(*Getter)(const void* data, int idx);
+    const void * const * Datas;
+    PlotMultiExGetterData(float(*getter)(const void* data, int idx), const void * const * datas) { Getter = getter; Datas = datas; }
+};
+static float PlotMultiExGetter(void* data, int idx, int data_idx)
+{
+    const PlotMultiExGetterData* getter_data = (const PlotMultiExGetterData*)data;
+    return getter_data->Getter(getter_data->Datas[data_idx], idx);
+}
+
 static void PlotMultiEx(
     ImGuiPlotType plot_type,
     const char* label,
@@ -1986,12 +2251,12 @@ static void PlotMultiEx(
     float(*getter)(const void* data, int idx),
     const void * const * datas,
     int values_count,
+    int values_offset,
     float scale_min,
     float scale_max,
-    ImVec2 graph_size)
+    ImVec2 graph_size,
+    const PlotMinMaxPyramid* const* pyramids)
 {
-    const int values_offset = 0;
-
     ImGuiWindow* window = GetCurrentWindow();
     if (window->SkipItems)
         return;
@@ -2019,6 +2284,12 @@ static void PlotMultiEx(
         float v_max = -FLT_MAX;
         for (int data_idx = 0; data_idx < num_datas; ++data_idx)
         {
+            if (pyramids)
+            {
+                v_min = ImMin(v_min, pyramids[data_idx]->getMin());
+                v_max = ImMax(v_max, pyramids[data_idx]->getMax());
+                continue;
+            }
             for (int i = 0; i < values_count; i++)
             {
                 const float v = getter(datas[data_idx], i);
@@ -2071,6 +2342,57 @@ static void PlotMultiEx(
         v_hovered = v_idx;
     }
 
+    // With 'pyramids' and at least two values per pixel column, every column shows the min and the max of its values
+    const int num_columns = (int)(inner_bb.Max.x - inner_bb.Min.x);
+    if (pyramids && num_columns >= 2 && values_count >= 2 * num_columns)
+    {
+        PlotMultiExGetterData getter_data(getter, datas);
+        const ImVec2 uv = window->DrawList->_Data->TexUvWhitePixel;
+        for (int data_idx = 0; data_idx < num_datas; ++data_idx)
+        {
+            IM_ASSERT(pyramids[data_idx]->getSize() == values_count);
+            const ImU32 col_base = colors[data_idx];
+            float last_v = 0.0f;
+            if (plot_type == ImGuiPlotType_Histogram)
+            {
+                // A strip of two vertices per column, from the max down to the bottom of the plot
+                window->DrawList->PrimReserve((num_columns - 1) * 6, num_columns * 2);
+            }
+            for (int n = 0; n < num_columns; n++)
+            {
+                float v_lo, v_hi;
+                PlotGetRangeMinMax(&PlotMultiExGetter, (void*)&getter_data, data_idx, pyramids[data_idx], values_count, values_offset, (int)((ImS64)n * values_count / num_columns), (int)((ImS64)(n + 1) * values_count / num_columns), v_lo, v_hi);
+                const float x = ImLerp(inner_bb.Min.x, inner_bb.Max.x, ((float)n + 0.5f) / (float)num_columns);
+                const float y_lo = ImLerp(inner_bb.Min.y, inner_bb.Max.y, 1.0f - ImSaturate((v_lo - scale_min) / (scale_max - scale_min)));
+                const float y_hi = ImLerp(inner_bb.Min.y, inner_bb.Max.y, 1.0f - ImSaturate((v_hi - scale_min) / (scale_max - scale_min)));
+                if (plot_type == ImGuiPlotType_Lines)
+                {
+                    // Two points per column: we start from the end that is nearer to the previous column
+                    if (n == 0) last_v = v_lo;
+                    const bool up = (last_v <= (v_lo + v_hi) * 0.5f);
+                    window->DrawList->PathLineTo(ImVec2(x, up ? y_lo : y_hi));
+                    window->DrawList->PathLineTo(ImVec2(x, up ? y_hi : y_lo));
+                    last_v = up ? v_hi : v_lo;
+                }
+                else
+                {
+                    const ImDrawIdx idx = (ImDrawIdx)window->DrawList->_VtxCurrentIdx;
+                    window->DrawList->PrimWriteVtx(ImVec2(x, y_hi), uv, col_base);
+                    window->DrawList->PrimWriteVtx(ImVec2(x, inner_bb.Max.y), uv, col_base);
+                    if (n > 0)
+                    {
+                        window->DrawList->PrimWriteIdx((ImDrawIdx)(idx - 2)); window->DrawList->PrimWriteIdx((ImDrawIdx)(idx - 1)); window->DrawList->PrimWriteIdx((ImDrawIdx)(idx + 1));
+                        window->DrawList->PrimWriteIdx((ImDrawIdx)(idx - 2)); window->DrawList->PrimWriteIdx((ImDrawIdx)(idx + 1)); window->DrawList->PrimWriteIdx(idx);
+                    }
+                }
+            }
+            if (plot_type == ImGuiPlotType_Lines)
+                window->DrawList->PathStroke(col_base, false);
+        }
+        RenderText(ImVec2(frame_bb.Max.x + style.ItemInnerSpacing.x, inner_bb.Min.y), label);
+        return;
+    }
+
     for (int data_idx = 0; data_idx < num_datas; ++data_idx)
     {
         const float t_step = 1.0f / (float) res_w;
@@ -2125,9 +2447,10 @@ void PlotMultiLines(
     int values_count,
     float scale_min,
     float scale_max,
-    ImVec2 graph_size)
+    ImVec2 graph_size,
+    const PlotMinMaxPyramid* const* pyramids)
 {
-    PlotMultiEx(ImGuiPlotType_Lines, label, num_datas, names, colors, getter, datas, values_count, scale_min, scale_max, graph_size);
+    PlotMultiEx(ImGuiPlotType_Lines, label, num_datas, names, colors, getter, datas, values_count, 0, scale_min, scale_max, graph_size, pyramids);
 }
 
 void PlotMultiHistograms(
@@ -2140,11 +2463,37 @@ void PlotMultiHistograms(
     int values_count,
     float scale_min,
     float scale_max,
-    ImVec2 graph_size)
+    ImVec2 graph_size,
+    const PlotMinMaxPyramid* const* pyramids)
 {
-    PlotMultiEx(ImGuiPlotType_Histogram, label, num_hists, names, colors, getter, datas, values_count, scale_min, scale_max, graph_size);
+    PlotMultiEx(ImGuiPlotType_Histogram, label, num_hists, names, colors, getter, datas, values_count, 0, scale_min, scale_max, graph_size, pyramids);
 }
 // End PlotMultiLines(...) and PlotMultiHistograms(...)--------------------------
+// Start PlotRingBuffer plot overloads -------------------------------------
+static float PlotRingBufferGetter(const void* data, int idx) {return ((const float*)data)[idx];}
+int PlotHistogram(const char* label, const PlotRingBuffer& buffer, int channel, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size,float histogramGroupSpacingInPixels,int* pOptionalHoveredHistogramIndexOut,float fillColorGradientDeltaIn0_05,const ImU32* pColorsOverride,int numColorsOverride)  {
+    const PlotRingBufferInternal* rb = buffer.ptr;
+    IM_ASSERT(channel>=-1 && channel<rb->numChannels);
+    const int first = channel<0 ? 0 : channel, count = channel<0 ? rb->numChannels : 1;
+    rb->lock();
+    int hovered = PlotHistogram(label, (const float**)&rb->channels[first], count, rb->size, rb->start, overlay_text, scale_min, scale_max, graph_size, sizeof(float), histogramGroupSpacingInPixels, pOptionalHoveredHistogramIndexOut, fillColorGradientDeltaIn0_05, pColorsOverride, numColorsOverride, &rb->channelPyramids[first]);
+    if (hovered>=0) hovered = (hovered-rb->start+rb->capacity)%rb->capacity;
+    rb->unlock();
+    return hovered;
+}
+void PlotMultiLines(const char* label, const PlotRingBuffer& buffer, const char** names, const ImColor* colors, float scale_min, float scale_max, ImVec2 graph_size)  {
+    const PlotRingBufferInternal* rb = buffer.ptr;
+    rb->lock();
+    if (rb->size>0) PlotMultiEx(ImGuiPlotType_Lines, label, rb->numChannels, names, colors, &PlotRingBufferGetter, (const void* const*)rb->channels.Data, rb->size, rb->start, scale_min, scale_max, graph_size, rb->channelPyramids.Data);
+    rb->unlock();
+}
+void PlotMultiHistograms(const char* label, const PlotRingBuffer& buffer, const char** names, const ImColor* colors, float scale_min, float scale_max, ImVec2 graph_size)  {
+    const PlotRingBufferInternal* rb = buffer.ptr;
+    rb->lock();
+    if (rb->size>0) PlotMultiEx(ImGuiPlotType_Histogram, label, rb->numChannels, names, colors, &PlotRingBufferGetter, (const void* const*)rb->channels.Data, rb->size, rb->start, scale_min, scale_max, graph_size, rb->channelPyramids.Data);
+    rb->unlock();
+}
+// End PlotRingBuffer plot overloads ---------------------------------------
 
 int DefaultInputTextAutoCompletionCallback(ImGuiTextEditCallbackData *data) {
     InputTextWithAutoCompletionData& mad = *((InputTextWithAutoCompletionData*) data->UserData);
@@ -2159,9 +2508,16 @@ int DefaultInputTextAutoCompletionCallback(ImGuiTextEditCallbackData *data) {
     return 0;
 }
 float InputTextWithAutoCompletionData::Opacity = 0.6f;
+// Items coming from an ImGuiCompletionIndex can be searched directly, instead of through the getter
+static inline const ImGuiCompletionIndex* GetAutoCompletionIndex(bool (*items_getter)(void*, int, const char**), int items_count, void* user_data) {
+    if (items_getter!=&ImGuiCompletionIndex::ItemGetter || !user_data) return NULL;
+    const ImGuiCompletionIndex* index = (const ImGuiCompletionIndex*) user_data;
+    return (index->Size()==items_count) ? index : NULL;
+}
 int InputTextWithAutoCompletionData::HelperGetItemInsertionPosition(const char* txt,bool (*items_getter)(void*, int, const char**), int items_count, void* user_data,bool* item_is_already_present_out) {
     if (item_is_already_present_out) *item_is_already_present_out=false;
     if (!txt || txt[0]=='\0' || !items_getter || items_count<0) return -1;
+    if (const ImGuiCompletionIndex* index = GetAutoCompletionIndex(items_getter,items_count,user_data)) return index->LowerBound(txt,item_is_already_present_out);
     const char* itxt = NULL;int cmp = 0;
     for (int i=0;i<items_count;i++) {
         if (items_getter(user_data,i,&itxt))   {
@@ -2200,7 +2556,12 @@ bool InputTextWithAutoCompletion(const char* label, char* buf, size_t buf_size,
         if (strlen(buf)>0)  {
             const char* txt=NULL;
             int itemPlacement = 0,comp = 0, alreadyPresentIndex = -1;
-            for (int i=0;i<autocompletion_items_size;i++) {
+            if (const ImGuiCompletionIndex* index = GetAutoCompletionIndex(autocompletion_items_getter,autocompletion_items_size,autocompletion_user_data)) {
+                bool found = false;
+                itemPlacement = index->LowerBound(buf,&found);
+                if (found) alreadyPresentIndex = itemPlacement;
+            }
+            else for (int i=0;i<autocompletion_items_size;i++) {
                 if (autocompletion_items_getter(autocompletion_user_data,i,&txt))   {
                     comp = strcmp(buf,txt);
                     if (comp>0) ++itemPlacement;
@@ -2226,10 +2587,24 @@ bool InputTextWithAutoCompletion(const char* label, char* buf, size_t buf_size,
                 ad.deltaTTItems = 0;    // We reset the UP/DOWN offset whe text changes
             }
 
-            int selectedTTItemIndex = numItems-1;
+            // With a fuzzy matcher, menu rows are the best matches. Otherwise they are the items (sorted) around the text.
+            ImGuiFuzzyMatcher* fm = ad.fuzzyMatcher;
+            if (fm) {
+                fm->SetItems(autocompletion_items_getter,autocompletion_user_data,numItems);
+                fm->SetQuery(buf);
+                fm->Update();
+            }
+            const int numRows = fm ? fm->GetResultsCount() : numItems;
+            int selectedTTItemIndex = numItems-1;   // row index
             const char* txt=NULL;
             // We need to fetch the selectedTTItemIndex here
-            if (ad.lastSelectedTTItemIndex>=0 && ad.lastSelectedTTItemIndex<numItems && autocompletion_items_getter(autocompletion_user_data,ad.lastSelectedTTItemIndex,&txt))   {
+            const ImGuiCompletionIndex* index = fm ? NULL : GetAutoCompletionIndex(autocompletion_items_getter,numItems,autocompletion_user_data);
+            if (fm) selectedTTItemIndex = 0;   // best match
+            else if (index) {
+                const int lb = index->LowerBound(buf);
+                selectedTTItemIndex = lb<numItems ? lb : numItems-1;
+            }
+            else if (ad.lastSelectedTTItemIndex>=0 && ad.lastSelectedTTItemIndex<numItems && autocompletion_items_getter(autocompletion_user_data,ad.lastSelectedTTItemIndex,&txt))   {
                 // Speed up branch (we start our search from previous frame: ad.lastSelectedTTItemIndex
                 int i = ad.lastSelectedTTItemIndex;
                 //int cnt = 0;
@@ -2262,13 +2637,14 @@ bool InputTextWithAutoCompletion(const char* label, char* buf, size_t buf_size,
                     }
                 }
             }
-            if (selectedTTItemIndex + ad.deltaTTItems>=numItems) ad.deltaTTItems=numItems-selectedTTItemIndex-1;
-            else if (selectedTTItemIndex + ad.deltaTTItems<0) ad.deltaTTItems=-selectedTTItemIndex;
-            ad.lastSelectedTTItemIndex=selectedTTItemIndex+=ad.deltaTTItems;
+            if (selectedTTItemIndex + ad.deltaTTItems>=numRows) ad.deltaTTItems=numRows-selectedTTItemIndex-1;
+            if (selectedTTItemIndex + ad.deltaTTItems<0) ad.deltaTTItems=-selectedTTItemIndex;
+            selectedTTItemIndex+=ad.deltaTTItems;
+            if (!fm) ad.lastSelectedTTItemIndex=selectedTTItemIndex;
             if (ad.tabPressed)  {
-                if (selectedTTItemIndex<numItems) {
+                if (selectedTTItemIndex>=0 && selectedTTItemIndex<numRows) {
                     const char* selectedTTItemText=NULL;
-                    if (!autocompletion_items_getter(autocompletion_user_data,selectedTTItemIndex,&selectedTTItemText))   {
+                    if (!autocompletion_items_getter(autocompletion_user_data,fm ? fm->GetResult(selectedTTItemIndex).Index : selectedTTItemIndex,&selectedTTItemText))   {
                         IM_ASSERT(true);
                     }
                     IM_ASSERT(selectedTTItemText && strlen(selectedTTItemText)>0);
@@ -2278,13 +2654,14 @@ bool InputTextWithAutoCompletion(const char* label, char* buf, size_t buf_size,
                 }
                 ad.deltaTTItems=0;
             }
+            if (numRows==0) {ad.tabPressed=false;return rv;}   // no fuzzy match
 
             const int MaxNumTooltipItems = num_visible_autocompletion_items>0 ? num_visible_autocompletion_items : 7;
             const float textLineHeightWithSpacing = ImGui::GetTextLineHeightWithSpacing();
             const ImVec2 storedCursorScreenPos = ImGui::GetCursorScreenPos();
             const int MaxNumItemsBelowInputText = (ImGui::GetIO().DisplaySize.y - (storedCursorScreenPos.y+textLineHeightWithSpacing))/textLineHeightWithSpacing;
             const int MaxNumItemsAboveInputText = storedCursorScreenPos.y/textLineHeightWithSpacing;
-            int numTTItems = numItems>MaxNumTooltipItems?MaxNumTooltipItems:numItems;
+            int numTTItems = numRows>MaxNumTooltipItems?MaxNumTooltipItems:numRows;
             bool useUpperScreen = false;
             if (numTTItems>MaxNumItemsBelowInputText && MaxNumItemsBelowInputText<MaxNumItemsAboveInputText)    {
                 useUpperScreen = true;
@@ -2294,7 +2671,7 @@ bool InputTextWithAutoCompletion(const char* label, char* buf, size_t buf_size,
 
             const int numTTItemsHalf = numTTItems/2;
             int firstTTItemIndex = selectedTTItemIndex-numTTItemsHalf;
-            if (selectedTTItemIndex+numTTItemsHalf>=numItems) firstTTItemIndex = numItems-numTTItems;
+            if (selectedTTItemIndex+numTTItemsHalf>=numRows) firstTTItemIndex = numRows-numTTItems;
             if (firstTTItemIndex<0) firstTTItemIndex=0;
 
             const ImVec2 inputTextBoxSize = ImGui::GetItemRectSize();
@@ -2317,8 +2694,9 @@ bool InputTextWithAutoCompletion(const char* label, char* buf, size_t buf_size,
             {
                 // We must always use newCursorScreenPos when mnually drawing inside this window
                 if (!window) window = ImGui::GetCurrentWindowRead();
-                for (int i=firstTTItemIndex,iSz=firstTTItemIndex+numTTItems;i<iSz;i++) {
-                    const ImVec2 start(newCursorScreenPos.x,newCursorScreenPos.y+(i-firstTTItemIndex)*textLineHeightWithSpacing);
+                for (int row=firstTTItemIndex,rowSz=firstTTItemIndex+numTTItems;row<rowSz;row++) {
+                    const int i = fm ? fm->GetResult(row).Index : row;
+                    const ImVec2 start(newCursorScreenPos.x,newCursorScreenPos.y+(row-firstTTItemIndex)*textLineHeightWithSpacing);
                     if (i==ad.currentAutocompletionItemIndex) {
                         ImVec2 end(start.x+ttWindowSize.x-1,start.y+textLineHeightWithSpacing);
                         ImU32 col = ImGui::ColorConvertFloat4ToU32(ImGui::GetStyle().Colors[ImGuiCol_Header]);
@@ -2327,7 +2705,7 @@ bool InputTextWithAutoCompletion(const char* label, char* buf, size_t buf_size,
 
                         ImGui::PushStyleColor(ImGuiCol_Text,ImGui::GetStyle().Colors[ImGuiCol_TextDisabled]);
                     }
-                    if (i==selectedTTItemIndex) {
+                    if (row==selectedTTItemIndex) {
                         ImVec2 end(start.x+ttWindowSize.x-1,start.y+textLineHeightWithSpacing);
                         ImU32 col = ImGui::ColorConvertFloat4ToU32(ImGui::GetStyle().Colors[ImGuiCol_Button]);
                         ImGui::GetWindowDrawList()->AddRectFilled(start,end,col,0,0);
@@ -2532,6 +2910,8 @@ struct MyTreeViewHelperStruct {
     float arrowOffset;
     TreeViewNode::Event& event;
     bool hasCbGlyphs,hasArrowGlyphs;
+    int rowIndex;                   // visible row being rendered
+    ImVector<int> toggledRows;      // visible rows whose STATE_OPEN was toggled by the user in this frame
     struct ContextMenuDataStruct {
         TreeViewNode* activeNode;
         TreeView* parentTreeView;
@@ -2559,7 +2939,7 @@ struct MyTreeViewHelperStruct {
         void reset() {*this = NameEditingStruct();}
     };
     static NameEditingStruct NameEditing;
-    MyTreeViewHelperStruct(TreeView& parent,TreeViewNode::Event& _event) : parentTreeView(parent),mustDrawAllNodesAsDisabled(false),event(_event) {
+    MyTreeViewHelperStruct(TreeView& parent,TreeViewNode::Event& _event) : parentTreeView(parent),mustDrawAllNodesAsDisabled(false),event(_event),rowIndex(-1) {
         window = ImGui::GetCurrentWindow();
         windowWidth = ImGui::GetWindowWidth();
         hasCbGlyphs=TreeView::FontCheckBoxGlyphs[0][0]!='\0';
@@ -2572,6 +2952,22 @@ struct MyTreeViewHelperStruct {
         event.wasStateRemoved = _eventFlagRemoved;
         if (event.state!=TreeViewNode::STATE_NONE) event.type = TreeViewNode::EVENT_STATE_CHANGED;
     }
+    inline static int IMGUIVC_CDECL IntReverseComparer(const void *p1, const void *p2)  {
+        return (*(const int*)p2)-(*(const int*)p1);
+    }
+    // Appends the rows of "n" and of its visible descendants, in display order
+    static void AppendVisibleRows(TreeViewNode* n,int numIndents,const TreeView& tv,ImVector<TreeView::VisibleRow>& rows) {
+        if (n->state&TreeViewNode::STATE_HIDDEN) return;
+        const bool isLeafNode = !n->childNodes;
+        const bool mustSkipToLeafNodes = !isLeafNode && tv.collapseToLeafNodesAtNodeDepth>=0 && numIndents-1>=tv.collapseToLeafNodesAtNodeDepth;
+        if (!mustSkipToLeafNodes) {
+            TreeView::VisibleRow row;row.node = n;row.numIndents = numIndents;
+            rows.push_back(row);
+        }
+        if (!isLeafNode && ((n->state&TreeViewNode::STATE_OPEN) || mustSkipToLeafNodes))  {
+            for (int i=0,isz=n->childNodes->size();i<isz;i++) AppendVisibleRows((*n->childNodes)[i],numIndents+(mustSkipToLeafNodes?0:1),tv,rows);
+        }
+    }
     // Sorters
     inline static int IMGUIVC_CDECL SorterByDisplayName(const void *pn1, const void *pn2)  {
         const char* s1 = (*((const TreeViewNode**)pn1))->data.displayName;
@@ -2613,6 +3009,87 @@ struct MyTreeViewHelperStruct {
         const TreeViewNode* n1 = *((const TreeViewNode**)pn2);
         return n1->data.userId-n2->data.userId;
     }
+    // Sort keys: the first 8 bytes of the string packed in big endian order (comparing two prefixes compares their bytes like strcmp()),
+    // or the userId biased to unsigned. Equal prefixes fall back to strcmp() on the rest of the strings.
+    enum SortKeyType {SORT_KEY_NONE=0,SORT_KEY_DISPLAY_NAME,SORT_KEY_TOOLTIP,SORT_KEY_USER_TEXT,SORT_KEY_USER_ID};
+    struct SortKey {
+        ImU64 prefix;
+        const char* text;   // NULL for userIds and for NULL strings
+        int index;          // index of the node before sorting: it makes the sort stable
+    };
+    static void FillSortKey(SortKey& k,const TreeViewNode* n,int keyType,int index) {
+        k.index = index;k.text = NULL;
+        if (keyType==SORT_KEY_USER_ID) {k.prefix = (ImU64)((unsigned int)n->data.userId^0x80000000U);return;}
+        const char* s = keyType==SORT_KEY_DISPLAY_NAME ? n->data.displayName : (keyType==SORT_KEY_TOOLTIP ? n->data.tooltip : n->data.userText);
+        if (!s) {k.prefix = ~(ImU64)0;return;}  // NULL strings go last
+        k.text = s;k.prefix = 0;
+        int i=0;
+        for (;i<8 && s[i];i++) k.prefix = (k.prefix<<8)|(unsigned char)s[i];
+        if (i>0) k.prefix<<=(8*(8-i));     // (a shift by 64 is undefined)
+    }
+    static int CompareSortKeys(const SortKey& k1,const SortKey& k2) {
+        if (k1.prefix!=k2.prefix) return k1.prefix<k2.prefix ? -1 : 1;
+        if (k1.text==k2.text) return 0;
+        if (!k1.text) return 1;
+        if (!k2.text) return -1;
+        if ((k1.prefix&0xFF)==0) return 0;  // both strings end inside the prefix
+        return strcmp(k1.text+8,k2.text+8);
+    }
+    inline static int IMGUIVC_CDECL SortKeyComparer(const void *p1, const void *p2)  {
+        const SortKey& k1 = *((const SortKey*)p1);const SortKey& k2 = *((const SortKey*)p2);
+        const int c = CompareSortKeys(k1,k2);
+        return c ? c : (k1.index-k2.index);
+    }
+    inline static int IMGUIVC_CDECL SortKeyReverseComparer(const void *p1, const void *p2)  {
+        const SortKey& k1 = *((const SortKey*)p1);const SortKey& k2 = *((const SortKey*)p2);
+        const int c = CompareSortKeys(k2,k1);
+        return c ? c : (k1.index-k2.index);
+    }
+    // The child node vectors to sort, each with its own slice of scratch space, so that they can be sorted in parallel
+    struct SortJob {
+        ImVector<TreeViewNode*> parentNodes;
+        ImVector<int> offsets;
+        ImVector<SortKey> keys;
+        ImVector<TreeViewNode*> nodes;
+        int keyType;
+        bool reverseOrder;
+        int (*comp)(const void *, const void *);
+    };
+    static void SortChildNodesOf(int index,void* userPtr) {
+        const SortJob& job = *((const SortJob*)userPtr);
+        TreeViewNode* p = job.parentNodes[index];
+        ImVector<TreeViewNode*>& c = *p->childNodes;
+        const int isz = c.size();
+        if (job.keyType==SORT_KEY_NONE) qsort(&c[0],isz,sizeof(TreeViewNode*),job.comp);
+        else {
+            SortKey* keys = (SortKey*) &job.keys[job.offsets[index]];
+            TreeViewNode** nodes = (TreeViewNode**) &job.nodes[job.offsets[index]];
+            for (int i=0;i<isz;i++) {FillSortKey(keys[i],c[i],job.keyType,i);nodes[i]=c[i];}
+            qsort(keys,isz,sizeof(SortKey),job.reverseOrder ? SortKeyReverseComparer : SortKeyComparer);
+            for (int i=0;i<isz;i++) c[i] = nodes[keys[i].index];
+        }
+        p->updateChildNodeIndices();
+    }
+    static void SortChildNodes(TreeViewNode* n,bool recursive,int keyType,bool reverseOrder,int (*comp)(const void *, const void *)) {
+        SortJob job;
+        job.keyType = keyType;job.reverseOrder = reverseOrder;job.comp = comp;
+        int numNodes = 0;
+        ImVector<TreeViewNode*> stack;
+        stack.push_back(n);
+        while (stack.size()>0) {
+            TreeViewNode* p = stack.back();stack.pop_back();
+            if (!p->childNodes) continue;
+            const int isz = p->childNodes->size();
+            if (isz>1) {job.parentNodes.push_back(p);job.offsets.push_back(numNodes);numNodes+=isz;}
+            if (recursive) for (int i=0;i<isz;i++) if ((*p->childNodes)[i]->childNodes) stack.push_back((*p->childNodes)[i]);
+        }
+        if (job.parentNodes.size()==0) return;
+        if (keyType!=SORT_KEY_NONE) {job.keys.resize(numNodes);job.nodes.resize(numNodes);}
+        int threadsCount = 1;
+        if (job.parentNodes.size()>1 && numNodes>=4096) threadsCount = TreeView::SortThreadsCount>0 ? TreeView::SortThreadsCount : ImGetHardwareThreadsCount();
+        ImParallelFor(job.parentNodes.size(),SortChildNodesOf,&job,threadsCount);
+        n->onVisibilityChanged();
+    }
     // Serialization
 #if (defined(IMGUIHELPER_H_) && !defined(NO_IMGUIHELPER_SERIALIZATION))
 #ifndef NO_IMGUIHELPER_SERIALIZATION_SAVE
@@ -2773,99 +3250,82 @@ TreeViewNode::~TreeViewNode() {
     if (this == MyTreeViewHelperStruct::NameEditing.editingNode) MyTreeViewHelperStruct::NameEditing.reset();
     //dbgDisplay();
     if (childNodes) {
-        // delete child nodes
-        //for (int i=0,isz=childNodes->size();i<isz;i++)    // Wrong !!
-        while (childNodes->size()>0)                        // Right !!
-        {
-	    TreeViewNode* n = (*childNodes)[0];
-            if (n) {
-		n->~TreeViewNode();
-                ImGui::MemFree(n);
-            }
-        }
-        childNodes->clear();
-        childNodes->~ImVector<TreeViewNode*>();
-        ImGui::MemFree(childNodes);
+        // delete child nodes (starting from the last one, so that no sibling must be shifted)
+        while (childNodes->size()>0) DeleteNode(childNodes->back());
         childNodes=NULL;
     }
+    childNodeVector.clear();
     if (parentNode && parentNode->childNodes) {
         // remove this node from parentNode->childNodes
-        for (int i=0,isz=parentNode->childNodes->size();i<isz;i++) {
-	    TreeViewNode* n = (*(parentNode->childNodes))[i];
-            if (n==this) {
-                for (int j=i+1;j<isz;j++) (*(parentNode->childNodes))[j-1] = (*(parentNode->childNodes))[j];
-                parentNode->childNodes->pop_back();
-                break;
-            }
-        }
-    }
-    if (parentNode) {
-        TreeView& tv = getTreeView();
+        ImVector<TreeViewNode*>& siblings = *parentNode->childNodes;
+        IM_ASSERT(nodeIndex>=0 && nodeIndex<siblings.size() && siblings[nodeIndex]==this);
+        siblings.erase(siblings.Data+nodeIndex);
+        parentNode->updateChildNodeIndices(nodeIndex);
+        onVisibilityChanged();
+    }
+    if (parentNode && treeView) {
+        TreeView& tv = *treeView;
         if (tv.treeViewNodeCreationDelationCb) tv.treeViewNodeCreationDelationCb(this,tv,true,tv.treeViewNodeCreationDelationCbUserPtr);
     }
     parentNode = NULL;
 }
 
-TreeViewNode::TreeViewNode(const Data& _data, TreeViewNode *_parentNode, int nodeIndex, bool addEmptyChildNodeVector) : userPtr(NULL),data(_data) {
-    parentNode = NULL;
+TreeViewNode::TreeViewNode(const Data& _data, TreeViewNode *_parentNode, int _nodeIndex, bool addEmptyChildNodeVector) : userPtr(NULL),data(_data) {
     childNodes = NULL;
     state = 0;
     parentNode = _parentNode;
+    treeView = parentNode ? parentNode->treeView : NULL;
+    depth = parentNode ? (parentNode->depth+1) : -1;
+    nodeIndex = 0;
     if (parentNode) {
         //We must add this node to parentNode->childNodes
-        if (!parentNode->childNodes)    {
-            parentNode->childNodes = (ImVector<TreeViewNode*>*) ImGui::MemAlloc(sizeof(ImVector<TreeViewNode*>));
-            IM_PLACEMENT_NEW(parentNode->childNodes) ImVector<TreeViewNode*>();
-            parentNode->childNodes->push_back(this);
-        }
-        else if (nodeIndex<0 || nodeIndex>=parentNode->childNodes->size()) {
+        if (!parentNode->childNodes) parentNode->childNodes = &parentNode->childNodeVector;
+        ImVector<TreeViewNode*>& siblings = *parentNode->childNodes;
+        if (_nodeIndex<0 || _nodeIndex>=siblings.size()) {
             // append at the end
-            parentNode->childNodes->push_back(this);
+            nodeIndex = siblings.size();
+            siblings.push_back(this);
         }
         else {
-            // insert "this" at "nodeIndex"
-            const int isz = parentNode->childNodes->size();
-            parentNode->childNodes->resize(parentNode->childNodes->size()+1);
-            for (int j=isz;j>nodeIndex;j--) (*(parentNode->childNodes))[j] = (*(parentNode->childNodes))[j-1];
-            (*(parentNode->childNodes))[nodeIndex] = this;
+            // insert "this" at "_nodeIndex"
+            siblings.insert(siblings.Data+_nodeIndex,this);
+            parentNode->updateChildNodeIndices(_nodeIndex);
         }
+        onVisibilityChanged();
     }
-    if (addEmptyChildNodeVector) {
-        childNodes = (ImVector<TreeViewNode*>*) ImGui::MemAlloc(sizeof(ImVector<TreeViewNode*>));
-        IM_PLACEMENT_NEW(childNodes) ImVector<TreeViewNode*>();
-    }
-    if (parentNode) {
-        TreeView& tv = getTreeView();
+    if (addEmptyChildNodeVector) childNodes = &childNodeVector;
+    if (parentNode && treeView) {
+        TreeView& tv = *treeView;
         if (tv.treeViewNodeCreationDelationCb) tv.treeViewNodeCreationDelationCb(this,tv,false,tv.treeViewNodeCreationDelationCbUserPtr);
     }
 }
 
 
 TreeViewNode *TreeViewNode::CreateNode(const Data& _data, TreeViewNode *_parentNode, int nodeIndex, bool addEmptyChildNodeVector) {
-    TreeViewNode* n = (TreeViewNode*) ImGui::MemAlloc(sizeof(TreeViewNode));
+    TreeView* tv = _parentNode ? _parentNode->treeView : NULL;
+    TreeViewNode* n = (TreeViewNode*) (tv ? tv->allocNodeMemory() : ImGui::MemAlloc(sizeof(TreeViewNode)));
     IM_PLACEMENT_NEW(n) TreeViewNode(_data,_parentNode,nodeIndex,addEmptyChildNodeVector);
     return n;
 }
 
 void TreeViewNode::DeleteNode(TreeViewNode *n) {
     if (n)  {
+        IM_ASSERT(n->parentNode || n->treeView!=n);   // A TreeView can't be deleted this way
+        TreeView* tv = n->treeView;
         n->~TreeViewNode();
-        ImGui::MemFree(n);
+        if (tv) tv->freeNodeMemory(n);
+        else ImGui::MemFree(n);
     }
 }
 
 TreeView &TreeViewNode::getTreeView() {
-    TreeViewNode* n = this;
-    while (n->parentNode) n=n->parentNode;
-    IM_ASSERT(n);
-    return *(static_cast < TreeView* > (n));
+    IM_ASSERT(treeView);
+    return *treeView;
 }
 
 const TreeView &TreeViewNode::getTreeView() const {
-    const TreeViewNode* n = this;
-    while (n->parentNode) n=n->parentNode;
-    IM_ASSERT(n);
-    return *(static_cast < const TreeView* > (n));
+    IM_ASSERT(treeView);
+    return *treeView;
 }
 
 TreeViewNode *TreeViewNode::getParentNode() {return (parentNode && parentNode->parentNode) ? parentNode : NULL;}
@@ -2873,31 +3333,27 @@ TreeViewNode *TreeViewNode::getParentNode() {return (parentNode && parentNode->p
 const TreeViewNode *TreeViewNode::getParentNode() const {return (parentNode && parentNode->parentNode) ? parentNode : NULL;}
 
 int TreeViewNode::getNodeIndex() const   {
-    if (!parentNode || !parentNode->childNodes) return 0;
-    for (int i=0,isz=parentNode->childNodes->size();i<isz;i++)  {
-        if ( (*parentNode->childNodes)[i] == this ) return i;
-    }
-    return 0;
+    return (parentNode && parentNode->childNodes) ? nodeIndex : 0;
 }
 
 void TreeViewNode::moveNodeTo(int nodeIndex)   {
     if (!parentNode || !parentNode->childNodes) return;
-    const int isz = parentNode->childNodes->size();
+    ImVector<TreeViewNode*>& siblings = *parentNode->childNodes;
+    const int isz = siblings.size();
     if (isz<2) return;
     if (nodeIndex<0 || nodeIndex>=isz) nodeIndex = isz-1;
-    const int curNodeIndex = getNodeIndex();
+    const int curNodeIndex = this->nodeIndex;
     if (curNodeIndex==nodeIndex) return;
-    if (curNodeIndex<nodeIndex) {
-        for (int i=curNodeIndex;i<nodeIndex;i++)  (*parentNode->childNodes)[i] = (*parentNode->childNodes)[i+1];
-    }
-    else {
-        for (int i=curNodeIndex;i>nodeIndex;i--)  (*parentNode->childNodes)[i] = (*parentNode->childNodes)[i-1];
-    }
-    (*parentNode->childNodes)[nodeIndex] = this;
+    if (curNodeIndex<nodeIndex) memmove(&siblings[curNodeIndex],&siblings[curNodeIndex+1],(size_t)(nodeIndex-curNodeIndex)*sizeof(TreeViewNode*));
+    else memmove(&siblings[nodeIndex+1],&siblings[nodeIndex],(size_t)(curNodeIndex-nodeIndex)*sizeof(TreeViewNode*));
+    siblings[nodeIndex] = this;
+    const int minIndex = ImMin(curNodeIndex,nodeIndex), maxIndex = ImMax(curNodeIndex,nodeIndex);
+    for (int i=minIndex;i<=maxIndex;i++) siblings[i]->nodeIndex = i;
+    onVisibilityChanged();
 }
 void TreeViewNode::deleteAllChildNodes(bool leaveEmptyChildNodeVector)  {
     if (childNodes && childNodes->size()>0) {
-        while (childNodes->size()>0)    DeleteNode((*childNodes)[0]);
+        while (childNodes->size()>0)    DeleteNode(childNodes->back());
         childNodes->clear();
     }
     if (!childNodes) {
@@ -2907,15 +3363,29 @@ void TreeViewNode::deleteAllChildNodes(bool leaveEmptyChildNodeVector)  {
 }
 void TreeViewNode::addEmptyChildNodeVector()    {
     if (!childNodes) {
-        childNodes = (ImVector<TreeViewNode*>*) ImGui::MemAlloc(sizeof(ImVector<TreeViewNode*>));
-        IM_PLACEMENT_NEW(childNodes) ImVector<TreeViewNode*>();
+        childNodes = &childNodeVector;
+        onVisibilityChanged();
     }
 }
 void TreeViewNode::removeEmptyChildNodeVector() {
     if (childNodes && childNodes->size()==0)    {
-        childNodes->~ImVector<TreeViewNode*>();
-        ImGui::MemFree(childNodes);
+        childNodeVector.clear();
         childNodes=NULL;
+        onVisibilityChanged();
+    }
+}
+void TreeViewNode::onVisibilityChanged() const {
+    if (treeView) treeView->visibleRowsDirty = true;
+}
+void TreeViewNode::setDepth(int _depth) {
+    depth = _depth;
+    if (childNodes) {
+        for (int i=0,isz=childNodes->size();i<isz;i++) (*childNodes)[i]->setDepth(_depth+1);
+    }
+}
+void TreeViewNode::updateChildNodeIndices(int startIndex) {
+    if (childNodes) {
+        for (int i=startIndex,isz=childNodes->size();i<isz;i++) (*childNodes)[i]->nodeIndex = i;
     }
 }
 int TreeViewNode::getNumSiblings(bool includeMe) const	{
@@ -2933,40 +3403,56 @@ const TreeViewNode *TreeViewNode::getSiblingNode(int nodeIndexInParentHierarchy)
     return (*parentNode->childNodes)[nodeIndexInParentHierarchy];
 }
 int TreeViewNode::getDepth() const  {
-    const TreeViewNode* n = this;int depth = -1;
-    while ((n = n->parentNode)) ++depth;
     return depth;
 }
 
 void TreeViewNode::Swap(TreeViewNode *&n1, TreeViewNode *&n2) {
-    // To test
-    if (!n1 || !n2) return;
-    {TreeViewNode* tmp = n1->parentNode;n1->parentNode=n2->parentNode;n2->parentNode = tmp;}
-    {ImVector<TreeViewNode*>* tmp = n1->childNodes;n1->childNodes=n2->childNodes;n2->childNodes=tmp;}
+    if (!n1 || !n2 || n1==n2 || !n1->parentNode || !n2->parentNode) return;
+    IM_ASSERT(n1->treeView==n2->treeView);
+    // A node can't take the place of one of its descendants
+    for (const TreeViewNode* p = n1->parentNode;p;p=p->parentNode) {if (p==n2) return;}
+    for (const TreeViewNode* p = n2->parentNode;p;p=p->parentNode) {if (p==n1) return;}
+    TreeViewNode* p1 = n1->parentNode;const int i1 = n1->nodeIndex;
+    TreeViewNode* p2 = n2->parentNode;const int i2 = n2->nodeIndex;
+    (*p1->childNodes)[i1] = n2;n2->parentNode = p1;n2->nodeIndex = i1;
+    (*p2->childNodes)[i2] = n1;n1->parentNode = p2;n1->nodeIndex = i2;
+    if (n1->depth!=n2->depth) {const int d1 = n1->depth;n1->setDepth(n2->depth);n2->setDepth(d1);}
+    n1->onVisibilityChanged();
 }
 
 void TreeViewNode::sortChildNodes(bool recursive,int (*comp)(const void *, const void *)) {
-    if (childNodes && childNodes->size()>1)  {
-        if (recursive) {
-            for (int i=0,isz=childNodes->size();i<isz;i++) (*childNodes)[i]->sortChildNodes(recursive,comp);
-        }
-        qsort(&(*childNodes)[0],childNodes->size(),sizeof(TreeViewNode*),comp);
-    }
+    MyTreeViewHelperStruct::SortChildNodes(this,recursive,MyTreeViewHelperStruct::SORT_KEY_NONE,false,comp);
 }
 void TreeViewNode::sortChildNodesByDisplayName(bool recursive, bool reverseOrder)    {
-    sortChildNodes(recursive,reverseOrder ? MyTreeViewHelperStruct::SorterByDisplayNameReverseOrder : &MyTreeViewHelperStruct::SorterByDisplayName);
+    MyTreeViewHelperStruct::SortChildNodes(this,recursive,MyTreeViewHelperStruct::SORT_KEY_DISPLAY_NAME,reverseOrder,NULL);
 }
 void TreeViewNode::sortChildNodesByTooltip(bool recursive,bool reverseOrder)  {
-    sortChildNodes(recursive,reverseOrder ? MyTreeViewHelperStruct::SorterByTooltipReverseOrder : MyTreeViewHelperStruct::SorterByTooltip);
+    MyTreeViewHelperStruct::SortChildNodes(this,recursive,MyTreeViewHelperStruct::SORT_KEY_TOOLTIP,reverseOrder,NULL);
 }
 void TreeViewNode::sortChildNodesByUserText(bool recursive, bool reverseOrder) {
-    sortChildNodes(recursive,reverseOrder ? MyTreeViewHelperStruct::SorterByUserTextReverseOrder : MyTreeViewHelperStruct::SorterByUserText);
+    MyTreeViewHelperStruct::SortChildNodes(this,recursive,MyTreeViewHelperStruct::SORT_KEY_USER_TEXT,reverseOrder,NULL);
 }
 void TreeViewNode::sortChildNodesByUserId(bool recursive,bool reverseOrder)   {
-    sortChildNodes(recursive,reverseOrder ? MyTreeViewHelperStruct::SorterByUserIdReverseOrder : MyTreeViewHelperStruct::SorterByUserId);
+    MyTreeViewHelperStruct::SortChildNodes(this,recursive,MyTreeViewHelperStruct::SORT_KEY_USER_ID,reverseOrder,NULL);
+}
+TreeViewNode* TreeViewNode::addChildNodeSorted(const Data& _data,int (*comp)(const void *, const void *),bool addEmptyChildNodeVector) {
+    TreeViewNode* n = CreateNode(_data,this,-1,addEmptyChildNodeVector);
+    const ImVector<TreeViewNode*>& c = *childNodes;
+    int lo = 0, hi = c.size()-1;    // the last one is "n"
+    while (lo<hi) {
+        const int mid = (lo+hi)>>1;
+        if (comp(&n,&c[mid])<0) hi = mid;
+        else lo = mid+1;
+    }
+    n->moveNodeTo(lo);
+    return n;
+}
+TreeViewNode* TreeViewNode::addChildNodeSortedByDisplayName(const Data& _data,bool reverseOrder,bool addEmptyChildNodeVector) {
+    return addChildNodeSorted(_data,reverseOrder ? MyTreeViewHelperStruct::SorterByDisplayNameReverseOrder : MyTreeViewHelperStruct::SorterByDisplayName,addEmptyChildNodeVector);
 }
 
 void TreeViewNode::addStateToAllChildNodes(int stateFlag,bool recursive) const {
+    if (stateFlag&(STATE_OPEN|STATE_HIDDEN)) onVisibilityChanged();
     if (childNodes) {
         for (int i=0,isz=childNodes->size();i<isz;i++)  {
             if (recursive) (*childNodes)[i]->addStateToAllChildNodes(stateFlag,recursive);
@@ -2975,6 +3461,7 @@ void TreeViewNode::addStateToAllChildNodes(int stateFlag,bool recursive) const {
     }
 }
 void TreeViewNode::removeStateFromAllChildNodes(int stateFlag,bool recursive) const   {
+    if (stateFlag&(STATE_OPEN|STATE_HIDDEN)) onVisibilityChanged();
     if (childNodes) {
         for (int i=0,isz=childNodes->size();i<isz;i++)  {
             if (recursive) (*childNodes)[i]->removeStateFromAllChildNodes(stateFlag,recursive);
@@ -3084,6 +3571,10 @@ TreeView::TreeView(Mode _selectionMode, bool _allowMultipleSelection, Mode _chec
     treeViewNodeCreationDelationCb = NULL;
     treeViewNodeCreationDelationCbUserPtr = NULL;
     inited = false;
+    treeView = this;
+    visibleRowsDirty = true;
+    nodePoolFreeList = NULL;
+    nodePoolBlockUsed = 0;
 
     selectionMode = _selectionMode;
     allowMultipleSelection = _allowMultipleSelection;
@@ -3104,21 +3595,44 @@ TreeView::TreeView(Mode _selectionMode, bool _allowMultipleSelection, Mode _chec
 
 TreeView::~TreeView() {
     if (this == MyTreeViewHelperStruct::ContextMenuData.parentTreeView) MyTreeViewHelperStruct::ContextMenuData.reset();
+    deleteAllChildNodes();  // Before the node storage is released
+    freeAllNodeMemory();
+}
+
+void* TreeView::allocNodeMemory() {
+    if (nodePoolFreeList) {
+        void* mem = nodePoolFreeList;
+        nodePoolFreeList = *((void**)mem);
+        return mem;
+    }
+    if (nodePoolBlocks.size()==0 || nodePoolBlockUsed==NodePoolBlockSize) {
+        nodePoolBlocks.push_back(ImGui::MemAlloc(sizeof(TreeViewNode)*NodePoolBlockSize));
+        nodePoolBlockUsed = 0;
+    }
+    return ((TreeViewNode*)nodePoolBlocks.back())+(nodePoolBlockUsed++);
+}
+void TreeView::freeNodeMemory(void* mem) {
+    *((void**)mem) = nodePoolFreeList;
+    nodePoolFreeList = mem;
+}
+void TreeView::freeAllNodeMemory() {
+    IM_ASSERT(!childNodes || childNodes->size()==0);
+    for (int i=0,isz=nodePoolBlocks.size();i<isz;i++) ImGui::MemFree(nodePoolBlocks[i]);
+    nodePoolBlocks.clear();
+    nodePoolFreeList = NULL;
+    nodePoolBlockUsed = 0;
 }
 
 
 void TreeViewNode::render(void* ptr,int numIndents)   {
-    // basically it should be: numIndents == getDepth() + 1; AFAICS
-    if (state&STATE_HIDDEN) return;
+    // Renders a single row (see TreeView::render()). Basically it should be: numIndents == getDepth() + 1; AFAICS
     MyTreeViewHelperStruct& tvhs = *((MyTreeViewHelperStruct*) ptr);
     TreeView& tv = tvhs.parentTreeView;
 
     bool mustShowMenu = false;
     bool isLeafNode = !childNodes;
 
-    bool mustSkipToLeafNodes = !isLeafNode && tv.collapseToLeafNodesAtNodeDepth>=0 && numIndents-1>=tv.collapseToLeafNodesAtNodeDepth;
-
-    if (!mustSkipToLeafNodes)   {
+    {
         bool mustTreePop = false;
         bool mustTriggerSelection = false;
         bool arrowHovered = false;
@@ -3245,7 +3759,7 @@ void TreeViewNode::render(void* ptr,int numIndents)   {
 
         if (arrowHovered)   {
             if (ImGui::GetIO().MouseClicked[0] && childNodes) {
-                toggleState(STATE_OPEN);
+                state^=STATE_OPEN;tvhs.toggledRows.push_back(tvhs.rowIndex);   // visible rows are updated after all rows are rendered
                 tvhs.fillEvent(this,STATE_OPEN,!(state&STATE_OPEN));
             }
         }
@@ -3258,7 +3772,7 @@ void TreeViewNode::render(void* ptr,int numIndents)   {
             else if (ImGui::GetIO().MouseClicked[0])		{
                 if (allowSelection) mustTriggerSelection = true;
                 else if (childNodes) {
-                    toggleState(STATE_OPEN);
+                    state^=STATE_OPEN;tvhs.toggledRows.push_back(tvhs.rowIndex);
                     tvhs.fillEvent(this,STATE_OPEN,!(state&STATE_OPEN));
                 }
             }
@@ -3276,21 +3790,6 @@ void TreeViewNode::render(void* ptr,int numIndents)   {
 
     }
 
-    if (isStatePresent(STATE_OPEN) || mustSkipToLeafNodes)  {
-        //---------------------------------------------------
-        for (int i=0,isz=childNodes->size();i<isz;i++)   {
-            TreeViewNode* n = (*childNodes)[i];
-            if (n) {
-                const bool oldMustDrawAllNodesAsDisabled = tvhs.mustDrawAllNodesAsDisabled;
-                if (tv.inheritDisabledLook && (state&STATE_DISABLED)) tvhs.mustDrawAllNodesAsDisabled = true;
-                n->render(&tvhs,numIndents+(mustSkipToLeafNodes?0:1));
-                tvhs.mustDrawAllNodesAsDisabled = oldMustDrawAllNodesAsDisabled;
-            }
-        }
-        //---------------------------------------------------
-    }
-
-
     if (mustShowMenu) {
         if (tv.treeViewNodePopupMenuDrawerCb)	{
             tvhs.ContextMenuData.activeNode = this;
@@ -3324,24 +3823,76 @@ bool TreeView::render() {
         // -------------------------------------------------------------
     }
 
+    if (visibleRowsDirty) rebuildVisibleRows();   // after the popup menu, that can add or delete nodes
+
     MyTreeViewHelperStruct tvhs(*this,lastEvent);
 
     ImGui::BeginGroup();
     ImGui::PushID(this);
-    for (int i=0,isz=childNodes->size();i<isz;i++)   {
-        TreeViewNode* n = (*childNodes)[i];
-        tvhs.mustDrawAllNodesAsDisabled = false;
-        if (n) n->render(&tvhs,1);
+    ImGuiVariableListClipper& clipper = visibleRowsClipper;
+    clipper.Begin(visibleRows.size());
+    while (clipper.Step()) {
+        // Callbacks can add or delete nodes: in that case the remaining rows can't be trusted until the next frame
+        for (int i=clipper.DisplayStart;i<clipper.DisplayEnd && !visibleRowsDirty;i++)   {
+            clipper.BeginItem(i);
+            const VisibleRow& row = visibleRows[i];
+            tvhs.mustDrawAllNodesAsDisabled = inheritDisabledLook && row.node->getFirstParentNodeWithState(STATE_DISABLED);
+            tvhs.rowIndex = i;
+            row.node->render(&tvhs,row.numIndents);
+        }
     }
     ImGui::PopID();
     ImGui::EndGroup();
 
+    if (!visibleRowsDirty)  {
+        // Update the visible rows of the nodes opened or closed by the user, starting from the last one, so that the other row indices stay valid
+        if (tvhs.toggledRows.size()>1) ImQsort(tvhs.toggledRows.Data,(size_t)tvhs.toggledRows.Size,sizeof(int),MyTreeViewHelperStruct::IntReverseComparer);
+        for (int i=0;i<tvhs.toggledRows.size();i++) updateVisibleRowsOfToggledNode(tvhs.toggledRows[i]);
+    }
+
     // TODO: Move as much as event handling stuff from TreeViewNode::render() here
 
     return (lastEvent.node!=NULL);
 }
 
-void TreeView::clear() {TreeViewNode::deleteAllChildNodes(true);}
+void TreeView::clear() {TreeViewNode::deleteAllChildNodes(true);freeAllNodeMemory();}
+
+void TreeView::rebuildVisibleRows() {
+    visibleRows.resize(0);
+    if (childNodes) {
+        for (int i=0,isz=childNodes->size();i<isz;i++) MyTreeViewHelperStruct::AppendVisibleRows((*childNodes)[i],1,*this,visibleRows);
+    }
+    visibleRowsClipper.Clear();     // rows are measured again when displayed
+    visibleRowsDirty = false;
+}
+
+void TreeView::updateVisibleRowsOfToggledNode(int rowIndex) {
+    IM_ASSERT(rowIndex>=0 && rowIndex<visibleRows.size());
+    const VisibleRow row = visibleRows[rowIndex];
+    const TreeViewNode* n = row.node;
+    const bool clipperHasRows = visibleRowsClipper.ItemsHeight.size()==visibleRows.size();   // false before the first render() after a rebuild
+
+    // Remove the rows of the descendants (they follow the node row, and they are deeper)
+    int endRowIndex = rowIndex+1;
+    while (endRowIndex<visibleRows.size() && visibleRows[endRowIndex].node->depth>n->depth) ++endRowIndex;
+    if (endRowIndex>rowIndex+1) {
+        visibleRows.erase(visibleRows.Data+rowIndex+1,visibleRows.Data+endRowIndex);
+        if (clipperHasRows) visibleRowsClipper.EraseItems(rowIndex+1,endRowIndex-rowIndex-1);
+    }
+
+    // Insert the rows of the descendants
+    if ((n->state&STATE_OPEN) && n->childNodes)    {
+        ImVector<VisibleRow> rows;
+        for (int i=0,isz=n->childNodes->size();i<isz;i++) MyTreeViewHelperStruct::AppendVisibleRows((*n->childNodes)[i],row.numIndents+1,*this,rows);
+        if (rows.size()>0)  {
+            const int oldSize = visibleRows.size();
+            visibleRows.resize(oldSize+rows.size());
+            memmove(visibleRows.Data+rowIndex+1+rows.size(),visibleRows.Data+rowIndex+1,(size_t)(oldSize-rowIndex-1)*sizeof(VisibleRow));   // may be empty, when the last row was opened
+            memcpy(visibleRows.Data+rowIndex+1,rows.Data,(size_t)rows.size()*sizeof(VisibleRow));
+            if (clipperHasRows) visibleRowsClipper.InsertItems(rowIndex+1,rows.size());
+        }
+    }
+}
 
 ImVec4 *TreeView::getTextColorForStateColor(int aStateColorFlag) const    {
     if (aStateColorFlag&STATE_COLOR1) return &stateColors[0];
@@ -3362,6 +3913,212 @@ void TreeView::setTextColorForStateColor(int aStateColorFlag, const ImVec4 &text
     if (aStateColorFlag&STATE_COLOR3) {stateColors[4] = textColor; stateColors[5] = stateColors[4]; stateColors[5].w = stateColors[4].w * disabledTextColorAlphaFactor;}
 }
 
+// Binary save/load ---------------------------------------------------------------
+#define TREEVIEW_BINARY_MAGIC   "ITVB"
+#define TREEVIEW_BINARY_VERSION 1
+struct TreeViewBinaryHeader {
+    char Magic[4];
+    int Version;
+    int NodesCount;
+    int StringsSize;                // Bytes of the string table (zero-terminated strings), padded to 4
+    ImVec4 StateColors[6];
+    int SelectionMode,CheckboxMode,CollapseToLeafNodesAtNodeDepth;
+    unsigned char AllowMultipleSelection,AllowAutoCheckboxBehaviour,InheritDisabledLook,Pad;
+};
+struct TreeViewBinaryNode {
+    int DepthDelta;                 // Depth minus the depth of the previous node (-1 before the first node)
+    int NumChildNodes;              // -1 when the node has no child node vector (leaf node)
+    int State;
+    int UserId;
+    int DisplayNameOffset;          // Offsets in the string table
+    int TooltipOffset;              // -1 = NULL
+    int UserTextOffset;             // -1 = NULL
+};
+// Open addressing hash set of the strings already in the table
+struct TreeViewBinaryStringTable {
+    ImVector<char> Strings;
+    ImVector<int> Slots;            // Offset in Strings, or -1
+    int Count;
+    TreeViewBinaryStringTable() : Count(0) {}
+    int add(const char* str) {
+        if (!str) return -1;
+        if ((Count+1)*2>Slots.size()) grow(Slots.size()>0 ? Slots.size()*2 : 1024);
+        const int mask = Slots.size()-1;
+        for (int i=(int)ImHashStr(str)&mask;;i=(i+1)&mask) {
+            if (Slots[i]<0) {
+                Slots[i] = Strings.size();++Count;
+                const int len = (int)strlen(str)+1;
+                Strings.resize(Strings.size()+len);
+                memcpy(&Strings[Slots[i]],str,(size_t)len);
+                return Slots[i];
+            }
+            if (strcmp(&Strings[Slots[i]],str)==0) return Slots[i];
+        }
+    }
+    void grow(int numSlots) {
+        ImVector<int> oldSlots;oldSlots.swap(Slots);
+        Slots.resize(numSlots);
+        for (int i=0;i<numSlots;i++) Slots[i]=-1;
+        const int mask = numSlots-1;
+        for (int j=0;j<oldSlots.size();j++) {
+            if (oldSlots[j]<0) continue;
+            int i=(int)ImHashStr(&Strings[oldSlots[j]])&mask;
+            while (Slots[i]>=0) i=(i+1)&mask;
+            Slots[i] = oldSlots[j];
+        }
+    }
+};
+// Calls cb(node,userPtr) on all the nodes in pre-order, without recursion
+static void TreeViewVisitPreOrder(const ImVector<TreeViewNode*>* rootChildNodes,ImVector<const TreeViewNode*>& stack,void (*cb)(const TreeViewNode*,void*),void* userPtr) {
+    stack.resize(0);
+    if (rootChildNodes) for (int i=rootChildNodes->size()-1;i>=0;i--) stack.push_back((*rootChildNodes)[i]);
+    while (stack.size()>0) {
+        const TreeViewNode* n = stack.back();stack.pop_back();
+        cb(n,userPtr);
+        for (int i=n->getNumChildNodes()-1;i>=0;i--) stack.push_back(n->getChildNode(i));
+    }
+}
+
+bool TreeView::saveBinary(const char* filename) const {
+    // First pass: string table
+    struct StringsPass {
+        TreeViewBinaryStringTable table;
+        ImVector<int> offsets;      // 3 per node
+        static void Visit(const TreeViewNode* n,void* userPtr) {
+            StringsPass& p = *((StringsPass*)userPtr);
+            p.offsets.push_back(p.table.add(n->getDisplayName()));
+            p.offsets.push_back(p.table.add(n->getTooltip()));
+            p.offsets.push_back(p.table.add(n->getUserText()));
+        }
+    };
+    StringsPass strings;
+    ImVector<const TreeViewNode*> stack;
+    TreeViewVisitPreOrder(childNodes,stack,&StringsPass::Visit,&strings);
+    while (strings.table.Strings.size()%4) strings.table.Strings.push_back('\0');
+
+    TreeViewBinaryHeader header;
+    memset((void*)&header,0,sizeof(header));
+    memcpy(header.Magic,TREEVIEW_BINARY_MAGIC,sizeof(header.Magic));
+    header.Version = TREEVIEW_BINARY_VERSION;
+    header.NodesCount = strings.offsets.size()/3;
+    header.StringsSize = strings.table.Strings.size();
+    for (int i=0;i<6;i++) header.StateColors[i] = stateColors[i];
+    header.SelectionMode = (int) selectionMode;
+    header.CheckboxMode = (int) checkboxMode;
+    header.CollapseToLeafNodesAtNodeDepth = collapseToLeafNodesAtNodeDepth;
+    header.AllowMultipleSelection = allowMultipleSelection ? 1 : 0;
+    header.AllowAutoCheckboxBehaviour = allowAutoCheckboxBehaviour ? 1 : 0;
+    header.InheritDisabledLook = inheritDisabledLook ? 1 : 0;
+
+    ImFileHandle f = ImFileOpen(filename,"wb");
+    if (!f) return false;
+    bool ok = ImFileWrite(&header,sizeof(header),1,f)==1;
+    if (ok && header.StringsSize>0) ok = ImFileWrite(&strings.table.Strings[0],(ImU64)header.StringsSize,1,f)==1;
+
+    // Second pass: node records, written in chunks
+    struct NodesPass {
+        ImFileHandle f;
+        const int* offsets;
+        int depth;
+        bool ok;
+        ImVector<TreeViewBinaryNode> chunk;
+        void flush() {
+            if (ok && chunk.size()>0) ok = ImFileWrite(&chunk[0],sizeof(TreeViewBinaryNode),(ImU64)chunk.size(),f)==(ImU64)chunk.size();
+            chunk.resize(0);
+        }
+        static void Visit(const TreeViewNode* n,void* userPtr) {
+            NodesPass& p = *((NodesPass*)userPtr);
+            TreeViewBinaryNode rec;
+            rec.DepthDelta = n->getDepth()-p.depth;p.depth = n->getDepth();
+            rec.NumChildNodes = n->isLeafNode() ? -1 : n->getNumChildNodes();
+            rec.State = n->state;
+            rec.UserId = n->getUserId();
+            rec.DisplayNameOffset = p.offsets[0];
+            rec.TooltipOffset = p.offsets[1];
+            rec.UserTextOffset = p.offsets[2];
+            p.offsets+=3;
+            p.chunk.push_back(rec);
+            if (p.chunk.size()==p.chunk.capacity()) p.flush();
+        }
+    };
+    NodesPass nodes;
+    nodes.f = f;nodes.offsets = strings.offsets.Data;nodes.depth = -1;nodes.ok = ok;
+    nodes.chunk.reserve(65536/(int)sizeof(TreeViewBinaryNode));
+    if (ok) {
+        TreeViewVisitPreOrder(childNodes,stack,&NodesPass::Visit,&nodes);
+        nodes.flush();
+    }
+    return ImFileClose(f) && nodes.ok;
+}
+
+bool TreeView::loadBinary(const char* filename) {
+    ImFileMapping mapping;
+    if (!ImFileMap(filename,&mapping)) return false;
+    const bool ok = loadBinary(mapping.Data,mapping.Size);
+    ImFileUnmap(&mapping);
+    return ok;
+}
+
+bool TreeView::loadBinary(const void* data,size_t dataSize) {
+    // Validate everything before touching the TreeView, so that a bad file leaves it untouched
+    if (!data || dataSize<sizeof(TreeViewBinaryHeader)) return false;
+    const TreeViewBinaryHeader& header = *((const TreeViewBinaryHeader*)data);
+    if (memcmp(header.Magic,TREEVIEW_BINARY_MAGIC,sizeof(header.Magic))!=0 || header.Version!=TREEVIEW_BINARY_VERSION || header.NodesCount<0 || header.StringsSize<0) return false;
+    if (header.StringsSize%4!=0) return false;     // the node records that follow must be aligned
+    if ((ImU64)sizeof(TreeViewBinaryHeader)+(ImU64)header.StringsSize+(ImU64)header.NodesCount*sizeof(TreeViewBinaryNode)!=(ImU64)dataSize) return false;
+    const char* strings = (const char*)data+sizeof(TreeViewBinaryHeader);
+    const TreeViewBinaryNode* records = (const TreeViewBinaryNode*)(strings+header.StringsSize);
+    if (header.StringsSize>0 && strings[header.StringsSize-1]!='\0') return false;    // so that all strings are terminated
+    int depth = -1,maxDepth = -1,numRootNodes = 0;
+    bool prevIsLeaf = false;
+    for (int i=0;i<header.NodesCount;i++) {
+        const TreeViewBinaryNode& rec = records[i];
+        if (rec.DepthDelta>1 || rec.DepthDelta<-depth) return false;   // the new depth must be >= 0 (written so that it can't overflow)
+        if (rec.DepthDelta==1 && prevIsLeaf) return false;     // leaf nodes can't have children
+        // NumChildNodes is only used to reserve memory: a node can't have more children than the records that follow it
+        if (rec.NumChildNodes<-1 || rec.NumChildNodes>header.NodesCount-i-1) return false;
+        prevIsLeaf = rec.NumChildNodes<0;
+        depth+=rec.DepthDelta;
+        if (depth==0) ++numRootNodes;
+        if (depth>maxDepth) maxDepth = depth;
+        if (rec.DisplayNameOffset<0 || rec.DisplayNameOffset>=header.StringsSize || rec.TooltipOffset>=header.StringsSize || rec.UserTextOffset>=header.StringsSize) return false;
+    }
+
+    clear();
+    for (int i=0;i<6;i++) stateColors[i] = header.StateColors[i];
+    selectionMode = (unsigned int) header.SelectionMode;
+    checkboxMode = (unsigned int) header.CheckboxMode;
+    collapseToLeafNodesAtNodeDepth = header.CollapseToLeafNodesAtNodeDepth;
+    allowMultipleSelection = header.AllowMultipleSelection!=0;
+    allowAutoCheckboxBehaviour = header.AllowAutoCheckboxBehaviour!=0;
+    inheritDisabledLook = header.InheritDisabledLook!=0;
+
+    // The creation callback is called once the node data is set
+    TreeViewNodeCreationDelationCallback callback = treeViewNodeCreationDelationCb;
+    treeViewNodeCreationDelationCb = NULL;
+    nodePoolBlocks.reserve(header.NodesCount/NodePoolBlockSize+1);
+    childNodeVector.reserve(numRootNodes);
+    ImVector<TreeViewNode*> parentNodes;    // parentNodes[d] is the last node of depth d
+    parentNodes.resize(maxDepth+1);
+    const Data emptyData;
+    depth = -1;
+    for (int i=0;i<header.NodesCount;i++) {
+        const TreeViewBinaryNode& rec = records[i];
+        depth+=rec.DepthDelta;
+        TreeViewNode* n = CreateNode(emptyData,depth==0 ? this : parentNodes[depth-1],-1,rec.NumChildNodes>=0);
+        if (rec.NumChildNodes>0) n->childNodeVector.reserve(rec.NumChildNodes);
+        Data::SetString(n->data.displayName,strings+rec.DisplayNameOffset,false);
+        if (rec.TooltipOffset>=0) Data::SetString(n->data.tooltip,strings+rec.TooltipOffset,true);
+        if (rec.UserTextOffset>=0) Data::SetString(n->data.userText,strings+rec.UserTextOffset,true);
+        n->data.userId = rec.UserId;
+        n->state = rec.State;
+        parentNodes[depth] = n;
+        if (callback) callback(n,*this,false,treeViewNodeCreationDelationCbUserPtr);
+    }
+    treeViewNodeCreationDelationCb = callback;
+    return true;
+}
+
 //-------------------------------------------------------------------------------
 #       if (defined(IMGUIHELPER_H_) && !defined(NO_IMGUIHELPER_SERIALIZATION))
 #       ifndef NO_IMGUIHELPER_SERIALIZATION_SAVE
@@ -3423,6 +4180,7 @@ void TreeView::setTextColorForStateColor(int aStateColorFlag, const ImVec4 &text
 
 char TreeView::FontCheckBoxGlyphs[2][5]={{'\0','\0','\0','\0','\0'},{'\0','\0','\0','\0','\0'}};
 char TreeView::FontArrowGlyphs[2][5]={{'\0','\0','\0','\0','\0'},{'\0','\0','\0','\0','\0'}};
+int TreeView::SortThreadsCount = 0;
 
 void TreeView::SetFontCheckBoxGlyphs(const char *emptyState, const char *fillState) {
     if (emptyState && strlen(emptyState)>0 && strlen(emptyState)<5 && fillState && strlen(fillState)>0 && strlen(fillState)<5) {
@@ -3908,8 +4666,8 @@ unsigned int CheckboxFlags(const char* label,unsigned int* flags,int numFlags,in
     unsigned int j=0;int groupItemCnt = 0, groupCnt = 0;
     const bool buttonPressed = ImGui::IsMouseClicked(0);
 
-    ImU32 annColor;int annSegments;
-    float annThickness,annCenter,annRadius;
+    ImU32 annColor=0;int annSegments=0;
+    float annThickness=0.f,annCenter=0.f,annRadius=0.f;
     if (flagAnnotations)    {
         annColor = GetColorU32(ImGuiCol_Button);
         annSegments = (int) (checkSize.x * 0.4f);if (annSegments<3) annSegments=3;
@@ -20,6 +20,8 @@
 #include <imgui.h>
 #endif //IMGUI_API
 
+struct ImGuiFuzzyMatcher;   // imgui_fuzzy_matcher.h
+
 // USAGE
 /*
 #include "imguivariouscontrols.h"
@@ -347,11 +349,83 @@ IMGUI_API bool ImageZoomAndPan(ImTextureID user_texture_id, const ImVec2& size,f
 // Return value rv can be: -1 => No button is hovered or clicked | [0,numButtons-1] => buttons[rv] has been clicked | [numButtons,2*numButtons-1] => buttons[rv-numButtons] is hovered
 IMGUI_API int AppendTreeNodeHeaderButtons(const void* ptr_id, float startWindowCursorXForClipping, int numButtons, ...);
 
+// Min/max pyramid of a series of values, that lets the plot functions below draw a series with many more values than pixels
+// in time proportional to the plot width: every pixel column shows the min and the max of its values.
+// Level 0 stores the min/max of every 'BlockSize' values, and every next level merges two entries of the previous one.
+// Build it once per series (one per histogram/line), then:
+// - append(...) the values added to the end of the series (it updates O(log N) entries).
+// - update(...) the values changed in the middle of the series (the whole series must be passed, because some blocks must be recomputed).
+// The pyramid must have the same size as 'values_count' in the plot functions, and it's indexed like the values (without 'values_offset').
+class PlotMinMaxPyramid {
+    public:
+    enum {BlockSize = 8,MaxLevels = 32};
+
+    PlotMinMaxPyramid() : size(0),numLevels(0) {}
+    IMGUI_API void clear();
+    IMGUI_API void build(const float* values,int values_count,int stride=sizeof(float));
+    IMGUI_API void build(float (*getter)(const void* data,int idx),const void* data,int values_count);  // same getter of PlotMultiLines(...)
+    IMGUI_API void append(const float* values,int values_count,int stride=sizeof(float));
+    inline void append(float value) {append(&value,1);}
+    IMGUI_API void update(const float* values,int begin,int end,int stride=sizeof(float));  // 'values' starts at index 0 of the series
+
+    inline int getSize() const {return size;}
+    inline float getMin() const {return numLevels>0 ? levels[numLevels-1][0].x : 0.f;}
+    inline float getMax() const {return numLevels>0 ? levels[numLevels-1][0].y : 0.f;}
+    // Min and max of the values in [begin,end). Returns false if the range is empty. Only the whole blocks inside the range are read
+    // from the pyramid: the values of the partial blocks at its ends are read from 'values' (or 'getter'), which start at index 0 of the series.
+    IMGUI_API bool getMinMax(const float* values,int begin,int end,float* pMinOut,float* pMaxOut,int stride=sizeof(float)) const;
+    IMGUI_API bool getMinMax(float (*getter)(const void* data,int idx),const void* data,int begin,int end,float* pMinOut,float* pMaxOut) const;
+
+    protected:
+    ImVector<ImVec2> levels[MaxLevels];     // x = min, y = max
+    int size,numLevels;
+    void refreshLevels(int firstBlock,int lastBlock);  // [firstBlock,lastBlock] of level 0 have changed
+};
+
+// Fixed capacity ring buffer of 'numChannels' series (e.g. frame times, queue times, MMR), that the plot functions below can draw
+// directly, without copies:
+// - Channels are stored SoA: one 64-byte aligned array per channel.
+// - append(...) adds one value per channel, overwriting the oldest values when the buffer is full. It can be called from any
+//   thread: a mutex serializes it with the plot functions (unless IMGUI_DISABLE_THREADS is defined).
+// - Every channel keeps its running mean and a PlotMinMaxPyramid, which gives its running min/max and the LOD of the plots.
+// The getters don't lock: use lock()/unlock() around them when other threads append values.
+class PlotRingBuffer {
+    public:
+    IMGUI_API explicit PlotRingBuffer(int capacity,int numChannels=1);
+    IMGUI_API ~PlotRingBuffer();
+    IMGUI_API void append(const float* values);   // 'numChannels' values
+    inline void append(float value) {IM_ASSERT(getNumChannels()==1);append(&value);}
+    IMGUI_API void clear();
+
+    IMGUI_API int getCapacity() const;
+    IMGUI_API int getNumChannels() const;
+    IMGUI_API int getSize() const;
+    IMGUI_API float getValue(int channel,int idx) const;  // idx==0 is the oldest value
+    // The values of 'channel' from the oldest one are: [*pValues0Out,*pValues0Out+*pCount0Out) and then [*pValues1Out,*pValues1Out+*pCount1Out)
+    IMGUI_API void getView(int channel,const float** pValues0Out,int* pCount0Out,const float** pValues1Out,int* pCount1Out) const;
+    IMGUI_API float getMin(int channel) const;
+    IMGUI_API float getMax(int channel) const;
+    IMGUI_API float getMean(int channel) const;
+    IMGUI_API const PlotMinMaxPyramid& getPyramid(int channel) const;    // indexed by slot (i.e. the oldest value is at 'getStart()')
+    IMGUI_API int getStart() const;
+    IMGUI_API void lock() const;
+    IMGUI_API void unlock() const;
+
+    private:
+    PlotRingBuffer(const PlotRingBuffer& ) {}
+    void operator=(const PlotRingBuffer& ) {}
+    struct PlotRingBufferInternal* ptr;
+    friend int PlotHistogram(const char* label, const PlotRingBuffer& buffer, int channel, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size,float histogramGroupSpacingInPixels,int* pOptionalHoveredHistogramIndexOut,float fillColorGradientDeltaIn0_05,const ImU32* pColorsOverride,int numColorsOverride);
+    friend void PlotMultiLines(const char* label, const PlotRingBuffer& buffer, const char** names, const ImColor* colors, float scale_min, float scale_max, ImVec2 graph_size);
+    friend void PlotMultiHistograms(const char* label, const PlotRingBuffer& buffer, const char** names, const ImColor* colors, float scale_min, float scale_max, ImVec2 graph_size);
+};
+
 // Returns the hovered value index WITH 'values_offset' ( (hovered_index+values_offset)%values_offset or -1). The index of the hovered histogram can be retrieved through 'pOptionalHoveredHistogramIndexOut'.
-IMGUI_API int PlotHistogram(const char* label, const float** values,int num_histograms,int values_count, int values_offset = 0, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0,0), int stride = sizeof(float),float histogramGroupSpacingInPixels=0.f,int* pOptionalHoveredHistogramIndexOut=NULL,float fillColorGradientDeltaIn0_05=0.05f,const ImU32* pColorsOverride=NULL,int numColorsOverride=0);
-IMGUI_API int PlotHistogram(const char* label, float (*values_getter)(void* data, int idx,int histogramIdx), void* data,int num_histograms, int values_count, int values_offset = 0, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0,0),float histogramGroupSpacingInPixels=0.f,int* pOptionalHoveredHistogramIndexOut=NULL,float fillColorGradientDeltaIn0_05=0.05f,const ImU32* pColorsOverride=NULL,int numColorsOverride=0);
+// 'pyramids' (one per histogram, or NULL): when the values don't fit the plot width, consecutive values are grouped, and every bar shows the value of its group that is farthest from the x axis.
+IMGUI_API int PlotHistogram(const char* label, const float** values,int num_histograms,int values_count, int values_offset = 0, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0,0), int stride = sizeof(float),float histogramGroupSpacingInPixels=0.f,int* pOptionalHoveredHistogramIndexOut=NULL,float fillColorGradientDeltaIn0_05=0.05f,const ImU32* pColorsOverride=NULL,int numColorsOverride=0,const PlotMinMaxPyramid* const* pyramids=NULL);
+IMGUI_API int PlotHistogram(const char* label, float (*values_getter)(void* data, int idx,int histogramIdx), void* data,int num_histograms, int values_count, int values_offset = 0, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0,0),float histogramGroupSpacingInPixels=0.f,int* pOptionalHoveredHistogramIndexOut=NULL,float fillColorGradientDeltaIn0_05=0.05f,const ImU32* pColorsOverride=NULL,int numColorsOverride=0,const PlotMinMaxPyramid* const* pyramids=NULL);
 // Shortcut for a single histogram to ease user code a bit (same signature as one of the 2 default Dear ImGui PlotHistogram(...) methods):
-IMGUI_API int PlotHistogram2(const char* label, const float* values,int values_count, int values_offset = 0, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0,0), int stride = sizeof(float),float fillColorGradientDeltaIn0_05=0.05f,const ImU32* pColorsOverride=NULL,int numColorsOverride=0);
+IMGUI_API int PlotHistogram2(const char* label, const float* values,int values_count, int values_offset = 0, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0,0), int stride = sizeof(float),float fillColorGradientDeltaIn0_05=0.05f,const ImU32* pColorsOverride=NULL,int numColorsOverride=0,const PlotMinMaxPyramid* pyramid=NULL);
 
 // This one plots a generic function (or multiple functions together) of a float single variable.
 // Returns the index of the hovered curve (or -1).
@@ -362,6 +436,8 @@ IMGUI_API int PlotCurve(const char* label, float (*values_getter)(void* data, fl
 
 // These 2 have a completely different implementation:
 // Posted by @JaapSuter and @maxint (please see: https://github.com/ocornut/imgui/issues/632)
+// 'pyramids' (one per data, or NULL): when there are more than two values per pixel column, every column shows the min and the max of its values
+// (otherwise only one value per column is shown).
 IMGUI_API void PlotMultiLines(
     const char* label,
     int num_datas,
@@ -372,7 +448,8 @@ IMGUI_API void PlotMultiLines(
     int values_count,
     float scale_min,
     float scale_max,
-    ImVec2 graph_size);
+    ImVec2 graph_size,
+    const PlotMinMaxPyramid* const* pyramids=NULL);
 
 // Posted by @JaapSuter and @maxint (please see: https://github.com/ocornut/imgui/issues/632)
 IMGUI_API void PlotMultiHistograms(
@@ -385,7 +462,14 @@ IMGUI_API void PlotMultiHistograms(
     int values_count,
     float scale_min,
     float scale_max,
-    ImVec2 graph_size);
+    ImVec2 graph_size,
+    const PlotMinMaxPyramid* const* pyramids=NULL);
+
+// PlotRingBuffer overloads: they plot all the channels (or just 'channel' when it's not -1), from the oldest value. They lock the buffer while drawing.
+// PlotHistogram(...) returns the hovered value index (0 is the oldest value) or -1.
+IMGUI_API int PlotHistogram(const char* label, const PlotRingBuffer& buffer, int channel = -1, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0,0),float histogramGroupSpacingInPixels=0.f,int* pOptionalHoveredHistogramIndexOut=NULL,float fillColorGradientDeltaIn0_05=0.05f,const ImU32* pColorsOverride=NULL,int numColorsOverride=0);
+IMGUI_API void PlotMultiLines(const char* label, const PlotRingBuffer& buffer, const char** names, const ImColor* colors, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0,0));
+IMGUI_API void PlotMultiHistograms(const char* label, const PlotRingBuffer& buffer, const char** names, const ImColor* colors, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0,0));
 
 
 class InputTextWithAutoCompletionData  {
@@ -401,9 +485,10 @@ class InputTextWithAutoCompletionData  {
 
     public:
     int currentAutocompletionItemIndex;         // completely user-side (if!=-1, that item is displayed in a different way in the autocompletion menu)
+    ImGuiFuzzyMatcher* fuzzyMatcher;            // completely user-side (if!=NULL, the autocompletion menu lists the best fuzzy matches of the text, instead of the items around it in sorted order)
     InputTextWithAutoCompletionData(ImGuiInputTextFlags _additionalFlags=0,int _currentAutocompletionItemIndex=-1) : deltaTTItems(0),tabPressed(false),itemPositionOfReturnedText(-1),itemIndexOfReturnedText(-1),
     additionalFlags(_additionalFlags&(ImGuiInputTextFlags_CharsDecimal|ImGuiInputTextFlags_CharsHexadecimal|ImGuiInputTextFlags_CharsNoBlank|ImGuiInputTextFlags_CharsUppercase)),bufTextLen(-1),lastSelectedTTItemIndex(-1),
-    inited(false),currentAutocompletionItemIndex(_currentAutocompletionItemIndex) {}
+    inited(false),currentAutocompletionItemIndex(_currentAutocompletionItemIndex),fuzzyMatcher(NULL) {}
 
     bool isInited() const {return inited;}      // added just for my laziness (to init elements inside DrawGL() of similiar)
     int getItemPositionOfReturnedText() const {return itemPositionOfReturnedText;}  // usable only after "return" is pressed: it returns the item position at which the newly entered text can be inserted, or -1
@@ -569,8 +654,8 @@ public:
     }
     IMGUI_API static void DeleteNode(TreeViewNode* n);
 
-    IMGUI_API class TreeView& getTreeView();              // slightly slow
-    IMGUI_API const class TreeView& getTreeView() const;  // slightly slow
+    IMGUI_API class TreeView& getTreeView();
+    IMGUI_API const class TreeView& getTreeView() const;
     IMGUI_API TreeViewNode* getParentNode();
     IMGUI_API const TreeViewNode* getParentNode() const;
     IMGUI_API int getNodeIndex() const;
@@ -588,19 +673,25 @@ public:
     IMGUI_API const TreeViewNode* getSiblingNode(int nodeIndexInParentHierarchy=-1) const;
     IMGUI_API int getDepth() const;   // root nodes have depth = 0
 
-    IMGUI_API static void Swap(TreeViewNode*& n1,TreeViewNode*& n2); // untested
+    IMGUI_API static void Swap(TreeViewNode*& n1,TreeViewNode*& n2); // swaps the positions of two nodes (and of their child nodes) inside the same TreeView
     IMGUI_API void startRenamingMode();       // starts renaming the node
     IMGUI_API bool isInRenamingMode() const;
 
+    // Recursive sorts sort the child nodes of different nodes in parallel (see TreeView::SortThreadsCount), so "comp" must be thread-safe.
+    // The By...() versions compare packed keys extracted once per node, and keep the original order of equal nodes.
     IMGUI_API void sortChildNodes(bool recursive,int (*comp)(const void *, const void *));
     IMGUI_API void sortChildNodesByDisplayName(bool recursive=false,bool reverseOrder=false);
     IMGUI_API void sortChildNodesByTooltip(bool recursive=false,bool reverseOrder=false);
     IMGUI_API void sortChildNodesByUserText(bool recursive=false,bool reverseOrder=false);
     IMGUI_API void sortChildNodesByUserId(bool recursive=false,bool reverseOrder=false);
-
-    inline void addState(int stateFlag) const {state|=stateFlag;}
-    inline void removeState(int stateFlag) const {state&=~stateFlag;}
-    inline void toggleState(int stateFlag) const {state^=stateFlag;}
+    // These add a node at its sorted position (after its equals) through a binary search: the child nodes must already be sorted with the same order
+    IMGUI_API TreeViewNode* addChildNodeSorted(const Data& _data,int (*comp)(const void *, const void *),bool addEmptyChildNodeVector=false);
+    IMGUI_API TreeViewNode* addChildNodeSortedByDisplayName(const Data& _data,bool reverseOrder=false,bool addEmptyChildNodeVector=false);
+
+    // Please use these instead of modifying "state" directly (or call TreeView::invalidateVisibleRows() when you change STATE_OPEN or STATE_HIDDEN)
+    inline void addState(int stateFlag) const {const int oldState=state;state|=stateFlag;if ((state^oldState)&(STATE_OPEN|STATE_HIDDEN)) onVisibilityChanged();}
+    inline void removeState(int stateFlag) const {const int oldState=state;state&=~stateFlag;if ((state^oldState)&(STATE_OPEN|STATE_HIDDEN)) onVisibilityChanged();}
+    inline void toggleState(int stateFlag) const {state^=stateFlag;if (stateFlag&(STATE_OPEN|STATE_HIDDEN)) onVisibilityChanged();}
     inline bool isStatePresent(int stateFlag) const {return ((state&stateFlag)==stateFlag);}
     inline bool isStateMissing(int stateFlag) const {return ((state&stateFlag)!=stateFlag);}
 
@@ -673,12 +764,21 @@ protected:
     Data data;
 
     TreeViewNode* parentNode;
-    ImVector<TreeViewNode*>* childNodes;
+    ImVector<TreeViewNode*>* childNodes;        // NULL for leaf nodes, &childNodeVector otherwise
+    ImVector<TreeViewNode*> childNodeVector;
+    class TreeView* treeView;                   // cached (NULL for nodes created without a parent node)
+    int depth;                                  // cached (-1 for the TreeView itself)
+    int nodeIndex;                              // cached index in parentNode->childNodes
+
+    IMGUI_API void setDepth(int _depth);        // updates the whole branch
+    IMGUI_API void onVisibilityChanged() const; // the visible rows of the TreeView must be rebuilt
+    IMGUI_API void updateChildNodeIndices(int startIndex=0);
 
     inline unsigned int getMode() const {
         int m = MODE_NONE;if (childNodes==NULL) m|=MODE_LEAF;
         if (!parentNode || !parentNode->parentNode) m|=MODE_ROOT;
-        if (m==MODE_NONE) m = MODE_INTERMEDIATE;return m;
+        if (m==MODE_NONE) m = MODE_INTERMEDIATE;
+        return m;
     }
     inline static bool MatchMode(unsigned int m,unsigned int nodeM) {
         // Hp) nodeM can't be MODE_NONE
@@ -709,6 +809,12 @@ public:
     inline TreeViewNode* addRootNode(const TreeViewNode::Data& _data,int nodeIndex=-1,bool addEmptyChildNodeVector=false)    {
         return TreeViewNode::CreateNode(_data,this,nodeIndex,addEmptyChildNodeVector);
     }
+    inline TreeViewNode* addRootNodeSorted(const TreeViewNode::Data& _data,int (*comp)(const void *, const void *),bool addEmptyChildNodeVector=false)    {
+        return TreeViewNode::addChildNodeSorted(_data,comp,addEmptyChildNodeVector);
+    }
+    inline TreeViewNode* addRootNodeSortedByDisplayName(const TreeViewNode::Data& _data,bool reverseOrder=false,bool addEmptyChildNodeVector=false)    {
+        return TreeViewNode::addChildNodeSortedByDisplayName(_data,reverseOrder,addEmptyChildNodeVector);
+    }
     inline static void DeleteNode(TreeViewNode* n) {TreeViewNode::DeleteNode(n);}    
 
     IMGUI_API void clear();
@@ -719,6 +825,7 @@ public:
     void sortRootNodesByTooltip(bool recursive=false,bool reverseOrder=false) {TreeViewNode::sortChildNodesByTooltip(recursive,reverseOrder);}
     void sortRootNodesByUserText(bool recursive=false,bool reverseOrder=false) {TreeViewNode::sortChildNodesByUserText(recursive,reverseOrder);}
     void sortRootNodesByUserId(bool recursive=false,bool reverseOrder=false) {TreeViewNode::sortChildNodesByUserId(recursive,reverseOrder);}
+    static int SortThreadsCount;    // Max threads used by recursive sorts of big trees (0 = ImGetHardwareThreadsCount(), 1 = calling thread only)
 
     // state
     void addStateToAllRootNodes(int stateFlag, bool recursive = false) const {TreeViewNode::addStateToAllChildNodes(stateFlag,recursive);}
@@ -748,7 +855,7 @@ public:
     void getAllNodesWithoutState(ImVector<TreeViewNode*>& result,int stateFlag,bool clearResultBeforeUsage=true) const {return getAllRootNodesWithoutState(result,stateFlag,true,false,clearResultBeforeUsage);}
 
     // -1 = disabled. When >= 0 if node->getDepth()==collapseToLeafNodesAtNodeDepth the hierarchy is flattened to leaf nodes
-    void setCollapseNodesToLeafNodesAtDepth(int nodeDepth) const {collapseToLeafNodesAtNodeDepth=nodeDepth;}
+    void setCollapseNodesToLeafNodesAtDepth(int nodeDepth) const {if (collapseToLeafNodesAtNodeDepth!=nodeDepth) {collapseToLeafNodesAtNodeDepth=nodeDepth;visibleRowsDirty=true;}}
     int getCollapseNodesToLeafNodesAtDepth() const {return collapseToLeafNodesAtNodeDepth;}
 
     // Callbacks:
@@ -772,11 +879,22 @@ public:
 
     void *userPtr;                  // user stuff, not mine
 
+    // render() only submits the rows on screen, from a flat list of the visible nodes which is rebuilt when nodes are added, deleted, moved or sorted,
+    // and when STATE_OPEN or STATE_HIDDEN change through addState()/removeState()/toggleState(). Call this if you modify TreeViewNode::state directly.
+    void invalidateVisibleRows() const {visibleRowsDirty=true;}
+
     IMGUI_API ImVec4* getTextColorForStateColor(int aStateColorFlag) const;
     IMGUI_API ImVec4* getTextDisabledColorForStateColor(int aStateColorFlag) const;
 
     IMGUI_API void setTextColorForStateColor(int aStateColorFlag,const ImVec4& textColor,float disabledTextColorAlphaFactor=0.5f) const;
 
+    // Binary save/load (doesn't need ImGuiHelper). The file holds the TreeView settings, a table of the (deduplicated) node strings,
+    // then a fixed-size record per node, in pre-order, with the depth stored as a delta from the previous node. Native endianness.
+    // Loading maps the file in memory, validates it, then builds the whole tree in a single pass (replacing all the nodes).
+    IMGUI_API bool saveBinary(const char* filename) const;
+    IMGUI_API bool loadBinary(const char* filename);
+    IMGUI_API bool loadBinary(const void* data,size_t dataSize);
+
 //-------------------------------------------------------------------------------
 #       if (defined(IMGUIHELPER_H_) && !defined(NO_IMGUIHELPER_SERIALIZATION))
 #       ifndef NO_IMGUIHELPER_SERIALIZATION_SAVE
@@ -831,6 +949,25 @@ protected:
 
     mutable int collapseToLeafNodesAtNodeDepth; // -1 = disabled. When >= 0 if node->getDepth()>=collapseToLeafNodesAtNodeDepth the hierarchy is flattened to leaf nodes
 
+    struct VisibleRow {
+        TreeViewNode* node;
+        int numIndents;
+    };
+    ImVector<VisibleRow> visibleRows;           // Visible nodes, in display order
+    mutable bool visibleRowsDirty;
+    ImGuiVariableListClipper visibleRowsClipper;
+    IMGUI_API void rebuildVisibleRows();
+    IMGUI_API void updateVisibleRowsOfToggledNode(int rowIndex);  // Adds or removes the rows of the child nodes of a node just opened or closed
+
+    // Node storage: nodes are allocated in blocks of NodePoolBlockSize nodes, and deleted nodes are recycled through a free list
+    enum {NodePoolBlockSize = 256};
+    ImVector<void*> nodePoolBlocks;
+    void* nodePoolFreeList;
+    int nodePoolBlockUsed;      // Number of nodes used in the last block
+    IMGUI_API void* allocNodeMemory();
+    IMGUI_API void freeNodeMemory(void* mem);
+    IMGUI_API void freeAllNodeMemory();     // Only when the TreeView has no nodes
+
 
 protected:
     TreeView(const TreeView& tv) : TreeViewNode(tv) {}
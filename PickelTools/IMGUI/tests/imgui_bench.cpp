@@ -0,0 +1,530 @@
+// Headless benchmark: runs scripted scenes through the null back-end (imgui_impl_null.cpp) and compares them with a stored baseline.
+// Usage:
+//   imgui_bench                                  Run every scene and print its stats
+//   imgui_bench --scene widgets --frames 1000    Run one scene
+//   imgui_bench --baseline bench_baseline.txt    Fail when the geometry or allocation counts differ from the baseline, print the time ratios
+//   imgui_bench --baseline bench_baseline.txt --max-slowdown 1.5
+//                                                Also fail when a median frame time is more than 1.5x the baseline one
+//   imgui_bench --write-baseline bench_baseline.txt
+// Counts only depend on the code, times depend on the machine: regenerate the baseline on the machine comparing against it.
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "imgui_impl_null.h"
+#include "imgui_timeline.h"
+#include "imgui_searchablecombo.h"
+#include "imguivariouscontrols.h"
+#ifdef IMGUI_ENABLE_FRAME_ALLOCATOR
+#include "imgui_allocator.h"
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// Scenes
+// Each scene is called between NewFrame() and Render(), and scripts the mouse from the frame number so every run submits the same frames.
+//-----------------------------------------------------------------------------
+
+// Data of the scenes which need some, created by their Setup function after the context of the scene
+struct BenchData
+{
+    ImGuiTimeline               Timeline;
+    std::vector<std::string>    ComboItems;
+    ImGuiSearchableComboIndex   ComboIndex;
+    int                         ComboCurrent;
+    ImGui::TreeView             Tree;
+    ImVector<float>             Lines[4];
+    ImGui::PlotMinMaxPyramid    Pyramids[4];
+
+    BenchData() { ComboCurrent = -1; }
+};
+
+static void SceneDemoWindow(int frame, void*)
+{
+    ImGui_ImplNull_SetMousePos(50.0f + (float)((frame * 7) % 600), 50.0f + (float)((frame * 3) % 500));
+    ImGui::SetNextWindowPos(ImVec2(10, 10), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(550, 680), ImGuiCond_Always);
+    ImGui::ShowDemoWindow();
+    ImGui::SetNextWindowPos(ImVec2(600, 10), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(600, 680), ImGuiCond_Always);
+    ImGui::Begin("Style Editor");
+    ImGui::ShowStyleEditor();
+    ImGui::End();
+}
+
+static void SceneWidgets(int frame, void*)
+{
+    static float values[200][4];
+    static bool checks[200];
+    static char texts[200][32];
+    ImGui_ImplNull_SetMousePos(200.0f, 300.0f);
+    ImGui_ImplNull_AddMouseWheel((frame / 60) % 2 ? 1.0f : -1.0f);
+    ImGui::SetNextWindowPos(ImVec2(10, 10), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(900, 700), ImGuiCond_Always);
+    ImGui::Begin("Widgets");
+    for (int i = 0; i < IM_ARRAYSIZE(values); i++)
+    {
+        ImGui::PushID(i);
+        ImGui::Button("Button"); ImGui::SameLine();
+        ImGui::Checkbox("##check", &checks[i]); ImGui::SameLine();
+        ImGui::SetNextItemWidth(150.0f);
+        ImGui::SliderFloat("##slider", &values[i][0], 0.0f, 1.0f); ImGui::SameLine();
+        ImGui::SetNextItemWidth(150.0f);
+        ImGui::InputText("##text", texts[i], IM_ARRAYSIZE(texts[i])); ImGui::SameLine();
+        ImGui::SetNextItemWidth(250.0f);
+        ImGui::ColorEdit4("##color", values[i]);
+        ImGui::PopID();
+    }
+    ImGui::End();
+}
+
+static void SceneTextList(int frame, void*)
+{
+    ImGui::SetNextWindowPos(ImVec2(10, 10), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(900, 700), ImGuiCond_Always);
+    ImGui::Begin("Text list");
+    ImGui::SetScrollY((float)frame * 97.0f);
+    ImGuiListClipper clipper(100000);
+    while (clipper.Step())
+        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+            ImGui::Text("Line %06d: the quick brown fox jumps over the lazy dog", i);
+    ImGui::End();
+}
+
+// 100k rows of 1 to 4 lines: only the visible rows are submitted, their heights are measured as they appear
+static void SceneVariableList(int frame, void*)
+{
+    static ImGuiVariableListClipper clipper;
+    ImGui::SetNextWindowPos(ImVec2(10, 10), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(900, 700), ImGuiCond_Always);
+    ImGui::Begin("Variable list");
+    ImGui::SetScrollY((float)frame * 211.0f);
+    clipper.Begin(100000);
+    while (clipper.Step())
+        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+        {
+            clipper.BeginItem(i);
+            ImGui::Text("Row %06d", i);
+            for (int line = 1, lines_count = 1 + (int)((i * 2654435761u) >> 28) % 4; line < lines_count; line++)
+                ImGui::Text("    the quick brown fox jumps over the lazy dog (%d)", line);
+        }
+    ImGui::End();
+}
+
+static void SceneShapes(int frame, void*)
+{
+    ImDrawList* draw_list = ImGui::GetForegroundDrawList();
+    const ImU32 col = IM_COL32(255, 200, 100, 255);
+    for (int i = 0; i < 400; i++)
+    {
+        const ImVec2 p((float)(20 + (i % 20) * 60), (float)(20 + (i / 20) * 34));
+        const float r = 3.0f + (float)((i + frame) % 24);
+        draw_list->AddCircle(p, r, col, 0, 1.5f);
+        draw_list->AddCircleFilled(ImVec2(p.x + 30, p.y), r * 0.5f, col);
+        draw_list->AddRectFilled(ImVec2(p.x - 10, p.y + 8), ImVec2(p.x + 40, p.y + 28), col, 6.0f);
+        draw_list->AddRect(ImVec2(p.x - 10, p.y + 8), ImVec2(p.x + 40, p.y + 28), col, 6.0f, ImDrawCornerFlags_All, 2.0f);
+        draw_list->AddBezierCurve(p, ImVec2(p.x + 10, p.y - 20), ImVec2(p.x + 30, p.y + 20), ImVec2(p.x + 50, p.y), col, 1.0f);
+    }
+    ImVec2 points[256];
+    for (int i = 0; i < IM_ARRAYSIZE(points); i++)
+        points[i] = ImVec2(10.0f + i * 4.9f, 600.0f + ImSin((float)(i + frame) * 0.1f) * 80.0f);
+    draw_list->AddPolyline(points, IM_ARRAYSIZE(points), col, false, 2.0f);
+}
+
+static void ScenePlots(int frame, void*)
+{
+    static float values[10000];
+    for (int i = 0; i < IM_ARRAYSIZE(values); i++)
+        values[i] = ImSin((float)(i + frame) * 0.01f) + ImSin((float)i * 0.37f) * 0.2f;
+    ImGui::SetNextWindowPos(ImVec2(10, 10), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(1200, 700), ImGuiCond_Always);
+    ImGui::Begin("Plots");
+    for (int i = 0; i < 4; i++)
+    {
+        ImGui::PushID(i);
+        ImGui::PlotLines("##lines", values, IM_ARRAYSIZE(values), 0, NULL, -1.5f, 1.5f, ImVec2(1150, 80));
+        ImGui::PlotHistogram("##histogram", values, IM_ARRAYSIZE(values) / 10, 0, NULL, -1.5f, 1.5f, ImVec2(1150, 80));
+        ImGui::PopID();
+    }
+    ImGui::End();
+}
+
+static void SceneTimeline(int frame, void* user_data)
+{
+    ImGuiTimeline* timeline = &((BenchData*)user_data)->Timeline;
+    ImGui_ImplNull_SetMousePos(600.0f, 300.0f);
+    ImGui_ImplNull_AddMouseWheel((frame / 50) % 2 ? 1.0f : -1.0f);
+    ImGui::SetNextWindowPos(ImVec2(10, 10), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(1200, 700), ImGuiCond_Always);
+    ImGui::Begin("Timeline");
+    ImGui::Timeline("##timeline", timeline, ImVec2(0, 0));
+    ImGui::End();
+}
+
+static void SetupTimeline(BenchData* data)
+{
+    ImGuiTimeline* timeline = &data->Timeline;
+    // 8 tracks of 3 nested lanes, 60k events in total
+    for (int track_n = 0; track_n < 8; track_n++)
+    {
+        char name[32];
+        ImFormatString(name, IM_ARRAYSIZE(name), "Track %d", track_n);
+        const int track = timeline->AddTrack(name);
+        for (int i = 0; i < 2500; i++)
+        {
+            const double t = i * 10.0 + track_n;
+            timeline->AddEvent(track, t, t + 8.0, "Frame", 0);
+            timeline->AddEvent(track, t + 1.0, t + 5.0, "Update", 1);
+            timeline->AddEvent(track, t + 2.0, t + 3.0, "Layout", 2);
+        }
+    }
+}
+
+// 10k items: the popup is opened by a click, then "map 12" is typed and erased one character per frame
+static void SceneSearchableCombo(int frame, void* user_data)
+{
+    BenchData* data = (BenchData*)user_data;
+    ImGui::SetNextWindowPos(ImVec2(10, 10), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(600, 700), ImGuiCond_Always);
+    ImGui::Begin("Searchable combo");
+    ImGui::SetNextItemWidth(400.0f);
+    const ImVec2 combo_pos(ImGui::GetCursorScreenPos().x + 100.0f, ImGui::GetCursorScreenPos().y + ImGui::GetFrameHeight() * 0.5f);
+    ImGui::SearchableCombo("Map", &data->ComboCurrent, &data->ComboIndex, data->ComboItems, "Select a map", "Search...", 20);
+    ImGui::End();
+
+    ImGui_ImplNull_SetMousePos(combo_pos.x, combo_pos.y);
+    ImGui_ImplNull_SetMouseButton(0, frame == 0);
+    ImGui_ImplNull_SetKey(ImGuiKey_Backspace, false);
+    const char* query = "map 12";
+    const int query_len = (int)strlen(query);
+    const int step = (frame - 2) % (query_len * 3);     // One character per frame, then one backspace every other frame
+    if (frame < 2)
+        return;
+    if (step < query_len)
+    {
+        const char c[2] = { query[step], 0 };
+        ImGui_ImplNull_AddInputCharacters(c);
+    }
+    else if ((step - query_len) % 2 == 0)
+    {
+        ImGui_ImplNull_SetKey(ImGuiKey_Backspace, true);
+    }
+}
+
+static void SetupSearchableCombo(BenchData* data)
+{
+    const char* kinds[] = { "Stadium", "Arena", "Park", "Field", "Dome", "Beach", "Forest", "Utopia" };
+    data->ComboItems.resize(10000);
+    for (int i = 0; i < (int)data->ComboItems.size(); i++)
+    {
+        char name[64];
+        ImFormatString(name, IM_ARRAYSIZE(name), "Map %d (%s)", i, kinds[(i * 7) % IM_ARRAYSIZE(kinds)]);
+        data->ComboItems[i] = name;
+    }
+    data->ComboCurrent = 5000;
+}
+
+// 50 roots of 20 nodes of 50 leaves, all open, scrolled through
+static void SceneTreeView(int frame, void* user_data)
+{
+    BenchData* data = (BenchData*)user_data;
+    ImGui::SetNextWindowPos(ImVec2(10, 10), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(600, 700), ImGuiCond_Always);
+    ImGui::Begin("Tree view");
+    ImGui::SetScrollY((float)frame * 311.0f);
+    data->Tree.render();
+    ImGui::End();
+}
+
+static void SetupTreeView(BenchData* data)
+{
+    char name[32];
+    for (int root_n = 0; root_n < 50; root_n++)
+    {
+        ImFormatString(name, IM_ARRAYSIZE(name), "Root %d", root_n);
+        ImGui::TreeViewNode* root = data->Tree.addRootNode(ImGui::TreeViewNode::Data(name));
+        for (int node_n = 0; node_n < 20; node_n++)
+        {
+            ImFormatString(name, IM_ARRAYSIZE(name), "Node %d.%d", root_n, node_n);
+            ImGui::TreeViewNode* node = root->addChildNode(ImGui::TreeViewNode::Data(name));
+            for (int leaf_n = 0; leaf_n < 50; leaf_n++)
+            {
+                ImFormatString(name, IM_ARRAYSIZE(name), "Leaf %d.%d.%d", root_n, node_n, leaf_n);
+                node->addChildNode(ImGui::TreeViewNode::Data(name));
+            }
+        }
+    }
+    data->Tree.addStateToAllDescendants(ImGui::TreeViewNode::STATE_OPEN);
+}
+
+static float CurveGetter(void*, float x, int curve)
+{
+    return ImSin(x * (1.0f + curve * 0.5f)) * (1.0f - curve * 0.2f) + ImSin(x * 37.0f) * 0.05f;
+}
+
+// 3 curves, sampled at every pixel column of wide graphs
+static void ScenePlotCurve(int frame, void*)
+{
+    ImGui::SetNextWindowPos(ImVec2(10, 10), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(1200, 700), ImGuiCond_Always);
+    ImGui::Begin("Plot curve");
+    for (int i = 0; i < 3; i++)
+    {
+        ImGui::PushID(i);
+        const float x0 = (float)frame * 0.05f + i;
+        ImGui::PlotCurve("##curve", CurveGetter, NULL, 3, NULL, ImVec2(-1.5f, 1.5f), ImVec2(x0, x0 + 20.0f), ImVec2(1150, 200));
+        ImGui::PopID();
+    }
+    ImGui::End();
+}
+
+static float LinesGetter(const void* data, int idx)
+{
+    return ((const float*)data)[idx];
+}
+
+// 4 series of 200k values: whole series through their min/max pyramids, and the first 2000 values of each without
+static void ScenePlotMultiLines(int, void* user_data)
+{
+    BenchData* data = (BenchData*)user_data;
+    const char* names[] = { "A", "B", "C", "D" };
+    const ImColor colors[] = { ImColor(255, 100, 100), ImColor(100, 255, 100), ImColor(100, 100, 255), ImColor(255, 255, 100) };
+    const void* datas[IM_ARRAYSIZE(data->Lines)];
+    const ImGui::PlotMinMaxPyramid* pyramids[IM_ARRAYSIZE(data->Lines)];
+    for (int n = 0; n < IM_ARRAYSIZE(data->Lines); n++)
+    {
+        datas[n] = data->Lines[n].Data;
+        pyramids[n] = &data->Pyramids[n];
+    }
+    ImGui::SetNextWindowPos(ImVec2(10, 10), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(1200, 700), ImGuiCond_Always);
+    ImGui::Begin("Plot multi lines");
+    ImGui::PlotMultiLines("##lines", IM_ARRAYSIZE(data->Lines), names, colors, LinesGetter, datas, data->Lines[0].Size, -1.5f, 1.5f, ImVec2(1150, 300), pyramids);
+    ImGui::PlotMultiLines("##zoomed", IM_ARRAYSIZE(data->Lines), names, colors, LinesGetter, datas, 2000, -1.5f, 1.5f, ImVec2(1150, 300));
+    ImGui::End();
+}
+
+static void SetupPlotMultiLines(BenchData* data)
+{
+    for (int n = 0; n < IM_ARRAYSIZE(data->Lines); n++)
+    {
+        ImVector<float>& values = data->Lines[n];
+        values.resize(200000);
+        for (int i = 0; i < values.Size; i++)
+            values[i] = ImSin((float)i * (0.001f + n * 0.0007f)) + ImSin((float)i * 0.37f) * 0.2f * (n + 1);
+        data->Pyramids[n].build(values.Data, values.Size);
+    }
+}
+
+struct BenchScene
+{
+    const char*     Name;
+    void            (*Func)(int frame, void* user_data);
+    void            (*Setup)(BenchData* data);      // Optional
+};
+
+// Scenes not covered: the settings panel of the plugin, which needs the BakkesMod SDK
+static const BenchScene g_Scenes[] =
+{
+    { "demo_window",            SceneDemoWindow,        NULL },
+    { "widgets",                SceneWidgets,           NULL },
+    { "text_list",              SceneTextList,          NULL },
+    { "variable_list",          SceneVariableList,      NULL },
+    { "shapes",                 SceneShapes,            NULL },
+    { "plots",                  ScenePlots,             NULL },
+    { "timeline",               SceneTimeline,          SetupTimeline },
+    { "searchable_combo_10k",   SceneSearchableCombo,   SetupSearchableCombo },
+    { "treeview_50k",           SceneTreeView,          SetupTreeView },
+    { "plot_curve",             ScenePlotCurve,         NULL },
+    { "plot_multilines",        ScenePlotMultiLines,    SetupPlotMultiLines },
+};
+
+//-----------------------------------------------------------------------------
+// Baseline
+//-----------------------------------------------------------------------------
+
+struct BenchResult
+{
+    char            Name[32];
+    int             Frames;
+    double          MedianMs, AvgMs, MaxMs;
+    int             DrawLists, DrawCmds, VtxCount, IdxCount, AllocCount;
+};
+
+static void PrintResult(FILE* f, const BenchResult& r)
+{
+    fprintf(f, "%-20s %6d %9.4f %9.4f %9.4f %5d %6d %8d %8d %6d\n", r.Name, r.Frames, r.MedianMs, r.AvgMs, r.MaxMs, r.DrawLists, r.DrawCmds, r.VtxCount, r.IdxCount, r.AllocCount);
+}
+
+static const char* g_ResultHeader = "# scene              frames median_ms    avg_ms    max_ms lists   cmds      vtx      idx allocs\n";
+
+static int LoadBaseline(const char* filename, BenchResult* out_results, int max_results)
+{
+    FILE* f = fopen(filename, "r");
+    if (f == NULL)
+        return -1;
+    int count = 0;
+    char line[256];
+    while (count < max_results && fgets(line, sizeof(line), f))
+    {
+        if (line[0] == '#')
+            continue;
+        BenchResult& r = out_results[count];
+        if (sscanf(line, "%31s %d %lf %lf %lf %d %d %d %d %d", r.Name, &r.Frames, &r.MedianMs, &r.AvgMs, &r.MaxMs, &r.DrawLists, &r.DrawCmds, &r.VtxCount, &r.IdxCount, &r.AllocCount) == 10)
+            count++;
+    }
+    fclose(f);
+    return count;
+}
+
+// Counts are compared exactly: the scenes are deterministic, so any difference is a change of the output (or of the allocation pattern)
+static bool CompareResult(const BenchResult& r, const BenchResult& base, double max_slowdown)
+{
+    bool ok = true;
+    if (r.DrawLists != base.DrawLists || r.DrawCmds != base.DrawCmds || r.VtxCount != base.VtxCount || r.IdxCount != base.IdxCount)
+    {
+        printf("  %s: geometry differs from the baseline (lists %d/%d, cmds %d/%d, vtx %d/%d, idx %d/%d)\n", r.Name,
+            r.DrawLists, base.DrawLists, r.DrawCmds, base.DrawCmds, r.VtxCount, base.VtxCount, r.IdxCount, base.IdxCount);
+        ok = false;
+    }
+    if (r.AllocCount >= 0 && base.AllocCount >= 0 && r.AllocCount > base.AllocCount)
+    {
+        printf("  %s: %d allocations per frame, baseline %d\n", r.Name, r.AllocCount, base.AllocCount);
+        ok = false;
+    }
+    const double ratio = (base.MedianMs > 0.0) ? r.MedianMs / base.MedianMs : 1.0;
+    printf("  %s: median %.4f ms, baseline %.4f ms (x%.2f)\n", r.Name, r.MedianMs, base.MedianMs, ratio);
+    if (max_slowdown > 0.0 && ratio > max_slowdown)
+    {
+        printf("  %s: slower than the baseline by more than x%.2f\n", r.Name, max_slowdown);
+        ok = false;
+    }
+    return ok;
+}
+
+//-----------------------------------------------------------------------------
+// Main
+//-----------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    const char* scene_filter = NULL;
+    const char* baseline_filename = NULL;
+    const char* write_baseline_filename = NULL;
+    int frames = 300;
+    double max_slowdown = 0.0;
+    for (int n = 1; n < argc; n++)
+    {
+        if (strcmp(argv[n], "--scene") == 0 && n + 1 < argc)                   scene_filter = argv[++n];
+        else if (strcmp(argv[n], "--frames") == 0 && n + 1 < argc)             frames = atoi(argv[++n]);
+        else if (strcmp(argv[n], "--baseline") == 0 && n + 1 < argc)           baseline_filename = argv[++n];
+        else if (strcmp(argv[n], "--write-baseline") == 0 && n + 1 < argc)     write_baseline_filename = argv[++n];
+        else if (strcmp(argv[n], "--max-slowdown") == 0 && n + 1 < argc)       max_slowdown = atof(argv[++n]);
+        else
+        {
+            fprintf(stderr, "Usage: %s [--scene name] [--frames N] [--baseline file [--max-slowdown ratio]] [--write-baseline file]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (frames < 1)
+        frames = 1;
+
+    BenchResult baseline[IM_ARRAYSIZE(g_Scenes)];
+    int baseline_count = 0;
+    if (baseline_filename)
+    {
+        baseline_count = LoadBaseline(baseline_filename, baseline, IM_ARRAYSIZE(baseline));
+        if (baseline_count < 0)
+        {
+            fprintf(stderr, "Can't read '%s'\n", baseline_filename);
+            return 2;
+        }
+    }
+
+#ifdef IMGUI_ENABLE_FRAME_ALLOCATOR
+    ImGui::InstallFrameAllocator();
+#endif
+
+    BenchResult results[IM_ARRAYSIZE(g_Scenes)];
+    int results_count = 0;
+    bool ok = true;
+    printf("%s", g_ResultHeader);
+    for (int scene_n = 0; scene_n < IM_ARRAYSIZE(g_Scenes); scene_n++)
+    {
+        const BenchScene& scene = g_Scenes[scene_n];
+        if (scene_filter && strcmp(scene_filter, scene.Name) != 0)
+            continue;
+
+        // Fresh context per scene so scenes don't affect each other
+        ImGuiContext* ctx = ImGui::CreateContext();
+        ImGui_ImplNull_Init(1280.0f, 720.0f);
+        BenchData* data = IM_NEW(BenchData)();
+        if (scene.Setup)
+            scene.Setup(data);
+
+        ImGui_ImplNull_RunStats stats;
+        ImGui_ImplNull_RunFrames(scene.Func, data, 60, frames, &stats);
+        IM_DELETE(data);
+
+        BenchResult& r = results[results_count++];
+        ImStrncpy(r.Name, scene.Name, IM_ARRAYSIZE(r.Name));
+        r.Frames = stats.Frames;
+        r.MedianMs = stats.CpuTimeMsMedian;
+        r.AvgMs = stats.CpuTimeMsAvg;
+        r.MaxMs = stats.CpuTimeMsMax;
+        r.DrawLists = stats.LastFrame.DrawLists;
+        r.DrawCmds = stats.LastFrame.DrawCmds;
+        r.VtxCount = stats.LastFrame.VtxCount;
+        r.IdxCount = stats.LastFrame.IdxCount;
+        r.AllocCount = stats.AllocCountMax;
+        PrintResult(stdout, r);
+
+        ImGui_ImplNull_Shutdown();
+        ImGui::DestroyContext(ctx);
+    }
+
+    if (baseline_filename)
+    {
+        printf("Comparing with '%s':\n", baseline_filename);
+        for (int n = 0; n < results_count; n++)
+        {
+            const BenchResult* base = NULL;
+            for (int b = 0; b < baseline_count && base == NULL; b++)
+                if (strcmp(baseline[b].Name, results[n].Name) == 0)
+                    base = &baseline[b];
+            if (base == NULL)
+            {
+                printf("  %s: not in the baseline\n", results[n].Name);
+                ok = false;
+            }
+            else if (base->Frames != results[n].Frames)
+            {
+                printf("  %s: baseline measured %d frames, run with --frames %d to compare\n", results[n].Name, base->Frames, base->Frames);
+                ok = false;
+            }
+            else if (!CompareResult(results[n], *base, max_slowdown))
+            {
+                ok = false;
+            }
+        }
+    }
+
+    if (write_baseline_filename)
+    {
+        FILE* f = fopen(write_baseline_filename, "w");
+        if (f == NULL)
+        {
+            fprintf(stderr, "Can't write '%s'\n", write_baseline_filename);
+            return 2;
+        }
+        fprintf(f, "%s", g_ResultHeader);
+        for (int n = 0; n < results_count; n++)
+            PrintResult(f, results[n]);
+        fclose(f);
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,68 @@
+// Minimal helpers shared by the tests of this directory. Each test is an executable returning a non-zero exit code on failure.
+#pragma once
+
+#include "imgui.h"
+#include "imgui_impl_null.h"
+#include <stdio.h>
+#include <string.h>
+
+static int          g_TestFailures = 0;
+static const char*  g_TestOutputDir = "build";  // Where tests write their files, set by --output-dir (the Makefile passes its BUILD_DIR)
+
+#define IM_CHECK(_EXPR)             do { if (!(_EXPR)) { fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #_EXPR); g_TestFailures++; } } while (0)
+#define IM_CHECK_EQ(_A, _B)         do { const double a_ = (double)(_A), b_ = (double)(_B); if (a_ != b_) { fprintf(stderr, "%s:%d: check failed: %s == %s (%g != %g)\n", __FILE__, __LINE__, #_A, #_B, a_, b_); g_TestFailures++; } } while (0)
+#define IM_CHECK_NEAR(_A, _B, _TOL) do { const double a_ = (double)(_A), b_ = (double)(_B); if (!(a_ - b_ <= (_TOL) && b_ - a_ <= (_TOL))) { fprintf(stderr, "%s:%d: check failed: %s ~= %s (%g != %g)\n", __FILE__, __LINE__, #_A, #_B, a_, b_); g_TestFailures++; } } while (0)
+
+// Context with the null back-end: no window, fixed time step, no .ini file
+static inline ImGuiContext* ImTestCreateContext(float display_width = 1280.0f, float display_height = 720.0f)
+{
+    ImGuiContext* ctx = ImGui::CreateContext();
+    ImGui_ImplNull_Init(display_width, display_height);
+    return ctx;
+}
+
+static inline void ImTestDestroyContext(ImGuiContext* ctx)
+{
+    ImGui_ImplNull_Shutdown();
+    ImGui::DestroyContext(ctx);
+}
+
+static inline void ImTestNewFrame()
+{
+    ImGui_ImplNull_NewFrame();
+    ImGui::NewFrame();
+}
+
+static inline void ImTestEndFrame()
+{
+    ImGui::Render();
+    ImGui_ImplNull_RenderDrawData(ImGui::GetDrawData());
+}
+
+// Consume the arguments shared by all the tests and return the count of the remaining ones, which are moved to the front of argv
+static inline int ImTestParseArgs(int argc, char** argv)
+{
+    int remaining = 1;
+    for (int n = 1; n < argc; n++)
+    {
+        if (strcmp(argv[n], "--output-dir") == 0 && n + 1 < argc)
+            g_TestOutputDir = argv[++n];
+        else
+            argv[remaining++] = argv[n];
+    }
+    return remaining;
+}
+
+static inline void ImTestOutputPath(char* buf, size_t buf_size, const char* filename)
+{
+    snprintf(buf, buf_size, "%s/%s", g_TestOutputDir, filename);
+}
+
+static inline int ImTestReport(const char* name)
+{
+    if (g_TestFailures > 0)
+        fprintf(stderr, "%s: %d check(s) failed\n", name, g_TestFailures);
+    else
+        printf("%s: ok\n", name);
+    return g_TestFailures > 0 ? 1 : 0;
+}
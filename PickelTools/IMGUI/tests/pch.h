@@ -0,0 +1,10 @@
+// Stand-in for PickelTools/pch.h when building the Dear ImGui sources outside of the plugin (Linux tests and benchmark).
+// The plugin's precompiled header pulls the BakkesMod SDK, which the ImGui files don't use.
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <memory>
+
+#include "imgui.h"
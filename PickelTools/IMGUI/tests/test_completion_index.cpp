@@ -0,0 +1,160 @@
+// ImGuiCompletionIndex against a std::set<std::string> reference: after every random Insert(), Erase(), Rename() and Compact(), the items
+// are in the same order, every Entries[n].Lcp is the prefix shared with the previous item, and LowerBound() finds the same position.
+
+#include "imgui_test.h"
+#include "imgui_internal.h"
+#include "imgui_completion_index.h"
+#include <iterator>
+#include <set>
+#include <string>
+
+static unsigned int g_Seed = 7;
+static unsigned int Rand()  { g_Seed = g_Seed * 1103515245u + 12345u; return (g_Seed >> 8) & 0xFFFF; }
+
+// Short strings over a few characters so that many share long prefixes, including the empty string and bytes >= 0x80
+static std::string RandomString()
+{
+    const char alphabet[] = "aab_Z\xE9";
+    std::string s;
+    for (int len = (int)(Rand() % 7); len > 0; len--)
+        s += alphabet[Rand() % (IM_ARRAYSIZE(alphabet) - 1)];
+    return s;
+}
+
+static int CommonPrefixLength(const std::string& a, const std::string& b)
+{
+    int n = 0;
+    while (n < (int)a.size() && n < (int)b.size() && a[n] == b[n])
+        n++;
+    return n;
+}
+
+static int g_Errors = 0;
+
+static void CheckIndex(const ImGuiCompletionIndex& index, const std::set<std::string>& reference)
+{
+    if (index.Size() != (int)reference.size())
+    {
+        g_Errors++;
+        return;
+    }
+    int n = 0;
+    const std::string* prev = NULL;
+    for (std::set<std::string>::const_iterator it = reference.begin(); it != reference.end(); ++it, n++)
+    {
+        if (*it != index.GetItem(n))
+            g_Errors++;
+        if (index.Entries[n].Lcp != (prev ? CommonPrefixLength(*prev, *it) : 0))
+            g_Errors++;
+        prev = &*it;
+    }
+
+    // Present and absent strings
+    for (int probe = 0; probe < 8; probe++)
+    {
+        const std::string txt = (probe < 4 && index.Size() > 0) ? std::string(index.GetItem((int)(Rand() % index.Size()))) : RandomString();
+        bool found = false;
+        const int pos = index.LowerBound(txt.c_str(), &found);
+        std::set<std::string>::const_iterator it = reference.lower_bound(txt);
+        if (pos != (int)std::distance(reference.begin(), it) || found != (it != reference.end() && *it == txt))
+            g_Errors++;
+    }
+}
+
+int main()
+{
+    std::set<std::string> reference;
+    ImGuiCompletionIndex index;
+
+    // Build() drops the duplicates
+    std::string initial[300];
+    const char* initial_items[IM_ARRAYSIZE(initial)];
+    for (int n = 0; n < IM_ARRAYSIZE(initial); n++)
+    {
+        initial[n] = RandomString();
+        initial_items[n] = initial[n].c_str();
+        reference.insert(initial[n]);
+    }
+    index.Build(initial_items, IM_ARRAYSIZE(initial_items));
+    CheckIndex(index, reference);
+    IM_CHECK(index.Size() < IM_ARRAYSIZE(initial));
+
+    int inserts = 0, erases = 0, renames = 0, compacts = 0;
+    for (int step = 0; step < 20000; step++)
+    {
+        const unsigned int op = Rand() % 16;
+        if (op < 6 || index.Size() == 0)
+        {
+            // Also insert suffixes of the arena's own strings, which it must copy before growing
+            std::string txt = RandomString();
+            const char* txt_ptr = txt.c_str();
+            if (op == 0 && index.Size() > 0)
+            {
+                txt_ptr = index.GetItem((int)(Rand() % index.Size()));
+                txt_ptr += (txt_ptr[0] != 0) ? 1 : 0;
+                txt = txt_ptr;
+            }
+            bool already_present = false;
+            const int pos = index.Insert(txt_ptr, &already_present);
+            const bool inserted = reference.insert(txt).second;
+            if (already_present == inserted || pos != (int)std::distance(reference.begin(), reference.find(txt)))
+                g_Errors++;
+            inserts++;
+        }
+        else if (op < 11)
+        {
+            const int n = (int)(Rand() % index.Size());
+            std::set<std::string>::iterator it = reference.begin();
+            std::advance(it, n);
+            reference.erase(it);
+            index.Erase(n);
+            erases++;
+        }
+        else if (op < 15)
+        {
+            const int n = (int)(Rand() % index.Size());
+            std::set<std::string>::iterator it = reference.begin();
+            std::advance(it, n);
+            const std::string old_txt = *it;
+            const std::string txt = (Rand() % 8 == 0) ? old_txt : RandomString();
+            const int new_pos = index.Rename(n, txt.c_str());
+            if (txt == old_txt)
+            {
+                if (new_pos != n)
+                    g_Errors++;
+            }
+            else if (reference.count(txt) != 0)
+            {
+                if (new_pos != -1)
+                    g_Errors++;
+            }
+            else
+            {
+                reference.erase(old_txt);
+                reference.insert(txt);
+                if (new_pos != (int)std::distance(reference.begin(), reference.find(txt)))
+                    g_Errors++;
+            }
+            renames++;
+        }
+        else
+        {
+            index.Compact();
+            IM_CHECK_EQ(index.GarbageSize, 0);
+            compacts++;
+        }
+        CheckIndex(index, reference);
+        if (g_Errors > 0)
+        {
+            fprintf(stderr, "test_completion_index: first error at step %d\n", step);
+            break;
+        }
+    }
+    IM_CHECK_EQ(g_Errors, 0);
+    IM_CHECK(inserts > 0 && erases > 0 && renames > 0 && compacts > 0);
+
+    // The arena never holds more than half of garbage after an erase
+    IM_CHECK(index.GarbageSize <= index.Strings.Size / 2 || index.GarbageSize == 0);
+
+    return ImTestReport("test_completion_index");
+}
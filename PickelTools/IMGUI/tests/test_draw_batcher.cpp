@@ -0,0 +1,116 @@
+// ImDrawBatcher::Optimize() must not change the rendered pixels: the same frame is rasterized with the software renderer (imgui_impl_soft.cpp)
+// before and after batching, with and without ImDrawBatcherFlags_CpuClipQuads. Draw call counts are printed.
+
+#include "imgui_test.h"
+#include "imgui_internal.h"
+#include "imgui_impl_soft.h"
+#include "imgui_draw_batcher.h"
+#include <string.h>
+
+static const int g_Width = 1280;
+static const int g_Height = 720;
+
+// Overlapping windows, a child window, clipped text and the demo window
+static void SubmitWindows(int frame)
+{
+    ImGui::SetNextWindowPos(ImVec2(20, 20), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(400, 300), ImGuiCond_Always);
+    ImGui::Begin("Settings");
+    for (int i = 0; i < 40; i++)
+        ImGui::Text("Line %d with some text long enough to be clipped by the window border %d", i, i * 37);
+    ImGui::BeginChild("Child", ImVec2(150, 80), true);
+    for (int i = 0; i < 10; i++)
+        ImGui::Button("Button in child");
+    ImGui::EndChild();
+    if (frame == 2)
+        ImGui::SetScrollY(ImGui::GetScrollMaxY() * 0.5f);
+    ImGui::End();
+
+    ImGui::SetNextWindowPos(ImVec2(300, 150), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(300, 200), ImGuiCond_Always);
+    ImGui::Begin("Overlap");
+    static float value = 0.3f;
+    static bool check = true;
+    ImGui::SliderFloat("Slider", &value, 0.0f, 1.0f);
+    ImGui::Checkbox("Check", &check);
+    ImGui::ProgressBar(0.4f);
+    ImGui::Separator();
+    ImGui::Text("Tail");
+    ImGui::End();
+
+    ImGui::SetNextWindowPos(ImVec2(700, 100), ImGuiCond_Always);
+    ImGui::Begin("Third", NULL, ImGuiWindowFlags_AlwaysAutoResize);
+    ImGui::Text("Hello");
+    ImGui::End();
+
+    ImGui::SetNextWindowPos(ImVec2(650, 250), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(550, 450), ImGuiCond_Always);
+    ImGui::ShowDemoWindow();
+}
+
+static void RenderPixels(ImDrawData* draw_data, ImVector<unsigned int>* out_pixels)
+{
+    out_pixels->resize(g_Width * g_Height);
+    memset(out_pixels->Data, 0, (size_t)out_pixels->size_in_bytes());
+    ImGui_ImplSoft_RenderDrawData(draw_data, out_pixels->Data, g_Width, g_Height);
+}
+
+static int CountDifferentPixels(const ImVector<unsigned int>& a, const ImVector<unsigned int>& b)
+{
+    int count = 0;
+    for (int n = 0; n < a.Size; n++)
+        if (a[n] != b[n])
+            count++;
+    return count;
+}
+
+int main()
+{
+    ImGuiContext* ctx = ImTestCreateContext((float)g_Width, (float)g_Height);
+    ImGui_ImplSoft_Init(1);
+    ImGui_ImplNull_SetMousePos(5.0f, 710.0f);
+    for (int frame = 0; frame < 4; frame++)
+    {
+        ImGui_ImplNull_NewFrame();
+        ImGui_ImplSoft_NewFrame();
+        ImGui::NewFrame();
+        SubmitWindows(frame);
+        ImGui::Render();
+    }
+
+    // Optimize() redirects ImDrawData to the batcher's lists and leaves the source lists untouched: restore the original before each run
+    ImDrawData* draw_data = ImGui::GetDrawData();
+    const ImDrawData original_draw_data = *draw_data;
+    ImVector<unsigned int> reference_pixels, batched_pixels;
+    RenderPixels(draw_data, &reference_pixels);
+
+    ImDrawBatcher batcher;
+    const ImDrawBatcherFlags flags_list[] = { ImDrawBatcherFlags_None, ImDrawBatcherFlags_CpuClipQuads };
+    for (int n = 0; n < IM_ARRAYSIZE(flags_list); n++)
+    {
+        *draw_data = original_draw_data;
+        batcher.Optimize(draw_data, flags_list[n]);
+        const ImDrawBatcherStats& stats = batcher.Stats;
+        printf("test_draw_batcher: flags %d: %d draw lists -> %d, %d draw calls -> %d, %d quads clipped, %d primitives culled\n",
+            flags_list[n], stats.DrawListsBefore, stats.DrawListsAfter, stats.DrawCmdsBefore, stats.DrawCmdsAfter, stats.QuadsClipped, stats.PrimitivesCulled);
+        IM_CHECK(stats.DrawCmdsAfter < stats.DrawCmdsBefore);
+        IM_CHECK(stats.DrawListsAfter < stats.DrawListsBefore);
+        int total_vtx = 0, total_idx = 0;
+        for (int list_n = 0; list_n < draw_data->CmdListsCount; list_n++)
+        {
+            total_vtx += draw_data->CmdLists[list_n]->VtxBuffer.Size;
+            total_idx += draw_data->CmdLists[list_n]->IdxBuffer.Size;
+        }
+        IM_CHECK_EQ(total_vtx, draw_data->TotalVtxCount);
+        IM_CHECK_EQ(total_idx, draw_data->TotalIdxCount);
+
+        RenderPixels(draw_data, &batched_pixels);
+        IM_CHECK_EQ(CountDifferentPixels(reference_pixels, batched_pixels), 0);
+    }
+    IM_CHECK(batcher.Stats.QuadsClipped > 0);
+
+    *draw_data = original_draw_data;
+    ImGui_ImplSoft_Shutdown();
+    ImTestDestroyContext(ctx);
+    return ImTestReport("test_draw_batcher");
+}
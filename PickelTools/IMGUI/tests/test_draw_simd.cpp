@@ -0,0 +1,128 @@
+// AddPolyline()/AddConvexPolyFilled() SIMD paths must produce the same vertices as the scalar code, bit for bit.
+// The Makefile builds this file and imgui_draw.cpp three times: with the default flags (SSE2 on x64), with IMGUI_DISABLE_SSE (scalar)
+// and with -mavx2. The scalar build writes its output with --write, the two others compare theirs with --compare.
+
+#include "imgui_test.h"
+#include "imgui_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(IMGUI_ENABLE_AVX2)
+static const char* g_Variant = "avx2";
+#elif defined(IMGUI_ENABLE_SSE)
+static const char* g_Variant = "sse2";
+#else
+static const char* g_Variant = "scalar";
+#endif
+
+static unsigned int g_Seed = 1;
+static float RandomFloat(float max) { g_Seed = g_Seed * 1103515245u + 12345u; return (float)((g_Seed >> 8) % 10000) * (max / 10000.0f); }
+
+// Every point count up to 40 covers all the remainders of the 2-wide and 4-wide loops
+static void SubmitShapes(ImDrawList* draw_list)
+{
+    const float thicknesses[] = { 1.0f, 3.5f, 0.7f };
+    for (int aa = 0; aa < 2; aa++)
+    {
+        draw_list->Flags = aa ? (ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedFill) : ImDrawListFlags_None;
+        for (int points_count = 2; points_count < 40; points_count++)
+            for (int closed = 0; closed < 2; closed++)
+                for (int thickness_n = 0; thickness_n < IM_ARRAYSIZE(thicknesses); thickness_n++)
+                {
+                    ImVec2 points[40];
+                    for (int i = 0; i < points_count; i++)
+                        points[i] = ImVec2(RandomFloat(370.0f), RandomFloat(210.0f));
+                    if (points_count > 4)
+                        points[2] = points[1];  // Zero-length segment
+                    const int vtx_before = draw_list->VtxBuffer.Size;
+                    draw_list->AddPolyline(points, points_count, IM_COL32_WHITE, closed != 0, thicknesses[thickness_n]);
+                    if (aa)
+                    {
+                        // Thin lines: 3 vertices per point, thick lines: 4
+                        const int vtx_per_point = (thicknesses[thickness_n] > 1.0f) ? 4 : 3;
+                        IM_CHECK_EQ(draw_list->VtxBuffer.Size - vtx_before, points_count * vtx_per_point);
+                    }
+                    draw_list->AddConvexPolyFilled(points, points_count, IM_COL32(255, 0, 255, 255));
+                }
+    }
+
+    // Paths whose scratch buffers are too large for the stack (see IM_DRAWLIST_TESSELLATION_ALLOCA_MAX)
+    draw_list->Flags = ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedFill | ImDrawListFlags_AllowVtxOffset;
+    ImVector<ImVec2> points;
+    points.resize(3001);
+    for (int i = 0; i < points.Size; i++)
+        points[i] = ImVec2(185.0f + ImCos(i * 0.01f) * 180.0f, 105.0f + ImSin(i * 0.01f) * 100.0f);
+    for (int closed = 0; closed < 2; closed++)
+        for (int thickness_n = 0; thickness_n < IM_ARRAYSIZE(thicknesses); thickness_n++)
+            draw_list->AddPolyline(points.Data, points.Size, IM_COL32_WHITE, closed != 0, thicknesses[thickness_n]);
+    draw_list->AddConvexPolyFilled(points.Data, points.Size, IM_COL32(255, 0, 255, 255));
+}
+
+static bool CompareWithFile(const char* filename, const ImDrawList* draw_list)
+{
+    size_t data_size = 0;
+    char* data = (char*)ImFileLoadToMemory(filename, "rb", &data_size);
+    if (data == NULL)
+    {
+        fprintf(stderr, "Can't read '%s'\n", filename);
+        return false;
+    }
+    const size_t vtx_bytes = (size_t)draw_list->VtxBuffer.size_in_bytes();
+    const size_t idx_bytes = (size_t)draw_list->IdxBuffer.size_in_bytes();
+    bool ok = (data_size == vtx_bytes + idx_bytes);
+    if (!ok)
+        fprintf(stderr, "%s: %d bytes of geometry, scalar build wrote %d\n", g_Variant, (int)(vtx_bytes + idx_bytes), (int)data_size);
+    for (int n = 0; ok && n < draw_list->VtxBuffer.Size; n++)
+        if (memcmp(&draw_list->VtxBuffer[n], data + n * sizeof(ImDrawVert), sizeof(ImDrawVert)) != 0)
+        {
+            const ImDrawVert* ref = (const ImDrawVert*)(data + n * sizeof(ImDrawVert));
+            fprintf(stderr, "%s: vertex %d is (%.9g,%.9g), scalar (%.9g,%.9g)\n", g_Variant, n, draw_list->VtxBuffer[n].pos.x, draw_list->VtxBuffer[n].pos.y, ref->pos.x, ref->pos.y);
+            ok = false;
+        }
+    if (ok && memcmp(draw_list->IdxBuffer.Data, data + vtx_bytes, idx_bytes) != 0)
+    {
+        fprintf(stderr, "%s: indices differ from the scalar build\n", g_Variant);
+        ok = false;
+    }
+    IM_FREE(data);
+    return ok;
+}
+
+int main(int argc, char** argv)
+{
+    const char* write_filename = (argc == 3 && strcmp(argv[1], "--write") == 0) ? argv[2] : NULL;
+    const char* compare_filename = (argc == 3 && strcmp(argv[1], "--compare") == 0) ? argv[2] : NULL;
+#if defined(IMGUI_ENABLE_AVX2) && defined(__GNUC__)
+    if (!__builtin_cpu_supports("avx2"))
+    {
+        printf("test_draw_simd (%s): skipped, the CPU doesn't support AVX2\n", g_Variant);
+        return 0;
+    }
+#endif
+
+    ImGuiContext* ctx = ImTestCreateContext();
+    ImTestNewFrame();
+    ImDrawList* draw_list = ImGui::GetForegroundDrawList();
+    SubmitShapes(draw_list);
+
+    if (write_filename)
+    {
+        FILE* f = fopen(write_filename, "wb");
+        IM_CHECK(f != NULL);
+        if (f)
+        {
+            fwrite(draw_list->VtxBuffer.Data, 1, (size_t)draw_list->VtxBuffer.size_in_bytes(), f);
+            fwrite(draw_list->IdxBuffer.Data, 1, (size_t)draw_list->IdxBuffer.size_in_bytes(), f);
+            fclose(f);
+        }
+    }
+    if (compare_filename)
+        IM_CHECK(CompareWithFile(compare_filename, draw_list));
+
+    ImTestEndFrame();
+    ImTestDestroyContext(ctx);
+
+    char name[64];
+    ImFormatString(name, IM_ARRAYSIZE(name), "test_draw_simd (%s)", g_Variant);
+    return ImTestReport(name);
+}
@@ -0,0 +1,71 @@
+// ImFontAtlas::Build(options) with ImFontAtlasBuildOptions::ThreadsCount > 1 must output the same texture and glyphs as a single-threaded
+// build. Build times are printed for reference only.
+
+#include "imgui_test.h"
+#include "imgui_internal.h"
+#include <chrono>
+#include <string.h>
+
+// The default font at several sizes, oversampled so that rasterization dominates the build time
+static void AddFonts(ImFontAtlas* atlas)
+{
+    for (int n = 0; n < 12; n++)
+    {
+        ImFontConfig font_cfg;
+        font_cfg.SizePixels = 13.0f + n * 4.0f;
+        font_cfg.OversampleH = 3;
+        font_cfg.OversampleV = 2;
+        font_cfg.PixelSnapH = false;
+        atlas->AddFontDefault(&font_cfg);
+    }
+}
+
+static bool SameGlyphs(const ImFont* a, const ImFont* b)
+{
+    if (a->Glyphs.Size != b->Glyphs.Size || a->IndexAdvanceX.Size != b->IndexAdvanceX.Size)
+        return false;
+    for (int n = 0; n < a->Glyphs.Size; n++)  // Field by field: ImFontGlyph has padding after Codepoint
+    {
+        const ImFontGlyph& ga = a->Glyphs[n];
+        const ImFontGlyph& gb = b->Glyphs[n];
+        if (ga.Codepoint != gb.Codepoint || ga.AdvanceX != gb.AdvanceX || ga.X0 != gb.X0 || ga.Y0 != gb.Y0 || ga.X1 != gb.X1 || ga.Y1 != gb.Y1 ||
+            ga.U0 != gb.U0 || ga.V0 != gb.V0 || ga.U1 != gb.U1 || ga.V1 != gb.V1)
+            return false;
+    }
+    return memcmp(a->IndexAdvanceX.Data, b->IndexAdvanceX.Data, (size_t)a->IndexAdvanceX.size_in_bytes()) == 0;
+}
+
+int main()
+{
+    ImFontAtlas reference;
+    AddFonts(&reference);
+    IM_CHECK(reference.Build());
+    unsigned char* ref_pixels = NULL;
+    int ref_width = 0, ref_height = 0;
+    reference.GetTexDataAsAlpha8(&ref_pixels, &ref_width, &ref_height);
+
+    const int threads_counts[] = { 1, 2, 4, 8 };
+    for (int n = 0; n < IM_ARRAYSIZE(threads_counts); n++)
+    {
+        ImFontAtlas atlas;
+        AddFonts(&atlas);
+        ImFontAtlasBuildOptions options;
+        options.ThreadsCount = threads_counts[n];
+        const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        IM_CHECK(atlas.Build(options));
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        printf("test_font_atlas_build: %d thread(s): %.2f ms\n", threads_counts[n], ms);
+
+        unsigned char* pixels = NULL;
+        int width = 0, height = 0;
+        atlas.GetTexDataAsAlpha8(&pixels, &width, &height);
+        IM_CHECK_EQ(width, ref_width);
+        IM_CHECK_EQ(height, ref_height);
+        IM_CHECK(width == ref_width && height == ref_height && memcmp(pixels, ref_pixels, (size_t)(width * height)) == 0);
+        IM_CHECK_EQ(atlas.Fonts.Size, reference.Fonts.Size);
+        for (int font_n = 0; font_n < atlas.Fonts.Size && font_n < reference.Fonts.Size; font_n++)
+            IM_CHECK(SameGlyphs(atlas.Fonts[font_n], reference.Fonts[font_n]));
+    }
+
+    return ImTestReport("test_font_atlas_build");
+}
@@ -0,0 +1,106 @@
+// ImFontAtlasBuildOptions::CacheFilename: an atlas restored from the cache file is identical to the one which wrote it, and a cache written
+// for other fonts is rejected.
+
+#include "imgui_test.h"
+#include "imgui_internal.h"
+#include <stdio.h>
+#include <string.h>
+
+static char g_CacheFilename[512];
+
+static void AddFonts(ImFontAtlas* atlas, float base_size)
+{
+    for (int n = 0; n < 3; n++)
+    {
+        ImFontConfig font_cfg;
+        font_cfg.SizePixels = base_size + n * 5.0f;
+        font_cfg.OversampleH = 2;
+        atlas->AddFontDefault(&font_cfg);
+    }
+}
+
+static bool SameFont(const ImFont* a, const ImFont* b)
+{
+    if (a->FontSize != b->FontSize || a->Ascent != b->Ascent || a->Descent != b->Descent || a->FallbackAdvanceX != b->FallbackAdvanceX)
+        return false;
+    if (a->Glyphs.Size != b->Glyphs.Size || a->IndexLookup.Size != b->IndexLookup.Size || a->IndexAdvanceX.Size != b->IndexAdvanceX.Size)
+        return false;
+    for (int n = 0; n < a->Glyphs.Size; n++)  // Field by field: ImFontGlyph has padding after Codepoint
+    {
+        const ImFontGlyph& ga = a->Glyphs[n];
+        const ImFontGlyph& gb = b->Glyphs[n];
+        if (ga.Codepoint != gb.Codepoint || ga.AdvanceX != gb.AdvanceX || ga.X0 != gb.X0 || ga.Y0 != gb.Y0 || ga.X1 != gb.X1 || ga.Y1 != gb.Y1 ||
+            ga.U0 != gb.U0 || ga.V0 != gb.V0 || ga.U1 != gb.U1 || ga.V1 != gb.V1)
+            return false;
+    }
+    if (a->FallbackGlyph == NULL || b->FallbackGlyph == NULL || a->FallbackGlyph->Codepoint != b->FallbackGlyph->Codepoint)
+        return false;
+    return memcmp(a->IndexLookup.Data, b->IndexLookup.Data, (size_t)a->IndexLookup.size_in_bytes()) == 0 &&
+           memcmp(a->IndexAdvanceX.Data, b->IndexAdvanceX.Data, (size_t)a->IndexAdvanceX.size_in_bytes()) == 0;
+}
+
+static bool SameAtlas(ImFontAtlas* a, ImFontAtlas* b)
+{
+    unsigned char* pixels_a = NULL;
+    unsigned char* pixels_b = NULL;
+    int width_a = 0, height_a = 0, width_b = 0, height_b = 0;
+    a->GetTexDataAsAlpha8(&pixels_a, &width_a, &height_a);
+    b->GetTexDataAsAlpha8(&pixels_b, &width_b, &height_b);
+    if (width_a != width_b || height_a != height_b || memcmp(pixels_a, pixels_b, (size_t)(width_a * height_a)) != 0)
+        return false;
+    if (a->TexUvWhitePixel.x != b->TexUvWhitePixel.x || a->TexUvWhitePixel.y != b->TexUvWhitePixel.y || a->Fonts.Size != b->Fonts.Size)
+        return false;
+    for (int n = 0; n < a->CustomRects.Size; n++)
+        if (a->CustomRects[n].X != b->CustomRects[n].X || a->CustomRects[n].Y != b->CustomRects[n].Y)
+            return false;
+    for (int n = 0; n < a->Fonts.Size; n++)
+        if (!SameFont(a->Fonts[n], b->Fonts[n]))
+            return false;
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    ImTestParseArgs(argc, argv);
+    ImTestOutputPath(g_CacheFilename, sizeof(g_CacheFilename), "test_font_atlas_cache.bin");
+    remove(g_CacheFilename);
+    ImFontAtlasBuildOptions options;
+    options.CacheFilename = g_CacheFilename;
+
+    // No cache yet: Build() rasterizes and writes it
+    ImFontAtlas built;
+    AddFonts(&built, 13.0f);
+    IM_CHECK(built.Build(options));
+    ImFileHandle f = ImFileOpen(g_CacheFilename, "rb");
+    IM_CHECK(f != NULL);
+    if (f)
+        ImFileClose(f);
+
+    // Same fonts: restored from the cache
+    ImFontAtlas loaded;
+    AddFonts(&loaded, 13.0f);
+    IM_CHECK(loaded.LoadBuildCache(g_CacheFilename));
+    IM_CHECK(SameAtlas(&built, &loaded));
+
+    ImFontAtlas loaded_by_build;
+    AddFonts(&loaded_by_build, 13.0f);
+    IM_CHECK(loaded_by_build.Build(options));
+    IM_CHECK(SameAtlas(&built, &loaded_by_build));
+
+    // Other fonts: the cache is rejected, Build() rasterizes them and replaces it
+    ImFontAtlas other;
+    AddFonts(&other, 16.0f);
+    IM_CHECK(!other.LoadBuildCache(g_CacheFilename));
+    IM_CHECK(other.Build(options));
+    ImFontAtlas other_reference;
+    AddFonts(&other_reference, 16.0f);
+    IM_CHECK(other_reference.Build());
+    IM_CHECK(SameAtlas(&other, &other_reference));
+    ImFontAtlas other_loaded;
+    AddFonts(&other_loaded, 16.0f);
+    IM_CHECK(other_loaded.LoadBuildCache(g_CacheFilename));
+    IM_CHECK(SameAtlas(&other_reference, &other_loaded));
+
+    remove(g_CacheFilename);
+    return ImTestReport("test_font_atlas_cache");
+}
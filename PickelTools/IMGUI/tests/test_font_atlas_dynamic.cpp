@@ -0,0 +1,88 @@
+// ImFontAtlasFlags_DynamicGlyphs: code points missing from the glyph ranges are rasterized by the next NewFrame(), match a static build, and
+// are reported by GetTexDirtyRects(). Atlases built without the flag keep no dynamic state.
+
+#include "imgui_test.h"
+#include "imgui_internal.h"
+#include <math.h>
+#include <string.h>
+
+static const ImWchar g_AsciiRanges[] = { 0x0020, 0x007F, 0 };
+static const ImWchar g_Latin1Ranges[] = { 0x0020, 0x00FF, 0 };
+static const char* g_Text = u8"Café naïve über à Å";
+
+static void SubmitText(int, void*)
+{
+    ImGui::Begin("Text");
+    ImGui::TextUnformatted(g_Text);
+    ImGui::End();
+}
+
+// Same metrics, and the same pixels at their respective places in the two textures
+static bool SameGlyph(const ImFontAtlas* atlas_a, const ImFontGlyph* a, const ImFontAtlas* atlas_b, const ImFontGlyph* b)
+{
+    if (a->AdvanceX != b->AdvanceX || a->X0 != b->X0 || a->Y0 != b->Y0 || a->X1 != b->X1 || a->Y1 != b->Y1)
+        return false;
+    const int ax = (int)lroundf(a->U0 * atlas_a->TexWidth), ay = (int)lroundf(a->V0 * atlas_a->TexHeight);
+    const int bx = (int)lroundf(b->U0 * atlas_b->TexWidth), by = (int)lroundf(b->V0 * atlas_b->TexHeight);
+    const int w = (int)lroundf((a->U1 - a->U0) * atlas_a->TexWidth), h = (int)lroundf((a->V1 - a->V0) * atlas_a->TexHeight);
+    if (w != (int)lroundf((b->U1 - b->U0) * atlas_b->TexWidth) || h != (int)lroundf((b->V1 - b->V0) * atlas_b->TexHeight))
+        return false;
+    for (int y = 0; y < h; y++)
+        if (memcmp(atlas_a->TexPixelsAlpha8 + (ay + y) * atlas_a->TexWidth + ax, atlas_b->TexPixelsAlpha8 + (by + y) * atlas_b->TexWidth + bx, (size_t)w) != 0)
+            return false;
+    return true;
+}
+
+int main()
+{
+    ImGuiContext* ctx = ImGui::CreateContext();
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    atlas->Flags |= ImFontAtlasFlags_DynamicGlyphs;
+    ImFontConfig font_cfg;
+    font_cfg.GlyphRanges = g_AsciiRanges;
+    ImFont* font = atlas->AddFontDefault(&font_cfg);
+    ImGui_ImplNull_Init();
+    unsigned char* pixels = NULL;
+    int width = 0, height = 0;
+    atlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+    IM_CHECK(ImFontAtlasBuildFindDynamicData(atlas) != NULL);
+    IM_CHECK(atlas->GetTexDirtyRects() != NULL);
+    IM_CHECK(font->FindGlyphNoFallback(0xE9) == NULL);
+
+    // Frame 0 requests the missing code points, frame 1 rasterizes them and uploads one rectangle per glyph
+    ImGui_ImplNull_RunStats stats;
+    ImGui_ImplNull_RunFrames(SubmitText, NULL, 0, 1, &stats);
+    IM_CHECK_EQ(stats.LastFrame.TexUploads, 0);
+    ImGui_ImplNull_RunFrames(SubmitText, NULL, 0, 1, &stats);
+    const ImWchar added_codepoints[] = { 0xE9, 0xEF, 0xFC, 0xE0, 0xC5 };
+    IM_CHECK_EQ(stats.LastFrame.TexUploads, IM_ARRAYSIZE(added_codepoints));
+    ImGui_ImplNull_RunFrames(SubmitText, NULL, 0, 1, &stats);
+    IM_CHECK_EQ(stats.LastFrame.TexUploads, 0);
+
+    // The glyphs match those of an atlas built with the code points in its ranges, and the RGBA32 copy was updated
+    ImFontAtlas reference;
+    ImFontConfig reference_cfg;
+    reference_cfg.GlyphRanges = g_Latin1Ranges;
+    ImFont* reference_font = reference.AddFontDefault(&reference_cfg);
+    IM_CHECK(reference.Build());
+    IM_CHECK(ImFontAtlasBuildFindDynamicData(&reference) == NULL);
+    IM_CHECK(reference.GetTexDirtyRects() == NULL);
+    for (int n = 0; n < IM_ARRAYSIZE(added_codepoints); n++)
+    {
+        const ImFontGlyph* glyph = font->FindGlyphNoFallback(added_codepoints[n]);
+        const ImFontGlyph* reference_glyph = reference_font->FindGlyphNoFallback(added_codepoints[n]);
+        IM_CHECK(glyph != NULL && reference_glyph != NULL && SameGlyph(atlas, glyph, &reference, reference_glyph));
+    }
+    int rgba_mismatches = 0;
+    for (int n = 0; n < width * height; n++)
+        if ((atlas->TexPixelsRGBA32[n] >> IM_COL32_A_SHIFT) != atlas->TexPixelsAlpha8[n])
+            rgba_mismatches++;
+    IM_CHECK_EQ(rgba_mismatches, 0);
+
+    // Destroying the atlas releases its dynamic state
+    ImGui_ImplNull_Shutdown();
+    ImGui::DestroyContext(ctx);
+    IM_CHECK(ImFontAtlasBuildFindDynamicData(atlas) == NULL);
+
+    return ImTestReport("test_font_atlas_dynamic");
+}
@@ -0,0 +1,246 @@
+// ImGuiFuzzyMatcher matches exactly the items containing the query as a case-insensitive subsequence, and a query typed and erased
+// over many frames with a tiny time budget ends with the same best matches as one unbounded Update(). The Makefile also builds this file
+// and imgui_fuzzy_matcher.cpp with IMGUI_DISABLE_SSE: the scalar build writes its rankings with --write, the SSE2 one compares with --compare.
+
+#include "imgui_test.h"
+#include "imgui_internal.h"
+#include "imgui_fuzzy_matcher.h"
+#include <float.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#if defined(IMGUI_ENABLE_SSE)
+static const char* g_Variant = "sse2";
+#else
+static const char* g_Variant = "scalar";
+#endif
+
+static const int    g_ItemsCount = 20000;
+
+static unsigned int g_Seed = 99;
+static unsigned int Rand()  { g_Seed = g_Seed * 1103515245u + 12345u; return (g_Seed >> 8) & 0xFFFF; }
+
+// Mixed case words, digits, separators and a few non-ASCII bytes. Lengths cover the 16-byte loads ending past the item.
+// ')' and '_', ';' and ' ' share a bit of the character masks: the search of the first character must stop at the end of the item.
+static void MakeItems(std::vector<std::string>* items)
+{
+    const char* words[] = { "Stadium", "arena", "DFH", "Utopia", "Coliseum", "mannfield", "BeckwithPark", "Neo", "Tokyo", "\xC3\xA9t\xC3\xA9", "Salty_Shores", "x", "42" };
+    const char* separators[] = { " ", "_", "-", "/", ".", "(", ")", ";", "" };
+    items->resize(g_ItemsCount);
+    for (int i = 0; i < g_ItemsCount; i++)
+    {
+        std::string& item = (*items)[i];
+        const int words_count = (int)(Rand() % 6);
+        for (int n = 0; n < words_count; n++)
+        {
+            if (n > 0)
+                item += separators[Rand() % IM_ARRAYSIZE(separators)];
+            item += words[Rand() % IM_ARRAYSIZE(words)];
+        }
+        if (Rand() % 4 == 0)
+        {
+            char number[16];
+            ImFormatString(number, IM_ARRAYSIZE(number), "%u", Rand() % 1000);
+            item += number;
+        }
+    }
+}
+
+static bool ItemsGetter(void* data, int idx, const char** out_text)
+{
+    *out_text = ((const std::vector<std::string>*)data)->at(idx).c_str();
+    return true;
+}
+
+static char ToLowerAscii(char c) { return (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c; }
+static char ToUpperAscii(char c) { return (c >= 'a' && c <= 'z') ? (char)(c - 'a' + 'A') : c; }
+
+static bool IsSubsequence(const char* query, const char* text)
+{
+    for (; *query != 0; query++)
+    {
+        while (*text != 0 && ToLowerAscii(*text) != ToLowerAscii(*query))
+            text++;
+        if (*text == 0)
+            return false;
+        text++;
+    }
+    return true;
+}
+
+static bool IsRankedBefore(const ImGuiFuzzyMatch& a, const ImGuiFuzzyMatch& b)
+{
+    if (a.Score != b.Score)
+        return a.Score > b.Score;
+    if (a.Length != b.Length)
+        return a.Length < b.Length;
+    return a.Index < b.Index;
+}
+
+// Subsequences of random items, in a random case, plus a few queries matching nothing
+static void MakeQueries(const std::vector<std::string>& items, std::vector<std::string>* queries)
+{
+    for (int n = 0; n < 40; n++)
+    {
+        const std::string& item = items[Rand() % items.size()];
+        std::string query;
+        for (size_t i = 0; i < item.size() && query.size() < 12; i++)
+            if (Rand() % 3 == 0)
+                query += (Rand() % 2) ? ToUpperAscii(item[i]) : item[i];
+        if (!query.empty())
+            queries->push_back(query);
+    }
+    queries->push_back("zzq");
+    queries->push_back("d");
+    queries->push_back(")");
+    queries->push_back(";");
+    queries->push_back("\xC3\xA9");
+    queries->push_back("stadium arena coliseum");
+}
+
+// Unbounded matching: every item is evaluated by one Update() and all matches are ranked
+static void RankAll(ImGuiFuzzyMatcher* matcher, const std::vector<std::string>& items, const char* query)
+{
+    matcher->MaxResults = (int)items.size();
+    matcher->SetItems(ItemsGetter, (void*)&items, (int)items.size());
+    matcher->SetQuery(query);
+    IM_CHECK(matcher->Update(FLT_MAX));
+}
+
+static void CheckSubsequenceParity(const std::vector<std::string>& items, const std::vector<std::string>& queries)
+{
+    ImGuiFuzzyMatcher matcher;
+    int errors = 0, order_errors = 0;
+    for (size_t q = 0; q < queries.size(); q++)
+    {
+        RankAll(&matcher, items, queries[q].c_str());
+        int expected_count = 0;
+        for (int i = 0; i < (int)items.size(); i++)
+            if (IsSubsequence(queries[q].c_str(), items[i].c_str()))
+                expected_count++;
+        if (matcher.GetResultsCount() != expected_count)
+            errors++;
+        for (int n = 0; n < matcher.GetResultsCount(); n++)
+        {
+            const ImGuiFuzzyMatch& match = matcher.GetResult(n);
+            if (!IsSubsequence(queries[q].c_str(), items[match.Index].c_str()) || match.Length != (int)items[match.Index].size())
+                errors++;
+            if (n > 0 && !IsRankedBefore(matcher.GetResult(n - 1), match))
+                order_errors++;
+        }
+    }
+    IM_CHECK_EQ(errors, 0);
+    IM_CHECK_EQ(order_errors, 0);
+}
+
+// Type each query one character at a time, sometimes erasing, with a few budgeted Update() per keystroke
+static void CheckBudgetedMatchesUnbounded(const std::vector<std::string>& items, const std::vector<std::string>& queries)
+{
+    ImGuiFuzzyMatcher budgeted, unbounded;
+    budgeted.SetItems(ItemsGetter, (void*)&items, (int)items.size());
+    int errors = 0, max_updates = 0;
+    for (size_t q = 0; q < queries.size(); q++)
+    {
+        const std::string& query = queries[q];
+        for (size_t len = 1; len <= query.size(); len++)
+        {
+            std::string typed = query.substr(0, len);
+            if (len > 2 && Rand() % 4 == 0)
+            {
+                budgeted.SetQuery(query.substr(0, len - 2).c_str());
+                budgeted.Update(0.0f);
+            }
+            budgeted.SetQuery(typed.c_str());
+            for (int n = (int)(Rand() % 3); n > 0; n--)
+                budgeted.Update(0.0f);
+        }
+        int updates = 0;
+        while (!budgeted.Update(0.0f))
+            updates++;
+        max_updates = ImMax(max_updates, updates);
+
+        RankAll(&unbounded, items, query.c_str());
+        const int expected_count = ImMin(unbounded.GetResultsCount(), budgeted.MaxResults);
+        if (budgeted.GetResultsCount() != expected_count)
+            errors++;
+        for (int n = 0; n < ImMin(budgeted.GetResultsCount(), expected_count); n++)
+        {
+            const ImGuiFuzzyMatch& a = budgeted.GetResult(n);
+            const ImGuiFuzzyMatch& b = unbounded.GetResult(n);
+            if (a.Index != b.Index || a.Score != b.Score || a.Length != b.Length)
+                errors++;
+        }
+    }
+    IM_CHECK_EQ(errors, 0);
+    IM_CHECK(max_updates > 0);      // The budget did split the evaluation
+}
+
+static bool CompareWithFile(const char* filename, const ImVector<ImGuiFuzzyMatch>& rankings)
+{
+    FILE* f = fopen(filename, "rb");
+    if (f == NULL)
+    {
+        fprintf(stderr, "test_fuzzy_matcher (%s): can't open %s\n", g_Variant, filename);
+        return false;
+    }
+    ImVector<ImGuiFuzzyMatch> expected;
+    expected.resize(rankings.Size);
+    const size_t read_size = fread(expected.Data, 1, (size_t)expected.size_in_bytes(), f);
+    const bool at_end = fgetc(f) == EOF;
+    fclose(f);
+    if (read_size != (size_t)expected.size_in_bytes() || !at_end)
+    {
+        fprintf(stderr, "test_fuzzy_matcher (%s): %s doesn't have the same number of matches\n", g_Variant, filename);
+        return false;
+    }
+    for (int n = 0; n < rankings.Size; n++)
+        if (memcmp(&rankings[n], &expected[n], sizeof(ImGuiFuzzyMatch)) != 0)
+        {
+            fprintf(stderr, "test_fuzzy_matcher (%s): match %d differs: item %d score %d, expected item %d score %d\n", g_Variant, n, rankings[n].Index, rankings[n].Score, expected[n].Index, expected[n].Score);
+            return false;
+        }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    argc = ImTestParseArgs(argc, argv);
+    const char* write_filename = (argc == 3 && strcmp(argv[1], "--write") == 0) ? argv[2] : NULL;
+    const char* compare_filename = (argc == 3 && strcmp(argv[1], "--compare") == 0) ? argv[2] : NULL;
+
+    std::vector<std::string> items;
+    std::vector<std::string> queries;
+    MakeItems(&items);
+    MakeQueries(items, &queries);
+    CheckSubsequenceParity(items, queries);
+    CheckBudgetedMatchesUnbounded(items, queries);
+
+    // Full rankings of all queries, back to back
+    ImVector<ImGuiFuzzyMatch> rankings;
+    ImGuiFuzzyMatcher matcher;
+    for (size_t q = 0; q < queries.size(); q++)
+    {
+        RankAll(&matcher, items, queries[q].c_str());
+        for (int n = 0; n < matcher.GetResultsCount(); n++)
+            rankings.push_back(matcher.GetResult(n));
+    }
+    IM_CHECK(rankings.Size > 1000);
+    if (write_filename)
+    {
+        FILE* f = fopen(write_filename, "wb");
+        IM_CHECK(f != NULL);
+        if (f)
+        {
+            fwrite(rankings.Data, 1, (size_t)rankings.size_in_bytes(), f);
+            fclose(f);
+        }
+    }
+    if (compare_filename)
+        IM_CHECK(CompareWithFile(compare_filename, rankings));
+
+    char name[64];
+    ImFormatString(name, IM_ARRAYSIZE(name), "test_fuzzy_matcher (%s)", g_Variant);
+    return ImTestReport(name);
+}
@@ -0,0 +1,244 @@
+// Golden image test: scripted scenes are rasterized with the software renderer (imgui_impl_soft.cpp) and compared with the reference
+// images of golden/. On mismatch, the rendered image and a diff image (differing pixels in red) are written to the output directory for inspection.
+// Usage:
+//   test_golden [--output-dir dir]     Compare every scene with its reference (dir defaults to build)
+//   test_golden --update               Rewrite the reference images (review them before committing!)
+// The software renderer output doesn't depend on the threads count nor on SIMD, so the references are valid for every build.
+
+#include "imgui_test.h"
+#include "imgui_internal.h"
+#include "imgui_impl_soft.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const int    g_Width = 400;
+static const int    g_Height = 300;
+static const ImU32  g_ClearColor = IM_COL32(30, 34, 40, 255);
+
+//-----------------------------------------------------------------------------
+// Scenes
+//-----------------------------------------------------------------------------
+
+static void SceneWidgets()
+{
+    static float slider_value = 0.35f;
+    static int int_value = 42;
+    static bool check = true;
+    static float color[4] = { 0.9f, 0.5f, 0.2f, 1.0f };
+    static char text[32] = "Golden";
+    ImGui::SetNextWindowPos(ImVec2(10, 10), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(380, 280), ImGuiCond_Always);
+    ImGui::Begin("Widgets");
+    ImGui::Text("Text with a %s", "format");
+    ImGui::Button("Button");
+    ImGui::SameLine();
+    ImGui::Checkbox("Checkbox", &check);
+    ImGui::SliderFloat("Slider", &slider_value, 0.0f, 1.0f);
+    ImGui::DragInt("Drag", &int_value);
+    ImGui::InputText("Input", text, IM_ARRAYSIZE(text));
+    ImGui::ColorEdit4("Color", color);
+    ImGui::ProgressBar(0.6f);
+    ImGui::Separator();
+    if (ImGui::TreeNodeEx("Tree", ImGuiTreeNodeFlags_DefaultOpen))
+    {
+        ImGui::BulletText("Leaf");
+        ImGui::TreePop();
+    }
+    ImGui::End();
+}
+
+static void SceneShapes()
+{
+    ImDrawList* draw_list = ImGui::GetForegroundDrawList();
+    const ImU32 col = IM_COL32(255, 200, 100, 255);
+    draw_list->AddRectFilled(ImVec2(10, 10), ImVec2(110, 70), IM_COL32(80, 120, 200, 255), 8.0f);
+    draw_list->AddRect(ImVec2(130, 10), ImVec2(230, 70), col, 0.0f, ImDrawCornerFlags_All, 3.0f);
+    draw_list->AddRectFilledMultiColor(ImVec2(250, 10), ImVec2(390, 70), IM_COL32(255, 0, 0, 255), IM_COL32(0, 255, 0, 255), IM_COL32(0, 0, 255, 255), IM_COL32(255, 255, 255, 128));
+    for (int i = 0; i < 6; i++)
+    {
+        draw_list->AddCircle(ImVec2(35.0f + i * 65.0f, 120.0f), 5.0f + i * 5.0f, col, 0, 1.0f + i * 0.5f);
+        draw_list->AddCircleFilled(ImVec2(35.0f + i * 65.0f, 190.0f), 3.0f + i * 4.0f, IM_COL32(100, 220, 150, 200));
+    }
+    draw_list->AddTriangleFilled(ImVec2(20, 290), ImVec2(70, 230), ImVec2(120, 290), IM_COL32(220, 80, 200, 255));
+    draw_list->AddBezierCurve(ImVec2(140, 280), ImVec2(180, 200), ImVec2(240, 320), ImVec2(280, 230), col, 2.0f);
+    ImVec2 points[40];
+    for (int i = 0; i < IM_ARRAYSIZE(points); i++)
+        points[i] = ImVec2(290.0f + i * 2.5f, 260.0f + ImSin(i * 0.5f) * 25.0f);
+    draw_list->AddPolyline(points, IM_ARRAYSIZE(points), IM_COL32(255, 255, 255, 255), false, 1.5f);
+    draw_list->AddText(ImVec2(140, 60), IM_COL32_WHITE, "AddText()");
+}
+
+static void SceneOverlappingWindows()
+{
+    static float values[64];
+    for (int i = 0; i < IM_ARRAYSIZE(values); i++)
+        values[i] = ImSin(i * 0.2f);
+    ImGui::SetNextWindowPos(ImVec2(10, 10), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(250, 200), ImGuiCond_Always);
+    ImGui::Begin("Back");
+    if (ImGui::BeginTabBar("Tabs"))
+    {
+        if (ImGui::BeginTabItem("First"))
+        {
+            for (int i = 0; i < 20; i++)
+                ImGui::Text("Clipped line %d of the first tab", i);
+            ImGui::EndTabItem();
+        }
+        if (ImGui::BeginTabItem("Second"))
+            ImGui::EndTabItem();
+        ImGui::EndTabBar();
+    }
+    ImGui::End();
+
+    ImGui::SetNextWindowPos(ImVec2(140, 110), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(250, 180), ImGuiCond_Always);
+    ImGui::Begin("Front");
+    ImGui::PlotLines("Lines", values, IM_ARRAYSIZE(values), 0, NULL, -1.0f, 1.0f, ImVec2(0, 50));
+    ImGui::PlotHistogram("Histogram", values, IM_ARRAYSIZE(values), 0, NULL, 0.0f, 1.0f, ImVec2(0, 50));
+    ImGui::BeginChild("Child", ImVec2(0, 0), true);
+    ImGui::Text("Child window");
+    ImGui::EndChild();
+    ImGui::End();
+}
+
+struct GoldenScene
+{
+    const char*     Name;
+    void            (*Func)();
+};
+
+static const GoldenScene g_Scenes[] =
+{
+    { "widgets",                SceneWidgets },
+    { "shapes",                 SceneShapes },
+    { "overlapping_windows",    SceneOverlappingWindows },
+};
+
+//-----------------------------------------------------------------------------
+// Images (binary PPM, RGB)
+//-----------------------------------------------------------------------------
+
+static bool SavePPM(const char* filename, const unsigned int* pixels, int width, int height)
+{
+    FILE* f = fopen(filename, "wb");
+    if (f == NULL)
+        return false;
+    fprintf(f, "P6\n%d %d\n255\n", width, height);
+    ImVector<unsigned char> rgb;
+    rgb.resize(width * height * 3);
+    for (int n = 0; n < width * height; n++)
+    {
+        rgb[n * 3 + 0] = (unsigned char)(pixels[n] >> IM_COL32_R_SHIFT);
+        rgb[n * 3 + 1] = (unsigned char)(pixels[n] >> IM_COL32_G_SHIFT);
+        rgb[n * 3 + 2] = (unsigned char)(pixels[n] >> IM_COL32_B_SHIFT);
+    }
+    const bool ret = fwrite(rgb.Data, 1, (size_t)rgb.Size, f) == (size_t)rgb.Size;
+    fclose(f);
+    return ret;
+}
+
+static bool LoadPPM(const char* filename, ImVector<unsigned int>* out_pixels, int* out_width, int* out_height)
+{
+    size_t data_size = 0;
+    char* data = (char*)ImFileLoadToMemory(filename, "rb", &data_size, 1);
+    if (data == NULL)
+        return false;
+    int width = 0, height = 0, max_value = 0, header_size = 0;
+    const bool ok = sscanf(data, "P6 %d %d %d%n", &width, &height, &max_value, &header_size) == 3 && max_value == 255 && width > 0 && height > 0
+        && (size_t)header_size + 1 + (size_t)(width * height * 3) == data_size;
+    if (ok)
+    {
+        const unsigned char* rgb = (const unsigned char*)data + header_size + 1;
+        out_pixels->resize(width * height);
+        for (int n = 0; n < width * height; n++)
+            (*out_pixels)[n] = IM_COL32(rgb[n * 3 + 0], rgb[n * 3 + 1], rgb[n * 3 + 2], 255);
+        *out_width = width;
+        *out_height = height;
+    }
+    IM_FREE(data);
+    return ok;
+}
+
+//-----------------------------------------------------------------------------
+// Main
+//-----------------------------------------------------------------------------
+
+static void RenderScene(const GoldenScene& scene, ImVector<unsigned int>* out_pixels)
+{
+    ImGuiContext* ctx = ImTestCreateContext((float)g_Width, (float)g_Height);
+    ImGui_ImplSoft_Init(0);
+    ImGui_ImplNull_SetMousePos(-100.0f, -100.0f);
+    for (int frame = 0; frame < 3; frame++)     // Let auto-sized elements settle
+    {
+        ImGui_ImplNull_NewFrame();
+        ImGui_ImplSoft_NewFrame();
+        ImGui::NewFrame();
+        scene.Func();
+        ImGui::Render();
+    }
+    out_pixels->resize(g_Width * g_Height);
+    for (int n = 0; n < out_pixels->Size; n++)
+        (*out_pixels)[n] = g_ClearColor;
+    ImGui_ImplSoft_RenderDrawData(ImGui::GetDrawData(), out_pixels->Data, g_Width, g_Height);
+    for (int n = 0; n < out_pixels->Size; n++)  // Only RGB is stored
+        (*out_pixels)[n] |= IM_COL32_A_MASK;
+    ImGui_ImplSoft_Shutdown();
+    ImTestDestroyContext(ctx);
+}
+
+int main(int argc, char** argv)
+{
+    argc = ImTestParseArgs(argc, argv);
+    const bool update = (argc == 2 && strcmp(argv[1], "--update") == 0);
+    for (int scene_n = 0; scene_n < IM_ARRAYSIZE(g_Scenes); scene_n++)
+    {
+        const GoldenScene& scene = g_Scenes[scene_n];
+        ImVector<unsigned int> pixels;
+        RenderScene(scene, &pixels);
+
+        char reference_filename[256];
+        ImFormatString(reference_filename, IM_ARRAYSIZE(reference_filename), "golden/%s.ppm", scene.Name);
+        if (update)
+        {
+            IM_CHECK(SavePPM(reference_filename, pixels.Data, g_Width, g_Height));
+            printf("test_golden: wrote %s\n", reference_filename);
+            continue;
+        }
+
+        ImVector<unsigned int> reference;
+        int reference_width = 0, reference_height = 0;
+        if (!LoadPPM(reference_filename, &reference, &reference_width, &reference_height))
+        {
+            fprintf(stderr, "test_golden: can't read '%s', run with --update to create it\n", reference_filename);
+            g_TestFailures++;
+            continue;
+        }
+        IM_CHECK_EQ(reference_width, g_Width);
+        IM_CHECK_EQ(reference_height, g_Height);
+        if (reference_width != g_Width || reference_height != g_Height)
+            continue;
+
+        ImVector<unsigned int> diff;
+        diff.resize(pixels.Size);
+        int different_pixels = 0;
+        for (int n = 0; n < pixels.Size; n++)
+        {
+            const bool different = (pixels[n] != reference[n]);
+            different_pixels += different ? 1 : 0;
+            diff[n] = different ? IM_COL32(255, 0, 0, 255) : ((reference[n] >> 2) & 0x3F3F3F3F) | IM_COL32_A_MASK; // Dimmed reference elsewhere
+        }
+        if (different_pixels > 0)
+        {
+            char name[128], filename[512];
+            ImFormatString(name, IM_ARRAYSIZE(name), "golden_%s_actual.ppm", scene.Name);
+            ImTestOutputPath(filename, sizeof(filename), name);
+            SavePPM(filename, pixels.Data, g_Width, g_Height);
+            ImFormatString(name, IM_ARRAYSIZE(name), "golden_%s_diff.ppm", scene.Name);
+            ImTestOutputPath(filename, sizeof(filename), name);
+            SavePPM(filename, diff.Data, g_Width, g_Height);
+            fprintf(stderr, "test_golden: %s: %d pixels differ from %s, see %s/golden_%s_*.ppm\n", scene.Name, different_pixels, reference_filename, g_TestOutputDir, scene.Name);
+            g_TestFailures++;
+        }
+    }
+    return ImTestReport("test_golden");
+}
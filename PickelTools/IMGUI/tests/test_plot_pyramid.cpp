@@ -0,0 +1,140 @@
+// PlotMinMaxPyramid against a brute-force scan: after random append() and update(), getMinMax() of random ranges (including ranges shorter
+// than a block, and ranges starting or ending inside a block) is the exact min and max of their values, through the stride and getter forms.
+
+#include "imgui_test.h"
+#include "imgui_internal.h"
+#include "imguivariouscontrols.h"
+#include <float.h>
+#include <vector>
+
+using ImGui::PlotMinMaxPyramid;
+
+static unsigned int g_Seed = 2024;
+static unsigned int Rand()  { g_Seed = g_Seed * 1103515245u + 12345u; return (g_Seed >> 8) & 0xFFFF; }
+
+// Values of all magnitudes, so that every block has a distinct min and max
+static float RandomValue()  { return (float)((int)(Rand() % 20001) - 10000) * 0.01f; }
+
+static float VectorGetter(const void* data, int idx) { return (*(const std::vector<float>*)data)[idx]; }
+
+static bool BruteForceMinMax(const std::vector<float>& values, int begin, int end, float* out_min, float* out_max)
+{
+    float mn = FLT_MAX, mx = -FLT_MAX;
+    for (int i = ImMax(begin, 0); i < ImMin(end, (int)values.size()); i++)
+    {
+        mn = ImMin(mn, values[i]);
+        mx = ImMax(mx, values[i]);
+    }
+    *out_min = mn;
+    *out_max = mx;
+    return mn <= mx;
+}
+
+static int g_Errors = 0;
+
+static void CheckRange(const PlotMinMaxPyramid& pyramid, const std::vector<float>& values, int begin, int end)
+{
+    float expected_min, expected_max, mn, mx;
+    const bool expected_ret = BruteForceMinMax(values, begin, end, &expected_min, &expected_max);
+    if (pyramid.getMinMax(values.empty() ? NULL : &values[0], begin, end, &mn, &mx) != expected_ret || (expected_ret && (mn != expected_min || mx != expected_max)))
+        g_Errors++;
+    if (pyramid.getMinMax(VectorGetter, &values, begin, end, &mn, &mx) != expected_ret || (expected_ret && (mn != expected_min || mx != expected_max)))
+        g_Errors++;
+}
+
+static void CheckPyramid(const PlotMinMaxPyramid& pyramid, const std::vector<float>& values)
+{
+    const int size = (int)values.size();
+    if (pyramid.getSize() != size)
+    {
+        g_Errors++;
+        return;
+    }
+    float mn, mx;
+    if (size > 0 && BruteForceMinMax(values, 0, size, &mn, &mx) && (pyramid.getMin() != mn || pyramid.getMax() != mx))
+        g_Errors++;
+
+    CheckRange(pyramid, values, 0, size);
+    for (int n = 0; n < 24 && size > 0; n++)
+    {
+        // Short ranges inside a block or across one block boundary, and long ranges with partial blocks at both ends
+        const int begin = (int)(Rand() % (size + 1));
+        const int len = (n % 2) ? (int)(Rand() % (PlotMinMaxPyramid::BlockSize * 2)) : (int)(Rand() % (size + 1));
+        CheckRange(pyramid, values, begin, ImMin(begin + len, size));
+    }
+    CheckRange(pyramid, values, -5, size + 5);  // Clamped
+    CheckRange(pyramid, values, size, size);    // Empty
+}
+
+int main()
+{
+    PlotMinMaxPyramid pyramid;
+    std::vector<float> values;
+    CheckPyramid(pyramid, values);
+
+    int appends = 0, updates = 0, builds = 0;
+    for (int step = 0; step < 3000; step++)
+    {
+        const unsigned int op = Rand() % 16;
+        if (op < 8 || values.empty())
+        {
+            // One value at a time, or a few strided values (every other float of a buffer)
+            if (op % 2 == 0)
+            {
+                const float v = RandomValue();
+                values.push_back(v);
+                pyramid.append(v);
+            }
+            else
+            {
+                float buffer[2 * 40];
+                const int count = 1 + (int)(Rand() % 40);
+                for (int i = 0; i < count; i++)
+                {
+                    buffer[i * 2] = RandomValue();
+                    buffer[i * 2 + 1] = 1e30f;
+                    values.push_back(buffer[i * 2]);
+                }
+                pyramid.append(buffer, count, 2 * sizeof(float));
+            }
+            appends++;
+        }
+        else if (op < 15)
+        {
+            // Updated values can remove the min or the max of their blocks
+            const int begin = (int)(Rand() % values.size());
+            const int end = ImMin(begin + 1 + (int)(Rand() % 20), (int)values.size());
+            for (int i = begin; i < end; i++)
+                values[i] = (Rand() % 2) ? RandomValue() * 0.1f : RandomValue();
+            pyramid.update(&values[0], begin, end);
+            updates++;
+        }
+        else
+        {
+            pyramid.build(VectorGetter, &values, (int)values.size());
+            builds++;
+        }
+        CheckPyramid(pyramid, values);
+        if (g_Errors > 0)
+        {
+            fprintf(stderr, "test_plot_pyramid: first error at step %d (%d values)\n", step, (int)values.size());
+            break;
+        }
+    }
+    IM_CHECK_EQ(g_Errors, 0);
+    IM_CHECK(appends > 0 && updates > 0 && builds > 0);
+    IM_CHECK(values.size() > 10000);
+
+    // A range of a few values in the middle of a block doesn't see the rest of the block
+    std::vector<float> block(PlotMinMaxPyramid::BlockSize * 4, 0.0f);
+    block[PlotMinMaxPyramid::BlockSize + 1] = -100.0f;
+    block[PlotMinMaxPyramid::BlockSize * 3 - 1] = 100.0f;
+    pyramid.build(&block[0], (int)block.size());
+    float mn = 0.0f, mx = 0.0f;
+    IM_CHECK(pyramid.getMinMax(&block[0], PlotMinMaxPyramid::BlockSize + 2, PlotMinMaxPyramid::BlockSize * 3 - 1, &mn, &mx));
+    IM_CHECK_EQ(mn, 0.0f);
+    IM_CHECK_EQ(mx, 0.0f);
+    IM_CHECK(!pyramid.getMinMax(&block[0], 5, 5, &mn, &mx));
+
+    return ImTestReport("test_plot_pyramid");
+}
@@ -0,0 +1,147 @@
+// PlotRingBuffer against a std::deque per channel: 500 appends at capacity 37 wrap around many times, and after every append getValue(0) is
+// the oldest value, getView() splits the values in two parts in the same order, and the running mean/min/max are those of the kept values.
+
+#include "imgui_test.h"
+#include "imgui_internal.h"
+#include "imguivariouscontrols.h"
+#include <float.h>
+#include <deque>
+
+using ImGui::PlotRingBuffer;
+using ImGui::PlotMinMaxPyramid;
+
+static const int    g_Capacity = 37;
+static const int    g_NumChannels = 3;
+
+static unsigned int g_Seed = 37;
+static unsigned int Rand()  { g_Seed = g_Seed * 1103515245u + 12345u; return (g_Seed >> 8) & 0xFFFF; }
+
+static int g_Errors = 0;
+
+static void CheckChannel(const PlotRingBuffer& buffer, int channel, const std::deque<float>& reference)
+{
+    const int size = (int)reference.size();
+    if (buffer.getSize() != size)
+    {
+        g_Errors++;
+        return;
+    }
+    double sum = 0.0;
+    float mn = FLT_MAX, mx = -FLT_MAX;
+    for (int i = 0; i < size; i++)
+    {
+        if (buffer.getValue(channel, i) != reference[i])
+            g_Errors++;
+        sum += reference[i];
+        mn = ImMin(mn, reference[i]);
+        mx = ImMax(mx, reference[i]);
+    }
+    if (size > 0 && (buffer.getMin(channel) != mn || buffer.getMax(channel) != mx))
+        g_Errors++;
+    if (size > 0 && ImFabs(buffer.getMean(channel) - (float)(sum / size)) > 1e-5f * ImMax(1.0f, ImFabs((float)(sum / size))))
+        g_Errors++;
+
+    // Both parts of the view, one after the other, are the values from the oldest one
+    const float* values0; const float* values1;
+    int count0, count1;
+    buffer.getView(channel, &values0, &count0, &values1, &count1);
+    if (count0 + count1 != size || count0 < 0 || count1 < 0 || ((size_t)values1 & 63) != 0)
+    {
+        g_Errors++;
+        return;
+    }
+    for (int i = 0; i < size; i++)
+        if ((i < count0 ? values0[i] : values1[i - count0]) != reference[i])
+            g_Errors++;
+
+    // The pyramid is indexed by slot: the oldest value is at getStart()
+    const PlotMinMaxPyramid& pyramid = buffer.getPyramid(channel);
+    if (pyramid.getSize() != size || (size > 0 && values0 != values1 + buffer.getStart()))
+        g_Errors++;
+    for (int n = 0; n < 4 && size > 0; n++)
+    {
+        const int begin = (int)(Rand() % size);
+        const int end = begin + 1 + (int)(Rand() % (size - begin));
+        float range_min = FLT_MAX, range_max = -FLT_MAX, pyramid_min, pyramid_max;
+        for (int slot = begin; slot < end; slot++)
+        {
+            range_min = ImMin(range_min, values1[slot]);
+            range_max = ImMax(range_max, values1[slot]);
+        }
+        if (!pyramid.getMinMax(values1, begin, end, &pyramid_min, &pyramid_max) || pyramid_min != range_min || pyramid_max != range_max)
+            g_Errors++;
+    }
+}
+
+int main()
+{
+    PlotRingBuffer buffer(g_Capacity, g_NumChannels);
+    IM_CHECK_EQ(buffer.getCapacity(), g_Capacity);
+    IM_CHECK_EQ(buffer.getNumChannels(), g_NumChannels);
+    IM_CHECK_EQ(buffer.getSize(), 0);
+
+    std::deque<float> reference[g_NumChannels];
+    int split_views = 0, wraps = 0;
+    for (int pass = 0; pass < 2; pass++)
+    {
+        for (int step = 0; step < 500; step++)
+        {
+            // Channel 0 counts, so getValue(0) of a full buffer is step-capacity+1. The others have large values which come and go.
+            float values[g_NumChannels];
+            values[0] = (float)step;
+            values[1] = (float)((int)(Rand() % 2001) - 1000);
+            values[2] = (Rand() % 16 == 0) ? 1e6f : (float)(Rand() % 100) * 0.25f;
+            const int start = buffer.getStart();
+            buffer.append(values);
+            if (buffer.getStart() < start)
+                wraps++;
+            for (int c = 0; c < g_NumChannels; c++)
+            {
+                reference[c].push_back(values[c]);
+                if ((int)reference[c].size() > g_Capacity)
+                    reference[c].pop_front();
+                CheckChannel(buffer, c, reference[c]);
+            }
+            IM_CHECK_EQ(buffer.getValue(0, 0), (float)ImMax(step - g_Capacity + 1, 0));
+            IM_CHECK_EQ(buffer.getValue(0, buffer.getSize() - 1), (float)step);
+
+            const float* values0; const float* values1;
+            int count0, count1;
+            buffer.getView(0, &values0, &count0, &values1, &count1);
+            if (count0 > 0 && count1 > 0)
+                split_views++;
+            if (g_Errors > 0)
+            {
+                fprintf(stderr, "test_plot_ring_buffer: first error at pass %d step %d\n", pass, step);
+                break;
+            }
+        }
+        IM_CHECK_EQ(g_Errors, 0);
+        IM_CHECK_EQ(buffer.getSize(), g_Capacity);
+        IM_CHECK(wraps >= 500 / g_Capacity - 1);
+        IM_CHECK(split_views > 400);
+
+        // clear() starts over from an empty buffer
+        buffer.clear();
+        IM_CHECK_EQ(buffer.getSize(), 0);
+        IM_CHECK_EQ(buffer.getMean(0), 0.0f);
+        IM_CHECK_EQ(buffer.getPyramid(1).getSize(), 0);
+        for (int c = 0; c < g_NumChannels; c++)
+            reference[c].clear();
+        split_views = wraps = 0;
+    }
+
+    // A single channel buffer with capacity 1 always holds the last value
+    PlotRingBuffer last(1);
+    for (int step = 0; step < 10; step++)
+    {
+        last.append((float)(step * 3 - 7));
+        IM_CHECK_EQ(last.getSize(), 1);
+        IM_CHECK_EQ(last.getValue(0, 0), (float)(step * 3 - 7));
+        IM_CHECK_EQ(last.getMin(0), (float)(step * 3 - 7));
+        IM_CHECK_EQ(last.getMax(0), (float)(step * 3 - 7));
+        IM_CHECK_EQ(last.getMean(0), (float)(step * 3 - 7));
+    }
+
+    return ImTestReport("test_plot_ring_buffer");
+}
@@ -0,0 +1,410 @@
+// Profiler zones recorded by two threads at once: every zone has the depth of its nesting and lies inside its parent, and each thread keeps its
+// own index and name. A thread recording more zones than its ring holds between two frames has the extra ones dropped and counted.
+// ProfilerExportChromeTrace() writes a file that a strict JSON parser reads back, with one event per frame and zone and escaped names.
+
+#include "imgui_test.h"
+#include "imgui_internal.h"
+#include "imgui_profiler.h"
+#include <stdlib.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const int    g_RingSize = 1 << 16;      // PROFILER_RING_SIZE of imgui_profiler.cpp
+static const char*  g_EscapedName = "Escaped \"zone\" \\ \t\x01";
+
+//-----------------------------------------------------------------------------
+// Strict JSON parser (RFC 8259): the whole input must be a single value
+//-----------------------------------------------------------------------------
+
+struct JsonValue
+{
+    enum Type { Type_Null, Type_Bool, Type_Number, Type_String, Type_Array, Type_Object };
+    Type                        ValueType;
+    double                      Number;         // Also 0.0 or 1.0 for Type_Bool
+    std::string                 String;
+    std::vector<std::string>    Keys;           // Type_Object
+    std::vector<JsonValue>      Values;         // Type_Array and Type_Object
+
+    JsonValue() { ValueType = Type_Null; Number = 0.0; }
+
+    const JsonValue* Find(const char* key) const
+    {
+        for (size_t n = 0; n < Keys.size(); n++)
+            if (Keys[n] == key)
+                return &Values[n];
+        return NULL;
+    }
+};
+
+struct JsonParser
+{
+    const char* P;
+    const char* End;
+
+    bool Parse(const char* text, size_t size, JsonValue* out)
+    {
+        P = text;
+        End = text + size;
+        if (!ParseValue(out, 0))
+            return false;
+        SkipSpaces();
+        return P == End;
+    }
+
+    void SkipSpaces()   { while (P < End && (*P == ' ' || *P == '\t' || *P == '\n' || *P == '\r')) P++; }
+    bool Consume(char c) { SkipSpaces(); if (P < End && *P == c) { P++; return true; } return false; }
+    static bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+    bool ParseLiteral(const char* literal)
+    {
+        const size_t len = strlen(literal);
+        if ((size_t)(End - P) < len || strncmp(P, literal, len) != 0)
+            return false;
+        P += len;
+        return true;
+    }
+
+    bool ParseNumber(double* out)
+    {
+        const char* start = P;
+        if (P < End && *P == '-')
+            P++;
+        if (P < End && *P == '0')
+            P++;
+        else if (P < End && IsDigit(*P))
+            while (P < End && IsDigit(*P)) P++;
+        else
+            return false;
+        if (P < End && *P == '.')
+        {
+            if (++P >= End || !IsDigit(*P))
+                return false;
+            while (P < End && IsDigit(*P)) P++;
+        }
+        if (P < End && (*P == 'e' || *P == 'E'))
+        {
+            if (++P < End && (*P == '+' || *P == '-'))
+                P++;
+            if (P >= End || !IsDigit(*P))
+                return false;
+            while (P < End && IsDigit(*P)) P++;
+        }
+        *out = atof(std::string(start, P).c_str());
+        return true;
+    }
+
+    bool ParseString(std::string* out)
+    {
+        if (P >= End || *P != '"')
+            return false;
+        for (P++; P < End && *P != '"'; P++)
+        {
+            if ((unsigned char)*P < 0x20)
+                return false;
+            if (*P != '\\')
+            {
+                *out += *P;
+                continue;
+            }
+            if (++P >= End)
+                return false;
+            switch (*P)
+            {
+            case '"': case '\\': case '/': *out += *P; break;
+            case 'b': *out += '\b'; break;
+            case 'f': *out += '\f'; break;
+            case 'n': *out += '\n'; break;
+            case 'r': *out += '\r'; break;
+            case 't': *out += '\t'; break;
+            case 'u':
+            {
+                if (End - P < 5)
+                    return false;
+                unsigned int c = 0;
+                for (int n = 1; n <= 4; n++)
+                {
+                    const char h = P[n];
+                    c = c * 16 + (IsDigit(h) ? h - '0' : (h >= 'a' && h <= 'f') ? h - 'a' + 10 : (h >= 'A' && h <= 'F') ? h - 'A' + 10 : 0x10000);
+                }
+                if (c > 0xFFFF)
+                    return false;
+                if (c < 0x80)
+                    *out += (char)c;
+                else if (c < 0x800)
+                    *out += std::string(1, (char)(0xC0 | (c >> 6))) + (char)(0x80 | (c & 0x3F));
+                else
+                    *out += std::string(1, (char)(0xE0 | (c >> 12))) + (char)(0x80 | ((c >> 6) & 0x3F)) + (char)(0x80 | (c & 0x3F));
+                P += 4;
+                break;
+            }
+            default:
+                return false;
+            }
+        }
+        if (P >= End)
+            return false;
+        P++;
+        return true;
+    }
+
+    bool ParseValue(JsonValue* out, int depth)
+    {
+        SkipSpaces();
+        if (P >= End || depth > 32)
+            return false;
+        if (*P == '{' || *P == '[')
+        {
+            const bool object = *P++ == '{';
+            const char close = object ? '}' : ']';
+            out->ValueType = object ? JsonValue::Type_Object : JsonValue::Type_Array;
+            if (Consume(close))
+                return true;
+            do
+            {
+                if (object)
+                {
+                    SkipSpaces();
+                    out->Keys.push_back(std::string());
+                    if (!ParseString(&out->Keys.back()) || !Consume(':'))
+                        return false;
+                }
+                out->Values.push_back(JsonValue());
+                if (!ParseValue(&out->Values.back(), depth + 1))
+                    return false;
+            }
+            while (Consume(','));
+            return Consume(close);
+        }
+        if (*P == '"')
+        {
+            out->ValueType = JsonValue::Type_String;
+            return ParseString(&out->String);
+        }
+        if (*P == 't' || *P == 'f')
+        {
+            out->ValueType = JsonValue::Type_Bool;
+            out->Number = (*P == 't') ? 1.0 : 0.0;
+            return ParseLiteral(*P == 't' ? "true" : "false");
+        }
+        if (*P == 'n')
+            return ParseLiteral("null");
+        out->ValueType = JsonValue::Type_Number;
+        return ParseNumber(&out->Number);
+    }
+};
+
+//-----------------------------------------------------------------------------
+// Threads recording zones
+//-----------------------------------------------------------------------------
+
+static void RecordNestedZones(const char* thread_name, int iterations)
+{
+    ImGui::ProfilerSetThreadName(thread_name);
+    for (int n = 0; n < iterations; n++)
+    {
+        IMGUI_PROFILE_ZONE("Outer");
+        {
+            IMGUI_PROFILE_ZONE("Middle");
+            { IMGUI_PROFILE_ZONE("Inner"); }
+            { IMGUI_PROFILE_ZONE("Inner"); }
+        }
+    }
+}
+
+static void RecordFlatZones(int count)
+{
+    for (int n = 0; n < count; n++)
+    {
+        IMGUI_PROFILE_ZONE("Flat");
+    }
+}
+
+static void RunFrame()
+{
+    ImTestNewFrame();
+    ImTestEndFrame();
+}
+
+// Zones of one thread in the order they were recorded, i.e. when they ended: the parent of a zone is the next one with a smaller depth
+static void CheckThreadZones(const ImProfilerZone* zones, int zones_count, int thread_index, int iterations)
+{
+    int outer = 0, middle = 0, inner = 0, depth_errors = 0, nesting_errors = 0;
+    const ImProfilerZone* prev_root = NULL;
+    for (int n = 0; n < zones_count; n++)
+    {
+        const ImProfilerZone& zone = zones[n];
+        if (zone.ThreadIndex != thread_index)
+            continue;
+        const int expected_depth = strcmp(zone.Name, "Outer") == 0 ? 0 : strcmp(zone.Name, "Middle") == 0 ? 1 : strcmp(zone.Name, "Inner") == 0 ? 2 : -1;
+        outer += expected_depth == 0;
+        middle += expected_depth == 1;
+        inner += expected_depth == 2;
+        if (zone.Depth != expected_depth || zone.Start > zone.End)
+            depth_errors++;
+        if (zone.Depth == 0)
+        {
+            if (prev_root != NULL && prev_root->End > zone.Start)
+                nesting_errors++;
+            prev_root = &zone;
+            continue;
+        }
+        int parent_n = n + 1;
+        while (parent_n < zones_count && (zones[parent_n].ThreadIndex != thread_index || zones[parent_n].Depth >= zone.Depth))
+            parent_n++;
+        if (parent_n == zones_count || zones[parent_n].Depth != zone.Depth - 1 || zones[parent_n].Start > zone.Start || zone.End > zones[parent_n].End)
+            nesting_errors++;
+    }
+    IM_CHECK_EQ(outer, iterations);
+    IM_CHECK_EQ(middle, iterations);
+    IM_CHECK_EQ(inner, iterations * 2);
+    IM_CHECK_EQ(depth_errors, 0);
+    IM_CHECK_EQ(nesting_errors, 0);
+}
+
+// First thread from 'first_thread_index' which recorded 'count' zones named 'name'
+static int FindThreadOfZones(const ImProfilerZone* zones, int zones_count, const char* name, int count, int first_thread_index = 0)
+{
+    for (int thread_index = first_thread_index; thread_index < 16; thread_index++)
+    {
+        int n_found = 0;
+        for (int n = 0; n < zones_count; n++)
+            if (zones[n].ThreadIndex == thread_index && strcmp(zones[n].Name, name) == 0)
+                n_found++;
+        if (n_found == count)
+            return thread_index;
+    }
+    return -1;
+}
+
+static void CheckChromeTrace(const char* filename, const char* thread_a_name, int thread_a, const char* thread_b_name, int thread_b)
+{
+    size_t size = 0;
+    char* text = (char*)ImFileLoadToMemory(filename, "rb", &size);
+    IM_CHECK(text != NULL);
+    if (text == NULL)
+        return;
+    JsonValue root;
+    JsonParser parser;
+    const bool parsed = parser.Parse(text, size, &root);
+    if (!parsed)
+        fprintf(stderr, "test_profiler: %s: JSON error at offset %d\n", filename, (int)(parser.P - text));
+    IM_CHECK(parsed);
+    IM_FREE(text);
+
+    const ImProfilerZone* zones;
+    const ImProfilerFrame* frames;
+    int zones_count, frames_count;
+    ImGui::ProfilerGetCapture(&zones, &zones_count, &frames, &frames_count, NULL);
+    const JsonValue* events = root.Find("traceEvents");
+    IM_CHECK(events != NULL && events->ValueType == JsonValue::Type_Array);
+    if (!parsed || events == NULL)
+        return;
+
+    // One complete event per frame and zone, named thread metadata, and the escaped zone name read back as it was recorded
+    int complete_events = 0, escaped_names = 0, named_threads = 0, type_errors = 0;
+    for (size_t n = 0; n < events->Values.size(); n++)
+    {
+        const JsonValue& event = events->Values[n];
+        const JsonValue* name = event.Find("name");
+        const JsonValue* ph = event.Find("ph");
+        const JsonValue* tid = event.Find("tid");
+        if (name == NULL || ph == NULL || tid == NULL || name->ValueType != JsonValue::Type_String || tid->ValueType != JsonValue::Type_Number)
+        {
+            type_errors++;
+            continue;
+        }
+        if (ph->String == "X")
+        {
+            const JsonValue* ts = event.Find("ts");
+            const JsonValue* dur = event.Find("dur");
+            if (ts == NULL || dur == NULL || ts->ValueType != JsonValue::Type_Number || dur->ValueType != JsonValue::Type_Number || dur->Number < 0.0)
+                type_errors++;
+            complete_events++;
+            escaped_names += name->String == g_EscapedName;
+        }
+        else if (ph->String == "M")
+        {
+            const JsonValue* args = event.Find("args");
+            const JsonValue* thread_name = args ? args->Find("name") : NULL;
+            if (thread_name == NULL)
+                type_errors++;
+            else if ((int)tid->Number == thread_a)
+                named_threads += thread_name->String == thread_a_name;
+            else if ((int)tid->Number == thread_b)
+                named_threads += thread_name->String == thread_b_name;
+        }
+    }
+    IM_CHECK_EQ(type_errors, 0);
+    IM_CHECK_EQ(complete_events, frames_count + zones_count);
+    IM_CHECK_EQ(escaped_names, 1);
+    IM_CHECK_EQ(named_threads, 2);
+}
+
+int main(int argc, char** argv)
+{
+    ImTestParseArgs(argc, argv);
+    ImGuiContext* ctx = ImTestCreateContext();
+    RunFrame();
+
+    // Two threads recording nested zones at the same time
+    const char* thread_a_name = "Worker A";
+    const char* thread_b_name = "Worker \"B\"";
+    ImGui::ProfilerStartCapture();
+    IM_CHECK(ImGui::IsProfilerCapturing());
+    RunFrame();
+    {
+        std::thread thread_a(RecordNestedZones, thread_a_name, 2000);
+        std::thread thread_b(RecordNestedZones, thread_b_name, 3000);
+        { IMGUI_PROFILE_ZONE(g_EscapedName); }
+        thread_a.join();
+        thread_b.join();
+    }
+    RunFrame();
+    ImGui::ProfilerStopCapture();
+    IM_CHECK(!ImGui::IsProfilerCapturing());
+
+    const ImProfilerZone* zones;
+    const ImProfilerFrame* frames;
+    int zones_count, frames_count, dropped_zones;
+    ImGui::ProfilerGetCapture(&zones, &zones_count, &frames, &frames_count, &dropped_zones);
+    IM_CHECK_EQ(dropped_zones, 0);
+    IM_CHECK(frames_count >= 1);
+    const int thread_a = FindThreadOfZones(zones, zones_count, "Outer", 2000);
+    const int thread_b = FindThreadOfZones(zones, zones_count, "Outer", 3000);
+    IM_CHECK(thread_a >= 0 && thread_b >= 0 && thread_a != thread_b);
+    CheckThreadZones(zones, zones_count, thread_a, 2000);
+    CheckThreadZones(zones, zones_count, thread_b, 3000);
+
+    char filename[256];
+    ImTestOutputPath(filename, IM_ARRAYSIZE(filename), "test_profiler_trace.json");
+    IM_CHECK(ImGui::ProfilerExportChromeTrace(filename));
+    CheckChromeTrace(filename, thread_a_name, thread_a, thread_b_name, thread_b);
+
+    // More zones than a ring holds between two frames: the extra ones are dropped and counted
+    ImGui::ProfilerStartCapture();
+    RunFrame();
+    {
+        std::thread thread_c(RecordFlatZones, g_RingSize + 123);
+        thread_c.join();
+    }
+    RunFrame();
+    ImGui::ProfilerGetCapture(&zones, &zones_count, &frames, &frames_count, &dropped_zones);
+    IM_CHECK_EQ(dropped_zones, 123);
+    const int thread_c = FindThreadOfZones(zones, zones_count, "Flat", g_RingSize);
+    IM_CHECK(thread_c >= 0);
+
+    // After the frame collected them, a whole ring fits again
+    {
+        std::thread thread_d(RecordFlatZones, g_RingSize);
+        thread_d.join();
+    }
+    RunFrame();
+    ImGui::ProfilerGetCapture(&zones, &zones_count, &frames, &frames_count, &dropped_zones);
+    IM_CHECK_EQ(dropped_zones, 123);
+    IM_CHECK(FindThreadOfZones(zones, zones_count, "Flat", g_RingSize, thread_c + 1) >= 0);
+
+    ImGui::ProfilerShutdown();
+    ImTestDestroyContext(ctx);
+    return ImTestReport("test_profiler");
+}
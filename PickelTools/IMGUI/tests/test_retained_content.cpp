@@ -0,0 +1,90 @@
+// BeginRetainedContent()/EndRetainedContent(): replayed frames output the same vertices as submitted ones, and unused regions are released.
+
+#include "imgui_test.h"
+#include "imgui_internal.h"
+#include <string.h>
+
+static int g_Submissions = 0;
+
+static void SubmitWindow(bool show_region)
+{
+    ImGui::SetNextWindowPos(ImVec2(10, 10), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(400, 400), ImGuiCond_Always);
+    ImGui::Begin("Retained");
+    ImGui::Text("Before");
+    if (show_region)
+    {
+        if (ImGui::BeginRetainedContent("region", 0x1234))
+        {
+            g_Submissions++;
+            for (int i = 0; i < 20; i++)
+                ImGui::Text("Row %d", i);
+        }
+        ImGui::EndRetainedContent();
+    }
+    ImGui::Text("After");
+    ImGui::End();
+}
+
+static void CopyWindowVertices(ImVector<ImDrawVert>* out_vtx)
+{
+    ImGuiWindow* window = ImGui::FindWindowByName("Retained");
+    out_vtx->resize(0);
+    if (window)
+        for (int n = 0; n < window->DrawList->VtxBuffer.Size; n++)
+            out_vtx->push_back(window->DrawList->VtxBuffer[n]);
+}
+
+int main()
+{
+    ImGuiContext* ctx = ImTestCreateContext();
+    ImGui_ImplNull_SetMousePos(900.0f, 700.0f);     // Not hovering the window, which would disable reuse
+
+    // First frame records, next ones replay
+    ImVector<ImDrawVert> recorded_vtx, replayed_vtx;
+    for (int frame = 0; frame < 3; frame++)
+    {
+        ImTestNewFrame();
+        SubmitWindow(true);
+        if (frame == 1)
+            CopyWindowVertices(&recorded_vtx);
+        if (frame == 2)
+            CopyWindowVertices(&replayed_vtx);
+        ImTestEndFrame();
+    }
+    IM_CHECK_EQ(g_Submissions, 2);  // Frame 0 appears (SkipItems on the first frame of a new window), frame 1 records, frame 2 replays
+    IM_CHECK_EQ(recorded_vtx.Size, replayed_vtx.Size);
+    IM_CHECK(recorded_vtx.Size > 0 && memcmp(recorded_vtx.Data, replayed_vtx.Data, (size_t)recorded_vtx.size_in_bytes()) == 0);
+
+    ImGuiRetainedContentStorage* storage = ImGui::FindRetainedContentStorage(ctx);
+    IM_CHECK(storage != NULL && storage->ContentsCount == 1);
+
+    // Stop submitting the region: it is released after IMGUI_RETAINED_CONTENT_GC_FRAMES frames. The GC runs from BeginRetainedContent(),
+    // so keep another region alive.
+    for (int frame = 0; frame < IMGUI_RETAINED_CONTENT_GC_FRAMES + 2; frame++)
+    {
+        ImTestNewFrame();
+        SubmitWindow(false);
+        ImGui::Begin("Other");
+        if (ImGui::BeginRetainedContent("other", 1))
+            ImGui::Text("Other");
+        ImGui::EndRetainedContent();
+        ImGui::End();
+        if (storage)
+            IM_CHECK_EQ(storage->ContentsCount, (frame < IMGUI_RETAINED_CONTENT_GC_FRAMES) ? 2 : 1);
+        ImTestEndFrame();
+    }
+
+    // Showing it again records it again
+    const int submissions_before = g_Submissions;
+    ImTestNewFrame();
+    SubmitWindow(true);
+    ImTestEndFrame();
+    IM_CHECK_EQ(g_Submissions, submissions_before + 1);
+
+    // Destroying the context releases its storage
+    ImTestDestroyContext(ctx);
+    IM_CHECK(ImGui::FindRetainedContentStorage(ctx) == NULL);
+
+    return ImTestReport("test_retained_content");
+}
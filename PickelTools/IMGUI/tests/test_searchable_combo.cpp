@@ -0,0 +1,228 @@
+// ImGuiSearchableComboIndex over 50k items: the matches of every query typed and erased character by character are those of a brute-force
+// lowercase strstr(), with one cached level per query prefix; Invalidate() picks up items modified in place; and when the popup appears,
+// the selected item is found among the matches and scrolled into view.
+
+#include "imgui_test.h"
+#include "imgui_internal.h"
+#include "imgui_searchablecombo.h"
+#include <string.h>
+
+static const int    g_ItemsCount = 50000;
+
+static unsigned int g_Seed = 4321;
+static unsigned int Rand()  { g_Seed = g_Seed * 1103515245u + 12345u; return (g_Seed >> 8) & 0xFFFF; }
+
+static void MakeItems(std::vector<std::string>* items)
+{
+    const char* kinds[] = { "Stadium", "ARENA", "Park", "field", "DomE", "Beach (Night)", "Forest", "Utopia Coliseum" };
+    items->resize(g_ItemsCount);
+    for (int i = 0; i < g_ItemsCount; i++)
+    {
+        char name[64];
+        ImFormatString(name, IM_ARRAYSIZE(name), "Map %d %s", i, kinds[(i * 7 + i / 3) % IM_ARRAYSIZE(kinds)]);
+        (*items)[i] = name;
+    }
+}
+
+static bool ItemsGetter(void* data, int idx, const char** out_text)
+{
+    *out_text = ((const std::vector<std::string>*)data)->at(idx).c_str();
+    return true;
+}
+
+static std::string ToLower(const std::string& s)
+{
+    std::string lower = s;
+    for (size_t n = 0; n < lower.size(); n++)
+        if (lower[n] >= 'A' && lower[n] <= 'Z')
+            lower[n] = (char)(lower[n] - 'A' + 'a');
+    return lower;
+}
+
+static void BruteForceMatches(const std::vector<std::string>& items, const char* query, ImVector<int>* out_matches)
+{
+    const std::string query_lower = ToLower(query);
+    out_matches->resize(0);
+    for (int i = 0; i < (int)items.size(); i++)
+        if (strstr(ToLower(items[i]).c_str(), query_lower.c_str()) != NULL)
+            out_matches->push_back(i);
+}
+
+static bool SameMatches(const ImGuiSearchableComboIndex& index, const ImVector<int>& expected)
+{
+    if (index.GetMatchesCount() != expected.Size)
+        return false;
+    for (int n = 0; n < expected.Size; n++)
+        if (index.GetMatch(n) != expected[n])
+            return false;
+    return true;
+}
+
+// Type and erase random characters, checking the matches and the cached levels after every keystroke
+static void CheckTyping(const std::vector<std::string>& items)
+{
+    ImGuiSearchableComboIndex index;
+    index.Build(ItemsGetter, (void*)&items, (int)items.size());
+    const char alphabet[] = "mapMAP 0123456789rkdtsu(";
+    char query[16] = "";
+    int query_len = 0;
+    int errors = 0, level_errors = 0, max_query_len = 0;
+    ImVector<int> expected;
+    for (int step = 0; step < 400; step++)
+    {
+        const bool erase = query_len == IM_ARRAYSIZE(query) - 1 || (query_len > 0 && Rand() % 3 == 0);
+        if (erase)
+            query[--query_len] = 0;
+        else
+        {
+            query[query_len++] = alphabet[Rand() % (IM_ARRAYSIZE(alphabet) - 1)];
+            query[query_len] = 0;
+        }
+        if (step % 50 == 0)     // Also start over with a common prefix
+        {
+            strcpy(query, step % 100 ? "Map 1" : "");
+            query_len = (int)strlen(query);
+        }
+        max_query_len = ImMax(max_query_len, query_len);
+        index.Filter(query);
+        BruteForceMatches(items, query, &expected);
+        if (!SameMatches(index, expected))
+            errors++;
+        if (index.Levels.Size > query_len || (query_len > 0 && index.Levels.Size == 0))
+            level_errors++;
+        for (int n = 1; n < index.Levels.Size; n++)
+            if (index.Levels[n].QueryLen <= index.Levels[n - 1].QueryLen || index.Levels[n].MatchesStart < index.Levels[n - 1].MatchesStart)
+                level_errors++;
+    }
+    IM_CHECK_EQ(errors, 0);
+    IM_CHECK_EQ(level_errors, 0);
+    IM_CHECK(max_query_len >= 4);
+
+    // Typing one character at a time keeps one level per prefix
+    index.Filter("");
+    const char* typed = "map 12";
+    for (int len = 1; len <= (int)strlen(typed); len++)
+    {
+        char prefix[16];
+        ImStrncpy(prefix, typed, (size_t)len + 1);
+        index.Filter(prefix);
+    }
+    IM_CHECK_EQ(index.Levels.Size, (int)strlen(typed));
+    index.Filter("map 1");  // Erasing goes back to the cached level
+    IM_CHECK_EQ(index.Levels.Size, 5);
+    BruteForceMatches(items, "map 1", &expected);
+    IM_CHECK(SameMatches(index, expected));
+}
+
+struct ComboState
+{
+    std::vector<std::string>    Items;
+    ImGuiSearchableComboIndex   Index;
+    int                         Current;
+    ImVec2                      ComboPos;
+};
+
+static void RunFrame(ComboState* state)
+{
+    ImTestNewFrame();
+    ImGui::SetNextWindowPos(ImVec2(10, 10), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(600, 700), ImGuiCond_Always);
+    ImGui::Begin("Combo");
+    ImGui::SetNextItemWidth(400.0f);
+    state->ComboPos = ImVec2(ImGui::GetCursorScreenPos().x + 100.0f, ImGui::GetCursorScreenPos().y + ImGui::GetFrameHeight() * 0.5f);
+    ImGui::SearchableCombo("Map", &state->Current, &state->Index, state->Items, "Select a map", "Search...", 20);
+    ImGui::End();
+    ImTestEndFrame();
+}
+
+static bool IsPopupVisible()
+{
+    ImGuiWindow* popup = ImGui::FindWindowByName("##Combo_00");
+    return popup != NULL && popup->Active;
+}
+
+static void OpenPopup(ComboState* state)
+{
+    ImGui_ImplNull_SetMousePos(state->ComboPos.x, state->ComboPos.y);
+    ImGui_ImplNull_SetMouseButton(0, true);
+    RunFrame(state);
+    ImGui_ImplNull_SetMouseButton(0, false);
+    RunFrame(state);
+    IM_CHECK(IsPopupVisible());
+}
+
+// Click in the void, below the window. The first click only deactivates the input text when it's being typed in.
+static void ClosePopup(ComboState* state)
+{
+    ImGui_ImplNull_SetMousePos(1200.0f, 715.0f);
+    for (int n = 0; n < 2 && IsPopupVisible(); n++)
+    {
+        ImGui_ImplNull_SetMouseButton(0, true);
+        RunFrame(state);
+        ImGui_ImplNull_SetMouseButton(0, false);
+        RunFrame(state);
+    }
+    IM_CHECK(!IsPopupVisible());
+}
+
+int main()
+{
+    std::vector<std::string> items;
+    MakeItems(&items);
+    CheckTyping(items);
+
+    ImGuiContext* ctx = ImTestCreateContext();
+    ComboState* state = IM_NEW(ComboState)();
+    MakeItems(&state->Items);
+    state->Current = -1;
+    RunFrame(state);
+
+    // Typed characters go to the query, and the matches follow it
+    OpenPopup(state);
+    ImGui_ImplNull_AddInputCharacters("MAP 4");
+    RunFrame(state);
+    RunFrame(state);
+    IM_CHECK(strcmp(state->Index.Query, "MAP 4") == 0);
+    ImVector<int> expected;
+    BruteForceMatches(state->Items, "map 4", &expected);
+    IM_CHECK(SameMatches(state->Index, expected));
+    ClosePopup(state);
+
+    // Items modified in place (same pointer and count): the lowercase copy is stale until Invalidate()
+    state->Items[4] = "Map 4 Renamed";
+    state->Items[41] = "Map 41 renamed (Moved)";
+    strcpy(state->Index.Query, "renamed");
+    OpenPopup(state);
+    IM_CHECK_EQ(state->Index.GetMatchesCount(), 0);
+    ClosePopup(state);
+    state->Index.Invalidate();
+    OpenPopup(state);
+    BruteForceMatches(state->Items, "renamed", &expected);
+    IM_CHECK_EQ(expected.Size, 2);
+    IM_CHECK(SameMatches(state->Index, expected));
+    ClosePopup(state);
+
+    // Appearing with a selected item far down the matches: it's found by binary search and scrolled into view
+    strcpy(state->Index.Query, "map 4");
+    state->Current = 44444;
+    OpenPopup(state);
+    RunFrame(state);
+    BruteForceMatches(state->Items, "map 4", &expected);
+    int expected_pos = 0;
+    while (expected_pos < expected.Size && expected[expected_pos] != state->Current)
+        expected_pos++;
+    IM_CHECK(expected_pos > 1000 && expected_pos < expected.Size);
+    ImGuiWindow* popup = ImGui::FindWindowByName("##Combo_00");
+    IM_CHECK(popup != NULL && popup->Active);
+    if (popup != NULL)
+    {
+        const float item_height = ImGui::GetTextLineHeightWithSpacing();
+        const float item_top = popup->WindowPadding.y + expected_pos * item_height - popup->Scroll.y;
+        IM_CHECK(item_top >= 0.0f && item_top + item_height <= popup->Size.y);
+    }
+    ClosePopup(state);
+
+    IM_DELETE(state);
+    ImTestDestroyContext(ctx);
+    return ImTestReport("test_searchable_combo");
+}
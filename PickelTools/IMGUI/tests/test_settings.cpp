@@ -0,0 +1,175 @@
+// .ini settings: text and binary round trips, records of unchanged windows copied from the previous save, identical saves skipped,
+// background writes, and window settings added to the context behind the back of the map (e.g. by the host's copy of Dear ImGui).
+
+#include "imgui_test.h"
+#include "imgui_internal.h"
+#include <stdio.h>
+#include <string.h>
+
+static char         g_IniFilename[512];
+static const int    g_WindowsCount = 200;
+
+static void SubmitWindows(int moved_window)
+{
+    for (int n = 0; n < g_WindowsCount; n++)
+    {
+        char name[32];
+        ImFormatString(name, IM_ARRAYSIZE(name), "Window %d", n);
+        ImGui::SetNextWindowPos(ImVec2((float)(n % 20) * 10.0f + (n == moved_window ? 7.0f : 0.0f), (float)(n / 20) * 10.0f), ImGuiCond_Always);
+        ImGui::SetNextWindowSize(ImVec2(100.0f + n, 50.0f), ImGuiCond_Always);
+        ImGui::Begin(name);
+        ImGui::End();
+    }
+}
+
+static void RunFrame(int moved_window)
+{
+    ImTestNewFrame();
+    SubmitWindows(moved_window);
+    ImTestEndFrame();
+}
+
+static bool CheckWindowSettings(int moved_window)
+{
+    int mismatches = 0;
+    for (int n = 0; n < g_WindowsCount; n++)
+    {
+        char name[32];
+        ImFormatString(name, IM_ARRAYSIZE(name), "Window %d", n);
+        const ImGuiWindowSettings* settings = ImGui::FindWindowSettings(ImHashStr(name));
+        if (settings == NULL || strcmp(((ImGuiWindowSettings*)settings)->GetName(), name) != 0 || settings->Collapsed ||
+            settings->Pos.x != (n % 20) * 10 + (n == moved_window ? 7 : 0) || settings->Pos.y != (n / 20) * 10 || settings->Size.x != 100 + n || settings->Size.y != 50)
+            mismatches++;
+    }
+    return mismatches == 0;
+}
+
+static bool LoadFile(const char* filename, ImVector<char>* out_data)
+{
+    size_t data_size = 0;
+    char* data = (char*)ImFileLoadToMemory(filename, "rb", &data_size);
+    if (data == NULL)
+        return false;
+    out_data->resize((int)data_size);
+    memcpy(out_data->Data, data, data_size);
+    IM_FREE(data);
+    return true;
+}
+
+static bool SameData(const ImVector<char>& data, const void* other, size_t other_size)
+{
+    return (size_t)data.Size == other_size && memcmp(data.Data, other, other_size) == 0;
+}
+
+int main(int argc, char** argv)
+{
+    ImTestParseArgs(argc, argv);
+    ImTestOutputPath(g_IniFilename, sizeof(g_IniFilename), "test_settings.ini");
+    remove(g_IniFilename);
+
+    // Text and binary saves of the same windows
+    ImGuiContext* ctx = ImTestCreateContext();
+    RunFrame(-1);
+    size_t text_size = 0;
+    ImVector<char> text;
+    const char* text_data = ImGui::SaveIniSettingsToMemory(&text_size);
+    text.resize((int)text_size);
+    memcpy(text.Data, text_data, text_size);
+    size_t binary_size = 0;
+    ImVector<char> binary;
+    const void* binary_data = ImGui::SaveIniSettingsToMemoryBinary(&binary_size);
+    binary.resize((int)binary_size);
+    memcpy(binary.Data, binary_data, binary_size);
+    IM_CHECK(binary_size < text_size);
+    IM_CHECK_EQ(ImGui::FindSettingsStorage(ctx)->WindowsIniRecords.Size, g_WindowsCount + 1); // + "Debug##Default"
+
+    // Moving one window: every other record is copied from the previous save, the output matches a save formatted from scratch
+    RunFrame(42);
+    size_t moved_size = 0;
+    ImVector<char> moved_text;
+    const char* moved_data = ImGui::SaveIniSettingsToMemory(&moved_size);
+    moved_text.resize((int)moved_size);
+    memcpy(moved_text.Data, moved_data, moved_size);
+    IM_CHECK(!SameData(moved_text, text.Data, (size_t)text.Size));
+    ImTestDestroyContext(ctx);
+    IM_CHECK(ImGui::FindSettingsStorage(ctx) == NULL);
+
+    ctx = ImTestCreateContext();
+    ImGui::LoadIniSettingsFromMemory(moved_text.Data, (size_t)moved_text.Size);
+    IM_CHECK(CheckWindowSettings(42));
+    size_t fresh_size = 0;
+    const char* fresh_data = ImGui::SaveIniSettingsToMemory(&fresh_size);
+    IM_CHECK(SameData(moved_text, fresh_data, fresh_size));
+    ImTestDestroyContext(ctx);
+
+    // Round trips
+    ctx = ImTestCreateContext();
+    ImGui::LoadIniSettingsFromMemory(text.Data, (size_t)text.Size);
+    IM_CHECK(CheckWindowSettings(-1));
+    ImTestDestroyContext(ctx);
+
+    ctx = ImTestCreateContext();
+    ImGui::LoadIniSettingsFromMemory(binary.Data, binary.Size);
+    IM_CHECK(CheckWindowSettings(-1));
+    size_t binary_text_size = 0;
+    const char* binary_text_data = ImGui::SaveIniSettingsToMemory(&binary_text_size);
+    IM_CHECK(SameData(text, binary_text_data, binary_text_size));
+    ImTestDestroyContext(ctx);
+
+    // Disk: identical saves don't touch the file
+    ctx = ImTestCreateContext();
+    RunFrame(-1);
+    ImGui::SaveIniSettingsToDisk(g_IniFilename);
+    ImVector<char> file;
+    IM_CHECK(LoadFile(g_IniFilename, &file) && SameData(file, text.Data, (size_t)text.Size));
+    remove(g_IniFilename);
+    ImGui::SaveIniSettingsToDisk(g_IniFilename);
+    IM_CHECK(!LoadFile(g_IniFilename, &file));
+
+    // Background write from NewFrame(), in the binary format. Shutdown waits for it.
+    ImGuiIniSavingOptions options;
+    options.Async = true;
+    options.Binary = true;
+    ImGui::SetIniSavingOptions(options);
+    IM_CHECK(ImGui::GetIniSavingOptions().Async && ImGui::GetIniSavingOptions().Binary);
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = g_IniFilename;
+    io.IniSavingRate = 0.001f;
+    RunFrame(42);
+    ImGui::MarkIniSettingsDirty();
+    RunFrame(42);
+    io.IniFilename = NULL;
+    IM_CHECK(ImGui::FindSettingsStorage(ctx)->Writer != NULL);
+    ImTestDestroyContext(ctx);
+    IM_CHECK(LoadFile(g_IniFilename, &file));
+    ctx = ImTestCreateContext();
+    ImGui::LoadIniSettingsFromMemory(file.Data, (size_t)file.Size);
+    IM_CHECK(CheckWindowSettings(42));
+    IM_CHECK(!ImGui::GetIniSavingOptions().Binary);   // Options belong to the context
+    ImTestDestroyContext(ctx);
+    remove(g_IniFilename);
+
+    // Settings appended, or cleared then refilled, without going through CreateNewWindowSettings()
+    ctx = ImTestCreateContext();
+    ImGuiContext& g = *ctx;
+    IM_CHECK(ImGui::CreateNewWindowSettings("First") != NULL);
+    ImGuiWindowSettings* appended = g.SettingsWindows.alloc_chunk(sizeof(ImGuiWindowSettings) + 7);
+    IM_PLACEMENT_NEW(appended) ImGuiWindowSettings();
+    appended->ID = ImHashStr("Second");
+    strcpy(appended->GetName(), "Second");
+    IM_CHECK(ImGui::FindWindowSettings(ImHashStr("Second")) == appended);
+    g.SettingsWindows.clear();
+    for (int n = 0; n < 3; n++)
+    {
+        ImGuiWindowSettings* settings = g.SettingsWindows.alloc_chunk(sizeof(ImGuiWindowSettings) + 7);
+        IM_PLACEMENT_NEW(settings) ImGuiWindowSettings();
+        settings->ID = ImHashStr(n == 2 ? "Second" : "Other");
+        strcpy(settings->GetName(), n == 2 ? "Second" : "Other");
+    }
+    const ImGuiWindowSettings* found = ImGui::FindWindowSettings(ImHashStr("Second"));
+    IM_CHECK(found != NULL && found->ID == ImHashStr("Second"));
+    IM_CHECK(ImGui::FindWindowSettings(ImHashStr("First")) == NULL);
+    ImTestDestroyContext(ctx);
+
+    return ImTestReport("test_settings");
+}
@@ -0,0 +1,143 @@
+// ImGuiTimeline: the segment trees of the lanes answer FindNextEvent()/GetMaxEnd() like a linear scan, a long event doesn't make the
+// following ones visible, and 100k events in view are merged into boxes whose count depends on the width of the lane in pixels.
+
+#include "imgui_test.h"
+#include "imgui_internal.h"
+#include "imgui_timeline.h"
+#include <chrono>
+#include <string.h>
+
+static unsigned int g_Seed = 12345;
+static unsigned int Rand()  { g_Seed = g_Seed * 1103515245u + 12345u; return (g_Seed >> 8) & 0xFFFF; }
+
+static int BruteFindNextEvent(const ImGuiTimeline& tl, int lane, int first, double time)
+{
+    const int events_end = tl.Lanes[lane].EventsStart + tl.Lanes[lane].EventsCount;
+    for (int n = ImMax(first, tl.Lanes[lane].EventsStart); n < events_end; n++)
+        if (tl.Events[n].End >= time)
+            return n;
+    return events_end;
+}
+
+static double BruteGetMaxEnd(const ImGuiTimeline& tl, int first, int last)
+{
+    double max_end = -DBL_MAX;
+    for (int n = first; n < last; n++)
+        max_end = ImMax(max_end, tl.Events[n].End);
+    return max_end;
+}
+
+static void CheckIndex()
+{
+    // Overlapping events of random lengths in lanes of various sizes (powers of 2 and not), including empty lanes
+    ImGuiTimeline tl;
+    for (int track_n = 0; track_n < 4; track_n++)
+    {
+        const int track = tl.AddTrack("Track");
+        const int counts[] = { 1, 7, 64, 1000 };
+        for (int n = 0; n < counts[track_n]; n++)
+        {
+            const double start = Rand() % 5000;
+            const double length = (Rand() % 16 == 0) ? Rand() % 3000 : Rand() % 20;
+            tl.AddEvent(track, start, start + length, NULL, (track_n == 3 && n % 3 == 0) ? 2 : 0);
+        }
+    }
+    tl.Build();
+    int errors = 0;
+    for (int lane_n = 0; lane_n < tl.Lanes.Size; lane_n++)
+    {
+        const ImGuiTimelineLane& lane = tl.Lanes[lane_n];
+        for (int q = 0; q < 300; q++)
+        {
+            const int first = lane.EventsStart + (lane.EventsCount > 0 ? (int)(Rand() % (lane.EventsCount + 1)) : 0);
+            const double time = Rand() % 8000;
+            if (tl.FindNextEvent(lane_n, first, time) != BruteFindNextEvent(tl, lane_n, first, time))
+                errors++;
+            if (first < lane.EventsStart + lane.EventsCount)
+            {
+                const int last = first + 1 + (int)(Rand() % (lane.EventsStart + lane.EventsCount - first));
+                if (tl.GetMaxEnd(lane_n, first, last) != BruteGetMaxEnd(tl, first, last))
+                    errors++;
+            }
+        }
+    }
+    IM_CHECK_EQ(errors, 0);
+    IM_CHECK_EQ(tl.Lanes.Size, 6);  // Track 3 has an empty lane at depth 1
+}
+
+static void SubmitTimeline(ImGuiTimeline* tl)
+{
+    ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(1000, 300), ImGuiCond_Always);
+    ImGui::Begin("Window");
+    ImGui::Timeline("##timeline", tl, ImVec2(0, 0));
+    ImGui::End();
+}
+
+static ImDrawList* GetTimelineDrawList()
+{
+    for (int n = 0; n < GImGui->Windows.Size; n++)
+        if (strncmp(GImGui->Windows[n]->Name, "Window/##timeline", 17) == 0)
+            return GImGui->Windows[n]->DrawList;
+    return NULL;
+}
+
+int main()
+{
+    CheckIndex();
+
+    // A long event followed by 100k short ones in the same lane
+    ImGuiContext* ctx = ImTestCreateContext();
+    ImGuiTimeline tl;
+    const int track = tl.AddTrack("Session");
+    tl.AddEvent(track, 0.0, 1000000.0, "Session", 0, 0, -1);
+    for (int n = 0; n < 100000; n++)
+        tl.AddEvent(track, 1.0 + n * 10.0, 1.0 + n * 10.0 + 4.0, "Event", 0, 0, n);
+
+    // Zoomed out: everything is in view, boxes are merged
+    ImGui_ImplNull_SetMousePos(-100.0f, -100.0f);
+    ImTestNewFrame();
+    SubmitTimeline(&tl);
+    ImTestEndFrame();
+    ImDrawList* draw_list = GetTimelineDrawList();
+    IM_CHECK(draw_list != NULL);
+    if (draw_list)
+        IM_CHECK(draw_list->VtxBuffer.Size < 20000);
+
+    // Zoomed in the middle: the event under the mouse is found, and only the events in view are drawn
+    tl.ViewMin = 500000.0;
+    tl.ViewMax = 500100.0;
+    const int expected_user_id = 50000;     // Starts at 500001.0
+    float mouse_x = 0.0f;
+    for (int frame = 0; frame < 3; frame++)
+    {
+        ImTestNewFrame();
+        SubmitTimeline(&tl);
+        ImTestEndFrame();
+        const ImRect inner = ImGui::FindWindowByName("Window")->InnerRect;
+        mouse_x = inner.Min.x + tl.TrackNameWidth + (float)((500002.0 - tl.ViewMin) / (tl.ViewMax - tl.ViewMin)) * (inner.GetWidth() - tl.TrackNameWidth - 2.0f);
+        ImGui_ImplNull_SetMousePos(mouse_x, inner.Min.y + ImGui::GetFrameHeight() * 1.5f);
+    }
+    IM_CHECK(tl.HoveredEvent >= 0 && tl.Events[tl.HoveredEvent].UserId == expected_user_id && tl.HoveredCount == 1);
+    draw_list = GetTimelineDrawList();
+    if (draw_list)
+        IM_CHECK(draw_list->VtxBuffer.Size < 2000);
+
+    // Cost of a zoomed in frame, for reference only
+    ImGui_ImplNull_SetMousePos(-100.0f, -100.0f);
+    const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    const int frames = 100;
+    for (int frame = 0; frame < frames; frame++)
+    {
+        tl.ViewMin = frame * 9000.0;
+        tl.ViewMax = tl.ViewMin + 200.0;
+        ImTestNewFrame();
+        SubmitTimeline(&tl);
+        ImTestEndFrame();
+    }
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    printf("test_timeline: 100k events behind a long one, %.4f ms per zoomed in frame\n", ms / frames);
+
+    ImTestDestroyContext(ctx);
+    return ImTestReport("test_timeline");
+}
@@ -0,0 +1,530 @@
+// TreeView node storage: deleted nodes are recycled through the free list, the cached depth and index of every node match the tree
+// after random Swap(), moveNodeTo(), deletions and insertions, and clear() releases the node blocks.
+// Visible rows: splicing the rows of the nodes opened or closed in a frame gives the same rows as a full rebuild.
+// Binary files: save, load and save again gives the same bytes, and truncated or corrupted files are rejected without touching the tree.
+// Sorting by display name gives the order of a stable strcmp() sort, on the calling thread and in parallel (ImParallelFor()).
+
+#include "imgui_test.h"
+#include "imgui_internal.h"
+#include "imguivariouscontrols.h"
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+using ImGui::TreeView;
+using ImGui::TreeViewNode;
+
+static unsigned int g_Seed = 12345;
+static unsigned int Rand()  { g_Seed = g_Seed * 1103515245u + 12345u; return (g_Seed >> 8) & 0xFFFF; }
+
+// Exposes the protected storage of TreeView
+struct TestTreeView : public TreeView
+{
+    int             GetNumNodeBlocks() const    { return nodePoolBlocks.size(); }
+    int             GetFreeListLength() const   { int n = 0; for (void* p = nodePoolFreeList; p; p = *(void**)p) n++; return n; }
+    void            FreeAllNodeMemory()         { freeAllNodeMemory(); }
+
+    // Toggle STATE_OPEN of some visible rows and splice them like render() does, from the last one
+    void ToggleRows(const ImVector<int>& sorted_rows)
+    {
+        for (int i = sorted_rows.Size - 1; i >= 0; i--)
+        {
+            visibleRows[sorted_rows[i]].node->toggleState(STATE_OPEN);
+            updateVisibleRowsOfToggledNode(sorted_rows[i]);
+        }
+    }
+    int GetNumVisibleRows() const               { return visibleRows.size(); }
+    bool VisibleRowsMatchRebuild()
+    {
+        ImVector<VisibleRow> spliced = visibleRows;
+        rebuildVisibleRows();
+        return spliced.size() == visibleRows.size() && (spliced.size() == 0 || memcmp(spliced.Data, visibleRows.Data, (size_t)spliced.size_in_bytes()) == 0);
+    }
+    void RebuildVisibleRows()                   { rebuildVisibleRows(); }
+};
+
+static TreeViewNode* AddNode(TreeView& tv, TreeViewNode* parent, int index, bool non_leaf)
+{
+    char name[32];
+    ImFormatString(name, IM_ARRAYSIZE(name), "Node %u", Rand());
+    return parent ? parent->addChildNode(TreeViewNode::Data(name), index, non_leaf) : tv.addRootNode(TreeViewNode::Data(name), index, non_leaf);
+}
+
+// Random tree: each node gets up to 'max_children' child nodes
+static void AddRandomChildNodes(TreeView& tv, TreeViewNode* parent, int depth, int max_depth, int max_children)
+{
+    const int count = (int)(Rand() % (max_children + 1));
+    for (int i = 0; i < count; i++)
+    {
+        TreeViewNode* n = AddNode(tv, parent, -1, depth < max_depth && Rand() % 2 == 0);
+        if (!n->isLeafNode())
+            AddRandomChildNodes(tv, n, depth + 1, max_depth, max_children);
+    }
+}
+
+// The cached values against the ones found by walking the tree
+static int CheckCachedDepthAndIndex(const TreeView& tv)
+{
+    int errors = 0;
+    ImVector<const TreeViewNode*> stack;
+    for (int i = 0; i < tv.getNumRootNodes(); i++)
+    {
+        const TreeViewNode* n = tv.getRootNode(i);
+        if (n->getNodeIndex() != i || n->getDepth() != 0 || n->getParentNode() != NULL)
+            errors++;
+        stack.push_back(n);
+    }
+    while (stack.Size > 0)
+    {
+        const TreeViewNode* p = stack.back();
+        stack.pop_back();
+        for (int i = 0; i < p->getNumChildNodes(); i++)
+        {
+            const TreeViewNode* n = p->getChildNode(i);
+            if (n->getNodeIndex() != i || n->getDepth() != p->getDepth() + 1 || n->getParentNode() != p || &n->getTreeView() != &tv)
+                errors++;
+            stack.push_back(n);
+        }
+    }
+    return errors;
+}
+
+static void TestFreeListReuse()
+{
+    TestTreeView tv;
+    TreeViewNode* root = tv.addRootNode(TreeViewNode::Data("Root"), -1, true);
+    ImVector<TreeViewNode*> nodes;
+    for (int i = 0; i < 1000; i++)
+        nodes.push_back(root->addChildNode(TreeViewNode::Data("Leaf")));
+    const int num_blocks = tv.GetNumNodeBlocks();
+    IM_CHECK_EQ(num_blocks, (1001 + 255) / 256);
+    IM_CHECK_EQ(tv.GetFreeListLength(), 0);
+
+    // The last deleted node is the first reused
+    TreeViewNode* deleted = nodes[500];
+    TreeView::DeleteNode(deleted);
+    IM_CHECK_EQ(tv.GetFreeListLength(), 1);
+    TreeViewNode* reused = root->addChildNode(TreeViewNode::Data("Reused"));
+    IM_CHECK(reused == deleted);
+    IM_CHECK_EQ(tv.GetFreeListLength(), 0);
+    IM_CHECK(strcmp(reused->getDisplayName(), "Reused") == 0);
+
+    // Deleting a branch frees all its nodes, which are all reused before any new block
+    ImVector<TreeViewNode*> all_nodes;
+    tv.getAllNodes(all_nodes);
+    const int num_nodes = all_nodes.Size;
+    for (int i = 0; i < 400; i++)
+        TreeView::DeleteNode(root->getChildNode((int)(Rand() % root->getNumChildNodes())));
+    IM_CHECK_EQ(tv.GetFreeListLength(), 400);
+    for (int i = 0; i < 400; i++)
+        root->addChildNode(TreeViewNode::Data("Again"), (int)(Rand() % (root->getNumChildNodes() + 1)));
+    IM_CHECK_EQ(tv.GetFreeListLength(), 0);
+    IM_CHECK_EQ(tv.GetNumNodeBlocks(), num_blocks);
+    tv.getAllNodes(all_nodes);
+    IM_CHECK_EQ(all_nodes.Size, num_nodes);
+    IM_CHECK_EQ(CheckCachedDepthAndIndex(tv), 0);
+}
+
+static void TestCachedDepthAndIndex()
+{
+    TestTreeView tv;
+    for (int i = 0; i < 8; i++)
+        AddRandomChildNodes(tv, AddNode(tv, NULL, -1, true), 1, 5, 4);
+    int errors = 0, swaps = 0, moves = 0, deletions = 0, insertions = 0;
+    ImVector<TreeViewNode*> nodes;
+    for (int step = 0; step < 3000; step++)
+    {
+        tv.getAllNodes(nodes);
+        if (nodes.Size < 2)
+        {
+            AddRandomChildNodes(tv, AddNode(tv, NULL, -1, true), 1, 5, 4);
+            continue;
+        }
+        TreeViewNode* n = nodes[(int)(Rand() % nodes.Size)];
+        switch (Rand() % 5)
+        {
+        case 0:
+        case 1:
+            {
+                // Also across branches and depths (refused when one node is an ancestor of the other)
+                TreeViewNode* n2 = nodes[(int)(Rand() % nodes.Size)];
+                TreeViewNode::Swap(n, n2);
+                swaps++;
+            }
+            break;
+        case 2:
+            n->moveNodeTo((int)(Rand() % (n->getNumSiblings() + 1)) - 1);   // -1 moves to the end
+            moves++;
+            break;
+        case 3:
+            if (nodes.Size > 50)
+            {
+                TreeView::DeleteNode(n);
+                deletions++;
+                break;
+            }
+            // Fall through
+        default:
+            AddNode(tv, n, (int)(Rand() % (n->getNumChildNodes() + 2)) - 1, Rand() % 2 == 0);
+            insertions++;
+            break;
+        }
+        errors += CheckCachedDepthAndIndex(tv);
+    }
+    IM_CHECK_EQ(errors, 0);
+    IM_CHECK(swaps > 0 && moves > 0 && deletions > 0 && insertions > 0);
+}
+
+static void TestClearThenFreeAllNodeMemory()
+{
+    TestTreeView tv;
+    for (int i = 0; i < 4; i++)
+        AddRandomChildNodes(tv, AddNode(tv, NULL, -1, true), 1, 4, 5);
+    IM_CHECK(tv.GetNumNodeBlocks() > 0);
+    tv.clear();
+    IM_CHECK_EQ(tv.getNumRootNodes(), 0);
+    IM_CHECK_EQ(tv.GetNumNodeBlocks(), 0);
+    IM_CHECK_EQ(tv.GetFreeListLength(), 0);
+    tv.FreeAllNodeMemory();     // Nothing left to free
+    IM_CHECK_EQ(tv.GetNumNodeBlocks(), 0);
+
+    // The TreeView is usable again
+    TreeViewNode* root = tv.addRootNode(TreeViewNode::Data("Root"), -1, true);
+    root->addChildNode(TreeViewNode::Data("Child"));
+    IM_CHECK_EQ(tv.GetNumNodeBlocks(), 1);
+    IM_CHECK_EQ(CheckCachedDepthAndIndex(tv), 0);
+}
+
+static void TestToggledRowsSplice()
+{
+    TestTreeView tv;
+    for (int i = 0; i < 20; i++)
+        AddRandomChildNodes(tv, AddNode(tv, NULL, -1, true), 1, 6, 6);
+    ImVector<TreeViewNode*> nodes;
+    tv.getAllNodes(nodes);
+    for (int i = 0; i < nodes.Size; i++)
+    {
+        if (Rand() % 2 == 0)
+            nodes[i]->addState(TreeViewNode::STATE_OPEN);
+        if (Rand() % 16 == 0)
+            nodes[i]->addState(TreeViewNode::STATE_HIDDEN);
+    }
+    tv.RebuildVisibleRows();
+
+    int mismatches = 0, max_rows = 0;
+    ImVector<int> rows;
+    for (int step = 0; step < 2000; step++)
+    {
+        // One to three distinct rows per frame, which may be nested
+        rows.resize(0);
+        for (int n = 1 + (int)(Rand() % 3); n > 0; n--)
+        {
+            const int row = (int)(Rand() % tv.GetNumVisibleRows());
+            if (!rows.contains(row))
+                rows.push_back(row);
+        }
+        for (int i = 1; i < rows.Size; i++)
+            for (int j = i; j > 0 && rows[j - 1] > rows[j]; j--)
+                ImSwap(rows[j - 1], rows[j]);
+        tv.ToggleRows(rows);
+        if (!tv.VisibleRowsMatchRebuild())
+            mismatches++;
+        max_rows = ImMax(max_rows, tv.GetNumVisibleRows());
+    }
+    IM_CHECK_EQ(mismatches, 0);
+    IM_CHECK(max_rows > 100);
+}
+
+// Same layout as TreeViewBinaryHeader and TreeViewBinaryNode in imguivariouscontrols.cpp
+struct BinaryHeader
+{
+    char            Magic[4];
+    int             Version;
+    int             NodesCount;
+    int             StringsSize;
+    ImVec4          StateColors[6];
+    int             SelectionMode, CheckboxMode, CollapseToLeafNodesAtNodeDepth;
+    unsigned char   AllowMultipleSelection, AllowAutoCheckboxBehaviour, InheritDisabledLook, Pad;
+};
+struct BinaryNode
+{
+    int             DepthDelta, NumChildNodes, State, UserId, DisplayNameOffset, TooltipOffset, UserTextOffset;
+};
+
+static bool SaveToMemory(const TreeView& tv, const char* filename, ImVector<char>* out_data)
+{
+    out_data->resize(0);
+    if (!tv.saveBinary(filename))
+        return false;
+    size_t size = 0;
+    char* data = (char*)ImFileLoadToMemory(filename, "rb", &size);
+    if (data == NULL)
+        return false;
+    out_data->resize((int)size);
+    memcpy(out_data->Data, data, size);
+    IM_FREE(data);
+    return true;
+}
+
+// A rejected file must leave the tree as it was
+static bool LoadRejected(TestTreeView& tv, const ImVector<char>& data, int num_nodes)
+{
+    ImVector<char> copy = data;     // Heap copy, so that reading past the end is caught by sanitizers
+    if (tv.loadBinary(copy.Data, (size_t)copy.Size))
+        return false;
+    ImVector<TreeViewNode*> nodes;
+    tv.getAllNodes(nodes);
+    return nodes.Size == num_nodes;
+}
+
+static BinaryNode* GetRecord(ImVector<char>& data, int n)
+{
+    const BinaryHeader* header = (const BinaryHeader*)data.Data;
+    return (BinaryNode*)(data.Data + sizeof(BinaryHeader) + header->StringsSize) + n;
+}
+
+static void TestBinaryRoundTrip()
+{
+    IM_CHECK_EQ((int)sizeof(BinaryHeader), 128);
+    char filename[512];
+    ImTestOutputPath(filename, IM_ARRAYSIZE(filename), "test_treeview.bin");
+
+    // Tooltips, user texts, ids and states, with shared strings, leaf nodes and empty non-leaf nodes
+    TestTreeView tv;
+    for (int i = 0; i < 20; i++)
+        AddRandomChildNodes(tv, AddNode(tv, NULL, -1, true), 1, 6, 6);
+    tv.addRootNode(TreeViewNode::Data("Empty folder"), -1, true);
+    tv.addRootNode(TreeViewNode::Data(""));
+    ImVector<TreeViewNode*> nodes;
+    tv.getAllNodes(nodes);
+    for (int i = 0; i < nodes.Size; i++)
+    {
+        if (Rand() % 3 == 0)
+            nodes[i]->setTooltip(Rand() % 2 ? "Shared tooltip" : nodes[i]->getDisplayName());
+        if (Rand() % 4 == 0)
+            nodes[i]->setUserText("User text");
+        nodes[i]->setUserId((int)Rand() - 0x8000);
+        nodes[i]->state = (int)(Rand() & (TreeViewNode::STATE_OPEN | TreeViewNode::STATE_CHECKED | TreeViewNode::STATE_USER3));
+    }
+    tv.setCollapseNodesToLeafNodesAtDepth(3);
+    const int num_nodes = nodes.Size;
+    IM_CHECK(num_nodes > 200);
+
+    ImVector<char> saved, saved_again;
+    IM_CHECK(SaveToMemory(tv, filename, &saved));
+    TestTreeView loaded;
+    loaded.addRootNode(TreeViewNode::Data("Replaced"));
+    IM_CHECK(loaded.loadBinary(saved.Data, (size_t)saved.Size));
+    IM_CHECK_EQ(CheckCachedDepthAndIndex(loaded), 0);
+    IM_CHECK_EQ(loaded.getCollapseNodesToLeafNodesAtDepth(), 3);
+    IM_CHECK(SaveToMemory(loaded, filename, &saved_again));
+    IM_CHECK(saved.Size == saved_again.Size && memcmp(saved.Data, saved_again.Data, (size_t)saved.Size) == 0);
+    IM_CHECK(loaded.loadBinary(filename));      // Memory-mapped
+    loaded.getAllNodes(nodes);
+    IM_CHECK_EQ(nodes.Size, num_nodes);
+
+    // An empty tree
+    TestTreeView empty;
+    IM_CHECK(SaveToMemory(empty, filename, &saved_again));
+    IM_CHECK(loaded.loadBinary(saved_again.Data, (size_t)saved_again.Size));
+    IM_CHECK_EQ(loaded.getNumRootNodes(), 0);
+
+    // A single node with a depth delta of INT_MIN: nothing follows it to catch a wrapped depth
+    TestTreeView single;
+    single.addRootNode(TreeViewNode::Data("Single"));
+    IM_CHECK(SaveToMemory(single, filename, &saved_again));
+    GetRecord(saved_again, 0)->DepthDelta = -0x7FFFFFFF - 1;
+    IM_CHECK(LoadRejected(loaded, saved_again, 0));
+
+    // Truncated files
+    IM_CHECK(loaded.loadBinary(saved.Data, (size_t)saved.Size));
+    int accepted = 0;
+    for (int size = 0; size < saved.Size; size += (size < 256) ? 1 : 1 + (int)(Rand() % 64))
+    {
+        ImVector<char> truncated;
+        truncated.resize(size);
+        if (size > 0)
+            memcpy(truncated.Data, saved.Data, (size_t)size);
+        if (!LoadRejected(loaded, truncated, num_nodes))
+            accepted++;
+    }
+    IM_CHECK_EQ(accepted, 0);
+
+    // Corrupted headers and records
+    const BinaryHeader& header = *(const BinaryHeader*)saved.Data;
+    const int last = header.NodesCount - 1;
+    ImVector<char> bad;
+    bad = saved; ((BinaryHeader*)bad.Data)->Magic[0] = 'X';                 IM_CHECK(LoadRejected(loaded, bad, num_nodes));
+    bad = saved; ((BinaryHeader*)bad.Data)->Version++;                      IM_CHECK(LoadRejected(loaded, bad, num_nodes));
+    bad = saved; ((BinaryHeader*)bad.Data)->NodesCount = -1;                IM_CHECK(LoadRejected(loaded, bad, num_nodes));
+    bad = saved; ((BinaryHeader*)bad.Data)->NodesCount--;                   IM_CHECK(LoadRejected(loaded, bad, num_nodes));
+    bad = saved; bad.Data[sizeof(BinaryHeader) + header.StringsSize - 1] = 'x';     IM_CHECK(LoadRejected(loaded, bad, num_nodes));     // Unterminated string table
+    bad = saved; GetRecord(bad, 0)->DepthDelta = 0;                         IM_CHECK(LoadRejected(loaded, bad, num_nodes));     // Depth -1
+    bad = saved; GetRecord(bad, 1)->DepthDelta = 2;                         IM_CHECK(LoadRejected(loaded, bad, num_nodes));
+    bad = saved; GetRecord(bad, 0)->DepthDelta = -0x7FFFFFFF - 1;           IM_CHECK(LoadRejected(loaded, bad, num_nodes));     // INT_MIN, which overflowed depth+DepthDelta
+    bad = saved; GetRecord(bad, last)->DepthDelta = -0x7FFFFFFF - 1;        IM_CHECK(LoadRejected(loaded, bad, num_nodes));
+    bad = saved; GetRecord(bad, last)->DepthDelta = -GetRecord(bad, last)->DepthDelta - 64; IM_CHECK(LoadRejected(loaded, bad, num_nodes));
+    bad = saved; GetRecord(bad, 0)->NumChildNodes = header.NodesCount;      IM_CHECK(LoadRejected(loaded, bad, num_nodes));     // More children than the records that follow
+    bad = saved; GetRecord(bad, last)->NumChildNodes = 1;                   IM_CHECK(LoadRejected(loaded, bad, num_nodes));
+    bad = saved; GetRecord(bad, 3)->NumChildNodes = -2;                     IM_CHECK(LoadRejected(loaded, bad, num_nodes));
+    bad = saved; GetRecord(bad, 2)->DisplayNameOffset = -1;                 IM_CHECK(LoadRejected(loaded, bad, num_nodes));
+    bad = saved; GetRecord(bad, 2)->TooltipOffset = header.StringsSize;     IM_CHECK(LoadRejected(loaded, bad, num_nodes));
+    bad = saved; GetRecord(bad, 2)->UserTextOffset = 0x7FFFFFFF;            IM_CHECK(LoadRejected(loaded, bad, num_nodes));
+
+    // A child node under a leaf node
+    int leaf = -1;
+    for (int n = 0; n < last && leaf < 0; n++)
+        if (GetRecord(saved, n)->NumChildNodes < 0 && GetRecord(saved, n + 1)->DepthDelta <= 0)
+            leaf = n;
+    IM_CHECK(leaf >= 0);
+    if (leaf >= 0)
+    {
+        bad = saved;
+        GetRecord(bad, leaf + 1)->DepthDelta = 1;
+        IM_CHECK(LoadRejected(loaded, bad, num_nodes));
+    }
+
+    // A string table whose size isn't a multiple of 4, with a consistent file size: the records would be misaligned
+    const int records_offset = (int)sizeof(BinaryHeader) + header.StringsSize;
+    bad.resize(saved.Size + 1);
+    memcpy(bad.Data, saved.Data, (size_t)records_offset);
+    bad[records_offset] = 0;
+    memcpy(bad.Data + records_offset + 1, saved.Data + records_offset, (size_t)(saved.Size - records_offset));
+    ((BinaryHeader*)bad.Data)->StringsSize++;
+    IM_CHECK(LoadRejected(loaded, bad, num_nodes));
+
+    // Random corruptions of the records: rejected, or loaded as a consistent tree
+    int corrupt_accepted = 0;
+    for (int step = 0; step < 500; step++)
+    {
+        bad = saved;
+        for (int n = 1 + (int)(Rand() % 4); n > 0; n--)
+        {
+            int* field = &GetRecord(bad, (int)(Rand() % header.NodesCount))->DepthDelta + Rand() % 7;
+            const int values[] = { -1, 0, 1, 2, -2, (int)Rand(), -(int)Rand(), -0x7FFFFFFF - 1, 0x7FFFFFFF };
+            *field = values[Rand() % IM_ARRAYSIZE(values)];
+        }
+        if (loaded.loadBinary(bad.Data, (size_t)bad.Size))
+        {
+            IM_CHECK_EQ(CheckCachedDepthAndIndex(loaded), 0);
+            corrupt_accepted++;
+            IM_CHECK(loaded.loadBinary(saved.Data, (size_t)saved.Size));
+        }
+    }
+    IM_CHECK(corrupt_accepted < 500);
+}
+
+// Names sharing prefixes longer than the 8 bytes of the packed sort keys, duplicates, short and empty names, and bytes >= 0x80
+static void AddSortTestChildNodes(TreeView& tv, TreeViewNode* parent, int count)
+{
+    const char* prefixes[] = { "", "a", "Map", "Map_0000", "Map_00001", "Map_0000\xE9", "Z", "\xC3\xA9" };
+    for (int i = 0; i < count; i++)
+    {
+        char name[32];
+        ImFormatString(name, IM_ARRAYSIZE(name), "%s%.*u", prefixes[Rand() % IM_ARRAYSIZE(prefixes)], (int)(Rand() % 4), Rand() % 50);
+        TreeViewNode* n = parent ? parent->addChildNode(TreeViewNode::Data(name)) : tv.addRootNode(TreeViewNode::Data(name));
+        n->setUserId(i);
+    }
+}
+
+struct NameLess
+{
+    bool reverse;
+    bool operator()(const TreeViewNode* a, const TreeViewNode* b) const { const int c = strcmp(a->getDisplayName(), b->getDisplayName()); return reverse ? c > 0 : c < 0; }
+};
+
+// Sort the child nodes of all the nodes with child nodes, and compare each list with std::stable_sort() of the previous order
+static void CheckSortByDisplayName(TestTreeView& tv, bool reverse_order, int threads_count)
+{
+    ImVector<TreeViewNode*> parents;
+    tv.getAllNodes(parents);
+    std::vector<std::vector<const TreeViewNode*> > expected(parents.Size + 1);
+    for (int p = 0; p <= parents.Size; p++)
+    {
+        const int count = (p < parents.Size) ? parents[p]->getNumChildNodes() : tv.getNumRootNodes();
+        for (int i = 0; i < count; i++)
+            expected[p].push_back((p < parents.Size) ? parents[p]->getChildNode(i) : tv.getRootNode(i));
+        NameLess less;
+        less.reverse = reverse_order;
+        std::stable_sort(expected[p].begin(), expected[p].end(), less);
+    }
+
+    const int backup_threads_count = TreeView::SortThreadsCount;
+    TreeView::SortThreadsCount = threads_count;
+    tv.sortRootNodesByDisplayName(true, reverse_order);
+    TreeView::SortThreadsCount = backup_threads_count;
+
+    int errors = 0;
+    for (int p = 0; p <= parents.Size; p++)
+        for (int i = 0; i < (int)expected[p].size(); i++)
+            if (expected[p][i] != ((p < parents.Size) ? parents[p]->getChildNode(i) : tv.getRootNode(i)))
+                errors++;
+    IM_CHECK_EQ(errors, 0);
+    IM_CHECK_EQ(CheckCachedDepthAndIndex(tv), 0);
+}
+
+static void TestSortByDisplayName()
+{
+    // Small: a single list, always sorted on the calling thread
+    for (int reverse_order = 0; reverse_order < 2; reverse_order++)
+    {
+        TestTreeView tv;
+        AddSortTestChildNodes(tv, NULL, 500);
+        CheckSortByDisplayName(tv, reverse_order != 0, 0);
+    }
+
+    // Big: several lists with 4096 child nodes or more in total, on the calling thread then in parallel
+    for (int threads_count = 1; threads_count <= 4; threads_count += 3)
+        for (int reverse_order = 0; reverse_order < 2; reverse_order++)
+        {
+            TestTreeView tv;
+            AddSortTestChildNodes(tv, NULL, 6);
+            for (int i = 0; i < tv.getNumRootNodes(); i++)
+            {
+                TreeViewNode* root = tv.getRootNode(i);
+                root->addEmptyChildNodeVector();
+                AddSortTestChildNodes(tv, root, 1000);
+                for (int j = 0; j < 3; j++)
+                {
+                    TreeViewNode* n = root->getChildNode((int)(Rand() % root->getNumChildNodes()));
+                    n->addEmptyChildNodeVector();
+                    AddSortTestChildNodes(tv, n, 200);
+                }
+            }
+            ImVector<TreeViewNode*> nodes;
+            tv.getAllNodes(nodes);
+            IM_CHECK(nodes.Size >= 4096);
+            CheckSortByDisplayName(tv, reverse_order != 0, threads_count);
+        }
+
+    // Sorted insertion goes after the equal names
+    TestTreeView tv;
+    AddSortTestChildNodes(tv, NULL, 300);
+    tv.sortRootNodesByDisplayName();
+    int errors = 0;
+    for (int i = 0; i < 200; i++)
+    {
+        TreeViewNode* ref = tv.getRootNode((int)(Rand() % tv.getNumRootNodes()));
+        TreeViewNode* n = tv.addRootNodeSortedByDisplayName(TreeViewNode::Data(ref->getDisplayName()));
+        const int idx = n->getNodeIndex();
+        if (idx == 0 || strcmp(tv.getRootNode(idx - 1)->getDisplayName(), n->getDisplayName()) != 0)
+            errors++;
+        if (idx + 1 < tv.getNumRootNodes() && strcmp(tv.getRootNode(idx + 1)->getDisplayName(), n->getDisplayName()) <= 0)
+            errors++;
+    }
+    IM_CHECK_EQ(errors, 0);
+}
+
+int main(int argc, char** argv)
+{
+    ImTestParseArgs(argc, argv);
+    ImGuiContext* ctx = ImTestCreateContext();
+    TestFreeListReuse();
+    TestCachedDepthAndIndex();
+    TestClearThenFreeAllNodeMemory();
+    TestToggledRowsSplice();
+    TestBinaryRoundTrip();
+    TestSortByDisplayName();
+    ImTestDestroyContext(ctx);
+    return ImTestReport("test_treeview");
+}
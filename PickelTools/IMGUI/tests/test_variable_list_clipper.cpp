@@ -0,0 +1,165 @@
+// ImGuiVariableListClipper over 100k rows of mixed heights: the Fenwick tree matches naive prefix sums through updates, resizes, insertions
+// and erasures; only the visible rows are submitted, their measured heights are exact, and the visible rows don't move when rows above
+// them change height.
+
+#include "imgui_test.h"
+#include "imgui_internal.h"
+#include <chrono>
+#include <string.h>
+
+static const int    g_ItemsCount = 100000;
+
+struct ListState
+{
+    ImGuiVariableListClipper    Clipper;
+    ImVector<int>               LinesCount;     // Lines of text of each row
+    int                         Submitted;      // Rows submitted by the last frame
+    int                         TrackedItem;    // Row whose screen position is recorded, or -1
+    float                       TrackedItemY;
+    float                       ScrollY;        // >= 0.0f: scroll position requested for the next frame
+};
+
+static void SubmitList(ListState* state)
+{
+    ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(600, 400), ImGuiCond_Always);
+    ImGui::Begin("List");
+    if (state->ScrollY >= 0.0f)
+        ImGui::SetScrollY(state->ScrollY);
+    state->ScrollY = -1.0f;
+    state->Submitted = 0;
+    state->TrackedItemY = -1.0f;
+    ImGuiVariableListClipper& clipper = state->Clipper;
+    clipper.Begin(state->LinesCount.Size);
+    while (clipper.Step())
+        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+        {
+            clipper.BeginItem(i);
+            if (i == state->TrackedItem)
+                state->TrackedItemY = ImGui::GetCursorScreenPos().y;
+            ImGui::Text("Row %d", i);
+            for (int line = 1; line < state->LinesCount[i]; line++)
+                ImGui::Text("  line %d", line);
+            state->Submitted++;
+        }
+    ImGui::End();
+}
+
+static void RunFrame(ListState* state)
+{
+    ImTestNewFrame();
+    SubmitList(state);
+    ImTestEndFrame();
+}
+
+static bool CheckTree(const ImGuiVariableListClipper& clipper)
+{
+    // Naive prefix sums, compared at every item and with FindItemAtOffsetY() at the start and in the middle of each item
+    double sum = 0.0;
+    int errors = 0;
+    for (int n = 0; n <= clipper.ItemsHeight.Size; n++)
+    {
+        if (ImFabs(clipper.GetItemOffsetY(n) - (float)sum) > 0.01f)
+            errors++;
+        if (n < clipper.ItemsHeight.Size)
+        {
+            const float height = clipper.ItemsHeight[n];
+            if (height > 0.5f && (clipper.FindItemAtOffsetY((float)(sum + height * 0.5)) != n || clipper.FindItemAtOffsetY((float)sum + 0.25f) != n))
+                errors++;
+            sum += height;
+        }
+    }
+    return errors == 0;
+}
+
+int main()
+{
+    ImGuiContext* ctx = ImTestCreateContext();
+    ListState* state = IM_NEW(ListState)();
+    state->ScrollY = -1.0f;
+    state->TrackedItem = -1;
+    state->LinesCount.resize(g_ItemsCount);
+    for (int n = 0; n < g_ItemsCount; n++)
+        state->LinesCount[n] = 1 + (int)((n * 2654435761u) >> 28) % 4;   // 1 to 4 lines
+
+    // First frame: estimated heights, only the first page is submitted
+    RunFrame(state);
+    ImGuiVariableListClipper& clipper = state->Clipper;
+    IM_CHECK_EQ(clipper.ItemsHeight.Size, g_ItemsCount);
+    IM_CHECK(state->Submitted > 0 && state->Submitted < 40);
+    const float line_height = ImGui::GetTextLineHeightWithSpacing();
+    int measure_errors = 0;
+    for (int n = 0; n < state->Submitted - 1; n++)   // The last one may not be measured if it went past the clip rect
+        if (ImFabs(clipper.ItemsHeight[n] - line_height * state->LinesCount[n]) > 0.01f)
+            measure_errors++;
+    IM_CHECK_EQ(measure_errors, 0);
+    IM_CHECK(CheckTree(clipper));
+
+    // Scrolling to the middle: the rows submitted cover the view, and their measured heights are exact
+    state->ScrollY = clipper.GetTotalHeight() * 0.5f;
+    RunFrame(state);
+    RunFrame(state);
+    IM_CHECK(state->Submitted > 0 && state->Submitted < 40);
+    ImGuiWindow* window = ImGui::FindWindowByName("List");
+    const int first_visible = clipper.FindItemAtOffsetY(window->Scroll.y);
+    IM_CHECK(first_visible > g_ItemsCount / 4);
+    IM_CHECK(ImFabs(clipper.ItemsHeight[first_visible + 1] - line_height * state->LinesCount[first_visible + 1]) < 0.01f);
+
+    // Rows above the view changing height: the tracked row keeps its screen position
+    state->TrackedItem = first_visible + 2;
+    RunFrame(state);
+    const float tracked_y = state->TrackedItemY;
+    IM_CHECK(tracked_y > 0.0f);
+    for (int n = 0; n < 1000; n++)
+        state->LinesCount[n * 10] = 8;
+    for (int n = 0; n < 1000; n++)
+        clipper.SetItemHeight(n * 10, line_height * 8);
+    state->LinesCount[first_visible - 1] = 6;   // Partially visible or just above the view, without SetItemHeight(): follows its measure
+    RunFrame(state);
+    RunFrame(state);
+    IM_CHECK_NEAR(state->TrackedItemY, tracked_y, 0.5f);
+    IM_CHECK(CheckTree(clipper));
+
+    // Same with rows inserted above the view
+    clipper.InsertItems(0, 100);
+    state->LinesCount.resize(state->LinesCount.Size + 100);
+    memmove(state->LinesCount.Data + 100, state->LinesCount.Data, (size_t)(state->LinesCount.Size - 100) * sizeof(int));
+    for (int n = 0; n < 100; n++)
+        state->LinesCount[n] = 2;
+    state->TrackedItem += 100;
+    RunFrame(state);
+    RunFrame(state);
+    IM_CHECK_NEAR(state->TrackedItemY, tracked_y, 0.5f);
+
+    // Growing, inserting and erasing keep the tree consistent with the heights
+    state->LinesCount.resize(state->LinesCount.Size + 5000, 2);
+    RunFrame(state);
+    IM_CHECK_EQ(clipper.ItemsHeight.Size, g_ItemsCount + 100 + 5000);
+    IM_CHECK(CheckTree(clipper));
+    clipper.InsertItems(50, 300);
+    clipper.EraseItems(60000, 1234);
+    IM_CHECK_EQ(clipper.ItemsHeight.Size, g_ItemsCount + 100 + 5000 + 300 - 1234);
+    IM_CHECK(CheckTree(clipper));
+    state->LinesCount.resize(clipper.ItemsHeight.Size);
+    state->LinesCount.resize(1000);
+    RunFrame(state);
+    IM_CHECK_EQ(clipper.ItemsHeight.Size, 1000);
+    IM_CHECK(CheckTree(clipper));
+
+    // Cost of a frame scrolling through the whole list, for reference only
+    state->LinesCount.resize(g_ItemsCount, 3);
+    const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    const int frames = 200;
+    for (int frame = 0; frame < frames; frame++)
+    {
+        state->ScrollY = clipper.GetTotalHeight() * frame / frames;
+        RunFrame(state);
+    }
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    printf("test_variable_list_clipper: %d rows, %.4f ms per frame\n", g_ItemsCount, ms / frames);
+    IM_CHECK(state->Submitted > 0 && state->Submitted < 40);
+
+    IM_DELETE(state);
+    ImTestDestroyContext(ctx);
+    return ImTestReport("test_variable_list_clipper");
+}
@@ -6,6 +6,8 @@
 
 #include "bakkesmod/wrappers/cvarmanagerwrapper.h"
 #include "IMGUI/imgui.h"
+#include "IMGUI/imgui_allocator.h"
+#include "IMGUI/imgui_profiler.h"
 
 BAKKESMOD_PLUGIN(PickelTools, "PickelTools", plugin_version, PLUGINTYPE_FREEPLAY)
 
@@ -43,6 +45,10 @@ void clearPlaylists(MatchmakingWrapper& mm) {
 
 void PickelTools::onLoad() {
 	_globalCvarManager = cvarManager;
+#ifdef IMGUI_ENABLE_PROFILER
+	// onLoad() and the event hooks run on the game thread, RenderSettings() on the render thread.
+	ImGui::ProfilerSetThreadName("Game thread");
+#endif
 
 	cvarManager->registerCvar(enabledCvarName, "1", "Determines whether PickelTools is enabled.").addOnValueChanged(std::bind(&PickelTools::pluginEnabledChanged, this));
 	cvarManager->registerCvar(trainingMapCvarName, "EuroStadium_Night_P", "Determines the map that will launch for training.");
@@ -64,9 +70,21 @@ void PickelTools::onLoad() {
 void PickelTools::onUnload() {
 	mmrNotifierToken.reset();
 	awaitingFinalMmrUpdate = false;
+#ifdef IMGUI_ENABLE_PROFILER
+	ImGui::ProfilerShutdown();
+#endif
 }
 
 void PickelTools::RenderSettings() {
+	// The host runs NewFrame(), so roll the allocator counters and mark the profiler frame from here.
+#ifdef IMGUI_ENABLE_FRAME_ALLOCATOR
+	ImGui::FrameAllocatorNewFrame();
+#endif
+#ifdef IMGUI_ENABLE_PROFILER
+	ImGui::ProfilerNewFrame();
+#endif
+	IMGUI_PROFILE_ZONE("PickelTools::RenderSettings");
+
 	const char* items[] = { "Ranked Duel", "Ranked Doubles", "Ranked Standard" };
 	static int selectedGameMode = 0;
 	ImGui::ListBox("Game Mode", &selectedGameMode, items, IM_ARRAYSIZE(items), -1);
@@ -130,12 +148,22 @@ void PickelTools::RenderSettings() {
 	
 	ImGui::SameLine();
 	ImGui::InputInt("Number of Games", &numGames);
+
+#ifdef IMGUI_ENABLE_PROFILER
+	if (ImGui::CollapsingHeader("Profiler")) {
+		ImGui::ShowProfiler();
+	}
+#endif
 }
 
 std::string PickelTools::GetPluginName() { return "PickelTools"; }
 
 void PickelTools::SetImGuiContext(uintptr_t ctx) {
 	ImGui::SetCurrentContext(reinterpret_cast<ImGuiContext*>(ctx));
+#ifdef IMGUI_ENABLE_FRAME_ALLOCATOR
+	// The allocator forwards to malloc()/free(): the host, which owns the context, can free buffers we grow (and vice versa).
+	ImGui::InstallFrameAllocator();
+#endif
 }
 
 // static
@@ -280,6 +308,7 @@ void PickelTools::onMatchEnd(ServerWrapper server, void* params, std::string eve
 }
 
 void PickelTools::onPenaltyChanged(ServerWrapper server, void* params, std::string eventName) {
+	IMGUI_PROFILE_ZONE("PickelTools::onPenaltyChanged");
 	if (server.GetbHasLeaveMatchPenalty()) return;
 
 	// Match leave penalty has been lifted. Either:
@@ -374,6 +403,7 @@ PickelTools::Ranks PickelTools::buildNewRanks() {
 }
 
 void PickelTools::onMmrUpdate(UniqueIDWrapper id) {
+	IMGUI_PROFILE_ZONE("PickelTools::onMmrUpdate");
 	if (id != uniqueId) {
 		LOG("Received MMR update for unrecognized player: {}", id.GetIdString());
 	}